@@ -52,7 +52,58 @@
 *********************************************************************************************************
 */
 #define APP_CFG_TASK_START_STK_SIZE          128u
-#define APP_CFG_TASK_SYMBOL_CONTROL_STK_SIZE 128u   /* Replaces old TIMER_OUT stack size */
+#define APP_CFG_TASK_SYMBOL_CONTROL_STK_SIZE 512u   /* Replaces old TIMER_OUT stack size. Deepest call */
+                                                    /* path 912 B by -fstack-usage on the host, plus the */
+                                                    /* FP context; check .StkUsed on target */
 #define APP_CFG_SW_TASK_STK_SIZE             128u
 
+/*
+*********************************************************************************************************
+*                                               SWITCHES
+*********************************************************************************************************
+*/
+#define APP_CFG_SW_IRQ_EN                    1u     /* 1: edge interrupt + debounce window, 0: 8 tick polling */
+
+/*
+*********************************************************************************************************
+*                                            SERIAL PROTOCOL
+*********************************************************************************************************
+*/
+#define APP_CFG_PROTO_BINARY                 0u     /* 1: COBS framed packets (SymProto.h), 0: text lines */
+
+/*
+*********************************************************************************************************
+*                                          QUICK ACCESS RING
+*********************************************************************************************************
+*/
+#define APP_CFG_QA_SIZE                      8u     /* Most used symbols kept, SW2 cycles these first */
+#define APP_CFG_QA_FLUSH_MS                  5000u  /* Save to flash after this long without a switch */
+
+/*
+*********************************************************************************************************
+*                                             COMPOSITION
+*********************************************************************************************************
+*/
+#define APP_CFG_COMPOSE_MAX                  6u     /* Staged symbols per SYMBOL_SEQ, 0: off. Binary: 6 max with stamps */
+
+/*
+*********************************************************************************************************
+*                                           LATENCY PROBES
+*********************************************************************************************************
+*/
+#define APP_CFG_LAT_PROBE_EN                 1u     /* 1: us histograms per probe (LatProbe.h), dumped on 'L' */
+#define APP_CFG_EV_STAMP_EN                  1u     /* 1: IDX/SENT carry CPU_TS stamps, 'S' answers a clock sync */
+
+/*
+*********************************************************************************************************
+*                                          KERNEL BENCHMARKS
+*********************************************************************************************************
+*/
+#ifndef APP_CFG_KBENCH_EN                           /* May be set on the command line (host build) */
+#define APP_CFG_KBENCH_EN                    0u     /* 1: run the kernel benchmarks (KBench.h) before the menu */
+#endif
+#define APP_CFG_KBENCH_ITER                  5000u  /* Iterations per benchmark */
+#define APP_CFG_KBENCH_PRIO                  2u     /* First of 4 helper tasks, above the start task */
+#define APP_CFG_KBENCH_STK_SIZE              128u
+
 #endif
@@ -38,6 +38,8 @@
 
 #define   MICRIUM_SOURCE
 #include  <os.h>
+#include  "MCUType.h"
+#include  "CsOS_Tick.h"
 #include  "os_app_hooks.h"
 
 
@@ -131,12 +133,32 @@ void  App_OS_ClrAllHooks (void)
 *
 * Arguments  : none
 *
-* Note(s)    : none
+* Note(s)    : 1) With the dynamic tick (board/CsOS_Tick.c) nothing interrupts an idle core before the next timeout or
+*                 event, so it sleeps in WFI. The idle task counts one per pass, and a pass that sleeps would count the
+*                 whole sleep as one, so OSStatTaskCPUUsage would read the time asleep as busy and the idle count
+*                 OSStatTaskCPUUsageInit() calibrates against would be off as well. The LPTMR counts spent asleep are
+*                 added to OSStatTaskCtr instead, so both the calibration and each statistic period count idle time
+*                 in the same units. The host port's OSIdleTaskHook() already waits for an interrupt.
 ************************************************************************************************************************
 */
 
 void  App_OS_IdleTaskHook (void){
+#if (OS_CFG_DYN_TICK_EN > 0u) && !defined(CS_HOST_POSIX)
+    INT32U  slept;
+#if (OS_CFG_STAT_TASK_EN > 0u)
+    CPU_SR_ALLOC();
+#endif
+
 
+    slept = CsOSTickIdle();                                     /* See Note #1.                                         */
+#if (OS_CFG_STAT_TASK_EN > 0u)
+    CPU_CRITICAL_ENTER();
+    OSStatTaskCtr += (OS_TICK)slept;
+    CPU_CRITICAL_EXIT();
+#else
+    (void)slept;
+#endif
+#endif
 }
 
 /*
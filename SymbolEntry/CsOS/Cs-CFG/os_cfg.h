@@ -44,12 +44,25 @@
 #define OS_CFG_ARG_CHK_EN                          0u           /* Enable (1) or Disable (0) argument checking                           */
 #define OS_CFG_CALLED_FROM_ISR_CHK_EN              1u           /* Enable (1) or Disable (0) check for called from ISR                   */
 #define OS_CFG_CALLED_FROM_TMR_CHK_EN              1u           /* Enable (1) or Disable (0) check for called from Timer                 */
+#ifndef OS_CFG_DBG_EN                                           /* May be set on the command line (host build)                           */
 #define OS_CFG_DBG_EN                              0u           /* Enable (1) or Disable (0) debug code/variables                        */
+#endif
 #define OS_CFG_TICK_EN                             1u           /* Enable (1) or Disable (0) the kernel tick                             */
-#define OS_CFG_DYN_TICK_EN                         0u           /* Enable (1) or Disable (0) the Dynamic Tick                            */
+#ifndef OS_CFG_DYN_TICK_EN                                      /* May be set on the command line (host build)                           */
+#define OS_CFG_DYN_TICK_EN                         1u           /* Enable (1) or Disable (0) the Dynamic Tick (board/CsOS_Tick.c)        */
+#endif
+#ifndef OS_CFG_TICK_WHEEL_EN                                    /* May be set on the command line (host/tick_bench.c)                    */
+#define OS_CFG_TICK_WHEEL_EN                       1u           /* Timeouts in a hashed timing wheel (1) or a sorted delta list (0)      */
+#endif
 #define OS_CFG_INVALID_OS_CALLS_CHK_EN             0u           /* Enable (1) or Disable (0) checks for invalid kernel calls             */
+#ifndef OS_CFG_ISR_POST_DEFERRED_EN                             /* May be set on the command line (host build)                           */
+#define OS_CFG_ISR_POST_DEFERRED_EN                0u           /* Posts from ISRs replayed by the ISR handler task (1) or done now (0)  */
+#endif
 #define OS_CFG_OBJ_TYPE_CHK_EN                     1u           /* Enable (1) or Disable (0) object type checking                        */
 #define OS_CFG_OBJ_CREATED_CHK_EN                  1u           /* Enable (1) or Disable (0) object created checks                       */
+#ifndef OS_CFG_PEND_LIST_BITMAP_EN                              /* May be set on the command line (host/pend_bench.c)                    */
+#define OS_CFG_PEND_LIST_BITMAP_EN                 0u           /* Pend lists with a priority bitmap (1) or a sorted walk (0)            */
+#endif
 #define OS_CFG_TS_EN                               1u           /* Enable (1) or Disable (0) time stamping                               */
 
 #define OS_CFG_PRIO_MAX                           32u           /* Defines the maximum number of task priorities (see OS_PRIO data type) */
@@ -107,7 +120,9 @@
 
 #define OS_CFG_TASK_CHANGE_PRIO_EN                 1u           /* Include code for OSTaskChangePrio()                                   */
 #define OS_CFG_TASK_DEL_EN                         1u           /* Include code for OSTaskDel()                                          */
-#define OS_CFG_TASK_PROFILE_EN                     0u           /* Include variables in OS_TCB for profiling                             */
+#ifndef OS_CFG_TASK_PROFILE_EN                                  /* May be set on the command line (host build)                           */
+#define OS_CFG_TASK_PROFILE_EN                     0u           /* Include variables in OS_TCB for profiling, see OSTaskProfileGet()     */
+#endif
 #define OS_CFG_TASK_Q_EN                           1u           /* Include code for OSTaskQXXXX()                                        */
 #define OS_CFG_TASK_Q_PEND_ABORT_EN                1u           /* Include code for OSTaskQPendAbort()                                   */
 #define OS_CFG_TASK_REG_TBL_SIZE                   1u           /* Number of task specific registers                                     */
@@ -135,7 +150,9 @@
 
 
                                                                 /* ------------------------- TRACE RECORDER ---------------------------- */
-#define OS_CFG_TRACE_EN                            0u           /* Enable (1) or Disable (0) Cs/OS3 Trace instrumentation                */
+#ifndef OS_CFG_TRACE_EN                                         /* May be set on the command line, needs OS_CFG_DBG_EN                   */
+#define OS_CFG_TRACE_EN                            0u           /* Enable (1) or Disable (0) Cs/OS3 Trace instrumentation (CsOS_Trace.c) */
+#endif
 #define OS_CFG_TRACE_API_ENTER_EN                  0u           /* Enable (1) or Disable (0) Cs/OS3 Trace API enter instrumentation      */
 #define OS_CFG_TRACE_API_EXIT_EN                   0u           /* Enable (1) or Disable (0) Cs/OS3 Trace API exit  instrumentation      */
 
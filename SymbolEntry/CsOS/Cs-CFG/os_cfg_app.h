@@ -53,6 +53,14 @@
 #define  OS_CFG_TASK_STK_LIMIT_PCT_EMPTY                  10u
 
 
+                                                                /* ----------------- ISR HANDLER TASK ----------------- */
+                                                                /* Posts from ISRs waiting for the ISR handler task, a  */
+                                                                /* power of 2 (OS_CFG_ISR_POST_DEFERRED_EN)             */
+#define  OS_CFG_INT_Q_SIZE                                16u
+                                                                /* Stack size (number of CPU_STK elements)              */
+#define  OS_CFG_INT_Q_TASK_STK_SIZE                      128u
+
+
                                                                 /* -------------------- IDLE TASK --------------------- */
                                                                 /* Stack size (number of CPU_STK elements)              */
 #define  OS_CFG_IDLE_TASK_STK_SIZE                        64u
@@ -65,11 +73,18 @@
 #define  OS_CFG_STAT_TASK_RATE_HZ                         10u
                                                                 /* Stack size (number of CPU_STK elements)              */
 #define  OS_CFG_STAT_TASK_STK_SIZE                       100u
+                                                                /* Stack entries checked per stack each run, 0 checks   */
+                                                                /* every stack in full (OS_CFG_STAT_TASK_STK_CHK_EN)    */
+#define  OS_CFG_STAT_TASK_STK_CHK_WORDS                   16u
 
 
                                                                 /* ---------------------- TICKS ----------------------- */
                                                                 /* Tick rate in Hertz (10 to 1000 Hz)                   */
 #define  OS_CFG_TICK_RATE_HZ                            1000u
+                                                                /* Spokes in the tick wheel, a power of 2 (OS_CFG_TICK_ */
+                                                                /* WHEEL_EN). Timeouts up to this many ticks are only   */
+                                                                /* visited when they expire.                            */
+#define  OS_CFG_TICK_WHEEL_SIZE                           64u
 
 
                                                                 /* --------------------- TIMERS ----------------------- */
@@ -0,0 +1,48 @@
+/*
+*********************************************************************************************************
+*                                               Cs/OS3
+*                                        The Real-Time Kernel
+*
+*                                     Trace recorder event hooks
+*********************************************************************************************************
+* File    : os_trace_events.h
+*********************************************************************************************************
+* Note(s) : (1) Included by os_trace.h when OS_CFG_TRACE_EN is enabled. Maps the Cs/OS3 trace hooks used
+*               by this project onto the RAM trace recorder in board/CsOS_Trace.c. Hooks not defined here
+*               keep their empty defaults from os_trace.h.
+*
+*           (2) Tasks and semaphores get a recorder ID in TaskID/SemID as they are created.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_TRACE_EVENTS_H
+#define  OS_TRACE_EVENTS_H
+
+#include  "CsOS_Trace.h"
+
+
+#define  OS_TRACE_ISR_ENTER()                    CsOSTraceIsrEnter((CPU_INT08U)OSIntNestingCtr)
+#define  OS_TRACE_ISR_EXIT()                     CsOSTraceRec(CSOS_TRACE_ISR_EXIT, 0u, (CPU_INT16U)OSIntNestingCtr)
+#define  OS_TRACE_ISR_EXIT_TO_SCHEDULER()        CsOSTraceRec(CSOS_TRACE_ISR_EXIT_SCHED, 0u, 0u)
+
+#define  OS_TRACE_TICK_INCREMENT(OSTickCtr)      CsOSTraceRec(CSOS_TRACE_TICK, 0u, (CPU_INT16U)(OSTickCtr))
+#define  OS_TRACE_TICK_LIST_UPDATE_ENTER(ticks)  CsOSTraceRec(CSOS_TRACE_TICK_LIST_BEGIN, 0u, (CPU_INT16U)(ticks))
+#define  OS_TRACE_TICK_LIST_UPDATE_EXIT(nbr)     CsOSTraceRec(CSOS_TRACE_TICK_LIST_END, 0u, (CPU_INT16U)(nbr))
+
+#define  OS_TRACE_TASK_CREATE(p_tcb)             ((p_tcb)->TaskID = CsOSTraceObjNew(CSOS_TRACE_OBJ_TASK,      \
+                                                                                    (p_tcb)->NamePtr,          \
+                                                                                    (CPU_INT08U)(p_tcb)->Prio))
+#define  OS_TRACE_TASK_READY(p_tcb)              CsOSTraceRec(CSOS_TRACE_TASK_READY, (CPU_INT08U)(p_tcb)->TaskID, 0u)
+#define  OS_TRACE_TASK_SWITCHED_IN(p_tcb)        CsOSTraceRec(CSOS_TRACE_TASK_IN, (CPU_INT08U)(p_tcb)->TaskID,      \
+                                                              (CPU_INT16U)(p_tcb)->Prio)
+
+#define  OS_TRACE_TASK_SEM_POST(p_tcb)           CsOSTraceRec(CSOS_TRACE_TSEM_POST, (CPU_INT08U)(p_tcb)->TaskID, 0u)
+#define  OS_TRACE_TASK_SEM_PEND(p_tcb)           CsOSTraceRec(CSOS_TRACE_TSEM_PEND, (CPU_INT08U)(p_tcb)->TaskID, 0u)
+#define  OS_TRACE_TASK_SEM_PEND_BLOCK(p_tcb)     CsOSTraceRec(CSOS_TRACE_TSEM_PEND_BLOCK, (CPU_INT08U)(p_tcb)->TaskID, 0u)
+
+#define  OS_TRACE_SEM_CREATE(p_sem, p_name)      ((p_sem)->SemID = CsOSTraceObjNew(CSOS_TRACE_OBJ_SEM, (p_name), 0u))
+#define  OS_TRACE_SEM_POST(p_sem)                CsOSTraceRec(CSOS_TRACE_SEM_POST, (CPU_INT08U)(p_sem)->SemID, 0u)
+#define  OS_TRACE_SEM_PEND(p_sem)                CsOSTraceRec(CSOS_TRACE_SEM_PEND, (CPU_INT08U)(p_sem)->SemID, 0u)
+#define  OS_TRACE_SEM_PEND_BLOCK(p_sem)          CsOSTraceRec(CSOS_TRACE_SEM_PEND_BLOCK, (CPU_INT08U)(p_sem)->SemID, 0u)
+
+#endif
@@ -0,0 +1,306 @@
+/*
+*********************************************************************************************************
+*                                               Cs/CPU
+*                                   CPU CONFIGURATION & PORT LAYER
+*
+*                           Copyright 2023; Weston Embedded Solutions, LLC.
+*                                       www.weston-embedded.com
+*
+*                   All rights reserved. Protected by international copyright laws.
+*
+*               Your use of this software is subject to your acceptance of the terms of
+*               a Weston Embedded Solutions software license, which can be obtained by
+*               contacting us at www.weston-embedded.com/company/contact. If you do not
+*                 agree to the terms of this license, you may not use this software.
+*
+*                 Please help us continue to provide the embedded community with the
+*                   finest software available. Your honesty is greatly appreciated.
+*
+*********************************************************************************************************
+*                                               uC/CPU
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*                                 SPDX-License-Identifier: APACHE-2.0
+*               This software is subject to an open-source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                            CPU PORT FILE
+*
+*                                         POSIX (Linux host)
+*                                           GNU C Compiler
+*
+* Filename : cpu.h
+* Version  : V1.32.05
+*********************************************************************************************************
+* Note(s)  : (1) This port runs the kernel inside a single Linux process so that the application can be
+*                profiled and checked at host speed (perf, valgrind, sanitizers).
+*
+*            (2) The 'interrupts' of this port are POSIX signals delivered to the kernel thread :
+*
+*                    CPU_HOST_SIG_TICK    SysTick (CPU_INT_SYSTICK), driven by a POSIX interval timer
+*                    CPU_HOST_SIG_IRQ     External interrupts (CPU_INT_EXT0+), raised by peripheral models
+*
+*                Disabling interrupts blocks both signals in the kernel thread's signal mask.
+*
+*            (3) This directory MUST be placed ahead of 'Cs-CPU' in the host include path and MUST be
+*                excluded from the target build.
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                               MODULE
+*********************************************************************************************************
+*/
+
+#ifndef  CPU_MODULE_PRESENT
+#define  CPU_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                          CPU INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <cpu_def.h>
+#include  <cpu_cfg.h>
+#include  <signal.h>
+
+#ifdef __cplusplus
+extern  "C" {
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    CONFIGURE STANDARD DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef            void        CPU_VOID;
+typedef            char        CPU_CHAR;                        /*  8-bit character                                     */
+typedef  unsigned  char        CPU_BOOLEAN;                     /*  8-bit boolean or logical                            */
+typedef  unsigned  char        CPU_INT08U;                      /*  8-bit unsigned integer                              */
+typedef    signed  char        CPU_INT08S;                      /*  8-bit   signed integer                              */
+typedef  unsigned  short       CPU_INT16U;                      /* 16-bit unsigned integer                              */
+typedef    signed  short       CPU_INT16S;                      /* 16-bit   signed integer                              */
+typedef  unsigned  int         CPU_INT32U;                      /* 32-bit unsigned integer                              */
+typedef    signed  int         CPU_INT32S;                      /* 32-bit   signed integer                              */
+typedef  unsigned  long  long  CPU_INT64U;                      /* 64-bit unsigned integer                              */
+typedef    signed  long  long  CPU_INT64S;                      /* 64-bit   signed integer                              */
+
+typedef            float       CPU_FP32;                        /* 32-bit floating point                                */
+typedef            double      CPU_FP64;                        /* 64-bit floating point                                */
+
+
+typedef  volatile  CPU_INT08U  CPU_REG08;                       /*  8-bit register                                      */
+typedef  volatile  CPU_INT16U  CPU_REG16;                       /* 16-bit register                                      */
+typedef  volatile  CPU_INT32U  CPU_REG32;                       /* 32-bit register                                      */
+typedef  volatile  CPU_INT64U  CPU_REG64;                       /* 64-bit register                                      */
+
+
+typedef            void      (*CPU_FNCT_VOID)(void);
+typedef            void      (*CPU_FNCT_PTR )(void *p_obj);
+
+
+/*
+*********************************************************************************************************
+*                                       CPU WORD CONFIGURATION
+*
+* Note(s) : (1) Host pointers are 64-bit; data words stay 32-bit so that kernel arithmetic matches the
+*               Cortex-M33 target.
+*********************************************************************************************************
+*/
+
+#define  CPU_CFG_ADDR_SIZE              CPU_WORD_SIZE_64        /* Defines CPU address word size  (in octets).          */
+#define  CPU_CFG_DATA_SIZE              CPU_WORD_SIZE_32        /* Defines CPU data    word size  (in octets).          */
+#define  CPU_CFG_DATA_SIZE_MAX          CPU_WORD_SIZE_64        /* Defines CPU maximum word size  (in octets).          */
+
+#define  CPU_CFG_ENDIAN_TYPE            CPU_ENDIAN_TYPE_LITTLE  /* Defines CPU data    word-memory order.               */
+
+
+/*
+*********************************************************************************************************
+*                                 CONFIGURE CPU ADDRESS & DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT64U  CPU_ADDR;                                  /* CPU address type based on address bus size.          */
+typedef  CPU_INT32U  CPU_DATA;                                  /* CPU data    type based on data    bus size.          */
+
+typedef  CPU_DATA    CPU_ALIGN;                                 /* Defines CPU data-word-alignment size.                */
+typedef  CPU_ADDR    CPU_SIZE_T;                                /* Defines CPU standard 'size_t'   size.                */
+
+
+/*
+*********************************************************************************************************
+*                                       CPU STACK CONFIGURATION
+*
+* Note(s) : (1) Each task executes on a host stack of OS_CPU_HOST_STK_SIZE bytes allocated by the port
+*               (see 'os_cpu_c.c  OSTaskStkInit()').  The CPU_STK array handed to OSTaskCreate() only
+*               holds the port's task record, so CPU_STK is pointer-sized.
+*********************************************************************************************************
+*/
+
+#define  CPU_CFG_STK_GROWTH       CPU_STK_GROWTH_HI_TO_LO       /* Defines CPU stack growth order.                      */
+
+#define  CPU_CFG_STK_ALIGN_BYTES  (16u)                         /* Defines CPU stack alignment in bytes.                */
+
+typedef  CPU_ADDR                 CPU_STK;                      /* Defines CPU stack data type (see Note #1).           */
+typedef  CPU_ADDR                 CPU_STK_SIZE;                 /* Defines CPU stack size data type.                    */
+
+
+/*
+*********************************************************************************************************
+*                                   CRITICAL SECTION CONFIGURATION
+*
+* Note(s) : (1) CPU_SR holds DEF_YES when the interrupt signals were already blocked on entry, so nested
+*               critical sections only unblock them on the outermost exit.
+*********************************************************************************************************
+*/
+
+#define  CPU_CFG_CRITICAL_METHOD    CPU_CRITICAL_METHOD_STATUS_LOCAL
+
+typedef  CPU_INT32U                 CPU_SR;                     /* Defines   CPU status register size (see Note #1).    */
+
+#define  CPU_SR_ALLOC()             CPU_SR  cpu_sr = (CPU_SR)0
+
+#define  CPU_INT_DIS()         do { cpu_sr = CPU_SR_Save(); } while (0) /* Save    CPU status word & disable interrupts.*/
+#define  CPU_INT_EN()          do { CPU_SR_Restore(cpu_sr); } while (0) /* Restore CPU status word.                     */
+
+
+#ifdef   CPU_CFG_INT_DIS_MEAS_EN
+#define  CPU_CRITICAL_ENTER()  do { CPU_INT_DIS();         \
+                                    CPU_IntDisMeasStart(); }  while (0)
+
+#define  CPU_CRITICAL_EXIT()   do { CPU_IntDisMeasStop();  \
+                                    CPU_INT_EN();          }  while (0)
+
+#else
+
+#define  CPU_CRITICAL_ENTER()  do { CPU_INT_DIS(); } while (0)          /* Disable   interrupts.                        */
+#define  CPU_CRITICAL_EXIT()   do { CPU_INT_EN();  } while (0)          /* Re-enable interrupts.                        */
+
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    MEMORY BARRIERS CONFIGURATION
+*********************************************************************************************************
+*/
+
+#define  CPU_MB()       __sync_synchronize()
+#define  CPU_RMB()      __sync_synchronize()
+#define  CPU_WMB()      __sync_synchronize()
+
+
+/*
+*********************************************************************************************************
+*                                    CPU COUNT ZEROS CONFIGURATION
+*
+* Note(s) : (1) The C versions in 'cpu_core.c' are used : CPU_CFG_LEAD_ZEROS_ASM_PRESENT and
+*               CPU_CFG_TRAIL_ZEROS_ASM_PRESENT are NOT #define'd for this port.
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                        HOST INTERRUPT SIGNALS
+*********************************************************************************************************
+*/
+
+#define  CPU_HOST_SIG_TICK                          SIGALRM     /* SysTick.                                             */
+#define  CPU_HOST_SIG_IRQ                           SIGUSR1     /* External interrupts.                                 */
+
+#define  CPU_HOST_INT_SRC_NBR_MAX                       256u    /* Size of the host vector table.                       */
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void        CPU_IntDis       (void);
+void        CPU_IntEn        (void);
+
+void        CPU_IntSrcDis    (CPU_INT08U  pos);
+void        CPU_IntSrcEn     (CPU_INT08U  pos);
+void        CPU_IntSrcPendClr(CPU_INT08U  pos);
+CPU_INT16S  CPU_IntSrcPrioGet(CPU_INT08U  pos);
+void        CPU_IntSrcPrioSet(CPU_INT08U  pos,
+                              CPU_INT08U  prio,
+                              CPU_INT08U  type);
+
+CPU_SR      CPU_SR_Save      (void);
+void        CPU_SR_Restore   (CPU_SR      cpu_sr);
+
+void        CPU_WaitForInt   (void);
+void        CPU_WaitForExcept(void);
+
+CPU_DATA    CPU_RevBits      (CPU_DATA    val);
+
+                                                                /* ------------------ HOST INTERRUPTS ------------------ */
+void        CPU_HostIntInit  (void);
+void        CPU_HostIntVectSet(CPU_INT08U     pos,
+                               CPU_FNCT_VOID  isr);
+void        CPU_HostIntSrcPendSet(CPU_INT08U  pos);             /* May be called from any host thread.                  */
+CPU_INT08U  CPU_HostIntCurGet(void);                            /* Vector being serviced, 0 in thread mode (IPSR).      */
+void        CPU_HostThreadSigBlock(void);
+
+
+/*
+*********************************************************************************************************
+*                                          INTERRUPT SOURCES
+*********************************************************************************************************
+*/
+
+#define  CPU_INT_STK_PTR                                   0u
+#define  CPU_INT_RESET                                     1u
+#define  CPU_INT_NMI                                       2u
+#define  CPU_INT_HFAULT                                    3u
+#define  CPU_INT_MEM                                       4u
+#define  CPU_INT_BUSFAULT                                  5u
+#define  CPU_INT_USAGEFAULT                                6u
+#define  CPU_INT_SECUREFAULT                               7u
+#define  CPU_INT_RSVD_08                                   8u
+#define  CPU_INT_RSVD_09                                   9u
+#define  CPU_INT_RSVD_10                                  10u
+#define  CPU_INT_SVCALL                                   11u
+#define  CPU_INT_DBGMON                                   12u
+#define  CPU_INT_RSVD_13                                  13u
+#define  CPU_INT_PENDSV                                   14u
+#define  CPU_INT_SYSTICK                                  15u
+#define  CPU_INT_EXT0                                     16u
+
+
+/*
+*********************************************************************************************************
+*                                            INTERRUPT TYPE
+*********************************************************************************************************
+*/
+
+#define  CPU_INT_KA                                        0u   /* Kernel Aware     interrupt request.                  */
+#define  CPU_INT_NKA                                       1u   /* Non-Kernel Aware interrupt request.                  */
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                          /* End of CPU module include.                           */
@@ -0,0 +1,566 @@
+/*
+*********************************************************************************************************
+*                                               Cs/CPU
+*                                   CPU CONFIGURATION & PORT LAYER
+*
+*                           Copyright 2023; Weston Embedded Solutions, LLC.
+*                                       www.weston-embedded.com
+*
+*                   All rights reserved. Protected by international copyright laws.
+*
+*               Your use of this software is subject to your acceptance of the terms of
+*               a Weston Embedded Solutions software license, which can be obtained by
+*               contacting us at www.weston-embedded.com/company/contact. If you do not
+*                 agree to the terms of this license, you may not use this software.
+*
+*                 Please help us continue to provide the embedded community with the
+*                   finest software available. Your honesty is greatly appreciated.
+*
+*********************************************************************************************************
+*                                               uC/CPU
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*                                 SPDX-License-Identifier: APACHE-2.0
+*               This software is subject to an open-source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                            CPU PORT FILE
+*
+*                                         POSIX (Linux host)
+*                                           GNU C Compiler
+*
+* Filename : cpu_c.c
+* Version  : V1.32.05
+*********************************************************************************************************
+* Note(s)  : (1) Also provides the CPU timestamp timer that 'cpu_ts.c' provides on the target, using
+*                CLOCK_MONOTONIC with a 1 ns count.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define   _GNU_SOURCE
+#include  <cpu.h>
+#include  <cpu_core.h>
+
+#include  <lib_def.h>
+
+#include  <pthread.h>
+#include  <signal.h>
+#include  <time.h>
+
+#ifdef __cplusplus
+extern  "C" {
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  CPU_HOST_INT_PEND_WORDS             (CPU_HOST_INT_SRC_NBR_MAX / 32u)
+
+#define  CPU_HOST_TS_TMR_FREQ_HZ              1000000000u       /* CLOCK_MONOTONIC nanoseconds.                         */
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  sigset_t        CPU_HostIntSigSet;                      /* Signals treated as interrupts.                       */
+static  pthread_t       CPU_HostKernelThread;                   /* Thread that runs the kernel & receives interrupts.   */
+static  CPU_BOOLEAN     CPU_HostIntInitDone = DEF_NO;
+
+static  CPU_FNCT_VOID   CPU_HostIntVectTbl[CPU_HOST_INT_SRC_NBR_MAX];
+static  CPU_INT32U      CPU_HostIntEnTbl  [CPU_HOST_INT_PEND_WORDS];
+static  CPU_INT32U      CPU_HostIntPendTbl[CPU_HOST_INT_PEND_WORDS];
+static  CPU_INT08U      CPU_HostIntCur    = 0u;                /* Vector being serviced, see CPU_HostIntCurGet().      */
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  CPU_HostIntSigHandler(int  sig);
+static  void  CPU_HostIntSigSetInit(void);
+
+
+/*
+*********************************************************************************************************
+*                                            CPU_IntDis()
+*                                            CPU_IntEn()
+*
+* Description : Disable/enable interrupts by blocking/unblocking the interrupt signals in the calling
+*               thread.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+void  CPU_IntDis (void)
+{
+    CPU_HostIntSigSetInit();
+    (void)pthread_sigmask(SIG_BLOCK, &CPU_HostIntSigSet, (sigset_t *)0);
+}
+
+
+void  CPU_IntEn (void)
+{
+    CPU_HostIntSigSetInit();
+    (void)pthread_sigmask(SIG_UNBLOCK, &CPU_HostIntSigSet, (sigset_t *)0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CPU_SR_Save()
+*                                           CPU_SR_Restore()
+*
+* Description : Save the interrupt state & disable interrupts / restore the saved interrupt state.
+*
+* Argument(s) : cpu_sr      Value returned by the matching CPU_SR_Save().
+*
+* Return(s)   : DEF_YES, if interrupts were already disabled on entry.
+*               DEF_NO,  otherwise.
+*********************************************************************************************************
+*/
+
+CPU_SR  CPU_SR_Save (void)
+{
+    sigset_t  prev;
+
+
+    CPU_HostIntSigSetInit();
+    (void)pthread_sigmask(SIG_BLOCK, &CPU_HostIntSigSet, &prev);
+
+    return ((sigismember(&prev, CPU_HOST_SIG_TICK) == 1) ? DEF_YES : DEF_NO);
+}
+
+
+void  CPU_SR_Restore (CPU_SR  cpu_sr)
+{
+    if (cpu_sr == DEF_NO) {
+        (void)pthread_sigmask(SIG_UNBLOCK, &CPU_HostIntSigSet, (sigset_t *)0);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          CPU_WaitForInt()
+*                                          CPU_WaitForExcept()
+*
+* Description : Sleep the kernel thread until an interrupt signal is delivered (host WFI/WFE).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) sigsuspend() atomically unblocks the interrupt signals, like WFI wakes on a pending
+*                   interrupt even while PRIMASK is set.
+*********************************************************************************************************
+*/
+
+void  CPU_WaitForInt (void)
+{
+    sigset_t  wait_set;
+
+
+    (void)pthread_sigmask(SIG_SETMASK, (sigset_t *)0, &wait_set);
+    (void)sigdelset(&wait_set, CPU_HOST_SIG_TICK);
+    (void)sigdelset(&wait_set, CPU_HOST_SIG_IRQ);
+    (void)sigsuspend(&wait_set);
+}
+
+
+void  CPU_WaitForExcept (void)
+{
+    CPU_WaitForInt();
+}
+
+
+/*
+*********************************************************************************************************
+*                                            CPU_RevBits()
+*
+* Description : Reverse the bits in a data value.
+*
+* Argument(s) : val         Data value to reverse bits.
+*
+* Return(s)   : Value with all bits in 'val' reversed.
+*********************************************************************************************************
+*/
+
+CPU_DATA  CPU_RevBits (CPU_DATA  val)
+{
+    CPU_DATA    rev;
+    CPU_INT08U  i;
+
+
+    rev = 0u;
+    for (i = 0u; i < (CPU_INT08U)(sizeof(CPU_DATA) * DEF_OCTET_NBR_BITS); i++) {
+        rev  = (rev << 1u) | (val & 1u);
+        val >>= 1u;
+    }
+
+    return (rev);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           CPU_IntSrcDis()
+*                                           CPU_IntSrcEn()
+*                                           CPU_IntSrcPendClr()
+*
+* Description : Disable, enable or clear the pending state of an interrupt source.
+*
+* Argument(s) : pos     Position of interrupt vector in interrupt table (see 'cpu.h  INTERRUPT SOURCES').
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Enabling a source that is already pending re-raises the interrupt signal.
+*********************************************************************************************************
+*/
+
+void  CPU_IntSrcDis (CPU_INT08U  pos)
+{
+    __atomic_and_fetch(&CPU_HostIntEnTbl[pos / 32u], ~DEF_BIT(pos % 32u), __ATOMIC_SEQ_CST);
+}
+
+
+void  CPU_IntSrcEn (CPU_INT08U  pos)
+{
+    CPU_INT32U  pend;
+
+
+    __atomic_or_fetch(&CPU_HostIntEnTbl[pos / 32u], DEF_BIT(pos % 32u), __ATOMIC_SEQ_CST);
+    pend = __atomic_load_n(&CPU_HostIntPendTbl[pos / 32u], __ATOMIC_SEQ_CST);
+    if ((pend & DEF_BIT(pos % 32u)) != 0u) {                    /* See Note #1.                                         */
+        CPU_HostIntSrcPendSet(pos);
+    }
+}
+
+
+void  CPU_IntSrcPendClr (CPU_INT08U  pos)
+{
+    __atomic_and_fetch(&CPU_HostIntPendTbl[pos / 32u], ~DEF_BIT(pos % 32u), __ATOMIC_SEQ_CST);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CPU_IntSrcPrioSet()
+*                                         CPU_IntSrcPrioGet()
+*
+* Description : Host interrupts share a single priority level.  Provided for API compatibility.
+*********************************************************************************************************
+*/
+
+void  CPU_IntSrcPrioSet (CPU_INT08U  pos,
+                         CPU_INT08U  prio,
+                         CPU_INT08U  type)
+{
+    (void)pos;
+    (void)prio;
+    (void)type;
+}
+
+
+CPU_INT16S  CPU_IntSrcPrioGet (CPU_INT08U  pos)
+{
+    (void)pos;
+
+    return (0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          CPU_HostIntInit()
+*
+* Description : Make the calling thread the kernel thread & install the interrupt signal handlers.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : OSInitHook().
+*
+* Note(s)     : (1) Each handler blocks both interrupt signals while it runs, so host ISRs never nest,
+*                   matching a single kernel-aware NVIC priority level.
+*********************************************************************************************************
+*/
+
+void  CPU_HostIntInit (void)
+{
+    struct sigaction  act;
+
+
+    CPU_HostIntSigSetInit();
+
+    act.sa_handler = CPU_HostIntSigHandler;
+    act.sa_mask    = CPU_HostIntSigSet;                         /* See Note #1.                                         */
+    act.sa_flags   = SA_RESTART;
+    (void)sigaction(CPU_HOST_SIG_TICK, &act, (struct sigaction *)0);
+    (void)sigaction(CPU_HOST_SIG_IRQ,  &act, (struct sigaction *)0);
+
+    CPU_HostKernelThread = pthread_self();
+    __atomic_store_n(&CPU_HostIntInitDone, DEF_YES, __ATOMIC_SEQ_CST);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        CPU_HostIntVectSet()
+*
+* Description : Install an interrupt service routine in the host vector table.
+*
+* Argument(s) : pos     Position of interrupt vector in interrupt table.
+*
+*               isr     Interrupt service routine.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+void  CPU_HostIntVectSet (CPU_INT08U     pos,
+                          CPU_FNCT_VOID  isr)
+{
+    CPU_HostIntVectTbl[pos] = isr;
+}
+
+
+/*
+*********************************************************************************************************
+*                                      CPU_HostIntSrcPendSet()
+*
+* Description : Set an interrupt source pending & signal the kernel thread (host NVIC ISPR).
+*
+* Argument(s) : pos     Position of interrupt vector in interrupt table.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Async-signal-safe; may be called by peripheral model threads or from a host ISR.
+*********************************************************************************************************
+*/
+
+void  CPU_HostIntSrcPendSet (CPU_INT08U  pos)
+{
+    CPU_INT32U  en;
+
+
+    __atomic_or_fetch(&CPU_HostIntPendTbl[pos / 32u], DEF_BIT(pos % 32u), __ATOMIC_SEQ_CST);
+
+    en = __atomic_load_n(&CPU_HostIntEnTbl[pos / 32u], __ATOMIC_SEQ_CST);
+    if (((en & DEF_BIT(pos % 32u)) != 0u) &&
+        (__atomic_load_n(&CPU_HostIntInitDone, __ATOMIC_SEQ_CST) == DEF_YES)) {
+        (void)pthread_kill(CPU_HostKernelThread,
+                           (pos == CPU_INT_SYSTICK) ? CPU_HOST_SIG_TICK : CPU_HOST_SIG_IRQ);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        CPU_HostIntCurGet()
+*
+* Description : Get the interrupt vector being serviced (host IPSR).
+*
+* Argument(s) : none.
+*
+* Return(s)   : Position of the vector in the interrupt table, 0 when no ISR is running.
+*
+* Note(s)     : (1) Host ISRs do not nest, so one position is enough. PendSV, which may switch to a task
+*                   that never returns to this handler, is not recorded.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  CPU_HostIntCurGet (void)
+{
+    return (CPU_HostIntCur);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      CPU_HostThreadSigBlock()
+*
+* Description : Block the interrupt signals in the calling (non-kernel) thread.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Peripheral model threads MUST call this first so that interrupts are only ever taken
+*                   by the kernel thread.
+*********************************************************************************************************
+*/
+
+void  CPU_HostThreadSigBlock (void)
+{
+    CPU_HostIntSigSetInit();
+    (void)pthread_sigmask(SIG_BLOCK, &CPU_HostIntSigSet, (sigset_t *)0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          CPU_TS_TmrInit()
+*                                          CPU_TS_TmrRd()
+*
+* Description : Host CPU timestamp timer : CLOCK_MONOTONIC truncated to the timestamp timer size.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Timestamp timer count (CPU_TS_TmrRd()).
+*********************************************************************************************************
+*/
+
+#if (CPU_CFG_TS_TMR_EN == DEF_ENABLED)
+void  CPU_TS_TmrInit (void)
+{
+    CPU_TS_TmrFreqSet((CPU_TS_TMR_FREQ)CPU_HOST_TS_TMR_FREQ_HZ);
+}
+
+
+CPU_TS_TMR  CPU_TS_TmrRd (void)
+{
+    struct timespec  now;
+
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((CPU_TS_TMR)(((CPU_INT64U)now.tv_sec * CPU_HOST_TS_TMR_FREQ_HZ) + (CPU_INT64U)now.tv_nsec));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         CPU_TSxx_to_uSec()
+*
+* Description : Convert a 32-/64-bit CPU timestamp from timer counts to microseconds.
+*
+* Argument(s) : ts_cnts   CPU timestamp (in timestamp timer counts).
+*
+* Return(s)   : Converted CPU timestamp (in microseconds), rounded to nearest.
+*********************************************************************************************************
+*/
+
+#if (CPU_CFG_TS_32_EN == DEF_ENABLED)
+CPU_INT32U  CPU_TS32_to_uSec (CPU_TS32  ts_cnts)
+{
+    return ((CPU_INT32U)((ts_cnts + 500u) / 1000u));
+}
+#endif
+
+
+#if (CPU_CFG_TS_64_EN == DEF_ENABLED)
+CPU_INT64U  CPU_TS64_to_uSec (CPU_TS64  ts_cnts)
+{
+    return ((ts_cnts + 500u) / 1000u);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       CPU_HostIntSigHandler()
+*
+* Description : Interrupt entry : dispatch every pending & enabled source to its vector, then run PendSV.
+*
+* Argument(s) : sig     Signal number (CPU_HOST_SIG_TICK or CPU_HOST_SIG_IRQ).
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The pending bit is cleared before the ISR runs, so a source re-raised while its ISR
+*                   executes is serviced again before the handler returns.
+*
+*               (2) PendSV has the lowest priority : it is not gated by the enable table & is taken only
+*                   once every other pending source has been serviced, so a context switch requested by
+*                   OSIntExit() never strands a pending interrupt.
+*********************************************************************************************************
+*/
+
+static  void  CPU_HostIntSigHandler (int  sig)
+{
+    CPU_INT32U     word;
+    CPU_INT32U     pend;
+    CPU_INT08U     pos;
+    CPU_BOOLEAN    serviced;
+    CPU_FNCT_VOID  isr;
+
+
+    if (sig == CPU_HOST_SIG_TICK) {
+        __atomic_or_fetch(&CPU_HostIntPendTbl[0], DEF_BIT(CPU_INT_SYSTICK), __ATOMIC_SEQ_CST);
+    }
+
+    do {
+        serviced = DEF_NO;
+        for (word = 0u; word < CPU_HOST_INT_PEND_WORDS; word++) {
+            pend = __atomic_load_n(&CPU_HostIntPendTbl[word], __ATOMIC_SEQ_CST) &
+                   __atomic_load_n(&CPU_HostIntEnTbl[word],   __ATOMIC_SEQ_CST);
+            if (word == 0u) {
+                pend &= ~DEF_BIT(CPU_INT_PENDSV);               /* See Note #2.                                         */
+            }
+            while (pend != 0u) {
+                pos   = (CPU_INT08U)((word * 32u) + (CPU_INT32U)__builtin_ctz(pend));
+                pend &= pend - 1u;
+                __atomic_and_fetch(&CPU_HostIntPendTbl[word], ~DEF_BIT(pos % 32u), __ATOMIC_SEQ_CST);
+                isr   = CPU_HostIntVectTbl[pos];
+                if (isr != (CPU_FNCT_VOID)0) {                  /* See Note #1.                                         */
+                    CPU_HostIntCur = pos;
+                    isr();
+                    CPU_HostIntCur = 0u;
+                }
+                serviced = DEF_YES;
+            }
+        }
+    } while (serviced == DEF_YES);
+
+    pend = __atomic_fetch_and(&CPU_HostIntPendTbl[0], ~DEF_BIT(CPU_INT_PENDSV), __ATOMIC_SEQ_CST);
+    isr  = CPU_HostIntVectTbl[CPU_INT_PENDSV];
+    if (((pend & DEF_BIT(CPU_INT_PENDSV)) != 0u) &&             /* See Note #2.                                         */
+        (isr != (CPU_FNCT_VOID)0)) {
+        isr();
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                       CPU_HostIntSigSetInit()
+*
+* Description : Build the set of signals treated as interrupts.
+*********************************************************************************************************
+*/
+
+static  void  CPU_HostIntSigSetInit (void)
+{
+    (void)sigemptyset(&CPU_HostIntSigSet);
+    (void)sigaddset(&CPU_HostIntSigSet, CPU_HOST_SIG_TICK);
+    (void)sigaddset(&CPU_HostIntSigSet, CPU_HOST_SIG_IRQ);
+}
+
+#ifdef __cplusplus
+}
+#endif
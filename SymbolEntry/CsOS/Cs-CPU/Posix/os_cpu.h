@@ -0,0 +1,146 @@
+/*
+*********************************************************************************************************
+*                                               Cs/OS3
+*                                        The Real-Time Kernel
+*
+*                           Copyright 2023; Weston Embedded Solutions, LLC.
+*                                       www.weston-embedded.com
+*
+*                   All rights reserved. Protected by international copyright laws.
+*
+*               Your use of this software is subject to your acceptance of the terms of
+*               a Weston Embedded Solutions software license, which can be obtained by
+*               contacting us at www.weston-embedded.com/company/contact. If you do not
+*                 agree to the terms of this license, you may not use this software.
+*
+*                 Please help us continue to provide the embedded community with the
+*                   finest software available. Your honesty is greatly appreciated.
+*
+*********************************************************************************************************
+*                                              uC/OS-III
+*                    Copyright 2009-2020 Silicon Laboratories Inc. www.silabs.com
+*                                 SPDX-License-Identifier: APACHE-2.0
+*               This software is subject to an open-source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                          POSIX (Linux host) Port
+*
+* File    : os_cpu.h
+* Version : V3.09.02
+*********************************************************************************************************
+* For     : x86-64 / AArch64 Linux, glibc
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CPU_H
+#define  OS_CPU_H
+
+#ifdef   OS_CPU_GLOBALS
+#define  OS_CPU_EXT
+#else
+#define  OS_CPU_EXT  extern
+#endif
+
+#include  <cpu.h>
+
+
+/*
+*********************************************************************************************************
+*                                     EXTERNAL C LANGUAGE LINKAGE
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+extern  "C" {
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*
+* Note(s) : (1) Size, in bytes, of the host stack each task runs on.  The CPU_STK array passed to
+*               OSTaskCreate() is too small for glibc & signal frames; see 'cpu.h  CPU STACK CONFIGURATION'.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CPU_HOST_STK_SIZE
+#define  OS_CPU_HOST_STK_SIZE          (256u * 1024u)           /* See Note #1.                                         */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                               MACROS
+*********************************************************************************************************
+*/
+
+#define  OS_TASK_SW()               OSCtxSw()
+
+
+/*
+*********************************************************************************************************
+*                                       TIMESTAMP CONFIGURATION
+*********************************************************************************************************
+*/
+
+#if      OS_CFG_TS_EN == 1u
+#define  OS_TS_GET()               (CPU_TS)CPU_TS_TmrRd()
+#else
+#define  OS_TS_GET()               (CPU_TS)0u
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+OS_CPU_EXT  CPU_STK  *OS_CPU_ExceptStkBase;                     /* Kept for parity with the Cortex-M port; unused.      */
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void  OSCtxSw               (void);
+void  OSIntCtxSw            (void);
+void  OSStartHighRdy        (void);
+
+void  OS_CPU_SysTickInit    (CPU_INT32U   cnts);
+void  OS_CPU_SysTickInitFreq(CPU_INT32U   cpu_freq);
+
+void  OS_CPU_SysTickHandler (void);
+void  OS_CPU_PendSVHandler  (void);
+                                                  /* CMSIS compliant names for Cortex-M                */
+void  PendSV_Handler        (void);
+void  SysTick_Handler       (void);
+
+
+/*
+*********************************************************************************************************
+*                                   EXTERNAL C LANGUAGE LINKAGE END
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
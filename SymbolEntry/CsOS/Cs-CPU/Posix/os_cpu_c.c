@@ -0,0 +1,803 @@
+/*
+*********************************************************************************************************
+*                                               Cs/OS3
+*                                        The Real-Time Kernel
+*
+*                           Copyright 2023; Weston Embedded Solutions, LLC.
+*                                       www.weston-embedded.com
+*
+*                   All rights reserved. Protected by international copyright laws.
+*
+*               Your use of this software is subject to your acceptance of the terms of
+*               a Weston Embedded Solutions software license, which can be obtained by
+*               contacting us at www.weston-embedded.com/company/contact. If you do not
+*                 agree to the terms of this license, you may not use this software.
+*
+*                 Please help us continue to provide the embedded community with the
+*                   finest software available. Your honesty is greatly appreciated.
+*
+*********************************************************************************************************
+*                                              uC/OS-III
+*                    Copyright 2009-2020 Silicon Laboratories Inc. www.silabs.com
+*                                 SPDX-License-Identifier: APACHE-2.0
+*               This software is subject to an open-source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                          POSIX (Linux host) Port
+*
+* File    : os_cpu_c.c
+* Version : V3.09.02
+*********************************************************************************************************
+* For     : x86-64 / AArch64 Linux, glibc
+*********************************************************************************************************
+* Note(s) : (1) Every task is a ucontext running on the kernel thread, so the scheduling decisions are
+*               exactly those of the target : only one task runs at a time and a task only loses the CPU
+*               through the kernel (OSCtxSw()) or through an 'interrupt' (a signal, see 'cpu.h').
+*
+*           (2) OSIntCtxSw() pends PendSV like the Cortex-M port does; the host interrupt dispatcher in
+*               'cpu_c.c' runs the PendSV vector after all other pending sources (tail-chaining).
+*
+*           (3) The C library is not re-entrant with respect to a task switch taken from a signal handler.
+*               Host heap calls made by this port are always done with interrupts disabled.
+*********************************************************************************************************
+*/
+
+#define   OS_CPU_GLOBALS
+#define  _GNU_SOURCE
+
+#ifdef VSC_INCLUDE_SOURCE_FILE_NAMES
+const  CPU_CHAR  *os_cpu_c__c = "$Id: $";
+#endif
+
+/*
+*********************************************************************************************************
+*                                             INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <signal.h>
+#include  <stdlib.h>
+#include  <time.h>
+#include  <ucontext.h>
+
+#include  "os.h"
+
+
+#ifdef __cplusplus
+extern  "C" {
+#endif
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  os_cpu_host_task {
+    ucontext_t    Ctx;                                          /* Saved task context.                                  */
+    OS_TASK_PTR   TaskPtr;                                      /* Task entry point.                                    */
+    void         *ArgPtr;                                       /* Task argument.                                       */
+    void         *StkPtr;                                       /* Host stack the task runs on.                         */
+} OS_CPU_HOST_TASK;
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_CPU_HOST_TASK  *OS_CPU_HostTaskCur;                  /* Context of the running task.                         */
+static  OS_CPU_HOST_TASK  *OS_CPU_HostTaskZombie;               /* Context of a deleted task still to be freed.         */
+static  CPU_INT32U         OS_CPU_HostSysTickFreq;              /* SysTick input clock, as given to ..InitFreq().       */
+static  timer_t            OS_CPU_HostSysTickTmr;
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void               OS_CPU_HostTaskEntry  (void);
+static  void               OS_CPU_HostTaskSw     (void);
+static  void               OS_CPU_HostZombieFree (void);
+static  OS_CPU_HOST_TASK  *OS_CPU_HostTaskGet    (OS_TCB  *p_tcb);
+
+
+/*
+*********************************************************************************************************
+*                                           IDLE TASK HOOK
+*
+* Description: This function is called by the idle task.  This hook has been added to allow you to do
+*              such things as STOP the CPU to conserve power.
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) The kernel thread sleeps until the next signal instead of spinning on the host CPU.
+*********************************************************************************************************
+*/
+
+void  OSIdleTaskHook (void)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppIdleTaskHookPtr != (OS_APP_HOOK_VOID)0) {
+        (*OS_AppIdleTaskHookPtr)();
+    }
+#endif
+
+    CPU_WaitForInt();                                           /* See Note #1.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                       OS INITIALIZATION HOOK
+*
+* Description: This function is called by OSInit() at the beginning of OSInit().
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) The calling thread becomes the kernel thread : it receives all host interrupts.
+*********************************************************************************************************
+*/
+
+void  OSInitHook (void)
+{
+    OS_CPU_ExceptStkBase = (CPU_STK *)(OSCfg_ISRStkBasePtr + OSCfg_ISRStkSize);
+
+    CPU_HostIntInit();                                          /* See Note #1.                                         */
+    CPU_HostIntVectSet(CPU_INT_PENDSV, OS_CPU_PendSVHandler);
+#if (CPU_CFG_TS_TMR_EN == DEF_ENABLED)
+    CPU_TS_TmrInit();
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                           REDZONE HIT HOOK
+*
+* Description: This function is called when a task's stack overflowed.
+*
+* Arguments  : p_tcb        Pointer to the task control block of the offending task. NULL if ISR.
+*
+* Note(s)    : None.
+*********************************************************************************************************
+*/
+#if (OS_CFG_TASK_STK_REDZONE_EN > 0u)
+void  OSRedzoneHitHook (OS_TCB  *p_tcb)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppRedzoneHitHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppRedzoneHitHookPtr)(p_tcb);
+    } else {
+        CPU_SW_EXCEPTION(;);
+    }
+#else
+    (void)p_tcb;                                                /* Prevent compiler warning                             */
+    CPU_SW_EXCEPTION(;);
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         STATISTIC TASK HOOK
+*
+* Description: This function is called every second by Cs/OS3's statistics task.  This allows your
+*              application to add functionality to the statistics task.
+*
+* Arguments  : None.
+*
+* Note(s)    : None.
+*********************************************************************************************************
+*/
+
+void  OSStatTaskHook (void)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppStatTaskHookPtr != (OS_APP_HOOK_VOID)0) {
+        (*OS_AppStatTaskHookPtr)();
+    }
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TASK CREATION HOOK
+*
+* Description: This function is called when a task is created.
+*
+* Arguments  : p_tcb        Pointer to the task control block of the task being created.
+*
+* Note(s)    : 1) Called with interrupts disabled.
+*********************************************************************************************************
+*/
+
+void  OSTaskCreateHook (OS_TCB  *p_tcb)
+{
+    OS_CPU_HostZombieFree();
+
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTaskCreateHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppTaskCreateHookPtr)(p_tcb);
+    }
+#else
+    (void)p_tcb;                                                /* Prevent compiler warning                             */
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TASK DELETION HOOK
+*
+* Description: This function is called when a task is deleted.
+*
+* Arguments  : p_tcb        Pointer to the task control block of the task being deleted.
+*
+* Note(s)    : 1) Called with interrupts disabled.
+*
+*              2) A task deleting itself is still running on its host stack, which is only released once
+*                 another task has been switched in.
+*********************************************************************************************************
+*/
+
+void  OSTaskDelHook (OS_TCB  *p_tcb)
+{
+    OS_CPU_HOST_TASK  *p_host;
+
+
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTaskDelHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppTaskDelHookPtr)(p_tcb);
+    }
+#endif
+
+    OS_CPU_HostZombieFree();
+    p_host = OS_CPU_HostTaskGet(p_tcb);
+    if (p_host == OS_CPU_HostTaskCur) {                         /* See Note #2.                                         */
+        OS_CPU_HostTaskZombie = p_host;
+    } else if (p_host != (OS_CPU_HOST_TASK *)0) {
+        free(p_host->StkPtr);
+        free(p_host);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            TASK RETURN HOOK
+*
+* Description: This function is called if a task accidentally returns.  In other words, a task should
+*              either be an infinite loop or delete itself when done.
+*
+* Arguments  : p_tcb        Pointer to the task control block of the task that is returning.
+*
+* Note(s)    : None.
+*********************************************************************************************************
+*/
+
+void  OSTaskReturnHook (OS_TCB  *p_tcb)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTaskReturnHookPtr != (OS_APP_HOOK_TCB)0) {
+        (*OS_AppTaskReturnHookPtr)(p_tcb);
+    }
+#else
+    (void)p_tcb;                                                /* Prevent compiler warning                             */
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                        INITIALIZE A TASK'S STACK
+*
+* Description: This function is called by either OSTaskCreate() or OSTaskCreateExt() to initialize the
+*              stack frame of the task being created.  This function is highly processor specific.
+*
+* Arguments  : p_task       Pointer to the task entry point address.
+*
+*              p_arg        Pointer to a user supplied data area that will be passed to the task
+*                               when the task first executes.
+*
+*              p_stk_base   Pointer to the base address of the stack.
+*
+*              stk_size     Size of the stack, in number of CPU_STK elements.
+*
+*              opt          Options used to alter the behavior of OS_Task_StkInit().
+*                            (see OS.H for OS_TASK_OPT_xxx).
+*
+* Returns    : Always returns the location of the new top-of-stack once the processor registers have
+*              been placed on the stack in the proper order.
+*
+* Note(s)    : (1) Interrupts are enabled when task starts executing.
+*
+*              (2) The task runs on a host stack of OS_CPU_HOST_STK_SIZE bytes.  The top entry of the task's
+*                  CPU_STK array holds a pointer to the host context, and is what the TCB's StkPtr points
+*                  to :
+*
+*                                   +--------------------+
+*                  StkPtr  ------>  |  OS_CPU_HOST_TASK* | ----> { ucontext, task, arg, host stack }
+*                                   +--------------------+
+*                                   |        ...         |
+*                                   +--------------------+
+*                  p_stk_base --->  |                    |
+*                                   +--------------------+
+*
+*                  Stack checking therefore reports the array as almost empty on the host.
+*
+*              (3) When the host heap is exhausted, a pointer below the stack base is returned so that
+*                  OSTaskCreate() fails with OS_ERR_STK_OVF.
+*********************************************************************************************************
+*/
+
+CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
+                         void          *p_arg,
+                         CPU_STK       *p_stk_base,
+                         CPU_STK       *p_stk_limit,
+                         CPU_STK_SIZE   stk_size,
+                         OS_OPT         opt)
+{
+    OS_CPU_HOST_TASK  *p_host;
+    CPU_STK           *p_stk;
+    void              *p_host_stk;
+    CPU_SR_ALLOC();
+
+
+    (void)opt;                                                  /* 'opt' is not used, prevent warning                   */
+    (void)p_stk_limit;
+
+    CPU_CRITICAL_ENTER();                                       /* See Note (3) of this file's header.                  */
+    p_host     = (OS_CPU_HOST_TASK *)malloc(sizeof(OS_CPU_HOST_TASK));
+    p_host_stk = malloc(OS_CPU_HOST_STK_SIZE);
+    if ((p_host     == (OS_CPU_HOST_TASK *)0) ||
+        (p_host_stk == (void *)0)) {
+        free(p_host_stk);
+        free(p_host);
+        CPU_CRITICAL_EXIT();
+        return (p_stk_base - 1u);                               /* See Note #3.                                         */
+    }
+    CPU_CRITICAL_EXIT();
+
+    p_host->TaskPtr = p_task;
+    p_host->ArgPtr  = p_arg;
+    p_host->StkPtr  = p_host_stk;
+
+    (void)getcontext(&p_host->Ctx);
+    p_host->Ctx.uc_stack.ss_sp   = p_host_stk;
+    p_host->Ctx.uc_stack.ss_size = OS_CPU_HOST_STK_SIZE;
+    p_host->Ctx.uc_link          = (ucontext_t *)0;
+    (void)sigdelset(&p_host->Ctx.uc_sigmask, CPU_HOST_SIG_TICK);/* See Note #1.                                         */
+    (void)sigdelset(&p_host->Ctx.uc_sigmask, CPU_HOST_SIG_IRQ);
+    makecontext(&p_host->Ctx, OS_CPU_HostTaskEntry, 0);
+
+    p_stk  = &p_stk_base[stk_size - 1u];                        /* See Note #2.                                         */
+   *p_stk  = (CPU_STK)p_host;
+
+    return (p_stk);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TASK SWITCH HOOK
+*
+* Description: This function is called when a task switch is performed.  This allows you to perform other
+*              operations during a context switch.
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*              2) It is assumed that the global pointer 'OSTCBHighRdyPtr' points to the TCB of the task
+*                 that will be 'switched in' (i.e. the highest priority task) and, 'OSTCBCurPtr' points
+*                 to the task being switched out (i.e. the preempted task).
+*              3) With OS_CFG_TASK_PROFILE_EN, the run time statistics of OSTaskProfileGet() are kept here,
+*                 in constant time whatever the number of tasks.
+*********************************************************************************************************
+*/
+
+void  OSTaskSwHook (void)
+{
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    CPU_TS  ts;
+#endif
+#ifdef  CPU_CFG_INT_DIS_MEAS_EN
+    CPU_TS  int_dis_time;
+#endif
+
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTaskSwHookPtr != (OS_APP_HOOK_VOID)0) {
+        (*OS_AppTaskSwHookPtr)();
+    }
+#endif
+
+    OS_TRACE_TASK_SWITCHED_IN(OSTCBHighRdyPtr);
+
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    ts = OS_TS_GET();
+    if (OSTCBCurPtr != OSTCBHighRdyPtr) {
+        OSTCBCurPtr->CyclesDelta  = ts - OSTCBCurPtr->CyclesStart;
+        OSTCBCurPtr->CyclesTotal += (OS_CYCLES)OSTCBCurPtr->CyclesDelta;
+        OSTCBCurPtr->CyclesRun   += (CPU_INT64U)OSTCBCurPtr->CyclesDelta;
+        if (OSTCBCurPtr->CyclesBurstMax < OSTCBCurPtr->CyclesDelta) {
+            OSTCBCurPtr->CyclesBurstMax = OSTCBCurPtr->CyclesDelta;
+        }
+        OSTCBCurPtr->CtxSwOutCtr++;
+        if (OSTCBCurPtr->TaskState == OS_TASK_STATE_RDY) {      /* Preempted, it waits for the CPU from now on          */
+            OSTCBCurPtr->RdyTs = ts;
+        }
+        if (OSTCBHighRdyPtr->RdyToRunMax < (ts - OSTCBHighRdyPtr->RdyTs)) {
+            OSTCBHighRdyPtr->RdyToRunMax = ts - OSTCBHighRdyPtr->RdyTs;
+        }
+    }
+
+    OSTCBHighRdyPtr->CyclesStart = ts;
+#endif
+
+#ifdef  CPU_CFG_INT_DIS_MEAS_EN
+    int_dis_time = CPU_IntDisMeasMaxCurReset();                 /* Keep track of per-task interrupt disable time        */
+    if (OSTCBCurPtr->IntDisTimeMax < int_dis_time) {
+        OSTCBCurPtr->IntDisTimeMax = int_dis_time;
+    }
+#endif
+
+#if OS_CFG_SCHED_LOCK_TIME_MEAS_EN > 0u
+                                                                /* Keep track of per-task scheduler lock time           */
+    if (OSTCBCurPtr->SchedLockTimeMax < OSSchedLockTimeMaxCur) {
+        OSTCBCurPtr->SchedLockTimeMax = OSSchedLockTimeMaxCur;
+    }
+    OSSchedLockTimeMaxCur = (CPU_TS)0;                          /* Reset the per-task value                             */
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                              TICK HOOK
+*
+* Description: This function is called every tick.
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) This function is assumed to be called from the Tick ISR.
+*********************************************************************************************************
+*/
+
+void  OSTimeTickHook (void)
+{
+#if OS_CFG_APP_HOOKS_EN > 0u
+    if (OS_AppTimeTickHookPtr != (OS_APP_HOOK_VOID)0) {
+        (*OS_AppTimeTickHookPtr)();
+    }
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                   START HIGHEST PRIORITY TASK READY-TO-RUN
+*
+* Description: This function is called by OSStart() to start the highest priority task that was created by
+*              your application before calling OSStart().
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) The kernel thread's own context is abandoned; this function does not return.
+*********************************************************************************************************
+*/
+
+void  OSStartHighRdy (void)
+{
+    OS_CPU_HOST_TASK  *p_host;
+
+
+    CPU_IntDis();
+    OSTaskSwHook();
+    OSPrioCur          = OSPrioHighRdy;
+    OSTCBCurPtr        = OSTCBHighRdyPtr;
+    p_host             = OS_CPU_HostTaskGet(OSTCBHighRdyPtr);
+    OS_CPU_HostTaskCur = p_host;
+
+    (void)setcontext(&p_host->Ctx);                             /* See Note #1.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TASK LEVEL CONTEXT SWITCH
+*
+* Description: This function is called by OS_TASK_SW() when a higher priority task is made ready to run.
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) Called with interrupts disabled; the switched-out task resumes here with its own mask.
+*********************************************************************************************************
+*/
+
+void  OSCtxSw (void)
+{
+    OS_CPU_HostTaskSw();
+}
+
+
+/*
+*********************************************************************************************************
+*                                      INTERRUPT LEVEL CONTEXT SWITCH
+*
+* Description: This function is called by OSIntExit() when an ISR readies a higher priority task.
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) The switch itself is done in OS_CPU_PendSVHandler(), once the interrupted sources have
+*                 all been serviced (see Note (2) of this file's header).
+*********************************************************************************************************
+*/
+
+void  OSIntCtxSw (void)
+{
+    CPU_HostIntSrcPendSet(CPU_INT_PENDSV);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          PENDSV HANDLER
+*
+* Description: Perform the context switch requested by OSIntCtxSw().
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) Called by the host interrupt dispatcher, with the interrupt signals blocked.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_PendSVHandler (void)
+{
+    OS_CPU_HostTaskSw();
+}
+
+
+void  PendSV_Handler (void)
+{
+    OS_CPU_PendSVHandler();
+}
+
+
+/*
+*********************************************************************************************************
+*                                          SYS TICK HANDLER
+*
+* Description: Handle the system tick (SysTick) interrupt, which is used to generate the Cs/OS3 tick
+*              interrupt.
+*
+* Arguments  : None.
+*
+* Note(s)    : 1) This function is installed on entry 15 of the host vector table by OS_CPU_SysTickInit().
+*********************************************************************************************************
+*/
+
+void  OS_CPU_SysTickHandler  (void)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    OSIntEnter();                                               /* Tell Cs/OS3 that we are starting an ISR              */
+    CPU_CRITICAL_EXIT();
+
+    OSTimeTick();                                               /* Call Cs/OS3's OSTimeTick()                           */
+
+    OSIntExit();                                                /* Tell Cs/OS3 that we are leaving the ISR              */
+}
+
+
+void  SysTick_Handler (void)
+{
+    OS_CPU_SysTickHandler();
+}
+
+
+/*
+*********************************************************************************************************
+*                                         INITIALIZE SYS TICK
+*
+* Description: Initialize the SysTick using the CPU clock frequency.
+*
+* Arguments  : cpu_freq         CPU clock frequency.
+*
+* Note(s)    : 1) This function MUST be called after OSStart() & after processor initialization.
+*
+*              2) Either OS_CPU_SysTickInitFreq or OS_CPU_SysTickInit() can be called.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_SysTickInitFreq (CPU_INT32U  cpu_freq)
+{
+#if (OS_CFG_TICK_EN > 0u)
+    CPU_INT32U  cnts;
+
+
+    OS_CPU_HostSysTickFreq = cpu_freq;
+    cnts = (cpu_freq / (CPU_INT32U)OSCfg_TickRate_Hz);          /* Determine nbr SysTick cnts between two OS tick intr. */
+
+    OS_CPU_SysTickInit(cnts);
+#else
+    (void)cpu_freq;
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                         INITIALIZE SYS TICK
+*
+* Description: Initialize the SysTick using the number of countes between two ticks.
+*
+* Arguments  : cnts         Number of SysTick counts between two OS tick interrupts.
+*
+* Note(s)    : 1) This function MUST be called after OSStart() & after processor initialization.
+*
+*              2) Either OS_CPU_SysTickInitFreq or OS_CPU_SysTickInit() can be called.
+*
+*              3) SysTick is modelled by a CLOCK_MONOTONIC interval timer raising CPU_HOST_SIG_TICK.  When
+*                 the input clock is unknown, 'cnts' is taken to be one OS tick.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_SysTickInit (CPU_INT32U  cnts)
+{
+#if (OS_CFG_TICK_EN > 0u)
+    struct  sigevent    sev;
+    struct  itimerspec  its;
+    CPU_INT64U          period_ns;
+
+
+    if (OS_CPU_HostSysTickFreq != 0u) {                         /* See Note #3.                                         */
+        period_ns = ((CPU_INT64U)cnts * 1000000000uLL) / OS_CPU_HostSysTickFreq;
+    } else {
+        period_ns = 1000000000uLL / OSCfg_TickRate_Hz;
+    }
+
+    CPU_HostIntVectSet(CPU_INT_SYSTICK, SysTick_Handler);
+    CPU_IntSrcEn(CPU_INT_SYSTICK);
+
+    sev.sigev_notify          = SIGEV_SIGNAL;
+    sev.sigev_signo           = CPU_HOST_SIG_TICK;
+    sev.sigev_value.sival_ptr = (void *)0;
+    if (timer_create(CLOCK_MONOTONIC, &sev, &OS_CPU_HostSysTickTmr) != 0) {
+        CPU_SW_EXCEPTION(;);
+    }
+
+    its.it_interval.tv_sec  = (time_t)(period_ns / 1000000000uLL);
+    its.it_interval.tv_nsec = (long)  (period_ns % 1000000000uLL);
+    its.it_value            = its.it_interval;
+    (void)timer_settime(OS_CPU_HostSysTickTmr, 0, &its, (struct itimerspec *)0);
+#else
+    (void)cnts;
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        OS_CPU_HostTaskEntry()
+*
+* Description: First code executed by every task : run the task body, then behave like the return
+*              address set up by the Cortex-M port (OS_TaskReturn()).
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_HostTaskEntry (void)
+{
+    OS_CPU_HOST_TASK  *p_host;
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    OS_CPU_HostZombieFree();
+    p_host = OS_CPU_HostTaskCur;
+    CPU_CRITICAL_EXIT();
+
+    p_host->TaskPtr(p_host->ArgPtr);
+
+    OS_TaskReturn();
+}
+
+
+/*
+*********************************************************************************************************
+*                                          OS_CPU_HostTaskSw()
+*
+* Description: Switch from the running context to the context of 'OSTCBHighRdyPtr'.
+*
+* Note(s)    : 1) Called with interrupts disabled.  The context being switched out is tracked by the port
+*                 rather than read back from 'OSTCBCurPtr', whose StkPtr has been cleared when a task has
+*                 just deleted itself.
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_HostTaskSw (void)
+{
+    OS_CPU_HOST_TASK  *p_from;
+    OS_CPU_HOST_TASK  *p_to;
+
+
+    OSTaskSwHook();
+    OSPrioCur   = OSPrioHighRdy;
+    OSTCBCurPtr = OSTCBHighRdyPtr;
+
+    p_from = OS_CPU_HostTaskCur;                                /* See Note #1.                                         */
+    p_to   = OS_CPU_HostTaskGet(OSTCBHighRdyPtr);
+    if (p_from == p_to) {
+        return;
+    }
+
+    OS_CPU_HostTaskCur = p_to;
+    (void)swapcontext(&p_from->Ctx, &p_to->Ctx);
+
+    OS_CPU_HostZombieFree();                                    /* Resumed : a different task was switched out.        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                        OS_CPU_HostZombieFree()
+*
+* Description: Release the host context of a task that deleted itself, once it is no longer running.
+*
+* Note(s)    : 1) Called with interrupts disabled.
+*********************************************************************************************************
+*/
+
+static  void  OS_CPU_HostZombieFree (void)
+{
+    OS_CPU_HOST_TASK  *p_host;
+
+
+    p_host = OS_CPU_HostTaskZombie;
+    if ((p_host != (OS_CPU_HOST_TASK *)0) &&
+        (p_host != OS_CPU_HostTaskCur)) {
+        OS_CPU_HostTaskZombie = (OS_CPU_HOST_TASK *)0;
+        free(p_host->StkPtr);
+        free(p_host);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         OS_CPU_HostTaskGet()
+*
+* Description: Return the host context of a task, or a NULL pointer if it has none.
+*********************************************************************************************************
+*/
+
+static  OS_CPU_HOST_TASK  *OS_CPU_HostTaskGet (OS_TCB  *p_tcb)
+{
+    if (p_tcb->StkPtr == (CPU_STK *)0) {
+        return ((OS_CPU_HOST_TASK *)0);
+    }
+
+    return ((OS_CPU_HOST_TASK *)*p_tcb->StkPtr);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -516,6 +516,8 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
 *              2) It is assumed that the global pointer 'OSTCBHighRdyPtr' points to the TCB of the task
 *                 that will be 'switched in' (i.e. the highest priority task) and, 'OSTCBCurPtr' points
 *                 to the task being switched out (i.e. the preempted task).
+*              3) With OS_CFG_TASK_PROFILE_EN, the run time statistics of OSTaskProfileGet() are kept here,
+*                 in constant time whatever the number of tasks.
 *********************************************************************************************************
 */
 
@@ -544,6 +546,17 @@ void  OSTaskSwHook (void)
     if (OSTCBCurPtr != OSTCBHighRdyPtr) {
         OSTCBCurPtr->CyclesDelta  = ts - OSTCBCurPtr->CyclesStart;
         OSTCBCurPtr->CyclesTotal += (OS_CYCLES)OSTCBCurPtr->CyclesDelta;
+        OSTCBCurPtr->CyclesRun   += (CPU_INT64U)OSTCBCurPtr->CyclesDelta;
+        if (OSTCBCurPtr->CyclesBurstMax < OSTCBCurPtr->CyclesDelta) {
+            OSTCBCurPtr->CyclesBurstMax = OSTCBCurPtr->CyclesDelta;
+        }
+        OSTCBCurPtr->CtxSwOutCtr++;
+        if (OSTCBCurPtr->TaskState == OS_TASK_STATE_RDY) {      /* Preempted, it waits for the CPU from now on          */
+            OSTCBCurPtr->RdyTs = ts;
+        }
+        if (OSTCBHighRdyPtr->RdyToRunMax < (ts - OSTCBHighRdyPtr->RdyTs)) {
+            OSTCBHighRdyPtr->RdyToRunMax = ts - OSTCBHighRdyPtr->RdyTs;
+        }
     }
 
     OSTCBHighRdyPtr->CyclesStart = ts;
@@ -104,6 +104,68 @@ extern "C" {
 #endif
 
 
+/*
+************************************************************************************************************************
+*                                          KERNEL OBJECT CRITICAL SECTIONS
+*
+* Note(s) : (1) With OS_CFG_ISR_POST_DEFERRED_EN, ISRs no longer touch the ready, pend and tick lists: their posts
+*               are queued and replayed by the ISR handler task (see os_int.c).  Services then guard kernel objects
+*               by locking the scheduler and leave interrupts enabled; otherwise these are the CPU critical section.
+*
+*           (2) OS_CRITICAL_EXIT() runs the scheduler if an ISR readied the ISR handler task while the scheduler
+*               was locked.  OS_CRITICAL_EXIT_NO_SCHED() leaves that to the OSSched() the caller makes next.
+*
+*           (3) OS_CRITICAL_LOCK_NESTING is the part of OSSchedLockNestingCtr held by the service itself, for the
+*               'Can't pend when the scheduler is locked' checks made inside the critical section.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+#define  OS_CRITICAL_ENTER()                                            \
+         do {                                                           \
+             CPU_CRITICAL_ENTER();                                      \
+             OSSchedLockNestingCtr++;                                   \
+             if (OSSchedLockNestingCtr == 1u) {                         \
+                 OS_SCHED_LOCK_TIME_MEAS_START();                       \
+             }                                                          \
+             CPU_CRITICAL_EXIT();                                       \
+         } while (0)
+
+#define  OS_CRITICAL_EXIT()                                             \
+         do {                                                           \
+             CPU_CRITICAL_ENTER();                                      \
+             OSSchedLockNestingCtr--;                                   \
+             if (OSSchedLockNestingCtr == 0u) {                         \
+                 OS_SCHED_LOCK_TIME_MEAS_STOP();                        \
+                 if (OSRdyList[0].HeadPtr != (OS_TCB *)0) {             \
+                     CPU_CRITICAL_EXIT();                               \
+                     OSSched();                                         \
+                     break;                                             \
+                 }                                                      \
+             }                                                          \
+             CPU_CRITICAL_EXIT();                                       \
+         } while (0)
+
+#define  OS_CRITICAL_EXIT_NO_SCHED()                                    \
+         do {                                                           \
+             CPU_CRITICAL_ENTER();                                      \
+             OSSchedLockNestingCtr--;                                   \
+             if (OSSchedLockNestingCtr == 0u) {                         \
+                 OS_SCHED_LOCK_TIME_MEAS_STOP();                        \
+             }                                                          \
+             CPU_CRITICAL_EXIT();                                       \
+         } while (0)
+
+#define  OS_CRITICAL_LOCK_NESTING           1u
+#else
+#define  OS_CRITICAL_ENTER()                CPU_CRITICAL_ENTER()
+#define  OS_CRITICAL_EXIT()                 CPU_CRITICAL_EXIT()
+#define  OS_CRITICAL_EXIT_NO_SCHED()        CPU_CRITICAL_EXIT()
+
+#define  OS_CRITICAL_LOCK_NESTING           0u
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                                     MISCELLANEOUS
@@ -216,6 +278,9 @@ extern "C" {
 #define  OS_OBJ_TYPE_MUTEX                   (OS_OBJ_TYPE)CPU_TYPE_CREATE('M', 'U', 'T', 'X')
 #define  OS_OBJ_TYPE_Q                       (OS_OBJ_TYPE)CPU_TYPE_CREATE('Q', 'U', 'E', 'U')
 #define  OS_OBJ_TYPE_SEM                     (OS_OBJ_TYPE)CPU_TYPE_CREATE('S', 'E', 'M', 'A')
+#define  OS_OBJ_TYPE_TASK_MSG                (OS_OBJ_TYPE)CPU_TYPE_CREATE('T', 'M', 'S', 'G')
+#define  OS_OBJ_TYPE_TASK_SIGNAL             (OS_OBJ_TYPE)CPU_TYPE_CREATE('T', 'S', 'G', 'N')
+#define  OS_OBJ_TYPE_TICK                    (OS_OBJ_TYPE)CPU_TYPE_CREATE('T', 'I', 'C', 'K')
 #define  OS_OBJ_TYPE_TMR                     (OS_OBJ_TYPE)CPU_TYPE_CREATE('T', 'M', 'R', ' ')
 
 /*
@@ -432,6 +497,8 @@ typedef  enum  os_err {
     OS_ERR_I                         = 18000u,
     OS_ERR_ILLEGAL_CREATE_RUN_TIME   = 18001u,
 
+    OS_ERR_INT_Q_FULL                = 18003u,
+
     OS_ERR_ILLEGAL_DEL_RUN_TIME      = 18007u,
 
     OS_ERR_J                         = 19000u,
@@ -629,6 +696,8 @@ typedef  struct  os_flag_grp         OS_FLAG_GRP;
 
 typedef  struct  os_data             OS_DATA;
 
+typedef  struct  os_int_q            OS_INT_Q;
+
 typedef  struct  os_mem              OS_MEM;
 
 typedef  struct  os_msg              OS_MSG;
@@ -645,6 +714,8 @@ typedef  void                      (*OS_TASK_PTR)(void *p_arg);
 
 typedef  struct  os_tcb              OS_TCB;
 
+typedef  struct  os_task_profile     OS_TASK_PROFILE;
+
 #if defined(OS_CFG_TLS_TBL_SIZE) && (OS_CFG_TLS_TBL_SIZE > 0u)
 typedef  void                       *OS_TLS;
 
@@ -703,6 +774,10 @@ struct  os_rdy_list {
 struct  os_pend_list {
     OS_TCB              *HeadPtr;
     OS_TCB              *TailPtr;
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    CPU_DATA             PrioTbl[OS_PRIO_TBL_SIZE];         /* Priorities with at least one waiter, as OSPrioTbl[]    */
+    OS_TCB              *PrioTailPtr[OS_CFG_PRIO_MAX];      /* Last waiter of each priority                           */
+#endif
 #if (OS_CFG_DBG_EN > 0u)
     OS_OBJ_QTY           NbrEntries;
 #endif
@@ -816,6 +891,26 @@ struct  os_flag_grp {                                       /* Event Flag Group
 };
 
 
+/*
+************************************************************************************************************************
+*                                                ISR POST QUEUE RECORD
+*
+* Note(s) : (1) One post an ISR made with OS_CFG_ISR_POST_DEFERRED_EN, waiting for the ISR handler task.  'Seq' tells
+*               whose turn the slot is, see OS_IntQPost().
+************************************************************************************************************************
+*/
+
+struct  os_int_q {
+    CPU_INT32U           Seq;                               /* Ring position the slot is ready for                    */
+    OS_OBJ_TYPE          Type;                              /* OS_OBJ_TYPE_xxx of the post                            */
+    void                *ObjPtr;                            /* Object, OS_TCB for task posts, OS_RDY_LIST for a tick  */
+    void                *MsgPtr;                            /* Message for queue posts                                */
+    OS_MSG_SIZE          MsgSize;
+    OS_FLAGS             Flags;                             /* Flags for event flag posts                             */
+    OS_OPT               Opt;                               /* Options the ISR posted with                            */
+};
+
+
 /*
 ************************************************************************************************************************
 *                                                   MEMORY PARTITIONS
@@ -1031,6 +1126,9 @@ struct os_tcb {
     OS_TCB              *PendNextPtr;                       /* Pointer to next     TCB in pend list.                  */
     OS_TCB              *PendPrevPtr;                       /* Pointer to previous TCB in pend list.                  */
     OS_PEND_OBJ         *PendObjPtr;                        /* Pointer to object pended on.                           */
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    OS_PRIO              PendPrio;                          /* Priority the TCB was inserted at in the pend list      */
+#endif
     OS_STATE             PendOn;                            /* Indicates what task is pending on                      */
     OS_STATUS            PendStatus;                        /* Pend status                                            */
 
@@ -1053,7 +1151,10 @@ struct os_tcb {
 
                                                             /* DELAY / TIMEOUT                                        */
 #if (OS_CFG_TICK_EN > 0u)
-    OS_TICK              TickRemain;                        /* Number of ticks remaining                              */
+    OS_TICK              TickRemain;                        /* Number of ticks remaining (at insertion, tick wheel)   */
+#if (OS_CFG_TICK_WHEEL_EN > 0u)
+    OS_TICK              TickCtrMatch;                      /* Value of OSTickCtr at which the delay expires          */
+#endif
     OS_TICK              TickCtrPrev;                       /* Used by OSTimeDlyXX() in PERIODIC mode                 */
     CPU_BOOLEAN          TickCtrSet;                        /* Used by OSTimeDlyXX() in PERIODIC mode                 */
 #endif
@@ -1098,6 +1199,11 @@ struct os_tcb {
     CPU_TS               CyclesStart;                       /* Snapshot of cycle counter at start of task resumption  */
     OS_CYCLES            CyclesTotal;                       /* Total number of # of cycles the task has been running  */
     OS_CYCLES            CyclesTotalPrev;                   /* Snapshot of previous # of cycles                       */
+    CPU_INT64U           CyclesRun;                         /* Total # of cycles run, not cleared by the stat task    */
+    CPU_TS               CyclesBurstMax;                    /* Longest run from being switched in to switched out     */
+    OS_CTX_SW_CTR        CtxSwOutCtr;                       /* Number of time the task was switched out               */
+    CPU_TS               RdyTs;                             /* Snapshot of cycle counter when task was made ready     */
+    CPU_TS               RdyToRunMax;                       /* Longest time from being made ready to running          */
 
     CPU_TS               SemPendTime;                       /* Time it took for signal to be received                 */
     CPU_TS               SemPendTimeMax;                    /* Max amount of time it took for signal to be received   */
@@ -1106,6 +1212,7 @@ struct os_tcb {
 #if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u)
     CPU_STK_SIZE         StkUsed;                           /* Number of stack elements used from the stack           */
     CPU_STK_SIZE         StkFree;                           /* Number of stack elements free on   the stack           */
+    CPU_STK_SIZE         StkScanIx;                         /* Stack elements left to check in the stat task's pass   */
 #endif
 
 #ifdef CPU_CFG_INT_DIS_MEAS_EN
@@ -1126,6 +1233,24 @@ struct os_tcb {
 };
 
 
+/*
+************************************************************************************************************************
+*                                                 TASK PROFILE SNAPSHOT
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_TASK_PROFILE_EN > 0u)
+struct  os_task_profile {                                   /* Filled in by OSTaskProfileGet(), in CPU_TS counts      */
+    OS_PRIO              Prio;                              /* Task priority                                          */
+    CPU_INT64U           CyclesRun;                         /* Total # of cycles the task has been running            */
+    OS_CTX_SW_CTR        CtxSwInCtr;                        /* Number of time the task was switched in                */
+    OS_CTX_SW_CTR        CtxSwOutCtr;                       /* Number of time the task was switched out               */
+    CPU_TS               CyclesBurstMax;                    /* Longest run from being switched in to switched out     */
+    CPU_TS               RdyToRunMax;                       /* Longest time from being made ready to running          */
+};
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                                    TICK DATA TYPE
@@ -1133,7 +1258,11 @@ struct os_tcb {
 */
 
 struct  os_tick_list {
+#if (OS_CFG_TICK_WHEEL_EN > 0u)
+    OS_TCB              *Spoke[OS_CFG_TICK_WHEEL_SIZE];     /* Unsorted lists, by TickCtrMatch % wheel size          */
+#else
     OS_TCB              *TCB_Ptr;                           /* Pointer to list of tasks in tick list                 */
+#endif
 #if (OS_CFG_DBG_EN > 0u)
     OS_OBJ_QTY           NbrEntries;                        /* Current number of entries in the tick list            */
     OS_OBJ_QTY           NbrUpdated;                        /* Number of entries updated                             */
@@ -1198,6 +1327,15 @@ OS_EXT            OS_IDLE_CTR               OSIdleTaskCtr;
 #endif
 OS_EXT            OS_TCB                    OSIdleTaskTCB;
 
+                                                                        /* ISR HANDLER TASK ------------------------- */
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+OS_EXT            OS_TCB                    OSIntQTaskTCB;
+OS_EXT            CPU_INT32U                OSIntQInIx;                 /* Next ring position an ISR claims           */
+OS_EXT            CPU_INT32U                OSIntQOutIx;                /* Next ring position the task replays        */
+OS_EXT            OS_OBJ_QTY                OSIntQNbrEntriesMax;        /* Most posts found waiting at once           */
+OS_EXT            OS_OBJ_QTY                OSIntQOvfCtr;               /* Posts lost to a full queue                 */
+#endif
+
                                                                         /* MISCELLANEOUS ---------------------------- */
 OS_EXT            OS_NESTING_CTR            OSIntNestingCtr;            /* Interrupt nesting level                    */
 #ifdef CPU_CFG_INT_DIS_MEAS_EN
@@ -1212,6 +1350,7 @@ OS_EXT            OS_STATE                  OSInitialized;              /* Flag
 #if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u) && (OS_CFG_ISR_STK_SIZE > 0u)
 OS_EXT            CPU_INT32U                OSISRStkFree;               /* Number of free ISR stack entries           */
 OS_EXT            CPU_INT32U                OSISRStkUsed;               /* Number of used ISR stack entries           */
+OS_EXT            CPU_STK_SIZE              OSISRStkScanIx;             /* ISR stack entries left to check            */
 #endif
 
                                                                         /* DATA QUEUES ------------------------------ */
@@ -1379,6 +1518,14 @@ extern  CPU_STK_SIZE  const OSCfg_IdleTaskStkLimit;
 extern  CPU_STK_SIZE  const OSCfg_IdleTaskStkSize;
 extern  CPU_INT32U    const OSCfg_IdleTaskStkSizeRAM;
 
+extern  OS_INT_Q    * const OSCfg_IntQBasePtr;
+extern  OS_OBJ_QTY    const OSCfg_IntQSize;
+extern  CPU_INT32U    const OSCfg_IntQSizeRAM;
+extern  CPU_STK     * const OSCfg_IntQTaskStkBasePtr;
+extern  CPU_STK_SIZE  const OSCfg_IntQTaskStkLimit;
+extern  CPU_STK_SIZE  const OSCfg_IntQTaskStkSize;
+extern  CPU_INT32U    const OSCfg_IntQTaskStkSizeRAM;
+
 extern  CPU_STK     * const OSCfg_ISRStkBasePtr;
 extern  CPU_STK_SIZE  const OSCfg_ISRStkSize;
 extern  CPU_INT32U    const OSCfg_ISRStkSizeRAM;
@@ -1409,6 +1556,11 @@ extern  CPU_INT32U    const OSCfg_DataSizeRAM;
 
 extern  CPU_STK             OSCfg_IdleTaskStk[OS_CFG_IDLE_TASK_STK_SIZE];
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+extern  OS_INT_Q            OSCfg_IntQ[OS_CFG_INT_Q_SIZE];
+extern  CPU_STK             OSCfg_IntQTaskStk[OS_CFG_INT_Q_TASK_STK_SIZE];
+#endif
+
 #if (OS_CFG_ISR_STK_SIZE > 0u)
 extern  CPU_STK             OSCfg_ISRStk[OS_CFG_ISR_STK_SIZE];
 #endif
@@ -1802,6 +1954,12 @@ void          OSTaskDel                 (OS_TCB                *p_tcb,
                                          OS_ERR                *p_err);
 #endif
 
+#if (OS_CFG_TASK_PROFILE_EN > 0u)
+void          OSTaskProfileGet          (OS_TCB                *p_tcb,
+                                         OS_TASK_PROFILE       *p_prof,
+                                         OS_ERR                *p_err);
+#endif
+
 #if (OS_CFG_TASK_Q_EN > 0u)
 OS_MSG_QTY    OSTaskQFlush              (OS_TCB                *p_tcb,
                                          OS_ERR                *p_err);
@@ -2093,12 +2251,37 @@ void          OS_IdleTask               (void                  *p_arg);
 
 void          OS_IdleTaskInit           (OS_ERR                *p_err);
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+void          OS_IntQPost               (OS_OBJ_TYPE            type,
+                                         void                  *p_obj,
+                                         void                  *p_msg,
+                                         OS_MSG_SIZE            msg_size,
+                                         OS_FLAGS               flags,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+
+void          OS_IntQTask               (void                  *p_arg);
+
+void          OS_IntQTaskInit           (OS_ERR                *p_err);
+#endif
+
 #if (OS_CFG_STAT_TASK_EN > 0u)
 void          OS_StatTask               (void                  *p_arg);
 #endif
 
 void          OS_StatTaskInit           (OS_ERR                *p_err);
 
+#if (OS_CFG_STAT_TASK_EN > 0u) && (OS_CFG_STAT_TASK_STK_CHK_EN > 0u)
+CPU_STK_SIZE  OS_StatStkScan            (CPU_STK               *p_base,
+                                         CPU_STK_SIZE           stk_size,
+                                         CPU_STK_SIZE           free_stk,
+                                         CPU_STK_SIZE          *p_ix,
+                                         CPU_STK_SIZE           words);
+
+void          OS_StatTaskStkScan        (OS_TCB                *p_tcb,
+                                         CPU_STK_SIZE           words);
+#endif
+
 void          OS_TickInit               (OS_ERR                *p_err);
 void          OS_TickUpdate             (OS_TICK                ticks);
 
@@ -2328,11 +2511,27 @@ OS_TICK       OS_DynTickSet             (OS_TICK                ticks);
 #endif
 
 
+#ifndef OS_CFG_PEND_LIST_BITMAP_EN
+#error  "OS_CFG.H, Missing OS_CFG_PEND_LIST_BITMAP_EN: Pend lists with a priority bitmap (1) or a sorted walk (0)"
+#endif
+
+
 #if     OS_CFG_PRIO_MAX < 8u
 #error  "OS_CFG.H, OS_CFG_PRIO_MAX must be >= 8"
 #endif
 
 
+#ifndef OS_CFG_ISR_POST_DEFERRED_EN
+#error  "OS_CFG.H, Missing OS_CFG_ISR_POST_DEFERRED_EN: Defer (1) or make (0) posts from ISRs"
+#else
+    #if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+        #if ((OS_CFG_INT_Q_SIZE < 2u) || ((OS_CFG_INT_Q_SIZE & (OS_CFG_INT_Q_SIZE - 1u)) != 0u))
+        #error "OS_CFG_APP.h, OS_CFG_INT_Q_SIZE must be a power of 2, >= 2"
+        #endif
+    #endif
+#endif
+
+
 #ifndef OS_CFG_SCHED_LOCK_TIME_MEAS_EN
 #error  "OS_CFG.H, Missing OS_CFG_SCHED_LOCK_TIME_MEAS_EN: Include code to measure scheduler lock time"
 #else
@@ -2509,6 +2708,12 @@ OS_TICK       OS_DynTickSet             (OS_TICK                ticks);
 
 #ifndef OS_CFG_STAT_TASK_STK_CHK_EN
 #error  "OS_CFG.H, Missing OS_CFG_STAT_TASK_STK_CHK_EN: Check task stacks from statistics task"
+#else
+    #if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u)
+        #ifndef OS_CFG_STAT_TASK_STK_CHK_WORDS
+        #error "OS_CFG_APP.h, Missing OS_CFG_STAT_TASK_STK_CHK_WORDS: Stack entries checked per stack each run"
+        #endif
+    #endif
 #endif
 
 #ifndef OS_CFG_TASK_CHANGE_PRIO_EN
@@ -2573,6 +2778,18 @@ OS_TICK       OS_DynTickSet             (OS_TICK                ticks);
     #endif
 #endif
 
+#ifndef OS_CFG_TICK_WHEEL_EN
+#error  "OS_CFG.H, Missing OS_CFG_TICK_WHEEL_EN: Hashed timing wheel (1) or sorted delta list (0) for timeouts"
+#else
+    #if (OS_CFG_TICK_WHEEL_EN > 0u)
+        #ifndef OS_CFG_TICK_WHEEL_SIZE
+        #error "OS_CFG_APP.h, Missing OS_CFG_TICK_WHEEL_SIZE: Number of spokes in the tick wheel"
+        #elif ((OS_CFG_TICK_WHEEL_SIZE < 2u) || ((OS_CFG_TICK_WHEEL_SIZE & (OS_CFG_TICK_WHEEL_SIZE - 1u)) != 0u))
+        #error "OS_CFG_APP.h, OS_CFG_TICK_WHEEL_SIZE must be a power of 2, >= 2"
+        #endif
+    #endif
+#endif
+
 /*
 ************************************************************************************************************************
 *                                                  TIME MANAGEMENT
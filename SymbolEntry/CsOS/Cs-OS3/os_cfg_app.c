@@ -47,6 +47,10 @@ const  CPU_CHAR  *os_cfg_app__c = "$Id: $";
 
 #define  OS_CFG_IDLE_TASK_STK_LIMIT      ((OS_CFG_IDLE_TASK_STK_SIZE  * OS_CFG_TASK_STK_LIMIT_PCT_EMPTY) / 100u)
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+#define  OS_CFG_INT_Q_TASK_STK_LIMIT     ((OS_CFG_INT_Q_TASK_STK_SIZE * OS_CFG_TASK_STK_LIMIT_PCT_EMPTY) / 100u)
+#endif
+
 #if (OS_CFG_STAT_TASK_EN > 0u)
 #define  OS_CFG_STAT_TASK_STK_LIMIT      ((OS_CFG_STAT_TASK_STK_SIZE  * OS_CFG_TASK_STK_LIMIT_PCT_EMPTY) / 100u)
 #endif
@@ -63,6 +67,11 @@ const  CPU_CHAR  *os_cfg_app__c = "$Id: $";
 
 CPU_STK        OSCfg_IdleTaskStk   [OS_CFG_IDLE_TASK_STK_SIZE];
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+OS_INT_Q       OSCfg_IntQ          [OS_CFG_INT_Q_SIZE];
+CPU_STK        OSCfg_IntQTaskStk   [OS_CFG_INT_Q_TASK_STK_SIZE];
+#endif
+
 #if (OS_CFG_ISR_STK_SIZE > 0u)
 CPU_STK        OSCfg_ISRStk        [OS_CFG_ISR_STK_SIZE];
 #endif
@@ -90,6 +99,24 @@ CPU_STK_SIZE   const  OSCfg_IdleTaskStkLimit     =  OS_CFG_IDLE_TASK_STK_LIMIT;
 CPU_STK_SIZE   const  OSCfg_IdleTaskStkSize      =  OS_CFG_IDLE_TASK_STK_SIZE;
 CPU_INT32U     const  OSCfg_IdleTaskStkSizeRAM   =  sizeof(OSCfg_IdleTaskStk);
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+OS_INT_Q     * const  OSCfg_IntQBasePtr          = &OSCfg_IntQ[0];
+OS_OBJ_QTY     const  OSCfg_IntQSize             =  OS_CFG_INT_Q_SIZE;
+CPU_INT32U     const  OSCfg_IntQSizeRAM          =  sizeof(OSCfg_IntQ);
+CPU_STK      * const  OSCfg_IntQTaskStkBasePtr   = &OSCfg_IntQTaskStk[0];
+CPU_STK_SIZE   const  OSCfg_IntQTaskStkLimit     =  OS_CFG_INT_Q_TASK_STK_LIMIT;
+CPU_STK_SIZE   const  OSCfg_IntQTaskStkSize      =  OS_CFG_INT_Q_TASK_STK_SIZE;
+CPU_INT32U     const  OSCfg_IntQTaskStkSizeRAM   =  sizeof(OSCfg_IntQTaskStk);
+#else
+OS_INT_Q     * const  OSCfg_IntQBasePtr          = (OS_INT_Q *)0;
+OS_OBJ_QTY     const  OSCfg_IntQSize             =            0u;
+CPU_INT32U     const  OSCfg_IntQSizeRAM          =            0u;
+CPU_STK      * const  OSCfg_IntQTaskStkBasePtr   =  (CPU_STK *)0;
+CPU_STK_SIZE   const  OSCfg_IntQTaskStkLimit     =            0u;
+CPU_STK_SIZE   const  OSCfg_IntQTaskStkSize      =            0u;
+CPU_INT32U     const  OSCfg_IntQTaskStkSizeRAM   =            0u;
+#endif
+
 
 #if (OS_CFG_ISR_STK_SIZE > 0u)
 CPU_STK      * const  OSCfg_ISRStkBasePtr        = &OSCfg_ISRStk[0];
@@ -180,6 +207,10 @@ CPU_INT32U     const  OSCfg_DataSizeRAM          = 0u
 #if (OS_CFG_ISR_STK_SIZE > 0u)
                                                  + sizeof(OSCfg_ISRStk)
 #endif
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+                                                 + sizeof(OSCfg_IntQ)
+                                                 + sizeof(OSCfg_IntQTaskStk)
+#endif
 
                                                  + sizeof(OSCfg_IdleTaskStk);
 
@@ -213,6 +244,14 @@ void  OSCfg_Init (void)
     (void)OSCfg_IdleTaskStkSize;
     (void)OSCfg_IdleTaskStkSizeRAM;
 
+    (void)OSCfg_IntQBasePtr;
+    (void)OSCfg_IntQSize;
+    (void)OSCfg_IntQSizeRAM;
+    (void)OSCfg_IntQTaskStkBasePtr;
+    (void)OSCfg_IntQTaskStkLimit;
+    (void)OSCfg_IntQTaskStkSize;
+    (void)OSCfg_IntQTaskStkSizeRAM;
+
     (void)OSCfg_ISRStkBasePtr;
     (void)OSCfg_ISRStkSize;
     (void)OSCfg_ISRStkSizeRAM;
@@ -207,6 +207,14 @@ void  OSInit (OS_ERR  *p_err)
     }
 
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    OS_IntQTaskInit(p_err);                                     /* Initialize the ISR Handler Task                      */
+    if (*p_err != OS_ERR_NONE) {
+        return;
+    }
+#endif
+
+
 #if (OS_CFG_TICK_EN > 0u)
     OS_TickInit(p_err);
     if (*p_err != OS_ERR_NONE) {
@@ -1183,12 +1191,19 @@ void  OS_PendListChangePrio (OS_TCB  *p_tcb)
     }
 #endif
 
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    OS_PendListRemove(p_tcb);                                   /* Always move, the TCB's priority bucket changes       */
+    p_tcb->PendObjPtr = p_obj;
+    OS_PendListInsertPrio(p_pend_list,
+                          p_tcb);
+#else
     if (p_pend_list->HeadPtr->PendNextPtr != (OS_TCB *)0) {     /* Only move if multiple entries in the list            */
             OS_PendListRemove(p_tcb);                           /* Remove entry from current position                   */
             p_tcb->PendObjPtr = p_obj;
             OS_PendListInsertPrio(p_pend_list,                  /* INSERT it back in the list                           */
                                   p_tcb);
     }
+#endif
 }
 
 
@@ -1209,8 +1224,21 @@ void  OS_PendListChangePrio (OS_TCB  *p_tcb)
 
 void  OS_PendListInit (OS_PEND_LIST  *p_pend_list)
 {
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    OS_PRIO  i;
+
+
+#endif
     p_pend_list->HeadPtr    = (OS_TCB *)0;
     p_pend_list->TailPtr    = (OS_TCB *)0;
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    for (i = 0u; i < OS_PRIO_TBL_SIZE; i++) {                   /* No priority has a waiter                             */
+        p_pend_list->PrioTbl[i] = (CPU_DATA)0;
+    }
+    for (i = 0u; i < OS_CFG_PRIO_MAX; i++) {
+        p_pend_list->PrioTailPtr[i] = (OS_TCB *)0;
+    }
+#endif
 #if (OS_CFG_DBG_EN > 0u)
     p_pend_list->NbrEntries =           0u;
 #endif
@@ -1277,12 +1305,61 @@ void  OS_PendListInit (OS_PEND_LIST  *p_pend_list)
 * Returns    : none
 *
 * Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application MUST NOT call it.
+*
+*              2) With OS_CFG_PEND_LIST_BITMAP_EN the list is not walked.  The pend list keeps a bitmap of the priorities
+*                 that have a waiter and the last waiter of each one, so the TCB goes right after the last waiter of the
+*                 nearest priority at or above its own, or at the head if there is none.  The order is the same as the
+*                 walk's: by priority, FIFO within a priority.  The cost no longer depends on the number of waiters.
 ************************************************************************************************************************
 */
 
 void  OS_PendListInsertPrio (OS_PEND_LIST  *p_pend_list,
                              OS_TCB        *p_tcb)
 {
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    OS_PRIO    prio;
+    OS_PRIO    ix;
+    OS_PRIO    ix_prio;
+    CPU_DATA   bit;
+    CPU_DATA   bits;
+    OS_TCB    *p_tcb_prev;
+    OS_TCB    *p_tcb_next;
+
+
+    prio            = p_tcb->Prio;                              /* Obtain the priority of the task to insert            */
+    p_tcb->PendPrio = prio;
+    ix_prio         = (OS_PRIO)(prio / (CPU_CFG_DATA_SIZE * 8u));
+    bit             = (CPU_DATA)1u << (((CPU_CFG_DATA_SIZE * 8u) - 1u) - (prio % (CPU_CFG_DATA_SIZE * 8u)));
+    ix              = ix_prio;
+    bits            = p_pend_list->PrioTbl[ix] & ~(bit - 1u);   /* Priorities at or above 'prio' in its entry           */
+    while ((bits == (CPU_DATA)0) && (ix > 0u)) {                /* None, try the entries of higher priorities           */
+        ix--;
+        bits = p_pend_list->PrioTbl[ix];
+    }
+
+    if (bits == (CPU_DATA)0) {                                  /* No waiter at or above 'prio', insert at the head     */
+        p_tcb_next           =  p_pend_list->HeadPtr;
+        p_tcb->PendPrevPtr   = (OS_TCB *)0;
+        p_pend_list->HeadPtr =  p_tcb;
+    } else {                                                    /* Insert after the last waiter of the nearest prio     */
+        p_tcb_prev              = p_pend_list->PrioTailPtr[(ix * (CPU_CFG_DATA_SIZE * 8u))
+                                                           + (((CPU_CFG_DATA_SIZE * 8u) - 1u) - CPU_CntTrailZeros(bits))];
+        p_tcb_next              = p_tcb_prev->PendNextPtr;
+        p_tcb->PendPrevPtr      = p_tcb_prev;
+        p_tcb_prev->PendNextPtr = p_tcb;
+    }
+    p_tcb->PendNextPtr = p_tcb_next;
+    if (p_tcb_next == (OS_TCB *)0) {                            /* TCB to insert is lowest in priority                  */
+        p_pend_list->TailPtr    = p_tcb;
+    } else {
+        p_tcb_next->PendPrevPtr = p_tcb;
+    }
+    p_pend_list->PrioTailPtr[prio]  = p_tcb;                    /* It is now the last waiter at its priority            */
+    p_pend_list->PrioTbl[ix_prio]  |= bit;
+#if (OS_CFG_DBG_EN > 0u)
+    p_pend_list->NbrEntries++;                                  /* One more OS_TCB in the list                          */
+#endif
+#else
     OS_PRIO   prio;
     OS_TCB   *p_tcb_next;
 
@@ -1328,6 +1405,7 @@ void  OS_PendListInsertPrio (OS_PEND_LIST  *p_pend_list,
             }
         }
     }
+#endif
 }
 
 
@@ -1382,6 +1460,9 @@ void  OS_PendListInsertPrio (OS_PEND_LIST  *p_pend_list,
 void  OS_PendListInsertFIFO (OS_PEND_LIST  *p_pend_list,
                              OS_TCB        *p_tcb)
 {
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    p_tcb->PendPrio = p_tcb->Prio;                              /* Kept in range for OS_PendListRemove()                */
+#endif
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* CASE 0: Insert when there are no entries             */
 #if (OS_CFG_DBG_EN > 0u)
         p_pend_list->NbrEntries = 1u;                           /* This is the first entry                              */
@@ -1456,11 +1537,28 @@ void  OS_PendListRemove (OS_TCB  *p_tcb)
     OS_PEND_LIST  *p_pend_list;
     OS_TCB        *p_next;
     OS_TCB        *p_prev;
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    OS_PRIO        prio;
+#endif
 
 
     if (p_tcb->PendObjPtr != (OS_PEND_OBJ *)0) {                /* Only remove if object has a pend list.               */
         p_pend_list = &p_tcb->PendObjPtr->PendList;             /* Get pointer to pend list                             */
 
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+        prio = p_tcb->PendPrio;                                 /* Always 0 in PrioTailPtr[] of FIFO lists              */
+        if (p_pend_list->PrioTailPtr[prio] == p_tcb) {          /* Last waiter at its priority?                         */
+            p_prev = p_tcb->PendPrevPtr;
+            if ((p_prev != (OS_TCB *)0) && (p_prev->PendPrio == prio)) {
+                p_pend_list->PrioTailPtr[prio] = p_prev;        /* No, the one before it is the last now                */
+            } else {                                            /* Yes, the priority has no waiter left                 */
+                p_pend_list->PrioTailPtr[prio] = (OS_TCB *)0;
+                p_pend_list->PrioTbl[prio / (CPU_CFG_DATA_SIZE * 8u)]
+                    &= ~((CPU_DATA)1u << (((CPU_CFG_DATA_SIZE * 8u) - 1u) - (prio % (CPU_CFG_DATA_SIZE * 8u))));
+            }
+        }
+#endif
+
                                                                 /* Remove TCB from the pend list.                       */
         if (p_pend_list->HeadPtr->PendNextPtr == (OS_TCB *)0) {
             p_pend_list->HeadPtr = (OS_TCB *)0;                 /* Only one entry in the pend list                      */
@@ -1719,6 +1817,9 @@ void  OS_RdyListInit (void)
 
 void  OS_RdyListInsert (OS_TCB  *p_tcb)
 {
+#if (OS_CFG_TASK_PROFILE_EN > 0u)
+    p_tcb->RdyTs = OS_TS_GET();                                 /* Start of the wait for the CPU, see OSTaskSwHook()    */
+#endif
     OS_PrioInsert(p_tcb->Prio);
     if (p_tcb->Prio == OSPrioCur) {                             /* Are we readying a task at the same prio?             */
         OS_RdyListInsertTail(p_tcb);                            /* Yes, insert readied task at the end of the list      */
@@ -2181,7 +2282,7 @@ void  OS_SchedRoundRobin (OS_RDY_LIST  *p_rdy_list)
         return;
     }
 
-    if (OSSchedLockNestingCtr > 0u) {                           /* Can't round-robin if the scheduler is locked         */
+    if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) {     /* Can't round-robin if the scheduler is locked         */
         CPU_CRITICAL_EXIT();
         return;
     }
@@ -393,7 +393,7 @@ OS_OBJ_QTY  OSDataDel (OS_DATA  *p_data,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_data->PendList;
     nbr_tasks   = 0u;
     switch (opt) {
@@ -410,10 +410,10 @@ OS_OBJ_QTY  OSDataDel (OS_DATA  *p_data,
 #if (OS_CREATE_EXT > 0u)
                  p_data->CreateOpt       =  0u;
 #endif
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_NONE;
              } else {
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_TASK_WAITING;
              }
              break;
@@ -444,13 +444,13 @@ OS_OBJ_QTY  OSDataDel (OS_DATA  *p_data,
 #if (OS_CREATE_EXT > 0u)
              p_data->CreateOpt       =  0u;
 #endif
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT_NO_SCHED();
              OSSched();                                         /* Find highest priority task ready to run              */
             *p_err = OS_ERR_NONE;
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_OPT_INVALID;
              break;
     }
@@ -527,10 +527,10 @@ CPU_DATA  OSDataFlush (OS_DATA  *p_data,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     entries         = p_data->Entries;                          /* Any data sent is lost                                */
     OS_DataStorageClr(p_data);
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
    *p_err           = OS_ERR_NONE;
     return (entries);
 }
@@ -691,7 +691,7 @@ void  OSDataPend (OS_DATA      *p_data,
         return;
     }
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_dest = (CPU_INT08U *)p_msg;
                                                                 /* ---------------- QUEUE IS NOT EMPTY ---------------- */
     if (p_data->Entries > 0u) {                                 /* Any data waiting in the data queue?                  */
@@ -710,29 +710,29 @@ void  OSDataPend (OS_DATA      *p_data,
             }
         }
         OS_TRACE_DATA_PEND(p_data);
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_DATA_PEND_EXIT(OS_ERR_NONE);
        *p_err = OS_ERR_NONE;
         return;                                                 /* Yes, Return a copy of the data                       */
     }
                                                                 /* ------------------ QUEUE IS EMPTY ------------------ */
     if ((opt & OS_OPT_PEND_PEEK) != 0u) {                       /* Caller can't peek at empty Queue                     */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_DATA_PEND_FAILED(p_data);
         OS_TRACE_DATA_PEND_EXIT(OS_ERR_PEND_EMPTY);
        *p_err = OS_ERR_PEND_EMPTY;
         return;
 
     } else if ((opt & OS_OPT_PEND_NON_BLOCKING) != 0u) {        /* Caller won't block on empty queue                    */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_DATA_PEND_FAILED(p_data);
         OS_TRACE_DATA_PEND_EXIT(OS_ERR_PEND_WOULD_BLOCK);
        *p_err = OS_ERR_PEND_WOULD_BLOCK;
         return;
 
     } else {                                                    /* Caller wants to pend on empty queue                  */
-        if (OSSchedLockNestingCtr > 0u) {                       /* Can't pend when the scheduler is locked              */
-            CPU_CRITICAL_EXIT();
+        if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* Can't pend when the scheduler is locked              */
+            OS_CRITICAL_EXIT();
             OS_TRACE_DATA_PEND_FAILED(p_data);
             OS_TRACE_DATA_PEND_EXIT(OS_ERR_SCHED_LOCKED);
            *p_err = OS_ERR_SCHED_LOCKED;
@@ -747,12 +747,12 @@ void  OSDataPend (OS_DATA      *p_data,
                                     OSTCBCurPtr,
                                     OS_TASK_PEND_ON_DATA,
                                     timeout);
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_DATA_PEND_BLOCK(p_data);
 
     OSSched();                                                  /* Find the next highest priority task ready to run     */
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     switch (OSTCBCurPtr->PendStatus) {
         case OS_STATUS_PEND_OK:                                 /* Data already placed into buffer by OSDataPost()      */
              OS_TRACE_DATA_PEND(p_data);
@@ -779,7 +779,7 @@ void  OSDataPend (OS_DATA      *p_data,
             *p_err = OS_ERR_STATUS_INVALID;
              break;
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_DATA_PEND_EXIT(*p_err);
     return;
 }
@@ -876,10 +876,10 @@ OS_OBJ_QTY  OSDataPendAbort (OS_DATA  *p_data,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_data->PendList;
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* Any task waiting on queue?                           */
-        CPU_CRITICAL_EXIT();                                    /* No                                                   */
+        OS_CRITICAL_EXIT();                                     /* No                                                   */
        *p_err = OS_ERR_PEND_ABORT_NONE;
         return (0u);
     }
@@ -895,7 +895,7 @@ OS_OBJ_QTY  OSDataPendAbort (OS_DATA  *p_data,
             break;                                              /* No                                                   */
         }
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
@@ -949,6 +949,8 @@ OS_OBJ_QTY  OSDataPendAbort (OS_DATA  *p_data,
 *                                OS_ERR_OS_NOT_RUNNING    If Cs/OS3 is not running yet
 *                                OS_ERR_Q_MAX             If the queue is full
 *                                OS_ERR_DATA_SIZE         If the item_size you specify doesn't match that of the queue
+*                                OS_ERR_POST_ISR          If you called this function from an ISR with
+*                                                         OS_CFG_ISR_POST_DEFERRED_EN
 *
 * Returns    : None
 *
@@ -988,6 +990,14 @@ void  OSDataPost (OS_DATA      *p_data,
     }
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (OSIntNestingCtr > 0u) {                                 /* Data is not queued for the ISR handler task          */
+        OS_TRACE_DATA_POST_EXIT(OS_ERR_POST_ISR);
+       *p_err = OS_ERR_POST_ISR;
+        return;
+    }
+#endif
+
 #if (OS_CFG_ARG_CHK_EN > 0u)
     if (p_data == (OS_DATA *)0) {                               /* Validate 'p_data'                                    */
         OS_TRACE_DATA_POST_FAILED(p_data);
@@ -1030,7 +1040,7 @@ void  OSDataPost (OS_DATA      *p_data,
 
     OS_TRACE_DATA_POST(p_data);
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
    *p_err       = OS_ERR_NONE;
     p_pend_list = &p_data->PendList;
     p_src       = (CPU_INT08U *)p_msg;
@@ -1118,7 +1128,7 @@ void  OSDataPost (OS_DATA      *p_data,
                  }
                  break;
         }
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_DATA_POST_EXIT(*p_err);
         return;
     }
@@ -1130,7 +1140,7 @@ void  OSDataPost (OS_DATA      *p_data,
              item_size,
              0u);
 
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
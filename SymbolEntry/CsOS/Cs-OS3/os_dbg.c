@@ -268,6 +268,7 @@ CPU_INT32U  const  OSDbg_DataSize = sizeof(OSIntNestingCtr)
 #if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u) && (OS_CFG_ISR_STK_SIZE > 0u)
                                   + sizeof(OSISRStkFree)
                                   + sizeof(OSISRStkUsed)
+                                  + sizeof(OSISRStkScanIx)
 #endif
 
 #if (OS_CFG_ISR_STK_SIZE > 0u)
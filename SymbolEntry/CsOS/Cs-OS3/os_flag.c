@@ -238,7 +238,7 @@ OS_OBJ_QTY  OSFlagDel (OS_FLAG_GRP  *p_grp,
         return (0u);
     }
 #endif
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_grp->PendList;
     nbr_tasks   = 0u;
     switch (opt) {
@@ -251,11 +251,11 @@ OS_OBJ_QTY  OSFlagDel (OS_FLAG_GRP  *p_grp,
                  OS_TRACE_FLAG_DEL(p_grp);
                  OS_FlagClr(p_grp);
 
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
 
                 *p_err = OS_ERR_NONE;
              } else {
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_TASK_WAITING;
              }
              break;
@@ -280,14 +280,14 @@ OS_OBJ_QTY  OSFlagDel (OS_FLAG_GRP  *p_grp,
              OS_TRACE_FLAG_DEL(p_grp);
 
              OS_FlagClr(p_grp);
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT_NO_SCHED();
 
              OSSched();                                         /* Find highest priority task ready to run              */
             *p_err = OS_ERR_NONE;
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_OPT_INVALID;
              break;
     }
@@ -485,7 +485,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
     }
 #endif
     mode = opt & OS_OPT_PEND_FLAG_MASK;
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     switch (mode) {
         case OS_OPT_PEND_FLAG_SET_ALL:                          /* See if all required flags are set                    */
              flags_rdy = (p_grp->Flags & flags);                /* Extract only the bits we want                        */
@@ -499,21 +499,21 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                     *p_ts = p_grp->TS;
                  }
 #endif
-                 CPU_CRITICAL_EXIT();                           /* Yes, condition met, return to caller                 */
+                 OS_CRITICAL_EXIT();                            /* Yes, condition met, return to caller                 */
                  OS_TRACE_FLAG_PEND(p_grp);
                  OS_TRACE_FLAG_PEND_EXIT(OS_ERR_NONE);
                 *p_err = OS_ERR_NONE;
                  return (flags_rdy);
              } else {                                           /* Block task until events occur or timeout             */
                  if ((opt & OS_OPT_PEND_NON_BLOCKING) != 0u) {
-                     CPU_CRITICAL_EXIT();
+                     OS_CRITICAL_EXIT();
                      OS_TRACE_FLAG_PEND_FAILED(p_grp);
                      OS_TRACE_FLAG_PEND_EXIT(OS_ERR_PEND_WOULD_BLOCK);
                     *p_err = OS_ERR_PEND_WOULD_BLOCK;           /* Specified non-blocking so task would block           */
                      return ((OS_FLAGS)0);
                  } else {                                       /* Specified blocking so check is scheduler is locked   */
-                     if (OSSchedLockNestingCtr > 0u) {          /* See if called with scheduler locked ...        */
-                         CPU_CRITICAL_EXIT();
+                     if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* See if called with scheduler locked ... */
+                         OS_CRITICAL_EXIT();
                          OS_TRACE_FLAG_PEND_FAILED(p_grp);
                          OS_TRACE_FLAG_PEND_EXIT(OS_ERR_SCHED_LOCKED);
                         *p_err = OS_ERR_SCHED_LOCKED;           /* ... can't PEND when locked                           */
@@ -525,7 +525,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                               flags,
                               opt,
                               timeout);
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
              }
              break;
 
@@ -541,20 +541,20 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                     *p_ts  = p_grp->TS;
                  }
 #endif
-                 CPU_CRITICAL_EXIT();                           /* Yes, condition met, return to caller                 */
+                 OS_CRITICAL_EXIT();                            /* Yes, condition met, return to caller                 */
                  OS_TRACE_FLAG_PEND(p_grp);
                  OS_TRACE_FLAG_PEND_EXIT(OS_ERR_NONE);
                 *p_err = OS_ERR_NONE;
                  return (flags_rdy);
              } else {                                           /* Block task until events occur or timeout             */
                  if ((opt & OS_OPT_PEND_NON_BLOCKING) != 0u) {
-                     CPU_CRITICAL_EXIT();
+                     OS_CRITICAL_EXIT();
                      OS_TRACE_FLAG_PEND_EXIT(OS_ERR_PEND_WOULD_BLOCK);
                     *p_err = OS_ERR_PEND_WOULD_BLOCK;           /* Specified non-blocking so task would block           */
                      return ((OS_FLAGS)0);
                  } else {                                       /* Specified blocking so check is scheduler is locked   */
-                     if (OSSchedLockNestingCtr > 0u) {          /* See if called with scheduler locked ...        */
-                         CPU_CRITICAL_EXIT();
+                     if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* See if called with scheduler locked ... */
+                         OS_CRITICAL_EXIT();
                          OS_TRACE_FLAG_PEND_EXIT(OS_ERR_SCHED_LOCKED);
                         *p_err = OS_ERR_SCHED_LOCKED;           /* ... can't PEND when locked                           */
                          return ((OS_FLAGS)0);
@@ -565,7 +565,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                               flags,
                               opt,
                               timeout);
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
              }
              break;
 
@@ -582,20 +582,20 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                     *p_ts  = p_grp->TS;
                  }
 #endif
-                 CPU_CRITICAL_EXIT();                           /* Yes, condition met, return to caller                 */
+                 OS_CRITICAL_EXIT();                            /* Yes, condition met, return to caller                 */
                  OS_TRACE_FLAG_PEND(p_grp);
                  OS_TRACE_FLAG_PEND_EXIT(OS_ERR_NONE);
                 *p_err = OS_ERR_NONE;
                  return (flags_rdy);
              } else {                                           /* Block task until events occur or timeout             */
                  if ((opt & OS_OPT_PEND_NON_BLOCKING) != 0u) {
-                     CPU_CRITICAL_EXIT();
+                     OS_CRITICAL_EXIT();
                      OS_TRACE_FLAG_PEND_EXIT(OS_ERR_PEND_WOULD_BLOCK);
                     *p_err = OS_ERR_PEND_WOULD_BLOCK;           /* Specified non-blocking so task would block           */
                      return ((OS_FLAGS)0);
                  } else {                                       /* Specified blocking so check is scheduler is locked   */
-                     if (OSSchedLockNestingCtr > 0u) {          /* See if called with scheduler locked ...        */
-                         CPU_CRITICAL_EXIT();
+                     if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* See if called with scheduler locked ... */
+                         OS_CRITICAL_EXIT();
                          OS_TRACE_FLAG_PEND_EXIT(OS_ERR_SCHED_LOCKED);
                         *p_err = OS_ERR_SCHED_LOCKED;           /* ... can't PEND when locked                           */
                          return (0);
@@ -606,7 +606,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                               flags,
                               opt,
                               timeout);
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
              }
              break;
 
@@ -622,20 +622,20 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                     *p_ts  = p_grp->TS;
                  }
 #endif
-                 CPU_CRITICAL_EXIT();                           /* Yes, condition met, return to caller                 */
+                 OS_CRITICAL_EXIT();                            /* Yes, condition met, return to caller                 */
                  OS_TRACE_FLAG_PEND(p_grp);
                  OS_TRACE_FLAG_PEND_EXIT(OS_ERR_NONE);
                 *p_err = OS_ERR_NONE;
                  return (flags_rdy);
              } else {                                           /* Block task until events occur or timeout             */
                  if ((opt & OS_OPT_PEND_NON_BLOCKING) != 0u) {
-                     CPU_CRITICAL_EXIT();
+                     OS_CRITICAL_EXIT();
                      OS_TRACE_FLAG_PEND_EXIT(OS_ERR_PEND_WOULD_BLOCK);
                     *p_err = OS_ERR_PEND_WOULD_BLOCK;           /* Specified non-blocking so task would block           */
                      return ((OS_FLAGS)0);
                  } else {                                       /* Specified blocking so check is scheduler is locked   */
-                     if (OSSchedLockNestingCtr > 0u) {          /* See if called with scheduler locked ...        */
-                         CPU_CRITICAL_EXIT();
+                     if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* See if called with scheduler locked ... */
+                         OS_CRITICAL_EXIT();
                          OS_TRACE_FLAG_PEND_EXIT(OS_ERR_SCHED_LOCKED);
                         *p_err = OS_ERR_SCHED_LOCKED;           /* ... can't PEND when locked                           */
                          return (0u);
@@ -646,13 +646,13 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                               flags,
                               opt,
                               timeout);
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
              }
              break;
 #endif
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              OS_TRACE_FLAG_PEND_FAILED(p_grp);
              OS_TRACE_FLAG_PEND_EXIT(OS_ERR_OPT_INVALID);
             *p_err = OS_ERR_OPT_INVALID;
@@ -663,7 +663,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
 
     OSSched();                                                  /* Find next HPT ready to run                           */
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     switch (OSTCBCurPtr->PendStatus) {
         case OS_STATUS_PEND_OK:                                 /* We got the event flags                               */
 #if (OS_CFG_TS_EN > 0u)
@@ -681,7 +681,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                 *p_ts = OSTCBCurPtr->TS;
              }
 #endif
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              OS_TRACE_FLAG_PEND_FAILED(p_grp);
             *p_err = OS_ERR_PEND_ABORT;
              break;
@@ -692,7 +692,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                 *p_ts = 0u;
              }
 #endif
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              OS_TRACE_FLAG_PEND_FAILED(p_grp);
             *p_err = OS_ERR_TIMEOUT;
              break;
@@ -703,13 +703,13 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                 *p_ts = OSTCBCurPtr->TS;
              }
 #endif
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              OS_TRACE_FLAG_PEND_FAILED(p_grp);
             *p_err = OS_ERR_OBJ_DEL;
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              OS_TRACE_FLAG_PEND_FAILED(p_grp);
             *p_err = OS_ERR_STATUS_INVALID;
              break;
@@ -734,13 +734,13 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
                  break;
 #endif
             default:
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                  OS_TRACE_FLAG_PEND_EXIT(OS_ERR_OPT_INVALID);
                 *p_err = OS_ERR_OPT_INVALID;
                  return (0u);
         }
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_FLAG_PEND_EXIT(OS_ERR_NONE);
    *p_err = OS_ERR_NONE;                                        /* Event(s) must have occurred                          */
     return (flags_rdy);
@@ -841,10 +841,10 @@ OS_OBJ_QTY  OSFlagPendAbort (OS_FLAG_GRP  *p_grp,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_grp->PendList;
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* Any task waiting on flag group?                      */
-        CPU_CRITICAL_EXIT();                                    /* No                                                   */
+        OS_CRITICAL_EXIT();                                     /* No                                                   */
        *p_err = OS_ERR_PEND_ABORT_NONE;
         return (0u);
     }
@@ -866,7 +866,7 @@ OS_OBJ_QTY  OSFlagPendAbort (OS_FLAG_GRP  *p_grp,
             break;                                              /* No                                                   */
         }
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
@@ -1025,6 +1025,20 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *p_grp,
     }
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR, the ISR handler task posts       */
+        OS_IntQPost(OS_OBJ_TYPE_FLAG,
+                    (void *)p_grp,
+                    (void *)0,
+                    0u,
+                    flags,
+                    opt,
+                    p_err);
+        OS_TRACE_FLAG_POST_EXIT(*p_err);
+        return (0u);
+    }
+#endif
+
 #if (OS_CFG_TS_EN > 0u)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
@@ -1036,13 +1050,13 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *p_grp,
     switch (opt) {
         case OS_OPT_POST_FLAG_SET:
         case OS_OPT_POST_FLAG_SET | OS_OPT_POST_NO_SCHED:
-             CPU_CRITICAL_ENTER();
+             OS_CRITICAL_ENTER();
              p_grp->Flags |=  flags;                            /* Set   the flags specified in the group               */
              break;
 
         case OS_OPT_POST_FLAG_CLR:
         case OS_OPT_POST_FLAG_CLR | OS_OPT_POST_NO_SCHED:
-             CPU_CRITICAL_ENTER();
+             OS_CRITICAL_ENTER();
              p_grp->Flags &= ~flags;                            /* Clear the flags specified in the group               */
              break;
 
@@ -1056,7 +1070,7 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *p_grp,
 #endif
     p_pend_list = &p_grp->PendList;
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* Any task waiting on event flag group?                */
-        CPU_CRITICAL_EXIT();                                    /* No                                                   */
+        OS_CRITICAL_EXIT();                                     /* No                                                   */
        *p_err = OS_ERR_NONE;
         OS_TRACE_FLAG_POST_EXIT(*p_err);
         return (p_grp->Flags);
@@ -1105,7 +1119,7 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *p_grp,
                  break;
 #endif
             default:
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_FLAG_PEND_OPT;
                  OS_TRACE_FLAG_POST_EXIT(*p_err);
                  return (0u);
@@ -1113,15 +1127,15 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *p_grp,
                                                                 /* Point to next task waiting for event flag(s)         */
         p_tcb = p_tcb_next;
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();
     }
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     flags_cur = p_grp->Flags;
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
    *p_err     = OS_ERR_NONE;
 
     OS_TRACE_FLAG_POST_EXIT(*p_err);
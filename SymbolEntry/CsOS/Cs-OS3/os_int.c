@@ -0,0 +1,365 @@
+/*
+*********************************************************************************************************
+*                                               Cs/OS3
+*                                        The Real-Time Kernel
+*
+*                           Copyright 2023; Weston Embedded Solutions, LLC.
+*                                       www.weston-embedded.com
+*
+*                   All rights reserved. Protected by international copyright laws.
+*
+*               Your use of this software is subject to your acceptance of the terms of
+*               a Weston Embedded Solutions software license, which can be obtained by
+*               contacting us at www.weston-embedded.com/company/contact. If you do not
+*                 agree to the terms of this license, you may not use this software.
+*
+*                 Please help us continue to provide the embedded community with the
+*                   finest software available. Your honesty is greatly appreciated.
+*
+*********************************************************************************************************
+*                                              uC/OS-III
+*                    Copyright 2009-2020 Silicon Laboratories Inc. www.silabs.com
+*                                 SPDX-License-Identifier: APACHE-2.0
+*               This software is subject to an open-source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       ISR POST QUEUE MANAGEMENT
+*
+* File    : os_int.c
+* Version : V3.09.02
+*********************************************************************************************************
+* Note(s) : (1) With OS_CFG_ISR_POST_DEFERRED_EN, OSSemPost(), OSQPost(), OSFlagPost(), OSTaskSemPost(),
+*               OSTaskQPost() and the tick called from an ISR only append a record to OSCfg_IntQ[] and ready the
+*               ISR handler task.  That task runs at priority 0 and replays the records with the scheduler
+*               locked and interrupts enabled, so the ready, pend and tick lists are only ever changed from
+*               task level and ISRs mask interrupts for a few instructions instead of a whole post.
+*
+*           (2) The queue is a bounded ring written by any number of (nested) ISRs and read by the ISR handler
+*               task alone.  Each slot carries a sequence number: 'pos' when it is free for ring position 'pos',
+*               'pos + 1' once the record for 'pos' is written, and 'pos + OS_CFG_INT_Q_SIZE' when the task has
+*               read it.  An ISR claims a position with a compare-and-swap on OSIntQInIx, so no lock is needed.
+*********************************************************************************************************
+*/
+
+#define  MICRIUM_SOURCE
+#include "os.h"
+
+#ifdef VSC_INCLUDE_SOURCE_FILE_NAMES
+const  CPU_CHAR  *os_int__c = "$Id: $";
+#endif
+
+
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+/*
+************************************************************************************************************************
+*                                                    LOCAL MACROS
+************************************************************************************************************************
+*/
+
+#define  OS_INT_Q_LOAD(p)                   __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define  OS_INT_Q_STORE(p, val)             __atomic_store_n((p), (val), __ATOMIC_RELEASE)
+#define  OS_INT_Q_CAS(p, p_expected, val)   __atomic_compare_exchange_n((p), (p_expected), (val), 0,      \
+                                                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define  OS_INT_Q_INC(p)                    (void)__atomic_fetch_add((p), 1u, __ATOMIC_RELAXED)
+
+
+/*
+************************************************************************************************************************
+*                                              LOCAL FUNCTION PROTOTYPES
+************************************************************************************************************************
+*/
+
+static  void  OS_IntQRePost (OS_INT_Q  *p_rec);
+
+
+/*
+************************************************************************************************************************
+*                                                 QUEUE A POST FROM AN ISR
+*
+* Description: This function is called by the OSxxxPost() services when they are called from an ISR.  The post is saved
+*              in the ISR queue and the ISR handler task is made ready to run.
+*
+* Arguments  : type          is the type of post (OS_OBJ_TYPE_FLAG, OS_OBJ_TYPE_Q, OS_OBJ_TYPE_SEM,
+*                            OS_OBJ_TYPE_TASK_MSG, OS_OBJ_TYPE_TASK_SIGNAL or OS_OBJ_TYPE_TICK)
+*
+*              p_obj         is a pointer to the object posted to, the OS_TCB for task posts or the ready list of the
+*                            interrupted task for a tick
+*
+*              p_msg         is the message for queue posts
+*
+*              msg_size      is the size of that message
+*
+*              flags         are the flags for an event flag post
+*
+*              opt           are the options the post was made with
+*
+*              p_err         is a pointer to a variable that will contain an error code returned by this function.
+*
+*                                OS_ERR_NONE          The post is queued
+*                                OS_ERR_INT_Q_FULL    The ISR queue is full, the post is lost (counted in OSIntQOvfCtr)
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application MUST NOT call it.
+*
+*              2) Interrupts are only disabled to put the ISR handler task in the ready list.
+************************************************************************************************************************
+*/
+
+void  OS_IntQPost (OS_OBJ_TYPE   type,
+                   void         *p_obj,
+                   void         *p_msg,
+                   OS_MSG_SIZE   msg_size,
+                   OS_FLAGS      flags,
+                   OS_OPT        opt,
+                   OS_ERR       *p_err)
+{
+    OS_INT_Q    *p_rec;
+    CPU_INT32U   pos;
+    CPU_INT32U   seq;
+    CPU_SR_ALLOC();
+
+
+    pos = OS_INT_Q_LOAD(&OSIntQInIx);
+    for (;;) {                                                  /* Claim the next ring position                         */
+        p_rec = &OSCfg_IntQ[pos & (OS_CFG_INT_Q_SIZE - 1u)];
+        seq   = OS_INT_Q_LOAD(&p_rec->Seq);
+        if (seq == pos) {                                       /* Slot free for this position?                         */
+            if (OS_INT_Q_CAS(&OSIntQInIx, &pos, pos + 1u) != 0) {
+                break;                                          /* Yes, and no other ISR took it first                  */
+            }                                                   /* No, 'pos' was reloaded, try again                    */
+        } else if ((CPU_INT32S)(seq - pos) < 0) {               /* Slot still holds a record from one lap ago           */
+            OS_INT_Q_INC(&OSIntQOvfCtr);
+           *p_err = OS_ERR_INT_Q_FULL;
+            return;
+        } else {                                                /* Another ISR got there first                          */
+            pos = OS_INT_Q_LOAD(&OSIntQInIx);
+        }
+    }
+
+    p_rec->Type    = type;                                      /* Save the post                                        */
+    p_rec->ObjPtr  = p_obj;
+    p_rec->MsgPtr  = p_msg;
+    p_rec->MsgSize = msg_size;
+    p_rec->Flags   = flags;
+    p_rec->Opt     = opt;
+    OS_INT_Q_STORE(&p_rec->Seq, pos + 1u);                      /* Hand the record to the ISR handler task              */
+
+    CPU_CRITICAL_ENTER();
+    if (OSRdyList[0].HeadPtr == (OS_TCB *)0) {                  /* Make the ISR handler task ready to run               */
+        OSRdyList[0].HeadPtr = &OSIntQTaskTCB;
+        OSRdyList[0].TailPtr = &OSIntQTaskTCB;
+#if (OS_CFG_TASK_PROFILE_EN > 0u)
+        OSIntQTaskTCB.RdyTs  =  OS_TS_GET();                    /* As OS_RdyListInsert()                                */
+#endif
+#if (OS_CFG_DBG_EN > 0u)
+        OSRdyList[0].NbrEntries = 1u;
+#endif
+        OS_PrioInsert(0u);
+    }
+    CPU_CRITICAL_EXIT();
+   *p_err = OS_ERR_NONE;
+}
+
+
+/*
+************************************************************************************************************************
+*                                                  ISR HANDLER TASK
+*
+* Description: This task replays the posts that ISRs queued with OS_IntQPost().  It runs at priority 0, above every
+*              application task, and leaves the ready list when the queue is empty.
+*
+* Arguments  : p_arg   is an argument passed to the task when the task is created (unused).
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application MUST NOT call it.
+*
+*              2) The records are replayed with the scheduler locked, so the tasks they ready only run once the queue
+*                 is empty and OSSched() is called.
+************************************************************************************************************************
+*/
+
+void  OS_IntQTask (void  *p_arg)
+{
+    OS_INT_Q     rec;
+    OS_INT_Q    *p_rec;
+    OS_OBJ_QTY   nbr_entries;
+    CPU_SR_ALLOC();
+
+
+    (void)p_arg;                                                /* Prevent compiler warning for not using 'p_arg'       */
+
+    for (;;) {
+        OS_CRITICAL_ENTER();
+        nbr_entries = (OS_OBJ_QTY)(OS_INT_Q_LOAD(&OSIntQInIx) - OSIntQOutIx);
+        if (OSIntQNbrEntriesMax < nbr_entries) {
+            OSIntQNbrEntriesMax = nbr_entries;
+        }
+        p_rec = &OSCfg_IntQ[OSIntQOutIx & (OS_CFG_INT_Q_SIZE - 1u)];
+        while (OS_INT_Q_LOAD(&p_rec->Seq) == (OSIntQOutIx + 1u)) {
+            rec = *p_rec;                                       /* Copy the record and give the slot back to the ISRs   */
+            OS_INT_Q_STORE(&p_rec->Seq, OSIntQOutIx + OS_CFG_INT_Q_SIZE);
+            OSIntQOutIx++;
+            OS_IntQRePost(&rec);
+            p_rec = &OSCfg_IntQ[OSIntQOutIx & (OS_CFG_INT_Q_SIZE - 1u)];
+        }
+
+        CPU_CRITICAL_ENTER();
+        if (OS_INT_Q_LOAD(&p_rec->Seq) != (OSIntQOutIx + 1u)) { /* Still nothing to replay?                             */
+            OSRdyList[0].HeadPtr = (OS_TCB *)0;                 /* Yes, leave the ready list until an ISR posts again   */
+            OSRdyList[0].TailPtr = (OS_TCB *)0;
+#if (OS_CFG_DBG_EN > 0u)
+            OSRdyList[0].NbrEntries = 0u;
+#endif
+            OS_PrioRemove(0u);
+        }
+        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT_NO_SCHED();
+        OSSched();                                              /* Run the tasks the posts made ready                   */
+    }
+}
+
+
+/*
+************************************************************************************************************************
+*                                                 REPLAY A QUEUED POST
+*
+* Description: This function makes the post an ISR queued, from the ISR handler task.
+*
+* Arguments  : p_rec     is a pointer to a copy of the queued record
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application MUST NOT call it.
+*
+*              2) Errors are dropped: the ISR that posted has already returned.
+************************************************************************************************************************
+*/
+
+static  void  OS_IntQRePost (OS_INT_Q  *p_rec)
+{
+#if (OS_CFG_DYN_TICK_EN > 0u)
+    OS_TICK  ticks;
+#endif
+    OS_ERR   err;
+
+
+    switch (p_rec->Type) {
+#if (OS_CFG_FLAG_EN > 0u)
+        case OS_OBJ_TYPE_FLAG:
+             (void)OSFlagPost((OS_FLAG_GRP *)p_rec->ObjPtr,
+                                             p_rec->Flags,
+                                             p_rec->Opt,
+                                            &err);
+             break;
+#endif
+
+#if (OS_CFG_Q_EN > 0u)
+        case OS_OBJ_TYPE_Q:
+             OSQPost((OS_Q *)p_rec->ObjPtr,
+                             p_rec->MsgPtr,
+                             p_rec->MsgSize,
+                             p_rec->Opt,
+                            &err);
+             break;
+#endif
+
+#if (OS_CFG_SEM_EN > 0u)
+        case OS_OBJ_TYPE_SEM:
+             (void)OSSemPost((OS_SEM *)p_rec->ObjPtr,
+                                       p_rec->Opt,
+                                      &err);
+             break;
+#endif
+
+#if (OS_CFG_TASK_Q_EN > 0u)
+        case OS_OBJ_TYPE_TASK_MSG:
+             OSTaskQPost((OS_TCB *)p_rec->ObjPtr,
+                                   p_rec->MsgPtr,
+                                   p_rec->MsgSize,
+                                   p_rec->Opt,
+                                  &err);
+             break;
+#endif
+
+        case OS_OBJ_TYPE_TASK_SIGNAL:
+             (void)OSTaskSemPost((OS_TCB *)p_rec->ObjPtr,
+                                           p_rec->Opt,
+                                          &err);
+             break;
+
+        case OS_OBJ_TYPE_TICK:
+#if (OS_CFG_SCHED_ROUND_ROBIN_EN > 0u)
+             OS_SchedRoundRobin((OS_RDY_LIST *)p_rec->ObjPtr);  /* Quanta of the task the tick interrupted              */
+#endif
+#if (OS_CFG_TICK_EN > 0u)
+#if (OS_CFG_DYN_TICK_EN > 0u)
+             ticks = OS_DynTickGet();                           /* Ticks elapsed by now, not when the ISR ran           */
+             if (ticks > 0u) {
+                 OS_TickUpdate(ticks);
+             }
+#else
+             OS_TickUpdate(1u);
+#endif
+#endif
+             break;
+
+        default:
+             break;
+    }
+    (void)err;
+}
+
+
+/*
+************************************************************************************************************************
+*                                            INITIALIZE THE ISR HANDLER TASK
+*
+* Description: This function empties the ISR queue and creates the ISR handler task.
+*
+* Arguments  : p_err    is a pointer to a variable that will contain an error code returned by this function.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+void  OS_IntQTaskInit (OS_ERR  *p_err)
+{
+    CPU_INT32U  i;
+
+
+    OSIntQInIx          = 0u;
+    OSIntQOutIx         = 0u;
+    OSIntQNbrEntriesMax = 0u;
+    OSIntQOvfCtr        = 0u;
+    for (i = 0u; i < OS_CFG_INT_Q_SIZE; i++) {                  /* Every slot free for its first lap                    */
+        OSCfg_IntQ[i].Seq = i;
+    }
+                                                                /* ----------- CREATE THE ISR HANDLER TASK ------------ */
+    OSTaskCreate(&OSIntQTaskTCB,
+#if  (OS_CFG_DBG_EN == 0u)
+                 (CPU_CHAR   *)0,
+#else
+                 (CPU_CHAR   *)"Cs/OS3 ISR Queue Task",
+#endif
+                  OS_IntQTask,
+                 (void       *)0,
+                 (OS_PRIO     )0u,
+                  OSCfg_IntQTaskStkBasePtr,
+                  OSCfg_IntQTaskStkLimit,
+                  OSCfg_IntQTaskStkSize,
+                  0u,
+                  0u,
+                 (void       *)0,
+                 (OS_OPT_TASK_STK_CHK | (OS_OPT)(OS_OPT_TASK_STK_CLR | OS_OPT_TASK_NO_TLS)),
+                  p_err);
+}
+#endif
@@ -363,7 +363,7 @@ OS_OBJ_QTY  OSMutexDel (OS_MUTEX  *p_mutex,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_mutex->PendList;
     nbr_tasks   = 0u;
     switch (opt) {
@@ -378,10 +378,10 @@ OS_OBJ_QTY  OSMutexDel (OS_MUTEX  *p_mutex,
                      OS_MutexGrpRemove(p_mutex->OwnerTCBPtr, p_mutex); /* yes, remove it from the task group.           */
                  }
                  OS_MutexClr(p_mutex);
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_NONE;
              } else {
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_TASK_WAITING;
              }
              break;
@@ -420,13 +420,13 @@ OS_OBJ_QTY  OSMutexDel (OS_MUTEX  *p_mutex,
              }
 
              OS_MutexClr(p_mutex);
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT_NO_SCHED();
              OSSched();                                         /* Find highest priority task ready to run              */
             *p_err = OS_ERR_NONE;
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_OPT_INVALID;
              break;
     }
@@ -576,7 +576,7 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if (p_mutex->OwnerNestingCtr == 0u) {                       /* Resource available?                                  */
         p_mutex->OwnerTCBPtr     = OSTCBCurPtr;                 /* Yes, caller may proceed                              */
         p_mutex->OwnerNestingCtr = 1u;
@@ -586,7 +586,7 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
         }
 #endif
         OS_MutexGrpAdd(OSTCBCurPtr, p_mutex);                   /* Add mutex to owner's group                           */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_MUTEX_PEND(p_mutex);
         OS_TRACE_MUTEX_PEND_EXIT(OS_ERR_NONE);
        *p_err = OS_ERR_NONE;
@@ -595,7 +595,7 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
 
     if (OSTCBCurPtr == p_mutex->OwnerTCBPtr) {                  /* See if current task is already the owner of the mutex*/
         if (p_mutex->OwnerNestingCtr == (OS_NESTING_CTR)-1) {
-            CPU_CRITICAL_EXIT();
+            OS_CRITICAL_EXIT();
             OS_TRACE_MUTEX_PEND_FAILED(p_mutex);
             OS_TRACE_MUTEX_PEND_EXIT(OS_ERR_MUTEX_OVF);
            *p_err = OS_ERR_MUTEX_OVF;
@@ -607,7 +607,7 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
            *p_ts = p_mutex->TS;
         }
 #endif
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_MUTEX_PEND_FAILED(p_mutex);
         OS_TRACE_MUTEX_PEND_EXIT(OS_ERR_MUTEX_OWNER);
        *p_err = OS_ERR_MUTEX_OWNER;                             /* Indicate that current task already owns the mutex    */
@@ -615,7 +615,7 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
     }
 
     if ((opt & OS_OPT_PEND_NON_BLOCKING) != 0u) {               /* Caller wants to block if not available?              */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
 #if (OS_CFG_TS_EN > 0u)
         if (p_ts != (CPU_TS *)0) {
            *p_ts = 0u;
@@ -626,8 +626,8 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
        *p_err = OS_ERR_PEND_WOULD_BLOCK;                        /* No                                                   */
         return;
     } else {
-        if (OSSchedLockNestingCtr > 0u) {                       /* Can't pend when the scheduler is locked              */
-            CPU_CRITICAL_EXIT();
+        if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* Can't pend when the scheduler is locked              */
+            OS_CRITICAL_EXIT();
 #if (OS_CFG_TS_EN > 0u)
             if (p_ts != (CPU_TS *)0) {
                *p_ts = 0u;
@@ -651,11 +651,11 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
              OS_TASK_PEND_ON_MUTEX,
              timeout);
 
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_MUTEX_PEND_BLOCK(p_mutex);
     OSSched();                                                  /* Find the next highest priority task ready to run     */
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     switch (OSTCBCurPtr->PendStatus) {
         case OS_STATUS_PEND_OK:                                 /* We got the mutex                                     */
 #if (OS_CFG_TS_EN > 0u)
@@ -702,7 +702,7 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
             *p_err = OS_ERR_STATUS_INVALID;
              break;
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_MUTEX_PEND_EXIT(*p_err);
 }
 
@@ -801,10 +801,10 @@ OS_OBJ_QTY  OSMutexPendAbort (OS_MUTEX  *p_mutex,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_mutex->PendList;
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* Any task waiting on mutex?                           */
-        CPU_CRITICAL_EXIT();                                    /* No                                                   */
+        OS_CRITICAL_EXIT();                                     /* No                                                   */
        *p_err =  OS_ERR_PEND_ABORT_NONE;
         return (0u);
     }
@@ -839,7 +839,7 @@ OS_OBJ_QTY  OSMutexPendAbort (OS_MUTEX  *p_mutex,
             break;                                              /* No                                                   */
         }
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
@@ -947,9 +947,9 @@ void  OSMutexPost (OS_MUTEX  *p_mutex,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if (OSTCBCurPtr != p_mutex->OwnerTCBPtr) {                  /* Make sure the mutex owner is releasing the mutex     */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_MUTEX_POST_FAILED(p_mutex);
         OS_TRACE_MUTEX_POST_EXIT(OS_ERR_MUTEX_NOT_OWNER);
        *p_err = OS_ERR_MUTEX_NOT_OWNER;
@@ -966,7 +966,7 @@ void  OSMutexPost (OS_MUTEX  *p_mutex,
 #endif
     p_mutex->OwnerNestingCtr--;                                 /* Decrement owner's nesting counter                    */
     if (p_mutex->OwnerNestingCtr > 0u) {                        /* Are we done with all nestings?                       */
-        CPU_CRITICAL_EXIT();                                     /* No                                                   */
+        OS_CRITICAL_EXIT();                                      /* No                                                   */
         OS_TRACE_MUTEX_POST_EXIT(OS_ERR_MUTEX_NESTING);
        *p_err = OS_ERR_MUTEX_NESTING;
         return;
@@ -978,7 +978,7 @@ void  OSMutexPost (OS_MUTEX  *p_mutex,
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* Any task waiting on mutex?                           */
         p_mutex->OwnerTCBPtr     = (OS_TCB *)0;                 /* No                                                   */
         p_mutex->OwnerNestingCtr =           0u;
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_MUTEX_POST_EXIT(OS_ERR_NONE);
        *p_err = OS_ERR_NONE;
         return;
@@ -1008,7 +1008,7 @@ void  OSMutexPost (OS_MUTEX  *p_mutex,
                            0u,
                            ts);
 
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
@@ -129,6 +129,16 @@ OS_PRIO  OS_PrioGetHighest (void)
 
 void  OS_PrioInsert (OS_PRIO  prio)
 {
+#if (OS_CFG_PRIO_MAX > (2u * (CPU_CFG_DATA_SIZE * 8u)))
+    CPU_DATA  bit_nbr;
+    OS_PRIO   ix;
+#endif
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    CPU_SR_ALLOC();                                             /* OS_IntQPost() sets bit 0 from ISRs                   */
+
+
+    CPU_CRITICAL_ENTER();
+#endif
 #if   (OS_CFG_PRIO_MAX <= (CPU_CFG_DATA_SIZE * 8u))             /* Optimize for less than word size nbr of priorities   */
     OSPrioTbl[0] |= (CPU_DATA)1u << (((CPU_CFG_DATA_SIZE * 8u) - 1u) - prio);
 
@@ -142,13 +152,13 @@ void  OS_PrioInsert (OS_PRIO  prio)
 
 
 #else
-    CPU_DATA  bit_nbr;
-    OS_PRIO   ix;
-
     ix             = (OS_PRIO)(prio /  (CPU_CFG_DATA_SIZE * 8u));
     bit_nbr        = (CPU_DATA)prio & ((CPU_CFG_DATA_SIZE * 8u) - 1u);
     OSPrioTbl[ix] |= (CPU_DATA)1u << (((CPU_CFG_DATA_SIZE * 8u) - 1u) - bit_nbr);
 #endif
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    CPU_CRITICAL_EXIT();
+#endif
 }
 
 /*
@@ -167,6 +177,16 @@ void  OS_PrioInsert (OS_PRIO  prio)
 
 void  OS_PrioRemove (OS_PRIO  prio)
 {
+#if (OS_CFG_PRIO_MAX > (2u * (CPU_CFG_DATA_SIZE * 8u)))
+    CPU_DATA  bit_nbr;
+    OS_PRIO   ix;
+#endif
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    CPU_SR_ALLOC();                                             /* OS_IntQPost() sets bit 0 from ISRs                   */
+
+
+    CPU_CRITICAL_ENTER();
+#endif
 #if   (OS_CFG_PRIO_MAX <= (CPU_CFG_DATA_SIZE * 8u))             /* Optimize for less than word size nbr of priorities   */
     OSPrioTbl[0] &= ~((CPU_DATA)1u << (((CPU_CFG_DATA_SIZE * 8u) - 1u) - prio));
 
@@ -180,11 +200,11 @@ void  OS_PrioRemove (OS_PRIO  prio)
 
 
 #else
-    CPU_DATA  bit_nbr;
-    OS_PRIO   ix;
-
     ix             =   (OS_PRIO)(prio  /   (CPU_CFG_DATA_SIZE * 8u));
     bit_nbr        =   (CPU_DATA)prio  &  ((CPU_CFG_DATA_SIZE * 8u) - 1u);
     OSPrioTbl[ix] &= ~((CPU_DATA)  1u << (((CPU_CFG_DATA_SIZE * 8u) - 1u) - bit_nbr));
 #endif
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    CPU_CRITICAL_EXIT();
+#endif
 }
@@ -370,7 +370,7 @@ OS_OBJ_QTY  OSQDel (OS_Q    *p_q,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_q->PendList;
     nbr_tasks   = 0u;
     switch (opt) {
@@ -382,10 +382,10 @@ OS_OBJ_QTY  OSQDel (OS_Q    *p_q,
 #endif
                  OS_TRACE_Q_DEL(p_q);
                  OS_QClr(p_q);
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_NONE;
              } else {
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_TASK_WAITING;
              }
              break;
@@ -409,13 +409,13 @@ OS_OBJ_QTY  OSQDel (OS_Q    *p_q,
 #endif
              OS_TRACE_Q_DEL(p_q);
              OS_QClr(p_q);
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT_NO_SCHED();
              OSSched();                                         /* Find highest priority task ready to run              */
             *p_err = OS_ERR_NONE;
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_OPT_INVALID;
              break;
     }
@@ -495,9 +495,9 @@ OS_MSG_QTY  OSQFlush (OS_Q    *p_q,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     entries = OS_MsgQFreeAll(&p_q->MsgQ);                       /* Return all OS_MSGs to the OS_MSG pool                */
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
    *p_err   = OS_ERR_NONE;
     return (entries);
 }
@@ -657,27 +657,27 @@ void  *OSQPend (OS_Q         *p_q,
        *p_ts = 0u;                                              /* Initialize the returned timestamp                    */
     }
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_void = OS_MsgQGet(&p_q->MsgQ,                             /* Any message waiting in the message queue?            */
                         p_msg_size,
                         p_ts,
                         p_err);
     if (*p_err == OS_ERR_NONE) {
         OS_TRACE_Q_PEND(p_q);
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_Q_PEND_EXIT(OS_ERR_NONE);
         return (p_void);                                        /* Yes, Return message received                         */
     }
 
     if ((opt & OS_OPT_PEND_NON_BLOCKING) != 0u) {               /* Caller wants to block if not available?              */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_Q_PEND_FAILED(p_q);
         OS_TRACE_Q_PEND_EXIT(OS_ERR_PEND_WOULD_BLOCK);
        *p_err = OS_ERR_PEND_WOULD_BLOCK;                        /* No                                                   */
         return ((void *)0);
     } else {
-        if (OSSchedLockNestingCtr > 0u) {                       /* Can't pend when the scheduler is locked              */
-            CPU_CRITICAL_EXIT();
+        if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* Can't pend when the scheduler is locked              */
+            OS_CRITICAL_EXIT();
             OS_TRACE_Q_PEND_FAILED(p_q);
             OS_TRACE_Q_PEND_EXIT(OS_ERR_SCHED_LOCKED);
            *p_err = OS_ERR_SCHED_LOCKED;
@@ -689,11 +689,11 @@ void  *OSQPend (OS_Q         *p_q,
             OSTCBCurPtr,
             OS_TASK_PEND_ON_Q,
             timeout);
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_Q_PEND_BLOCK(p_q);
     OSSched();                                                  /* Find the next highest priority task ready to run     */
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     switch (OSTCBCurPtr->PendStatus) {
         case OS_STATUS_PEND_OK:                                 /* Extract message from TCB (Put there by Post)         */
              p_void     = OSTCBCurPtr->MsgPtr;
@@ -745,7 +745,7 @@ void  *OSQPend (OS_Q         *p_q,
             *p_err      = OS_ERR_STATUS_INVALID;
              break;
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_Q_PEND_EXIT(*p_err);
     return (p_void);
 }
@@ -843,10 +843,10 @@ OS_OBJ_QTY  OSQPendAbort (OS_Q    *p_q,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_q->PendList;
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* Any task waiting on queue?                           */
-        CPU_CRITICAL_EXIT();                                    /* No                                                   */
+        OS_CRITICAL_EXIT();                                     /* No                                                   */
        *p_err =  OS_ERR_PEND_ABORT_NONE;
         return (0u);
     }
@@ -867,7 +867,7 @@ OS_OBJ_QTY  OSQPendAbort (OS_Q    *p_q,
             break;                                              /* No                                                   */
         }
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
@@ -997,6 +997,20 @@ void  OSQPost (OS_Q         *p_q,
         return;
     }
 #endif
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR, the ISR handler task posts       */
+        OS_IntQPost(OS_OBJ_TYPE_Q,
+                    (void *)p_q,
+                    p_void,
+                    msg_size,
+                    0u,
+                    opt,
+                    p_err);
+        OS_TRACE_Q_POST_EXIT(*p_err);
+        return;
+    }
+#endif
+
 #if (OS_CFG_TS_EN > 0u)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
@@ -1005,7 +1019,7 @@ void  OSQPost (OS_Q         *p_q,
 
     OS_TRACE_Q_POST(p_q);
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_q->PendList;
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* Any task waiting on message queue?                   */
         if ((opt & OS_OPT_POST_LIFO) == 0u) {                   /* Determine whether we post FIFO or LIFO               */
@@ -1019,7 +1033,7 @@ void  OSQPost (OS_Q         *p_q,
                    post_type,
                    ts,
                    p_err);
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_Q_POST_EXIT(*p_err);
         return;
     }
@@ -1038,7 +1052,7 @@ void  OSQPost (OS_Q         *p_q,
         p_tcb = p_tcb_next;
     }
 
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
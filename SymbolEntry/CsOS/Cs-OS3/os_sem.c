@@ -367,7 +367,7 @@ OS_OBJ_QTY  OSSemDel (OS_SEM  *p_sem,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_sem->PendList;
     nbr_tasks   = 0u;
     switch (opt) {
@@ -379,10 +379,10 @@ OS_OBJ_QTY  OSSemDel (OS_SEM  *p_sem,
 #endif
                  OS_TRACE_SEM_DEL(p_sem);
                  OS_SemClr(p_sem);
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_NONE;
              } else {
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_TASK_WAITING;
              }
              break;
@@ -406,13 +406,13 @@ OS_OBJ_QTY  OSSemDel (OS_SEM  *p_sem,
 #endif
              OS_TRACE_SEM_DEL(p_sem);
              OS_SemClr(p_sem);
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT_NO_SCHED();
              OSSched();                                         /* Find highest priority task ready to run              */
             *p_err = OS_ERR_NONE;
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_OPT_INVALID;
              break;
     }
@@ -567,7 +567,7 @@ OS_SEM_CTR  OSSemPend (OS_SEM   *p_sem,
 #endif
 
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if (p_sem->Ctr > 0u) {                                      /* Resource available?                                  */
         p_sem->Ctr--;                                           /* Yes, caller may proceed                              */
 #if (OS_CFG_TS_EN > 0u)
@@ -577,7 +577,7 @@ OS_SEM_CTR  OSSemPend (OS_SEM   *p_sem,
 #endif
         ctr   = p_sem->Ctr;
         OS_TRACE_SEM_PEND(p_sem);
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_SEM_PEND_EXIT(OS_ERR_NONE);
        *p_err = OS_ERR_NONE;
         return (ctr);
@@ -590,19 +590,19 @@ OS_SEM_CTR  OSSemPend (OS_SEM   *p_sem,
         }
 #endif
         ctr   = p_sem->Ctr;                                     /* No                                                   */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_SEM_PEND_FAILED(p_sem);
         OS_TRACE_SEM_PEND_EXIT(OS_ERR_PEND_WOULD_BLOCK);
        *p_err = OS_ERR_PEND_WOULD_BLOCK;
         return (ctr);
     } else {                                                    /* Yes                                                  */
-        if (OSSchedLockNestingCtr > 0u) {                       /* Can't pend when the scheduler is locked              */
+        if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* Can't pend when the scheduler is locked              */
 #if (OS_CFG_TS_EN > 0u)
             if (p_ts != (CPU_TS *)0) {
                *p_ts = 0u;
             }
 #endif
-            CPU_CRITICAL_EXIT();
+            OS_CRITICAL_EXIT();
             OS_TRACE_SEM_PEND_FAILED(p_sem);
             OS_TRACE_SEM_PEND_EXIT(OS_ERR_SCHED_LOCKED);
            *p_err = OS_ERR_SCHED_LOCKED;
@@ -614,11 +614,11 @@ OS_SEM_CTR  OSSemPend (OS_SEM   *p_sem,
             OSTCBCurPtr,
             OS_TASK_PEND_ON_SEM,
             timeout);
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_SEM_PEND_BLOCK(p_sem);
     OSSched();                                                  /* Find the next highest priority task ready to run     */
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     switch (OSTCBCurPtr->PendStatus) {
         case OS_STATUS_PEND_OK:                                 /* We got the semaphore                                 */
 #if (OS_CFG_TS_EN > 0u)
@@ -663,12 +663,12 @@ OS_SEM_CTR  OSSemPend (OS_SEM   *p_sem,
         default:
              OS_TRACE_SEM_PEND_FAILED(p_sem);
             *p_err = OS_ERR_STATUS_INVALID;
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              OS_TRACE_SEM_PEND_EXIT(*p_err);
              return (0u);
     }
     ctr = p_sem->Ctr;
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_SEM_PEND_EXIT(*p_err);
     return (ctr);
 }
@@ -766,10 +766,10 @@ OS_OBJ_QTY  OSSemPendAbort (OS_SEM  *p_sem,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_sem->PendList;
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* Any task waiting on semaphore?                       */
-        CPU_CRITICAL_EXIT();                                    /* No                                                   */
+        OS_CRITICAL_EXIT();                                     /* No                                                   */
        *p_err =  OS_ERR_PEND_ABORT_NONE;
         return (0u);
     }
@@ -790,7 +790,7 @@ OS_OBJ_QTY  OSSemPendAbort (OS_SEM  *p_sem,
             break;                                              /* No                                                   */
         }
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
@@ -893,6 +893,20 @@ OS_SEM_CTR  OSSemPost (OS_SEM  *p_sem,
         return (0u);
     }
 #endif
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR, the ISR handler task posts       */
+        OS_IntQPost(OS_OBJ_TYPE_SEM,
+                    (void *)p_sem,
+                    (void *)0,
+                    0u,
+                    0u,
+                    opt,
+                    p_err);
+        OS_TRACE_SEM_POST_EXIT(*p_err);
+        return (0u);
+    }
+#endif
+
 #if (OS_CFG_TS_EN > 0u)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
@@ -900,11 +914,11 @@ OS_SEM_CTR  OSSemPost (OS_SEM  *p_sem,
 #endif
 
     OS_TRACE_SEM_POST(p_sem);
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_pend_list = &p_sem->PendList;
     if (p_pend_list->HeadPtr == (OS_TCB *)0) {                  /* Any task waiting on semaphore?                       */
         if (p_sem->Ctr == (OS_SEM_CTR)-1) {
-           CPU_CRITICAL_EXIT();
+           OS_CRITICAL_EXIT();
           *p_err = OS_ERR_SEM_OVF;
            OS_TRACE_SEM_POST_EXIT(*p_err);
            return (0u);
@@ -914,7 +928,7 @@ OS_SEM_CTR  OSSemPost (OS_SEM  *p_sem,
 #if (OS_CFG_TS_EN > 0u)
         p_sem->TS = ts;                                         /* Save timestamp in semaphore control block            */
 #endif
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
        *p_err     = OS_ERR_NONE;
         OS_TRACE_SEM_POST_EXIT(*p_err);
         return (ctr);
@@ -933,7 +947,7 @@ OS_SEM_CTR  OSSemPost (OS_SEM  *p_sem,
         }
         p_tcb = p_tcb_next;
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
     }
@@ -1010,7 +1024,7 @@ void  OSSemSet (OS_SEM      *p_sem,
 #endif
 
    *p_err = OS_ERR_NONE;
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if (p_sem->Ctr > 0u) {                                      /* See if semaphore already has a count                 */
         p_sem->Ctr = cnt;                                       /* Yes, set it to the new value specified.              */
     } else {
@@ -1021,7 +1035,7 @@ void  OSSemSet (OS_SEM      *p_sem,
            *p_err      = OS_ERR_TASK_WAITING;
         }
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 }
 #endif
 
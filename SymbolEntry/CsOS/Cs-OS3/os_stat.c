@@ -144,6 +144,10 @@ void  OSStatReset (OS_ERR  *p_err)
         p_tcb->CPUUsageMax      = 0u;
         p_tcb->CyclesTotal      = 0u;
         p_tcb->CyclesTotalPrev  = 0u;
+        p_tcb->CyclesRun        = 0u;
+        p_tcb->CyclesBurstMax   = 0u;
+        p_tcb->CtxSwOutCtr      = 0u;
+        p_tcb->RdyToRunMax      = 0u;
 #if (OS_CFG_TS_EN > 0u)
         p_tcb->CyclesStart      = OS_TS_GET();
 #endif
@@ -321,9 +325,11 @@ void  OS_StatTask (void  *p_arg)
     CPU_TS       ts_start;
 #endif
 #if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u) && (OS_CFG_ISR_STK_SIZE > 0u)
+#if (OS_CFG_STAT_TASK_STK_CHK_WORDS == 0u)
     CPU_STK     *p_stk;
-    CPU_INT32U   free_stk;
     CPU_INT32U   size_stk;
+#endif
+    CPU_INT32U   free_stk;
 #endif
     CPU_SR_ALLOC();
 
@@ -450,10 +456,15 @@ void  OS_StatTask (void  *p_arg)
 #endif
 
 #if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u)
+#if (OS_CFG_STAT_TASK_STK_CHK_WORDS > 0u)
+            OS_StatTaskStkScan(p_tcb,                           /* Continue the stack usage pass of active tasks only   */
+                               OS_CFG_STAT_TASK_STK_CHK_WORDS);
+#else
             OSTaskStkChk( p_tcb,                                /* Compute stack usage of active tasks only             */
                          &p_tcb->StkFree,
                          &p_tcb->StkUsed,
                          &err);
+#endif
 #endif
 
             CPU_CRITICAL_ENTER();
@@ -464,6 +475,18 @@ void  OS_StatTask (void  *p_arg)
 
                                                                 /*------------------ Check ISR Stack -------------------*/
 #if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u) && (OS_CFG_ISR_STK_SIZE > 0u)
+#if (OS_CFG_STAT_TASK_STK_CHK_WORDS > 0u)
+        if ((OSISRStkFree == 0u) && (OSISRStkUsed == 0u)) {     /*   Never checked, the first pass starts at the top    */
+            free_stk = OSCfg_ISRStkSize;
+        } else {
+            free_stk = OSISRStkFree;
+        }
+        free_stk  = (CPU_INT32U)OS_StatStkScan(OSCfg_ISRStkBasePtr,
+                                               OSCfg_ISRStkSize,
+                                               free_stk,
+                                              &OSISRStkScanIx,
+                                               OS_CFG_STAT_TASK_STK_CHK_WORDS);
+#else
         free_stk  = 0u;
 #if (CPU_CFG_STK_GROWTH == CPU_STK_GROWTH_HI_TO_LO)
         p_stk     = OSCfg_ISRStkBasePtr;                        /*   Start at the lowest memory and go up               */
@@ -489,6 +512,7 @@ void  OS_StatTask (void  *p_arg)
             free_stk++;
             p_stk--;
         }
+#endif
 #endif
         OSISRStkFree = free_stk;
         OSISRStkUsed = OSCfg_ISRStkSize - free_stk;
@@ -544,6 +568,7 @@ void  OS_StatTaskInit (OS_ERR  *p_err)
 #if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u) && (OS_CFG_ISR_STK_SIZE > 0u)
     OSISRStkFree     = 0u;
     OSISRStkUsed     = 0u;
+    OSISRStkScanIx   = 0u;
 #endif
                                                                 /* --------------- CREATE THE STAT TASK --------------- */
     if (OSCfg_StatTaskStkBasePtr == (CPU_STK *)0) {
@@ -580,4 +605,135 @@ void  OS_StatTaskInit (OS_ERR  *p_err)
                   p_err);
 }
 
+
+/*
+************************************************************************************************************************
+*                                            CONTINUE A STACK USAGE PASS
+*
+* Description: This function checks up to 'words' more entries of a stack for the statistic task.  A pass starts just
+*              below the last high-water mark and goes down toward the base of the stack, one call at a time.  Any used
+*              (non-zero) entry it finds moves the mark down.
+*
+* Argument(s): p_base     is the base of the stack, as passed to OSTaskCreate().
+*
+*              stk_size   is the size of the stack (number of CPU_STK elements).
+*
+*              free_stk   is the number of free entries found so far, the stack size if it was never checked.
+*
+*              p_ix       is the number of entries the pass in progress has left to check, 0 to start a new pass.
+*
+*              words      is the most entries to check in this call.
+*
+* Returns    : The number of free entries, between the base (after the redzone) and the lowest used entry found.
+*
+* Note(s)    : 1) The mark only ever moves toward the base, so only the entries below it are checked again.  Once a pass
+*                 ends, the result matches OSTaskStkChk() as of the start of that pass, as long as the used entries
+*                 found have not been set back to zero.
+*
+*              2) This function is INTERNAL to Cs/OS3 and your application should not call it.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u)
+CPU_STK_SIZE  OS_StatStkScan (CPU_STK       *p_base,
+                              CPU_STK_SIZE   stk_size,
+                              CPU_STK_SIZE   free_stk,
+                              CPU_STK_SIZE  *p_ix,
+                              CPU_STK_SIZE   words)
+{
+    CPU_STK       *p_stk;
+    CPU_STK_SIZE   ix;
+
+
+#if (OS_CFG_TASK_STK_REDZONE_EN > 0u)
+    stk_size -= OS_CFG_TASK_STK_REDZONE_DEPTH;
+#endif
+#if (CPU_CFG_STK_GROWTH == CPU_STK_GROWTH_HI_TO_LO)
+    p_stk     = p_base;                                         /* Entry 0 is at the lowest memory                      */
+#if (OS_CFG_TASK_STK_REDZONE_EN > 0u)
+    p_stk    += OS_CFG_TASK_STK_REDZONE_DEPTH;
+#endif
+#else
+    p_stk     = p_base + stk_size - 1u;                         /* Entry 0 is at the highest memory                     */
+#endif
+
+    if (free_stk > stk_size) {
+        free_stk = stk_size;
+    }
+    ix = *p_ix;
+    if (ix == 0u) {                                             /* Start a new pass just below the mark                 */
+        ix = free_stk;
+    }
+
+    while ((words > 0u) && (ix > 0u)) {                         /* Go down toward the base                              */
+        ix--;
+        words--;
+#if (CPU_CFG_STK_GROWTH == CPU_STK_GROWTH_HI_TO_LO)
+        if (*(p_stk + ix) != 0u) {
+#else
+        if (*(p_stk - ix) != 0u) {
+#endif
+            free_stk = ix;                                      /* Used entry, below the mark                           */
+        }
+    }
+   *p_ix = ix;
+    return (free_stk);
+}
+
+
+/*
+************************************************************************************************************************
+*                                         CONTINUE A TASK'S STACK USAGE PASS
+*
+* Description: This function is called by OS_StatTask() to update a task's .StkFree and .StkUsed, checking up to 'words'
+*              entries of its stack with OS_StatStkScan().  The pass in progress is kept in .StkScanIx.
+*
+* Argument(s): p_tcb      is a pointer to the TCB of the task.
+*
+*              words      is the most entries to check in this call.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Tasks that don't exist or were created without OS_OPT_TASK_STK_CHK are skipped.
+*
+*              2) The stack is checked with interrupts enabled, as in OSTaskStkChk().
+*
+*              3) This function is INTERNAL to Cs/OS3 and your application should not call it.
+************************************************************************************************************************
+*/
+
+void  OS_StatTaskStkScan (OS_TCB        *p_tcb,
+                          CPU_STK_SIZE   words)
+{
+    CPU_STK       *p_base;
+    CPU_STK_SIZE   stk_size;
+    CPU_STK_SIZE   free_stk;
+    CPU_STK_SIZE   ix;
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    if ((p_tcb->StkPtr == (CPU_STK *)0) ||                      /* Make sure task exist and its stack can be checked    */
+        ((p_tcb->Opt & OS_OPT_TASK_STK_CHK) == 0u)) {
+        CPU_CRITICAL_EXIT();
+        return;
+    }
+    p_base   = p_tcb->StkBasePtr;
+    stk_size = p_tcb->StkSize;
+    if ((p_tcb->StkFree == 0u) && (p_tcb->StkUsed == 0u)) {     /* Never checked, the first pass starts at the top      */
+        free_stk = stk_size;
+    } else {
+        free_stk = p_tcb->StkFree;
+    }
+    ix       = p_tcb->StkScanIx;
+    CPU_CRITICAL_EXIT();
+
+    free_stk = OS_StatStkScan(p_base, stk_size, free_stk, &ix, words);
+
+    p_tcb->StkScanIx = ix;                                      /* Only the statistic task writes these                 */
+    p_tcb->StkFree   = free_stk;
+    p_tcb->StkUsed   = stk_size - free_stk;                     /* Compute number of entries used on the stack          */
+}
+#endif
+
 #endif
@@ -107,11 +107,18 @@ void  OSTaskChangePrio (OS_TCB   *p_tcb,
         return;
     }
 
-    CPU_CRITICAL_ENTER();
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (prio_new == 0u) {                                       /* Cannot set to ISR handler task priority              */
+       *p_err = OS_ERR_PRIO_INVALID;
+        return;
+    }
+#endif
+
+    OS_CRITICAL_ENTER();
 
     if (p_tcb == (OS_TCB *)0) {                                 /* Are we changing the priority of 'self'?              */
         if (OSRunning != OS_STATE_OS_RUNNING) {
-            CPU_CRITICAL_EXIT();
+            OS_CRITICAL_EXIT();
            *p_err = OS_ERR_OS_NOT_RUNNING;
             return;
         }
@@ -134,7 +141,7 @@ void  OSTaskChangePrio (OS_TCB   *p_tcb,
     OS_TaskChangePrio(p_tcb, prio_new);
 
     OS_TRACE_TASK_PRIO_CHANGE(p_tcb, prio_new);
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
     if (OSRunning == OS_STATE_OS_RUNNING) {
         OSSched();                                              /* Run highest priority task ready                      */
@@ -324,6 +331,16 @@ void  OSTaskCreate (OS_TCB        *p_tcb,
         }
     }
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (prio == 0u) {
+        if (p_tcb != &OSIntQTaskTCB) {
+            OS_TRACE_TASK_CREATE_FAILED(p_tcb);
+           *p_err = OS_ERR_PRIO_INVALID;                        /* Priority 0 is reserved for the ISR handler task      */
+            return;
+        }
+    }
+#endif
+
     OS_TaskInitTCB(p_tcb);                                      /* Initialize the TCB to default values                 */
 
    *p_err = OS_ERR_NONE;
@@ -533,6 +550,13 @@ void  OSTaskDel (OS_TCB  *p_tcb,
         return;
     }
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (p_tcb == &OSIntQTaskTCB) {                              /* Not allowed to delete the ISR handler task           */
+       *p_err = OS_ERR_TASK_DEL_INVALID;
+        return;
+    }
+#endif
+
     if (p_tcb == (OS_TCB *)0) {                                 /* Delete 'Self'?                                       */
         CPU_CRITICAL_ENTER();
         p_tcb = OSTCBCurPtr;                                    /* Yes.                                                 */
@@ -656,6 +680,90 @@ void  OSTaskDel (OS_TCB  *p_tcb,
 }
 #endif
 
+/*
+************************************************************************************************************************
+*                                                 GET A TASK'S PROFILE
+*
+* Description: This function takes a consistent snapshot of the run time statistics OSTaskSwHook() keeps for a task.
+*              Unlike .CPUUsage, which the statistic task recomputes every period, these accumulate from the creation
+*              of the task (or the last OSStatReset()).
+*
+* Arguments  : p_tcb       is a pointer to the TCB of the task.  If you specify a NULL pointer then you are specifying
+*                          the current task.
+*
+*              p_prof      is a pointer to the OS_TASK_PROFILE to fill in:
+*
+*                              .Prio             The task's priority
+*                              .CyclesRun        The timestamp counts it has been running, in all
+*                              .CtxSwInCtr       The number of times it was switched in
+*                              .CtxSwOutCtr      The number of times it was switched out
+*                              .CyclesBurstMax   The longest it ran from a switch in to the next switch out
+*                              .RdyToRunMax      The longest from being made ready (or preempted) to running
+*
+*              p_err       is a pointer to a variable that will contain an error code returned by this function.
+*
+*                              OS_ERR_NONE               Upon success
+*                              OS_ERR_PTR_INVALID        If 'p_prof' is a NULL pointer
+*                              OS_ERR_TASK_NOT_EXIST     If the task was deleted
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are disabled only for the copy, so this may be called at any rate.  Keeping the statistics
+*                 costs a constant time per context switch, see OSTaskSwHook(), and one timestamp read each time a
+*                 task is made ready, see OS_RdyListInsert().
+*
+*              2) Times are in CPU_TS counts, see CPU_TS_TmrFreqGet().  For a task readied from an ISR, .RdyToRunMax
+*                 starts at the post, not at the interrupt request.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_TASK_PROFILE_EN > 0u)
+void  OSTaskProfileGet (OS_TCB           *p_tcb,
+                        OS_TASK_PROFILE  *p_prof,
+                        OS_ERR           *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#if (OS_CFG_ARG_CHK_EN > 0u)
+    if (p_prof == (OS_TASK_PROFILE *)0) {                       /* User must specify a valid destination                */
+       *p_err = OS_ERR_PTR_INVALID;
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    if (p_tcb == (OS_TCB *)0) {                                 /* Profile of the current task?                         */
+        p_tcb = OSTCBCurPtr;                                    /* Yes                                                  */
+    }
+
+    if (p_tcb->TaskState == OS_TASK_STATE_DEL) {                /* Make sure task exist                                 */
+        CPU_CRITICAL_EXIT();
+       *p_err = OS_ERR_TASK_NOT_EXIST;
+        return;
+    }
+
+    p_prof->Prio           = p_tcb->Prio;
+    p_prof->CyclesRun      = p_tcb->CyclesRun;
+    p_prof->CtxSwInCtr     = p_tcb->CtxSwCtr;
+    p_prof->CtxSwOutCtr    = p_tcb->CtxSwOutCtr;
+    p_prof->CyclesBurstMax = p_tcb->CyclesBurstMax;
+    p_prof->RdyToRunMax    = p_tcb->RdyToRunMax;
+    if (p_tcb == OSTCBCurPtr) {                                 /* Count the current task's run up to now               */
+        p_prof->CyclesRun += (CPU_INT64U)(OS_TS_GET() - p_tcb->CyclesStart);
+    }
+    CPU_CRITICAL_EXIT();
+   *p_err = OS_ERR_NONE;
+}
+#endif
+
 
 /*
 ************************************************************************************************************************
@@ -711,14 +819,14 @@ OS_MSG_QTY  OSTaskQFlush (OS_TCB  *p_tcb,
 #endif
 
     if (p_tcb == (OS_TCB *)0) {                                 /* Flush message queue of calling task?                 */
-        CPU_CRITICAL_ENTER();
+        OS_CRITICAL_ENTER();
         p_tcb = OSTCBCurPtr;
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
     }
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     entries = OS_MsgQFreeAll(&p_tcb->MsgQ);                     /* Return all OS_MSGs to the OS_MSG pool                */
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
    *p_err   = OS_ERR_NONE;
     return (entries);
 }
@@ -848,7 +956,7 @@ void  *OSTaskQPend (OS_TICK       timeout,
        *p_ts = 0u;                                              /* Initialize the returned timestamp                    */
     }
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     p_msg_q = &OSTCBCurPtr->MsgQ;                               /* Any message waiting in the message queue?            */
     p_void  = OS_MsgQGet(p_msg_q,
                          p_msg_size,
@@ -866,20 +974,20 @@ void  *OSTaskQPend (OS_TICK       timeout,
 #endif
 #endif
         OS_TRACE_TASK_MSG_Q_PEND(p_msg_q);
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_TASK_MSG_Q_PEND_EXIT(OS_ERR_NONE);
         return (p_void);                                        /* Yes, Return oldest message received                  */
     }
 
     if ((opt & OS_OPT_PEND_NON_BLOCKING) != 0u) {               /* Caller wants to block if not available?              */
        *p_err = OS_ERR_PEND_WOULD_BLOCK;                        /* No                                                   */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_TASK_MSG_Q_PEND_FAILED(p_msg_q);
         OS_TRACE_TASK_MSG_Q_PEND_EXIT(OS_ERR_PEND_WOULD_BLOCK);
         return ((void *)0);
     } else {                                                    /* Yes                                                  */
-        if (OSSchedLockNestingCtr > 0u) {                       /* Can't block when the scheduler is locked             */
-            CPU_CRITICAL_EXIT();
+        if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* Can't block when the scheduler is locked             */
+            OS_CRITICAL_EXIT();
             OS_TRACE_TASK_MSG_Q_PEND_FAILED(p_msg_q);
             OS_TRACE_TASK_MSG_Q_PEND_EXIT(OS_ERR_SCHED_LOCKED);
            *p_err = OS_ERR_SCHED_LOCKED;
@@ -891,11 +999,11 @@ void  *OSTaskQPend (OS_TICK       timeout,
              OSTCBCurPtr,
              OS_TASK_PEND_ON_TASK_Q,
              timeout);
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_TASK_MSG_Q_PEND_BLOCK(p_msg_q);
     OSSched();                                                  /* Find the next highest priority task ready to run     */
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     switch (OSTCBCurPtr->PendStatus) {
         case OS_STATUS_PEND_OK:                                 /* Extract message from TCB (Put there by Post)         */
              p_void      = OSTCBCurPtr->MsgPtr;
@@ -938,7 +1046,7 @@ void  *OSTaskQPend (OS_TICK       timeout,
             *p_err      =  OS_ERR_TIMEOUT;
              break;
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_TASK_MSG_Q_PEND_EXIT(*p_err);
     return (p_void);                                            /* Return received message                              */
 }
@@ -1018,18 +1126,18 @@ CPU_BOOLEAN  OSTaskQPendAbort (OS_TCB  *p_tcb,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
 #if (OS_CFG_ARG_CHK_EN > 0u)
     if ((p_tcb == (OS_TCB *)0) ||                               /* Pend abort self?                                     */
         (p_tcb == OSTCBCurPtr)) {
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
        *p_err = OS_ERR_PEND_ABORT_SELF;                         /* ... doesn't make sense                               */
         return (OS_FALSE);
     }
 #endif
 
     if (p_tcb->PendOn != OS_TASK_PEND_ON_TASK_Q) {              /* Is task waiting for a message?                       */
-        CPU_CRITICAL_EXIT();                                    /* No                                                   */
+        OS_CRITICAL_EXIT();                                     /* No                                                   */
        *p_err = OS_ERR_PEND_ABORT_NONE;
         return (OS_FALSE);
     }
@@ -1042,7 +1150,7 @@ CPU_BOOLEAN  OSTaskQPendAbort (OS_TCB  *p_tcb,
     OS_PendAbort(p_tcb,                                         /* Abort the pend                                       */
                  ts,
                  OS_STATUS_PEND_ABORT);
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
     }
@@ -1137,6 +1245,20 @@ void  OSTaskQPost (OS_TCB       *p_tcb,
     }
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR, the ISR handler task posts       */
+        OS_IntQPost(OS_OBJ_TYPE_TASK_MSG,
+                    (p_tcb != (OS_TCB *)0) ? (void *)p_tcb : (void *)OSTCBCurPtr,
+                    p_void,
+                    msg_size,
+                    0u,
+                    opt,
+                    p_err);
+        OS_TRACE_TASK_MSG_Q_POST_EXIT(*p_err);
+        return;
+    }
+#endif
+
 #if (OS_CFG_TS_EN > 0u)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
@@ -1146,7 +1268,7 @@ void  OSTaskQPost (OS_TCB       *p_tcb,
     OS_TRACE_TASK_MSG_Q_POST(&p_tcb->MsgQ);
 
    *p_err = OS_ERR_NONE;                                        /* Assume we won't have any errors                      */
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if (p_tcb == (OS_TCB *)0) {                                 /* Post msg to 'self'?                                  */
         p_tcb = OSTCBCurPtr;
     }
@@ -1161,7 +1283,7 @@ void  OSTaskQPost (OS_TCB       *p_tcb,
                         opt,
                         ts,
                         p_err);
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         case OS_TASK_STATE_PEND:
@@ -1174,7 +1296,7 @@ void  OSTaskQPost (OS_TCB       *p_tcb,
                           p_void,
                           msg_size,
                           ts);
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                  if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
                      OSSched();                                 /* Run the scheduler                                    */
                  }
@@ -1185,12 +1307,12 @@ void  OSTaskQPost (OS_TCB       *p_tcb,
                             opt,
                             ts,
                             p_err);
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
              }
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_STATE_INVALID;
              break;
     }
@@ -1431,25 +1553,25 @@ void  OSTaskResume (OS_TCB  *p_tcb,
 
 
 #if (OS_CFG_ARG_CHK_EN > 0u)
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if ((p_tcb == (OS_TCB *)0) ||                               /* We cannot resume 'self'                              */
         (p_tcb == OSTCBCurPtr)) {
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
        *p_err = OS_ERR_TASK_RESUME_SELF;
         OS_TRACE_TASK_RESUME_EXIT(OS_ERR_TASK_RESUME_SELF);
         return;
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
    *p_err = OS_ERR_NONE;
     switch (p_tcb->TaskState) {
         case OS_TASK_STATE_RDY:
         case OS_TASK_STATE_DLY:
         case OS_TASK_STATE_PEND:
         case OS_TASK_STATE_PEND_TIMEOUT:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_TASK_NOT_SUSPENDED;
              OS_TRACE_TASK_RESUME_EXIT(OS_ERR_TASK_NOT_SUSPENDED);
              break;
@@ -1461,7 +1583,7 @@ void  OSTaskResume (OS_TCB  *p_tcb,
                  OS_RdyListInsert(p_tcb);                       /* Insert the task in the ready list                    */
                  OS_TRACE_TASK_RESUME(p_tcb);
              }
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         case OS_TASK_STATE_DLY_SUSPENDED:
@@ -1469,7 +1591,7 @@ void  OSTaskResume (OS_TCB  *p_tcb,
              if (p_tcb->SuspendCtr == 0u) {
                  p_tcb->TaskState = OS_TASK_STATE_DLY;
              }
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         case OS_TASK_STATE_PEND_SUSPENDED:
@@ -1477,7 +1599,7 @@ void  OSTaskResume (OS_TCB  *p_tcb,
              if (p_tcb->SuspendCtr == 0u) {
                  p_tcb->TaskState = OS_TASK_STATE_PEND;
              }
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         case OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED:
@@ -1485,11 +1607,11 @@ void  OSTaskResume (OS_TCB  *p_tcb,
              if (p_tcb->SuspendCtr == 0u) {
                  p_tcb->TaskState = OS_TASK_STATE_PEND_TIMEOUT;
              }
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_STATE_INVALID;
              OS_TRACE_TASK_RESUME_EXIT(OS_ERR_STATE_INVALID);
              break;
@@ -1614,7 +1736,7 @@ OS_SEM_CTR  OSTaskSemPend (OS_TICK   timeout,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if (OSTCBCurPtr->SemCtr > 0u) {                             /* See if task already been signaled                    */
         OSTCBCurPtr->SemCtr--;
         ctr = OSTCBCurPtr->SemCtr;
@@ -1632,14 +1754,14 @@ OS_SEM_CTR  OSTaskSemPend (OS_TICK   timeout,
 #endif
 #endif
         OS_TRACE_TASK_SEM_PEND(OSTCBCurPtr);
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
         OS_TRACE_TASK_SEM_PEND_EXIT(OS_ERR_NONE);
        *p_err = OS_ERR_NONE;
         return (ctr);
     }
 
     if ((opt & OS_OPT_PEND_NON_BLOCKING) != 0u) {               /* Caller wants to block if not available?              */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
 #if (OS_CFG_TS_EN > 0u)
         if (p_ts != (CPU_TS *)0) {
             *p_ts  = 0u;
@@ -1650,13 +1772,13 @@ OS_SEM_CTR  OSTaskSemPend (OS_TICK   timeout,
        *p_err = OS_ERR_PEND_WOULD_BLOCK;                        /* No                                                   */
         return (0u);
     } else {                                                    /* Yes                                                  */
-        if (OSSchedLockNestingCtr > 0u) {                       /* Can't pend when the scheduler is locked              */
+        if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* Can't pend when the scheduler is locked              */
 #if (OS_CFG_TS_EN > 0u)
             if (p_ts != (CPU_TS *)0) {
                *p_ts  = 0u;
             }
 #endif
-            CPU_CRITICAL_EXIT();
+            OS_CRITICAL_EXIT();
             OS_TRACE_TASK_SEM_PEND_FAILED(OSTCBCurPtr);
             OS_TRACE_TASK_SEM_PEND_EXIT(OS_ERR_SCHED_LOCKED);
            *p_err = OS_ERR_SCHED_LOCKED;
@@ -1668,11 +1790,11 @@ OS_SEM_CTR  OSTaskSemPend (OS_TICK   timeout,
              OSTCBCurPtr,
              OS_TASK_PEND_ON_TASK_SEM,
              timeout);
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_TASK_SEM_PEND_BLOCK(OSTCBCurPtr);
     OSSched();                                                  /* Find next highest priority task ready to run         */
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     switch (OSTCBCurPtr->PendStatus) {                          /* See if we timed-out or aborted                       */
         case OS_STATUS_PEND_OK:
 #if (OS_CFG_TS_EN > 0u)
@@ -1718,7 +1840,7 @@ OS_SEM_CTR  OSTaskSemPend (OS_TICK   timeout,
              break;
     }
     ctr = OSTCBCurPtr->SemCtr;
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     OS_TRACE_TASK_SEM_PEND_EXIT(*p_err);
     return (ctr);
 }
@@ -1799,22 +1921,22 @@ CPU_BOOLEAN  OSTaskSemPendAbort (OS_TCB  *p_tcb,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if ((p_tcb == (OS_TCB *)0) ||                               /* Pend abort self?                                     */
         (p_tcb == OSTCBCurPtr)) {
-        CPU_CRITICAL_EXIT();                                    /* ... doesn't make sense!                              */
+        OS_CRITICAL_EXIT();                                     /* ... doesn't make sense!                              */
        *p_err = OS_ERR_PEND_ABORT_SELF;
         return (OS_FALSE);
     }
 
     if (p_tcb->PendOn != OS_TASK_PEND_ON_TASK_SEM) {            /* Is task waiting for a signal?                        */
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
        *p_err = OS_ERR_PEND_ABORT_NONE;
         return (OS_FALSE);
     }
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
 #if (OS_CFG_TS_EN > 0u)
     ts = OS_TS_GET();
 #else
@@ -1823,7 +1945,7 @@ CPU_BOOLEAN  OSTaskSemPendAbort (OS_TCB  *p_tcb,
     OS_PendAbort(p_tcb,                                         /* Abort the pend                                       */
                  ts,
                  OS_STATUS_PEND_ABORT);
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
     if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
         OSSched();                                              /* Run the scheduler                                    */
     }
@@ -1902,6 +2024,20 @@ OS_SEM_CTR  OSTaskSemPost (OS_TCB  *p_tcb,
     }
 #endif
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR, the ISR handler task posts       */
+        OS_IntQPost(OS_OBJ_TYPE_TASK_SIGNAL,
+                    (p_tcb != (OS_TCB *)0) ? (void *)p_tcb : (void *)OSTCBCurPtr,
+                    (void *)0,
+                    0u,
+                    0u,
+                    opt,
+                    p_err);
+        OS_TRACE_TASK_SEM_POST_EXIT(*p_err);
+        return (0u);
+    }
+#endif
+
 #if (OS_CFG_TS_EN > 0u)
     ts = OS_TS_GET();                                           /* Get timestamp                                        */
 #else
@@ -1910,7 +2046,7 @@ OS_SEM_CTR  OSTaskSemPost (OS_TCB  *p_tcb,
 
     OS_TRACE_TASK_SEM_POST(p_tcb);
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if (p_tcb == (OS_TCB *)0) {                                 /* Post signal to 'self'?                               */
         p_tcb = OSTCBCurPtr;
     }
@@ -1924,14 +2060,14 @@ OS_SEM_CTR  OSTaskSemPost (OS_TCB  *p_tcb,
         case OS_TASK_STATE_SUSPENDED:
         case OS_TASK_STATE_DLY_SUSPENDED:
              if (p_tcb->SemCtr == (OS_SEM_CTR)-1) {
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_SEM_OVF;
                  OS_TRACE_SEM_POST_EXIT(*p_err);
                  return (0u);
              }
              p_tcb->SemCtr++;                                   /* Task signaled is not pending on anything             */
              ctr = p_tcb->SemCtr;
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         case OS_TASK_STATE_PEND:
@@ -1945,25 +2081,25 @@ OS_SEM_CTR  OSTaskSemPost (OS_TCB  *p_tcb,
                           0u,
                           ts);
                  ctr = p_tcb->SemCtr;
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                  if ((opt & OS_OPT_POST_NO_SCHED) == 0u) {
                      OSSched();                                 /* Run the scheduler                                    */
                  }
              } else {
                  if (p_tcb->SemCtr == (OS_SEM_CTR)-1) {
-                     CPU_CRITICAL_EXIT();
+                     OS_CRITICAL_EXIT();
                     *p_err = OS_ERR_SEM_OVF;
                      OS_TRACE_SEM_POST_EXIT(*p_err);
                      return (0u);
                  }
                  p_tcb->SemCtr++;                               /* No,  Task signaled is NOT pending on semaphore ...   */
                  ctr = p_tcb->SemCtr;                           /* ... it must be waiting on something else             */
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
              }
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_STATE_INVALID;
              ctr   = 0u;
              break;
@@ -2021,21 +2157,21 @@ OS_SEM_CTR  OSTaskSemSet (OS_TCB      *p_tcb,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if (p_tcb == (OS_TCB *)0) {
         p_tcb = OSTCBCurPtr;
     }
 
     if (((p_tcb->TaskState   & OS_TASK_STATE_PEND) != 0u) &&    /* Not allowed when a task is waiting.                  */
          (p_tcb->PendOn == OS_TASK_PEND_ON_TASK_SEM)) {
-        CPU_CRITICAL_EXIT();
+        OS_CRITICAL_EXIT();
        *p_err = OS_ERR_TASK_WAITING;
         return (0u);
     }
 
     ctr           =  p_tcb->SemCtr;
     p_tcb->SemCtr = (OS_SEM_CTR)cnt;
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT();
    *p_err         =  OS_ERR_NONE;
     return (ctr);
 }
@@ -2223,8 +2359,8 @@ CPU_BOOLEAN  OSTaskStkRedzoneChk (OS_TCB  *p_tcb)
 *                           OS_ERR_TASK_SUSPEND_ISR            If you called this function from an ISR
 *                           OS_ERR_TASK_SUSPEND_IDLE           If you attempted to suspend the idle task which is not
 *                                                                  allowed
-*                           OS_ERR_TASK_SUSPEND_INT_HANDLER    If you attempted to suspend the idle task which is not
-*                                                                  allowed
+*                           OS_ERR_TASK_SUSPEND_INT_HANDLER    If you attempted to suspend the ISR handler task which is
+*                                                                  not allowed
 *
 * Returns    : none
 *
@@ -2264,10 +2400,18 @@ void   OSTaskSuspend (OS_TCB  *p_tcb,
         return;
     }
 
-    CPU_CRITICAL_ENTER();
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (p_tcb == &OSIntQTaskTCB) {                              /* Not allowed to suspend the ISR handler task          */
+       *p_err = OS_ERR_TASK_SUSPEND_INT_HANDLER;
+        OS_TRACE_TASK_SUSPEND_EXIT(OS_ERR_TASK_SUSPEND_INT_HANDLER);
+        return;
+    }
+#endif
+
+    OS_CRITICAL_ENTER();
     if (p_tcb == (OS_TCB *)0) {                                 /* See if specified to suspend self                     */
         if (OSRunning != OS_STATE_OS_RUNNING) {                 /* Can't suspend self when the kernel isn't running     */
-            CPU_CRITICAL_EXIT();
+            OS_CRITICAL_EXIT();
            *p_err = OS_ERR_OS_NOT_RUNNING;
             OS_TRACE_TASK_SUSPEND_EXIT(OS_ERR_OS_NOT_RUNNING);
             return;
@@ -2276,8 +2420,8 @@ void   OSTaskSuspend (OS_TCB  *p_tcb,
     }
 
     if (p_tcb == OSTCBCurPtr) {
-        if (OSSchedLockNestingCtr > 0u) {                       /* Can't suspend when the scheduler is locked           */
-            CPU_CRITICAL_EXIT();
+        if (OSSchedLockNestingCtr > OS_CRITICAL_LOCK_NESTING) { /* Can't suspend when the scheduler is locked           */
+            OS_CRITICAL_EXIT();
            *p_err = OS_ERR_SCHED_LOCKED;
             OS_TRACE_TASK_SUSPEND_EXIT(OS_ERR_SCHED_LOCKED);
             return;
@@ -2291,25 +2435,25 @@ void   OSTaskSuspend (OS_TCB  *p_tcb,
              p_tcb->SuspendCtr = 1u;
              OS_RdyListRemove(p_tcb);
              OS_TRACE_TASK_SUSPEND(p_tcb);
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         case OS_TASK_STATE_DLY:
              p_tcb->TaskState  = OS_TASK_STATE_DLY_SUSPENDED;
              p_tcb->SuspendCtr = 1u;
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         case OS_TASK_STATE_PEND:
              p_tcb->TaskState  = OS_TASK_STATE_PEND_SUSPENDED;
              p_tcb->SuspendCtr = 1u;
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         case OS_TASK_STATE_PEND_TIMEOUT:
              p_tcb->TaskState  = OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED;
              p_tcb->SuspendCtr = 1u;
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         case OS_TASK_STATE_SUSPENDED:
@@ -2317,17 +2461,17 @@ void   OSTaskSuspend (OS_TCB  *p_tcb,
         case OS_TASK_STATE_PEND_SUSPENDED:
         case OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED:
              if (p_tcb->SuspendCtr == (OS_NESTING_CTR)-1) {
-                 CPU_CRITICAL_EXIT();
+                 OS_CRITICAL_EXIT();
                 *p_err = OS_ERR_TASK_SUSPEND_CTR_OVF;
                  OS_TRACE_TASK_SUSPEND_EXIT(OS_ERR_TASK_SUSPEND_CTR_OVF);
                  return;
              }
              p_tcb->SuspendCtr++;
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_STATE_INVALID;
              OS_TRACE_TASK_SUSPEND_EXIT(OS_ERR_STATE_INVALID);
              return;
@@ -2597,12 +2741,16 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
 #if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u)
     p_tcb->StkFree              =                     0u;
     p_tcb->StkUsed              =                     0u;
+    p_tcb->StkScanIx            =                     0u;
 #endif
 
     p_tcb->Opt                  =                     0u;
 
 #if (OS_CFG_TICK_EN > 0u)
     p_tcb->TickRemain           =                     0u;
+#if (OS_CFG_TICK_WHEEL_EN > 0u)
+    p_tcb->TickCtrMatch         =                     0u;
+#endif
     p_tcb->TickCtrPrev          =                     0u;
     p_tcb->TickCtrSet           =  OS_FALSE;
 #endif
@@ -2623,6 +2771,11 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
     p_tcb->CyclesStart          =                     0u;
 #endif
     p_tcb->CyclesTotal          =                     0u;
+    p_tcb->CyclesRun            =                     0u;
+    p_tcb->CyclesBurstMax       =                     0u;
+    p_tcb->CtxSwOutCtr          =                     0u;
+    p_tcb->RdyTs                =  p_tcb->CyclesStart;
+    p_tcb->RdyToRunMax          =                     0u;
 #endif
 
 #ifdef CPU_CFG_INT_DIS_MEAS_EN
@@ -2635,6 +2788,9 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
     p_tcb->PendNextPtr          = (OS_TCB           *)0;
     p_tcb->PendPrevPtr          = (OS_TCB           *)0;
     p_tcb->PendObjPtr           = (OS_PEND_OBJ      *)0;
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    p_tcb->PendPrio             =                     0u;
+#endif
     p_tcb->PendOn               =  OS_TASK_PEND_ON_NOTHING;
     p_tcb->PendStatus           =  OS_STATUS_PEND_OK;
     p_tcb->TaskState            =  OS_TASK_STATE_RDY;
@@ -50,6 +50,10 @@ const  CPU_CHAR  *os_tick__c = "$Id: $";
 */
 
 static  void  OS_TickListUpdate (OS_TICK  ticks);
+static  void  OS_TickListExpire (OS_TCB  *p_tcb);
+#if (OS_CFG_DYN_TICK_EN > 0u) && (OS_CFG_TICK_WHEEL_EN > 0u)
+static  OS_TICK  OS_TickListNext  (void);
+#endif
 
 
 /*
@@ -79,7 +83,18 @@ void  OS_TickInit (OS_ERR  *p_err)
     OSTickCtrStep         = 0u;
 #endif
 
+#if (OS_CFG_TICK_WHEEL_EN > 0u)
+    {
+        OS_TICK  i;
+
+
+        for (i = 0u; i < OS_CFG_TICK_WHEEL_SIZE; i++) {
+            OSTickList.Spoke[i] = (OS_TCB *)0;
+        }
+    }
+#else
     OSTickList.TCB_Ptr    = (OS_TCB *)0;
+#endif
 
 #if (OS_CFG_DBG_EN > 0u)
     OSTickList.NbrEntries = 0u;
@@ -99,7 +114,10 @@ void  OS_TickInit (OS_ERR  *p_err)
 *
 * Returns    : none
 *
-* Note(s)    : This function is INTERNAL to Cs/OS3 and your application should not call it.
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application should not call it.
+*
+*              2) With OS_CFG_ISR_POST_DEFERRED_EN only the ISR handler task calls this function, and the lists are
+*                 updated with the scheduler locked instead of interrupts disabled.
 ************************************************************************************************************************
 */
 
@@ -111,12 +129,13 @@ void  OS_TickUpdate (OS_TICK  ticks)
     CPU_SR_ALLOC();
 
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
 
     OSTickCtr += ticks;                                         /* Keep track of the number of ticks                    */
 
     OS_TRACE_TICK_INCREMENT(OSTickCtr);
 
+    OS_TRACE_TICK_LIST_UPDATE_ENTER(ticks);
 #if (OS_CFG_TS_EN > 0u)
     ts_start   = OS_TS_GET();
     OS_TickListUpdate(ticks);
@@ -127,19 +146,104 @@ void  OS_TickUpdate (OS_TICK  ticks)
 #else
     OS_TickListUpdate(ticks);
 #endif
+    OS_TRACE_TICK_LIST_UPDATE_EXIT(OSTickList.NbrUpdated);
 
 #if (OS_CFG_DYN_TICK_EN > 0u)
+#if (OS_CFG_TICK_WHEEL_EN > 0u)
+    OSTickCtrStep = OS_TickListNext();                          /* Ticks to the earliest timeout in the wheel           */
+#else
     if (OSTickList.TCB_Ptr != (OS_TCB *)0) {
         OSTickCtrStep = OSTickList.TCB_Ptr->TickRemain;
     } else {
         OSTickCtrStep = 0u;
     }
+#endif
 
     OS_DynTickSet(OSTickCtrStep);
 #endif
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT_NO_SCHED();
 }
 
+#if (OS_CFG_TICK_WHEEL_EN > 0u)
+/*
+************************************************************************************************************************
+*                                                      INSERT
+*
+* Description: This task is internal to Cs/OS3 and allows the insertion of a task in a tick list.
+*
+* Arguments  : p_tcb       is a pointer to the TCB to insert in the list
+*
+*              elapsed     is the number of elapsed ticks since the last tick interrupt
+*
+*              tick_base   is value of OSTickCtr from which time is offset
+*
+*              time        is the amount of time remaining (in ticks) for the task to become ready
+*
+* Returns    : OS_TRUE     if time is valid for the given tick base
+*
+*              OS_FALSE    if time is invalid (i.e. zero delay)
+*
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application should not call it.
+*
+*              2) Tick wheel version: the task goes at the head of spoke (TickCtrMatch % OS_CFG_TICK_WHEEL_SIZE), so
+*                 insertion takes the same time however many tasks are delayed. Spokes are not sorted.
+*
+*              3) PTM should always call this function with elapsed == 0u.
+*
+*              4) In DTM the tick timer is reprogrammed only when the new timeout ends before the current step. A task
+*                 removed before its timeout leaves the step as it is; that costs one early tick interrupt, after
+*                 which OS_TickUpdate() programs the next timeout.
+************************************************************************************************************************
+*/
+
+CPU_BOOLEAN  OS_TickListInsert (OS_TCB   *p_tcb,
+                                OS_TICK   elapsed,
+                                OS_TICK   tick_base,
+                                OS_TICK   time)
+{
+    OS_TCB   **p_spoke;
+    OS_TICK    delta;
+
+
+    delta = (time + tick_base) - (OSTickCtr + elapsed);         /* How many ticks until our delay expires?              */
+
+    if (delta == 0u) {
+        p_tcb->TickRemain = 0u;
+        return (OS_FALSE);
+    }
+
+    OS_TRACE_TASK_DLY(delta);
+
+    p_tcb->TickRemain   = delta;
+    p_tcb->TickCtrMatch = OSTickCtr + elapsed + delta;          /* Tick at which OS_TickListUpdate() readies the task   */
+    p_spoke             = &OSTickList.Spoke[p_tcb->TickCtrMatch & (OS_CFG_TICK_WHEEL_SIZE - 1u)];
+
+    p_tcb->TickPrevPtr  = (OS_TCB *)0;                          /* Insert at the head of the spoke                      */
+    p_tcb->TickNextPtr  = *p_spoke;
+    if (*p_spoke != (OS_TCB *)0) {
+        (*p_spoke)->TickPrevPtr = p_tcb;
+    }
+   *p_spoke             = p_tcb;
+
+#if (OS_CFG_DBG_EN > 0u)
+    OSTickList.NbrEntries++;
+#endif
+
+#if (OS_CFG_DYN_TICK_EN > 0u)
+    if ((OSTickCtrStep == 0u) ||                                /* Tick timer idle, or our timeout ends first?          */
+        ((elapsed < OSTickCtrStep) && (delta < (OSTickCtrStep - elapsed)))) {
+        if (elapsed != 0u) {
+            OSTickCtr += elapsed;                               /* Update OSTickCtr before we set a new tick step.      */
+            OS_TRACE_TICK_INCREMENT(OSTickCtr);
+        }
+        OSTickCtrStep = delta;
+        OS_DynTickSet(OSTickCtrStep);
+    }
+#endif
+    return (OS_TRUE);
+}
+
+#else
 /*
 ************************************************************************************************************************
 *                                                      INSERT
@@ -268,6 +372,7 @@ CPU_BOOLEAN  OS_TickListInsert (OS_TCB   *p_tcb,
 
     return (OS_TRUE);
 }
+#endif
 
 /*
 ************************************************************************************************************************
@@ -366,6 +471,51 @@ void  OS_TickListInsertDly (OS_TCB   *p_tcb,
     }
 }
 
+#if (OS_CFG_TICK_WHEEL_EN > 0u)
+/*
+************************************************************************************************************************
+*                                         REMOVE A TASK FROM THE TICK LIST
+*
+* Description: This function is called to remove a task from the tick list
+*
+* Arguments  : p_tcb          Is a pointer to the OS_TCB to remove.
+*              -----
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application MUST NOT call it.
+*
+*              2) This function is assumed to be called with interrupts disabled.
+*
+*              3) Tick wheel version: unlinks the task from its spoke; no other entry changes.
+************************************************************************************************************************
+*/
+
+void  OS_TickListRemove (OS_TCB  *p_tcb)
+{
+    OS_TCB  *p_tcb1;
+    OS_TCB  *p_tcb2;
+
+
+    p_tcb1 = p_tcb->TickPrevPtr;
+    p_tcb2 = p_tcb->TickNextPtr;
+    if (p_tcb1 == (OS_TCB *)0) {                                /* Head of its spoke?                                   */
+        OSTickList.Spoke[p_tcb->TickCtrMatch & (OS_CFG_TICK_WHEEL_SIZE - 1u)] = p_tcb2;
+    } else {
+        p_tcb1->TickNextPtr = p_tcb2;
+    }
+    if (p_tcb2 != (OS_TCB *)0) {
+        p_tcb2->TickPrevPtr = p_tcb1;
+    }
+    p_tcb->TickPrevPtr = (OS_TCB *)0;
+    p_tcb->TickNextPtr = (OS_TCB *)0;
+    p_tcb->TickRemain  =           0u;
+#if (OS_CFG_DBG_EN > 0u)
+    OSTickList.NbrEntries--;
+#endif
+}
+
+#else
 /*
 ************************************************************************************************************************
 *                                         REMOVE A TASK FROM THE TICK LIST
@@ -450,7 +600,108 @@ void  OS_TickListRemove (OS_TCB  *p_tcb)
         p_tcb->TickRemain        =           0u;
     }
 }
+#endif
+
+#if (OS_CFG_TICK_WHEEL_EN > 0u)
+/*
+************************************************************************************************************************
+*                                 UPDATE THE LIST OF TASKS DELAYED OR PENDING WITH TIMEOUT
+*
+* Description: This function readies the tasks in the tick wheel whose delay or timeout expired in the last 'ticks'
+*              ticks.
+*
+* Arguments  : ticks          the number of ticks which have elapsed (OSTickCtr already includes them).
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application MUST NOT call it.
+*
+*              2) Only the spokes of the elapsed ticks are visited, at most all of them once. A task delayed for more
+*                 than OS_CFG_TICK_WHEEL_SIZE ticks is passed over each time the wheel comes round to its spoke.
+************************************************************************************************************************
+*/
+
+static  void  OS_TickListUpdate (OS_TICK  ticks)
+{
+    OS_TCB   *p_tcb;
+    OS_TCB   *p_next;
+    OS_TICK   base;
+    OS_TICK   spoke;
+    OS_TICK   n;
+#if (OS_CFG_DBG_EN > 0u)
+    OS_OBJ_QTY  nbr_updated;
+#endif
+
+
+#if (OS_CFG_DBG_EN > 0u)
+    nbr_updated = 0u;
+#endif
+    base = OSTickCtr - ticks;                                   /* OSTickCtr at the previous update                     */
+    n    = (ticks < OS_CFG_TICK_WHEEL_SIZE) ? ticks : OS_CFG_TICK_WHEEL_SIZE;
+    for (spoke = base + 1u; n > 0u; n--, spoke++) {
+        p_tcb = OSTickList.Spoke[spoke & (OS_CFG_TICK_WHEEL_SIZE - 1u)];
+        while (p_tcb != (OS_TCB *)0) {
+            p_next = p_tcb->TickNextPtr;
+            if ((OS_TICK)(p_tcb->TickCtrMatch - base - 1u) < ticks) {   /* Expired in (base, OSTickCtr]?                */
+                OS_TickListRemove(p_tcb);
+                OS_TickListExpire(p_tcb);
+#if (OS_CFG_DBG_EN > 0u)
+                nbr_updated++;
+#endif
+            }
+            p_tcb  = p_next;
+        }
+    }
+#if (OS_CFG_DBG_EN > 0u)
+    OSTickList.NbrUpdated = nbr_updated;
+#endif
+}
 
+#if (OS_CFG_DYN_TICK_EN > 0u)
+/*
+************************************************************************************************************************
+*                                            TICKS TO THE NEXT TIMEOUT IN THE TICK WHEEL
+*
+* Description: This function finds the earliest timeout in the tick wheel, for the next dynamic tick step.
+*
+* Arguments  : none
+*
+* Returns    : the number of ticks from OSTickCtr to the earliest timeout, 0 if the wheel is empty.
+*
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application MUST NOT call it.
+*
+*              2) The spokes are visited from the next tick on and the search stops at the first spoke that cannot
+*                 hold an earlier timeout, so a busy wheel costs a few spokes and an empty one all of them.
+************************************************************************************************************************
+*/
+
+static  OS_TICK  OS_TickListNext (void)
+{
+    OS_TCB   *p_tcb;
+    OS_TICK   next;
+    OS_TICK   remain;
+    OS_TICK   i;
+
+
+    next = 0u;
+    for (i = 1u; i <= OS_CFG_TICK_WHEEL_SIZE; i++) {
+        if ((next != 0u) && (next <= i)) {                      /* Nothing further on ends sooner                       */
+            break;
+        }
+        p_tcb = OSTickList.Spoke[(OSTickCtr + i) & (OS_CFG_TICK_WHEEL_SIZE - 1u)];
+        while (p_tcb != (OS_TCB *)0) {
+            remain = p_tcb->TickCtrMatch - OSTickCtr;
+            if ((next == 0u) || (remain < next)) {
+                next = remain;
+            }
+            p_tcb = p_tcb->TickNextPtr;
+        }
+    }
+    return (next);
+}
+#endif
+
+#else
 /*
 ************************************************************************************************************************
 *                                 UPDATE THE LIST OF TASKS DELAYED OR PENDING WITH TIMEOUT
@@ -472,10 +723,6 @@ static  void  OS_TickListUpdate (OS_TICK  ticks)
 #if (OS_CFG_DBG_EN > 0u)
     OS_OBJ_QTY     nbr_updated;
 #endif
-#if (OS_CFG_MUTEX_EN > 0u)
-    OS_TCB        *p_tcb_owner;
-    OS_PRIO        prio_new;
-#endif
 
 
 
@@ -496,65 +743,7 @@ static  void  OS_TickListUpdate (OS_TICK  ticks)
 #if (OS_CFG_DBG_EN > 0u)
             nbr_updated++;
 #endif
-
-            switch (p_tcb->TaskState) {
-                case OS_TASK_STATE_DLY:
-                     p_tcb->TaskState = OS_TASK_STATE_RDY;
-                     OS_RdyListInsert(p_tcb);                            /* Insert the task in the ready list                    */
-                     break;
-
-                case OS_TASK_STATE_DLY_SUSPENDED:
-                     p_tcb->TaskState = OS_TASK_STATE_SUSPENDED;
-                     break;
-
-                default:
-#if (OS_CFG_MUTEX_EN > 0u)
-                     p_tcb_owner = (OS_TCB *)0;
-                     if (p_tcb->PendOn == OS_TASK_PEND_ON_MUTEX) {
-                         p_tcb_owner = (OS_TCB *)((OS_MUTEX *)((void *)p_tcb->PendObjPtr))->OwnerTCBPtr;
-                     }
-#endif
-
-#if (OS_MSG_EN > 0u)
-                     p_tcb->MsgPtr  = (void *)0;
-                     p_tcb->MsgSize = 0u;
-#endif
-#if (OS_CFG_TS_EN > 0u)
-                     p_tcb->TS      = OS_TS_GET();
-#endif
-                     OS_PendListRemove(p_tcb);                           /* Remove task from pend list                           */
-
-                     switch (p_tcb->TaskState) {
-                         case OS_TASK_STATE_PEND_TIMEOUT:
-                              OS_RdyListInsert(p_tcb);                   /* Insert the task in the ready list                    */
-                              p_tcb->TaskState  = OS_TASK_STATE_RDY;
-                              break;
-
-                         case OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED:
-                              p_tcb->TaskState  = OS_TASK_STATE_SUSPENDED;
-                              break;
-
-                         default:
-                              break;
-                     }
-                     p_tcb->PendStatus = OS_STATUS_PEND_TIMEOUT;         /* Indicate pend timed out                              */
-                     p_tcb->PendOn     = OS_TASK_PEND_ON_NOTHING;        /* Indicate no longer pending                           */
-
-#if (OS_CFG_MUTEX_EN > 0u)
-                     if (p_tcb_owner != (OS_TCB *)0) {
-                         if ((p_tcb_owner->Prio != p_tcb_owner->BasePrio) &&
-                             (p_tcb_owner->Prio == p_tcb->Prio)) {       /* Has the owner inherited a priority?                  */
-                             prio_new = OS_MutexGrpPrioFindHighest(p_tcb_owner);
-                             prio_new = (prio_new > p_tcb_owner->BasePrio) ? p_tcb_owner->BasePrio : prio_new;
-                             if (prio_new != p_tcb_owner->Prio) {
-                                 OS_TaskChangePrio(p_tcb_owner, prio_new);
-                                 OS_TRACE_MUTEX_TASK_PRIO_DISINHERIT(p_tcb_owner, p_tcb_owner->Prio);
-                             }
-                         }
-                     }
-#endif
-                     break;
-            }
+            OS_TickListExpire(p_tcb);
 
             p_list->TCB_Ptr = p_tcb->TickNextPtr;
             p_tcb           = p_list->TCB_Ptr;                           /* Get 'p_tcb' again for loop                           */
@@ -581,5 +770,88 @@ static  void  OS_TickListUpdate (OS_TICK  ticks)
     p_list->NbrUpdated = nbr_updated;
 #endif
 }
+#endif
+
+/*
+************************************************************************************************************************
+*                                          READY A TASK WHOSE DELAY OR TIMEOUT EXPIRED
+*
+* Description: This function ends the delay or the pend of a task taken off the tick list.
+*
+* Arguments  : p_tcb          is a pointer to the OS_TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to Cs/OS3 and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+static  void  OS_TickListExpire (OS_TCB  *p_tcb)
+{
+#if (OS_CFG_MUTEX_EN > 0u)
+    OS_TCB   *p_tcb_owner;
+    OS_PRIO   prio_new;
+#endif
+
+
+    switch (p_tcb->TaskState) {
+        case OS_TASK_STATE_DLY:
+             p_tcb->TaskState = OS_TASK_STATE_RDY;
+             OS_RdyListInsert(p_tcb);                                    /* Insert the task in the ready list                    */
+             break;
+
+        case OS_TASK_STATE_DLY_SUSPENDED:
+             p_tcb->TaskState = OS_TASK_STATE_SUSPENDED;
+             break;
+
+        default:
+#if (OS_CFG_MUTEX_EN > 0u)
+             p_tcb_owner = (OS_TCB *)0;
+             if (p_tcb->PendOn == OS_TASK_PEND_ON_MUTEX) {
+                 p_tcb_owner = (OS_TCB *)((OS_MUTEX *)((void *)p_tcb->PendObjPtr))->OwnerTCBPtr;
+             }
+#endif
+
+#if (OS_MSG_EN > 0u)
+             p_tcb->MsgPtr  = (void *)0;
+             p_tcb->MsgSize = 0u;
+#endif
+#if (OS_CFG_TS_EN > 0u)
+             p_tcb->TS      = OS_TS_GET();
+#endif
+             OS_PendListRemove(p_tcb);                                   /* Remove task from pend list                           */
+
+             switch (p_tcb->TaskState) {
+                 case OS_TASK_STATE_PEND_TIMEOUT:
+                      OS_RdyListInsert(p_tcb);                           /* Insert the task in the ready list                    */
+                      p_tcb->TaskState  = OS_TASK_STATE_RDY;
+                      break;
+
+                 case OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED:
+                      p_tcb->TaskState  = OS_TASK_STATE_SUSPENDED;
+                      break;
+
+                 default:
+                      break;
+             }
+             p_tcb->PendStatus = OS_STATUS_PEND_TIMEOUT;                 /* Indicate pend timed out                              */
+             p_tcb->PendOn     = OS_TASK_PEND_ON_NOTHING;                /* Indicate no longer pending                           */
+
+#if (OS_CFG_MUTEX_EN > 0u)
+             if (p_tcb_owner != (OS_TCB *)0) {
+                 if ((p_tcb_owner->Prio != p_tcb_owner->BasePrio) &&
+                     (p_tcb_owner->Prio == p_tcb->Prio)) {               /* Has the owner inherited a priority?                  */
+                     prio_new = OS_MutexGrpPrioFindHighest(p_tcb_owner);
+                     prio_new = (prio_new > p_tcb_owner->BasePrio) ? p_tcb_owner->BasePrio : prio_new;
+                     if (prio_new != p_tcb_owner->Prio) {
+                         OS_TaskChangePrio(p_tcb_owner, prio_new);
+                         OS_TRACE_MUTEX_TASK_PRIO_DISINHERIT(p_tcb_owner, p_tcb_owner->Prio);
+                     }
+                 }
+             }
+#endif
+             break;
+    }
+}
 
 #endif                                                                   /* #if OS_CFG_TICK_EN                                   */
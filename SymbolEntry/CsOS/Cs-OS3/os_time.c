@@ -152,7 +152,7 @@ void  OSTimeDly (OS_TICK   dly,
     }
 
 #if (OS_CFG_TICK_EN > 0u)
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if ((opt & OS_OPT_TIME_PERIODIC_RESET) != 0u) {
         OSTCBCurPtr->TickCtrSet = OS_FALSE;
     }
@@ -161,12 +161,12 @@ void  OSTimeDly (OS_TICK   dly,
                          opt_time,
                          p_err);
     if (*p_err != OS_ERR_NONE) {
-         CPU_CRITICAL_EXIT();
+         OS_CRITICAL_EXIT();
          return;
     }
 
     OS_RdyListRemove(OSTCBCurPtr);                              /* Remove current task from ready list                  */
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT_NO_SCHED();
     OSSched();                                                  /* Find next task to run!                               */
 #endif
 #endif
@@ -351,7 +351,7 @@ void  OSTimeDlyHMSM (CPU_INT16U   hours,
               + ((tick_rate * ((OS_TICK)milli + ((OS_TICK)500u / tick_rate))) / (OS_TICK)1000u);
 
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     if ((opt & OS_OPT_TIME_PERIODIC_RESET) != 0u) {
         OSTCBCurPtr->TickCtrSet = OS_FALSE;
     }
@@ -360,12 +360,12 @@ void  OSTimeDlyHMSM (CPU_INT16U   hours,
                          opt_time,
                          p_err);
     if (*p_err != OS_ERR_NONE) {
-         CPU_CRITICAL_EXIT();
+         OS_CRITICAL_EXIT();
          return;
     }
 
     OS_RdyListRemove(OSTCBCurPtr);                              /* Remove current task from ready list                  */
-    CPU_CRITICAL_EXIT();
+    OS_CRITICAL_EXIT_NO_SCHED();
     OSSched();                                                  /* Find next task to run!                               */
 #endif
 }
@@ -433,7 +433,7 @@ void  OSTimeDlyResume (OS_TCB  *p_tcb,
     }
 #endif
 
-    CPU_CRITICAL_ENTER();
+    OS_CRITICAL_ENTER();
     switch (p_tcb->TaskState) {
         case OS_TASK_STATE_RDY:                                 /* Cannot Abort delay if task is ready                  */
         case OS_TASK_STATE_PEND:
@@ -441,7 +441,7 @@ void  OSTimeDlyResume (OS_TCB  *p_tcb,
         case OS_TASK_STATE_SUSPENDED:
         case OS_TASK_STATE_PEND_SUSPENDED:
         case OS_TASK_STATE_PEND_TIMEOUT_SUSPENDED:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_TASK_NOT_DLY;
              break;
 
@@ -451,7 +451,7 @@ void  OSTimeDlyResume (OS_TCB  *p_tcb,
              OS_TickListRemove(p_tcb);                          /* Remove task from tick list                           */
              OS_RdyListInsert(p_tcb);                           /* Add to ready list                                    */
 #endif
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_NONE;
              break;
 
@@ -460,12 +460,12 @@ void  OSTimeDlyResume (OS_TCB  *p_tcb,
 #if (OS_CFG_TICK_EN > 0u)
              OS_TickListRemove(p_tcb);                          /* Remove task from tick list                           */
 #endif
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err            = OS_ERR_TASK_SUSPENDED;
              break;
 
         default:
-             CPU_CRITICAL_EXIT();
+             OS_CRITICAL_EXIT();
             *p_err = OS_ERR_STATE_INVALID;
              break;
     }
@@ -596,12 +596,31 @@ void  OSTimeSet (OS_TICK   ticks,
 
 void  OSTimeTick (void)
 {
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    OS_ERR  err;
+
+
+#endif
     if (OSRunning != OS_STATE_OS_RUNNING) {
         return;
     }
 
     OSTimeTickHook();                                           /* Call user definable hook                             */
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR, the ISR handler task updates     */
+        OS_IntQPost(OS_OBJ_TYPE_TICK,
+                    (void *)&OSRdyList[OSPrioCur],
+                    (void *)0,
+                    0u,
+                    0u,
+                    0u,
+                   &err);
+        (void)err;
+        return;
+    }
+#endif
+
 #if (OS_CFG_SCHED_ROUND_ROBIN_EN > 0u)
     OS_SchedRoundRobin(&OSRdyList[OSPrioCur]);                  /* Update quanta ctr for the task which just ran        */
 #endif
@@ -630,12 +649,32 @@ void  OSTimeTick (void)
 #if (OS_CFG_DYN_TICK_EN > 0u)
 void  OSTimeDynTick (OS_TICK  ticks)
 {
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    OS_ERR  err;
+
+
+#endif
     if (OSRunning != OS_STATE_OS_RUNNING) {
         return;
     }
 
     OSTimeTickHook();
 
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    if (OSIntNestingCtr > 0u) {                                 /* Called from an ISR, the ISR handler task updates ... */
+        OS_IntQPost(OS_OBJ_TYPE_TICK,                           /* ... with the ticks elapsed by then                   */
+                    (void *)&OSRdyList[OSPrioCur],
+                    (void *)0,
+                    0u,
+                    0u,
+                    0u,
+                   &err);
+        (void)err;
+        (void)ticks;
+        return;
+    }
+#endif
+
     OS_TickUpdate(ticks);                                       /* Update from the ISR                                  */
 }
 #endif
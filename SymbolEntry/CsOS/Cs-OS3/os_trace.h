@@ -80,6 +80,13 @@
 #define  OS_TRACE_TICK_INCREMENT(OSTickCtr)
 #endif
 
+#ifndef  OS_TRACE_TICK_LIST_UPDATE_ENTER
+#define  OS_TRACE_TICK_LIST_UPDATE_ENTER(ticks)
+#endif
+#ifndef  OS_TRACE_TICK_LIST_UPDATE_EXIT
+#define  OS_TRACE_TICK_LIST_UPDATE_EXIT(nbr_updated)
+#endif
+
 #ifndef  OS_TRACE_TASK_CREATE
 #define  OS_TRACE_TASK_CREATE(p_tcb)
 #endif
@@ -12,9 +12,11 @@
 void __assertion_failed(char *failedExpr)
 {
 
+	BIOTxFlush();
 	BIOPutStrg("ASSERT ERROR ");
 	BIOPutStrg(failedExpr);
 	BIOOutCRLF();
+	BIOTxFlush();
     for (;;)
     {
         __BKPT(0);
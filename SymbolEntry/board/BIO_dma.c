@@ -0,0 +1,100 @@
+/******************************************************************************************
+ * BIO_dma.c - eDMA transfer control descriptors for the BasicIO scatter-gather transmit
+ * path. See BIO_dma.h.
+ *
+ * The descriptor builder is plain C and is also compiled for the host. The DMA0 register
+ * access is target only; host/host_bsp.c provides the host versions.
+ ******************************************************************************************/
+#include "MCUType.h"
+#include "BIO_dma.h"
+
+/******************************************************************************************
+ * Module Defines
+ ******************************************************************************************/
+#define BIO_DMA_REQ_LPUART4_TX  78u     /* DMA0 request source: LP_FLEXCOMM4 transmit */
+
+/******************************************************************************************
+ * BIODmaTcdChain() - Builds a scatter-gather chain that writes each fragment, one byte
+ *                    per request, to dest. Zero length fragments are skipped.
+ *    Each TCD moves NBYTES = 1 per LPUART TX request, CITER = BITER = fragment length
+ *    requests, then either loads the next TCD (ESG) or, for the last one, stops taking
+ *    requests (DREQ) and interrupts (INTMAJOR).
+ ******************************************************************************************/
+INT8U BIODmaTcdChain(BIO_DMA_TCD *tcds, INT8U ntcd, const BIO_FRAG *frags,
+                     INT8U nfrags, volatile void *dest){
+    INT8U i;
+    INT8U used = 0;
+    BIO_DMA_TCD *tcd;
+
+    for(i = 0; i < nfrags; i++){
+        if(frags[i].len == 0){
+        }else if((used >= ntcd) || (frags[i].len > BIO_DMA_CITER_MAX)){
+            return 0;
+        }else{
+            tcd = &tcds[used];
+            tcd->SADDR = (BIO_DMA_ADDR)frags[i].ptr;
+            tcd->SOFF = 1u;
+            tcd->ATTR = 0u;                         /* 8-bit source and destination */
+            tcd->NBYTES = 1u;
+            tcd->SLAST = -(INT32S)frags[i].len;     /* Leave SADDR where it started */
+            tcd->DADDR = (BIO_DMA_ADDR)dest;
+            tcd->DOFF = 0u;
+            tcd->CITER = frags[i].len;
+            tcd->BITER = frags[i].len;
+            tcd->DLAST_SGA = 0u;
+            tcd->CSR = BIO_DMA_CSR_INTMAJOR | BIO_DMA_CSR_DREQ;
+            if(used > 0){                           /* Link the previous TCD to this one */
+                tcds[used - 1u].DLAST_SGA = (BIO_DMA_ADDR)tcd;
+                tcds[used - 1u].CSR = BIO_DMA_CSR_ESG;
+            }else{
+            }
+            used++;
+        }
+    }
+    return used;
+}
+
+#ifndef CS_HOST_POSIX
+/******************************************************************************************
+ * BIODmaInit() - Enables DMA0, routes LPUART4 TX requests to BIO_DMA_CH and enables its
+ *                interrupt.
+ ******************************************************************************************/
+void BIODmaInit(void){
+    SYSCON->AHBCLKCTRLSET[0] = SYSCON_AHBCLKCTRL0_DMA0(1);
+    DMA0->CH[BIO_DMA_CH].CH_CSR = DMA_CH_CSR_DONE_MASK;     /* w1c, ERQ off */
+    DMA0->CH[BIO_DMA_CH].CH_INT = DMA_CH_INT_INT_MASK;
+    DMA0->CH[BIO_DMA_CH].CH_MUX = DMA_CH_MUX_SRC(BIO_DMA_REQ_LPUART4_TX);
+    NVIC_ClearPendingIRQ(EDMA_0_CH0_IRQn);
+    NVIC_EnableIRQ(EDMA_0_CH0_IRQn);
+}
+
+/******************************************************************************************
+ * BIODmaStart() - Loads the first TCD of a chain and enables LPUART4 TX DMA requests.
+ *                 The remaining TCDs are loaded by the eDMA engine from DLAST_SGA.
+ ******************************************************************************************/
+void BIODmaStart(const BIO_DMA_TCD *tcd){
+    DMA0->CH[BIO_DMA_CH].TCD_SADDR = tcd->SADDR;
+    DMA0->CH[BIO_DMA_CH].TCD_SOFF = tcd->SOFF;
+    DMA0->CH[BIO_DMA_CH].TCD_ATTR = tcd->ATTR;
+    DMA0->CH[BIO_DMA_CH].TCD_NBYTES_MLOFFNO = tcd->NBYTES;
+    DMA0->CH[BIO_DMA_CH].TCD_SLAST_SDA = (INT32U)tcd->SLAST;
+    DMA0->CH[BIO_DMA_CH].TCD_DADDR = tcd->DADDR;
+    DMA0->CH[BIO_DMA_CH].TCD_DOFF = tcd->DOFF;
+    DMA0->CH[BIO_DMA_CH].TCD_CITER_ELINKNO = tcd->CITER;
+    DMA0->CH[BIO_DMA_CH].TCD_DLAST_SGA = tcd->DLAST_SGA;
+    DMA0->CH[BIO_DMA_CH].TCD_BITER_ELINKNO = tcd->BITER;
+    DMA0->CH[BIO_DMA_CH].TCD_CSR = tcd->CSR;                /* CSR last, ESG checks DLAST_SGA */
+    DMA0->CH[BIO_DMA_CH].CH_CSR |= DMA_CH_CSR_ERQ_MASK;
+    LPUART4->BAUD |= LPUART_BAUD_TDMAE_MASK;
+}
+
+/******************************************************************************************
+ * BIODmaDoneClr() - Clears the channel's interrupt/done flags and LPUART4 TX DMA
+ *                   requests. Called from the channel ISR.
+ ******************************************************************************************/
+void BIODmaDoneClr(void){
+    LPUART4->BAUD &= ~LPUART_BAUD_TDMAE_MASK;
+    DMA0->CH[BIO_DMA_CH].CH_INT = DMA_CH_INT_INT_MASK;
+    DMA0->CH[BIO_DMA_CH].CH_CSR |= DMA_CH_CSR_DONE_MASK;
+}
+#endif /* CS_HOST_POSIX */
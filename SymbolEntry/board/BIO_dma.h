@@ -0,0 +1,74 @@
+/******************************************************************************************
+ * BIO_dma.h - eDMA transfer control descriptors (TCDs) for the BasicIO scatter-gather
+ * transmit path, BIOWriteV().
+ *
+ * BIODmaTcdChain() only builds descriptors in memory. BIODmaInit(), BIODmaStart() and
+ * BIODmaDoneClr() program DMA0 channel BIO_DMA_CH for LPUART4 TX requests. The host
+ * build (CS_HOST_POSIX) replaces those three with a model in host/host_bsp.c that walks
+ * the same descriptor chain, so chaining can be checked without hardware.
+ * host/dma_chain.c checks the chains BIODmaTcdChain() builds on their own.
+ ******************************************************************************************/
+#ifndef BIO_DMA_INCL
+#define BIO_DMA_INCL
+
+#include "BasicIO.h"
+
+/******************************************************************************************
+ * Configuration
+ ******************************************************************************************/
+#define BIO_DMA_CH          0u      /* DMA0 channel used for LPUART4 TX */
+#define BIO_DMA_TCD_MAX     8u      /* Max fragments per BIOWriteV() */
+#define BIO_DMA_CITER_MAX   0x7FFFu /* Max bytes per fragment (CITER without linking) */
+
+/******************************************************************************************
+ * TCD_CSR bits
+ ******************************************************************************************/
+#define BIO_DMA_CSR_INTMAJOR    0x0002u   /* Interrupt at major loop completion */
+#define BIO_DMA_CSR_DREQ        0x0008u   /* Clear ERQ at major loop completion */
+#define BIO_DMA_CSR_ESG         0x0010u   /* Load DLAST_SGA as the next TCD */
+
+/******************************************************************************************
+ * Transfer control descriptor, in eDMA TCD order. Scatter-gather TCDs must be 32-byte
+ * aligned. On the host addresses are pointer sized so the model can follow them.
+ ******************************************************************************************/
+#ifdef CS_HOST_POSIX
+typedef uintptr_t BIO_DMA_ADDR;
+#else
+typedef INT32U BIO_DMA_ADDR;
+#endif
+
+typedef struct{
+    BIO_DMA_ADDR SADDR;
+    INT16U SOFF;
+    INT16U ATTR;
+    INT32U NBYTES;
+    INT32S SLAST;
+    BIO_DMA_ADDR DADDR;
+    INT16U DOFF;
+    INT16U CITER;
+    BIO_DMA_ADDR DLAST_SGA;
+    INT16U CSR;
+    INT16U BITER;
+}BIO_DMA_TCD;
+
+/******************************************************************************************
+ * BIODmaTcdChain() - Builds a scatter-gather chain that writes each fragment, one byte
+ *                    per request, to dest. Zero length fragments are skipped.
+ *    Return: Number of TCDs used, 0 if there is nothing to send, more fragments than
+ *            ntcd, or a fragment longer than BIO_DMA_CITER_MAX.
+ ******************************************************************************************/
+INT8U BIODmaTcdChain(BIO_DMA_TCD *tcds, INT8U ntcd, const BIO_FRAG *frags,
+                     INT8U nfrags, volatile void *dest);
+
+/******************************************************************************************
+ * BIODmaInit() - Enables DMA0, routes LPUART4 TX requests to BIO_DMA_CH and enables its
+ *                interrupt.
+ * BIODmaStart() - Loads the first TCD of a chain and enables LPUART4 TX DMA requests.
+ * BIODmaDoneClr() - Clears the channel's interrupt/done flags and LPUART4 TX DMA
+ *                   requests. Called from the channel ISR.
+ ******************************************************************************************/
+void BIODmaInit(void);
+void BIODmaStart(const BIO_DMA_TCD *tcd);
+void BIODmaDoneClr(void);
+
+#endif
@@ -2,21 +2,106 @@
  * BasicIO.c - is a module with public functions used to send and receive
  * information from a serial port. In this case UART2 configured for the
  * MCULink debug USB serial port. FRDM-MCXN947 board.
- * v1.1
+ * v1.3
  *  Created by: Todd Morton, 05/04/2024
+ *  Transmit is interrupt driven: BIOWrite() queues characters in a ring buffer that
+ *  the LPUART4 TX watermark interrupt moves into the 8-word TX FIFO. A task only blocks
+ *  when the ring is full.
+ *  BIOWriteV() sends a list of fragments straight from the caller's memory with a DMA0
+ *  scatter-gather chain (BIO_dma.c), after whatever is in the ring at the time.
+ *  Receive is interrupt driven too: the RX interrupt stamps each character with
+ *  CPU_TS_TmrRd() as it arrives and keeps it in a small ring for BIORead()/BIOReadTs().
  *******************************************************************************************
 * Project master header file
 ********************************************************************/
 #include "MCUType.h"
+#include "os.h"
 #include "BasicIO.h"
+#include "BIO_dma.h"
 #include "math.h"
 
+/*******************************************************************************************
+* Module Defines
+*******************************************************************************************/
+#define BIO_TX_BUF_SIZE     256u    /* Must be a power of two */
+#define BIO_TX_BUF_MASK     (BIO_TX_BUF_SIZE - 1u)
+#define BIO_TX_FIFO_SIZE    8u      /* LPUART4 TX FIFO depth */
+#define BIO_TX_WATER        2u      /* Interrupt when the FIFO drains to this many words */
+#define BIO_RX_BUF_SIZE     16u     /* Must be a power of two */
+#define BIO_RX_BUF_MASK     (BIO_RX_BUF_SIZE - 1u)
+
+/* Transmit ring buffer. in and out are free running, in is only changed by tasks and
+ * out only by the TX ISR or the polled path, both with interrupts disabled. */
+typedef struct{
+    INT8C buffer[BIO_TX_BUF_SIZE];
+    INT16U in;
+    INT16U out;
+    INT8U blocked;      /* Tasks are waiting on space */
+    OS_SEM space;
+}BIO_TX_BUFFER;
+
+/* Receive ring. in is only changed by the RX ISR, out by BIORead() with interrupts
+ * disabled. A character that finds the ring full is dropped and counted. The ISR posts
+ * flags to grp, if set, for every batch of characters it takes (BIORxFlagSet()). */
+typedef struct{
+    INT8C buffer[BIO_RX_BUF_SIZE];
+    CPU_TS ts[BIO_RX_BUF_SIZE];
+    INT16U in;
+    INT16U out;
+    INT32U overruns;
+    OS_FLAG_GRP *grp;
+    OS_FLAGS grp_flags;
+}BIO_RX_BUFFER;
+
+/* DMA transmit. One transfer at a time. QUEUED waits for the ring to drain up to mark,
+ * the ring position when BIOWriteV() was called, so output stays in call order. While
+ * the DMA is QUEUED or ACTIVE the ring only takes characters; the DMA done interrupt
+ * restarts the ring. */
+typedef enum{
+    BIO_DMA_IDLE,
+    BIO_DMA_QUEUED,
+    BIO_DMA_ACTIVE
+}BIO_DMA_STATE;
+
+typedef struct{
+    BIO_DMA_STATE state;
+    INT16U mark;
+    INT8U blocked;      /* A task is waiting for the transfer to finish */
+    BIO_TX_DONE done;
+    void *p_arg;
+    OS_SEM idle;
+}BIO_TX_DMA;
+
 /*******************************************************************************************
 * Private Resources
 *******************************************************************************************/
 static INT8C bioHtoA(INT8U hnib);   //Convert nibble to ascii
 static INT8U bioIsHex(INT8C c);
 static INT8U bioHtoB(INT8C c);
+static void bioTxPoll(void);
+static void bioTxDmaStart(void);
+static BIO_TX_BUFFER bioTxBuffer;
+static BIO_RX_BUFFER bioRxBuffer;
+static BIO_TX_DMA bioTxDma;
+static BIO_DMA_TCD bioTxTcd[BIO_DMA_TCD_MAX] __attribute__((aligned(32)));
+
+/* LPUART4 register access. The host build models the side effects of DATA and CTRL
+ * accesses in host/host_bsp.c. */
+#ifdef CS_HOST_POSIX
+#define BIO_DATA_WR(c)  HostLpuartDataWr(LPUART4, (uint32_t)(c))
+#define BIO_DATA_RD()   HostLpuartDataRd(LPUART4)
+#define BIO_CTRL_WR(v)  HostLpuartCtrlWr(LPUART4, (uint32_t)(v))
+#else
+#define BIO_DATA_WR(c)  (LPUART4->DATA = (INT32U)(c))
+#define BIO_DATA_RD()   (LPUART4->DATA)
+#define BIO_CTRL_WR(v)  (LPUART4->CTRL = (INT32U)(v))
+#endif
+#define BIO_TX_IE_ON()      BIO_CTRL_WR(LPUART4->CTRL | LPUART_CTRL_TIE_MASK)
+#define BIO_TX_IE_OFF()     BIO_CTRL_WR(LPUART4->CTRL & ~LPUART_CTRL_TIE_MASK)
+#define BIO_TX_FIFO_CNT()   ((LPUART4->WATER & LPUART_WATER_TXCOUNT_MASK) >> LPUART_WATER_TXCOUNT_SHIFT)
+#define BIO_TX_BUF_CNT()    ((INT16U)(bioTxBuffer.in - bioTxBuffer.out))
+#define BIO_RX_BUF_CNT()    ((INT16U)(bioRxBuffer.in - bioRxBuffer.out))
+
 /*******************************************************************************************
  * void BIOOpen(INT8U rate) - Initializes UART to operate at a specified rate.
  * MCU: MCXN947, LPUART4 configured for debugger USB.
@@ -27,8 +112,10 @@ static INT8U bioHtoB(INT8C c);
  *  BIO_BIT_RATE_38400
  *  BIO_BIT_RATE_57600
  *  BIO_BIT_RATE_115200
+ * Must be called after OSInit() since it creates the TX semaphore.
  ******************************************************************************************/
 void BIOOpen(INT8U rate){
+    OS_ERR os_err;
 
 	SYSCON->AHBCLKCTRLSET[0] = SYSCON_AHBCLKCTRL0_PORT1(1);
 	SYSCON->FCCLKSEL[4] = SYSCON_FCCLKSEL_SEL(1);			//PLL div clk, 50MHz
@@ -63,17 +150,40 @@ void BIOOpen(INT8U rate){
     }
 
     /* Enable tx/rx FIFO */
-    /* The FIFO is only 8 words so this sends the first 8 words without delay.
-     * But after that, there's a delay for each character. */
+    /* The TX interrupt refills the 8 word FIFO when it drains to BIO_TX_WATER words,
+     * so there is one interrupt per several characters. */
 
-    LPUART4->WATER = LPUART_WATER_RXWATER(0) | LPUART_WATER_TXWATER(7);
+    LPUART4->WATER = LPUART_WATER_RXWATER(0) | LPUART_WATER_TXWATER(BIO_TX_WATER);
     LPUART4->FIFO |= (LPUART_FIFO_TXFE_MASK | LPUART_FIFO_RXFE_MASK);
 
     /* Flush FIFO */
     LPUART4->FIFO |= (LPUART_FIFO_TXFLUSH_MASK | LPUART_FIFO_RXFLUSH_MASK);
 
-    /* Enable RxD and TxD */
-    LPUART4->CTRL |= LPUART_CTRL_TE_MASK|LPUART_CTRL_RE_MASK;
+    /* TX ring buffer */
+    bioTxBuffer.in = 0;
+    bioTxBuffer.out = 0;
+    bioTxBuffer.blocked = FALSE;
+    OSSemCreate(&(bioTxBuffer.space),"BIO TX Semaphore",0,&os_err);
+    assert(os_err == OS_ERR_NONE);
+
+    /* RX ring */
+    bioRxBuffer.in = 0;
+    bioRxBuffer.out = 0;
+    bioRxBuffer.overruns = 0;
+    bioRxBuffer.grp = (OS_FLAG_GRP *)0;
+
+    /* TX DMA */
+    bioTxDma.state = BIO_DMA_IDLE;
+    bioTxDma.blocked = FALSE;
+    OSSemCreate(&(bioTxDma.idle),"BIO TX DMA Semaphore",0,&os_err);
+    assert(os_err == OS_ERR_NONE);
+    BIODmaInit();
+
+    /* Enable RxD and TxD. TX interrupt is only enabled while the ring has data, the RX
+     * interrupt always. */
+    BIO_CTRL_WR(LPUART4->CTRL | LPUART_CTRL_TE_MASK|LPUART_CTRL_RE_MASK|LPUART_CTRL_RIE_MASK);
+    NVIC_ClearPendingIRQ(LP_FLEXCOMM4_IRQn);
+    NVIC_EnableIRQ(LP_FLEXCOMM4_IRQn);
 
 }
 
@@ -83,14 +193,58 @@ void BIOOpen(INT8U rate){
 *    return: ASCII character received or 0 if no character received
 *******************************************************************************************/
 INT8C BIORead(void){
+    CPU_TS ts;
+    return BIOReadTs(&ts);
+}
+
+/*******************************************************************************************
+* BIOReadTs() - BIORead() that also returns when the character arrived
+*               Takes the oldest character from the RX ring. With interrupts disabled
+*               (before the kernel runs) the ring stays empty, so the data register is
+*               read directly and stamped now.
+* MCU: MCXN947, LPUART4
+*    parameter: ts gets the CPU_TS_TmrRd() value from the RX interrupt
+*    return: ASCII character received or 0 if no character received
+*******************************************************************************************/
+INT8C BIOReadTs(CPU_TS *ts){
     INT8C c;
-    if ((LPUART4->STAT & LPUART_STAT_RDRF_MASK) != 0){   //check if char received
-        c = (INT8C)(LPUART4->DATA);
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    if(BIO_RX_BUF_CNT() > 0){
+        c = bioRxBuffer.buffer[bioRxBuffer.out & BIO_RX_BUF_MASK];
+        *ts = bioRxBuffer.ts[bioRxBuffer.out & BIO_RX_BUF_MASK];
+        bioRxBuffer.out++;
+    }else if((LPUART4->STAT & LPUART_STAT_RDRF_MASK) != 0){
+        c = (INT8C)(BIO_DATA_RD());
+        *ts = CPU_TS_TmrRd();
     }else{
         c = '\0';                           //If not return 0
     }
+    CPU_CRITICAL_EXIT();
     return (c);
 }
+/*******************************************************************************************
+* BIORxFlagSet() - Post flags to grp from the RX interrupt whenever characters arrive, so
+*                  a task can pend for them instead of polling BIORead(). Posts them now if
+*                  characters are already waiting. NULL stops the posts.
+*******************************************************************************************/
+void BIORxFlagSet(OS_FLAG_GRP *grp, OS_FLAGS flags){
+    OS_ERR os_err;
+    INT16U cnt;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    bioRxBuffer.grp = grp;
+    bioRxBuffer.grp_flags = flags;
+    cnt = BIO_RX_BUF_CNT();
+    CPU_CRITICAL_EXIT();
+    if((grp != (OS_FLAG_GRP *)0) && (cnt > 0)){
+        (void)OSFlagPost(grp, flags, OS_OPT_POST_FLAG_SET, &os_err);
+    }else{
+    }
+}
+
 /*******************************************************************************************
 * BIOGetChar() - Blocks until character is received
 *    return: INT8C ASCII character
@@ -104,14 +258,208 @@ INT8C BIOGetChar(void){
 }
 
 /*******************************************************************************************
-* BIOWrite() - Sends an ASCII character
-*              Blocks as much as one character time after FIFO is full
+* BIOWrite() - Queues an ASCII character for transmission
+*              Returns right away unless the TX ring is full. Then a task pends until the
+*              TX interrupt makes room. Before the kernel runs, in an ISR, or with the
+*              scheduler locked, characters are moved out of the ring by polling instead.
 * MCU: MCXN947, LPUART4
 *    parameter: c is the ASCII character to be sent
 *******************************************************************************************/
 void BIOWrite(INT8C c){
-    while ((LPUART4->STAT & LPUART_STAT_TDRE_MASK)==0){} //waits for space on FIFO
-    LPUART4->DATA = (INT32U)c;
+    OS_ERR os_err;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    while(BIO_TX_BUF_CNT() >= BIO_TX_BUF_SIZE){
+        if((OSRunning == OS_STATE_OS_RUNNING) && (OSIntNestingCtr == 0u) &&
+           (OSSchedLockNestingCtr == 0u)){
+            bioTxBuffer.blocked = TRUE;
+            CPU_CRITICAL_EXIT();
+            (void)OSSemPend(&(bioTxBuffer.space), 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+            assert(os_err == OS_ERR_NONE);
+            CPU_CRITICAL_ENTER();
+        }else{
+            bioTxPoll();
+        }
+    }
+    bioTxBuffer.buffer[bioTxBuffer.in & BIO_TX_BUF_MASK] = c;
+    bioTxBuffer.in++;
+    if(bioTxDma.state != BIO_DMA_ACTIVE){
+        BIO_TX_IE_ON();
+    }else{
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*******************************************************************************************
+* BIOWriteV() - Sends a list of fragments with DMA, without copying them into the ring.
+*               The fragment list is turned into a scatter-gather TCD chain before return,
+*               the data itself is read by the DMA as it goes out.
+*               If a transfer is in progress a task pends until it is done. Before the
+*               kernel runs, in an ISR, or with the scheduler locked BIO_WRV_BUSY is
+*               returned instead.
+*               BIOTxFlush() and the polled path of BIOWrite() do not wait for a DMA
+*               transfer, so their characters can land in the middle of one.
+*    parameters: frags, nfrags - up to BIO_DMA_TCD_MAX fragments
+*                done, p_arg - optional callback from the DMA done ISR
+*    return: BIO_WRV_OK, BIO_WRV_BUSY or BIO_WRV_ERR
+*******************************************************************************************/
+INT8U BIOWriteV(const BIO_FRAG *frags, INT8U nfrags, BIO_TX_DONE done, void *p_arg){
+    OS_ERR os_err;
+    CPU_SR_ALLOC();
+
+    if((nfrags == 0) || (nfrags > BIO_DMA_TCD_MAX)){
+        return BIO_WRV_ERR;
+    }else{
+    }
+    CPU_CRITICAL_ENTER();
+    while(bioTxDma.state != BIO_DMA_IDLE){
+        if((OSRunning == OS_STATE_OS_RUNNING) && (OSIntNestingCtr == 0u) &&
+           (OSSchedLockNestingCtr == 0u)){
+            bioTxDma.blocked = TRUE;
+            CPU_CRITICAL_EXIT();
+            (void)OSSemPend(&(bioTxDma.idle), 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+            assert(os_err == OS_ERR_NONE);
+            CPU_CRITICAL_ENTER();
+        }else{
+            CPU_CRITICAL_EXIT();
+            return BIO_WRV_BUSY;
+        }
+    }
+    if(BIODmaTcdChain(bioTxTcd, BIO_DMA_TCD_MAX, frags, nfrags, &(LPUART4->DATA)) == 0){
+        CPU_CRITICAL_EXIT();
+        return BIO_WRV_ERR;
+    }else{
+    }
+    bioTxDma.done = done;
+    bioTxDma.p_arg = p_arg;
+    if(BIO_TX_BUF_CNT() == 0){
+        bioTxDmaStart();
+    }else{                              /* TX ISR starts it when the ring reaches mark */
+        bioTxDma.mark = bioTxBuffer.in;
+        bioTxDma.state = BIO_DMA_QUEUED;
+        BIO_TX_IE_ON();
+    }
+    CPU_CRITICAL_EXIT();
+    return BIO_WRV_OK;
+}
+
+/*******************************************************************************************
+* BIOTxFlush() - Sends everything in the TX ring by polling. For use where interrupts may
+*                be disabled, e.g. an assert handler.
+*******************************************************************************************/
+void BIOTxFlush(void){
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    while(BIO_TX_BUF_CNT() > 0){
+        bioTxPoll();
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*******************************************************************************************
+* LP_FLEXCOMM4_IRQHandler() - LPUART4 RX and TX watermark interrupt
+*    Moves received characters into the RX ring with their arrival time.
+*    Refills the TX FIFO from the ring. Disables TX when the ring is empty and
+*    releases all tasks waiting for space, each rechecks the ring in BIOWrite().
+*******************************************************************************************/
+void LP_FLEXCOMM4_IRQHandler(void){
+    OS_ERR os_err;
+    INT8C c;
+    INT32U room;
+    INT16U stop;
+    INT16U rx_in = bioRxBuffer.in;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    OSIntEnter();
+    CPU_CRITICAL_EXIT();
+
+    while((LPUART4->STAT & LPUART_STAT_RDRF_MASK) != 0){
+        c = (INT8C)(BIO_DATA_RD());
+        if(BIO_RX_BUF_CNT() < BIO_RX_BUF_SIZE){
+            bioRxBuffer.buffer[bioRxBuffer.in & BIO_RX_BUF_MASK] = c;
+            bioRxBuffer.ts[bioRxBuffer.in & BIO_RX_BUF_MASK] = CPU_TS_TmrRd();
+            bioRxBuffer.in++;
+        }else{
+            bioRxBuffer.overruns++;
+        }
+    }
+    if((bioRxBuffer.in != rx_in) && (bioRxBuffer.grp != (OS_FLAG_GRP *)0)){
+        (void)OSFlagPost(bioRxBuffer.grp, bioRxBuffer.grp_flags, OS_OPT_POST_FLAG_SET, &os_err);
+    }else{
+    }
+
+    if(((LPUART4->CTRL & LPUART_CTRL_TIE_MASK) != 0) && ((LPUART4->STAT & LPUART_STAT_TDRE_MASK) != 0)){
+        if(bioTxDma.state == BIO_DMA_QUEUED){
+            stop = bioTxDma.mark;
+        }else{
+            stop = bioTxBuffer.in;
+        }
+        room = BIO_TX_FIFO_SIZE - BIO_TX_FIFO_CNT();
+        while((room > 0) && (bioTxBuffer.out != stop)){
+            BIO_DATA_WR(bioTxBuffer.buffer[bioTxBuffer.out & BIO_TX_BUF_MASK]);
+            bioTxBuffer.out++;
+            room--;
+        }
+        if(bioTxBuffer.out != stop){
+        }else if(bioTxDma.state == BIO_DMA_QUEUED){
+            BIO_TX_IE_OFF();
+            bioTxDmaStart();
+        }else{
+            BIO_TX_IE_OFF();
+        }
+        if(bioTxBuffer.blocked != FALSE){
+            bioTxBuffer.blocked = FALSE;
+            (void)OSSemPost(&(bioTxBuffer.space), OS_OPT_POST_ALL, &os_err);
+        }else{
+        }
+    }else{
+    }
+
+    OSIntExit();
+}
+
+/*******************************************************************************************
+* EDMA_0_CH0_IRQHandler() - TX DMA done interrupt
+*    Hands the transmitter back to the ring, releases tasks waiting in BIOWriteV() and
+*    calls the transfer's done callback.
+*******************************************************************************************/
+void EDMA_0_CH0_IRQHandler(void){
+    OS_ERR os_err;
+    BIO_TX_DONE done;
+    void *p_arg;
+    INT8U blocked;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    OSIntEnter();
+    CPU_CRITICAL_EXIT();
+
+    CPU_CRITICAL_ENTER();
+    BIODmaDoneClr();                    /* Read-modify-writes LPUART4 BAUD, as BIODmaStart() */
+    done = bioTxDma.done;
+    p_arg = bioTxDma.p_arg;
+    bioTxDma.state = BIO_DMA_IDLE;
+    if(BIO_TX_BUF_CNT() > 0){
+        BIO_TX_IE_ON();
+    }else{
+    }
+    blocked = bioTxDma.blocked;
+    bioTxDma.blocked = FALSE;
+    CPU_CRITICAL_EXIT();
+
+    if(blocked != FALSE){
+        (void)OSSemPost(&(bioTxDma.idle), OS_OPT_POST_ALL, &os_err);
+    }else{
+    }
+    if(done != (BIO_TX_DONE)0){
+        done(p_arg);
+    }else{
+    }
+
+    OSIntExit();
 }
 
 /*******************************************************************************************
@@ -331,6 +679,29 @@ void BIOOutHexWord(INT32U bin){
     BIOOutHexByte((INT8U)(bin>>8));
     BIOOutHexByte((INT8U)(bin & 0x000000ff));
 }
+/*******************************************************************************************
+* bioTxPoll() - Moves one character from the TX ring to the FIFO, waiting for FIFO space.
+*               Called with interrupts disabled and the ring not empty. - private
+*******************************************************************************************/
+static void bioTxPoll(void){
+    while(BIO_TX_FIFO_CNT() >= BIO_TX_FIFO_SIZE){}
+    if((bioTxDma.state == BIO_DMA_QUEUED) && (bioTxBuffer.out == bioTxDma.mark)){
+        bioTxDma.mark++;                /* Don't let out pass a queued transfer's mark */
+    }else{
+    }
+    BIO_DATA_WR(bioTxBuffer.buffer[bioTxBuffer.out & BIO_TX_BUF_MASK]);
+    bioTxBuffer.out++;
+}
+
+/*******************************************************************************************
+* bioTxDmaStart() - Starts the chain in bioTxTcd. Called with interrupts disabled, TX
+*                   interrupt off and the ring drained up to the transfer. - private
+*******************************************************************************************/
+static void bioTxDmaStart(void){
+    bioTxDma.state = BIO_DMA_ACTIVE;
+    BIODmaStart(&bioTxTcd[0]);
+}
+
 /*******************************************************************************************
 * bioIsHex() - Checks for hex ascii character - private
 * returns 1 if hex and 0 if not hex.
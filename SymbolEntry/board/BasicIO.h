@@ -9,6 +9,9 @@
 #define BIO_INCL
 
 #include "assert.h"
+#include "cpu.h"
+#include "cpu_core.h"
+#include "os.h"
 
 /******************************************************************************************
  * Defined UART bit rates
@@ -29,12 +32,26 @@ typedef enum {
     BIO_OD_MODE_AL
 } BIO_OUTDEC_MODE;
 
+/*************************************************************************
+* Scatter-gather transmit, BIOWriteV()
+*************************************************************************/
+typedef struct{
+    const INT8C *ptr;       /* Must stay valid until the transfer is done */
+    INT16U len;
+}BIO_FRAG;
+
+typedef void (*BIO_TX_DONE)(void *p_arg);   /* Called from the DMA ISR */
+
+#define BIO_WRV_OK      0   /* Transfer started or queued */
+#define BIO_WRV_BUSY    1   /* A transfer is in progress and caller can't block */
+#define BIO_WRV_ERR     2   /* Nothing to send or too many/too long fragments */
 
 /********************************************************************
 * Public Function Prototypes 
 ********************************************************************/
 /********************************************************************
 * BIOOpen() - Initialization routine for BasicIO()
+*             Call after OSInit().
 * Acceptable rates:
 *  BIO_BIT_RATE_9600
 *  BIO_BIT_RATE_19200
@@ -50,6 +67,20 @@ void BIOOpen(INT8U rate);
 ********************************************************************/
 INT8C BIORead(void);     /* Reads received character, 0 if none */
 
+/********************************************************************
+* BIOReadTs() - BIORead() with the character's arrival time
+*    ts: CPU_TS_TmrRd() when the RX interrupt took the character
+*    return: ASCII character received or 0 if no character received
+********************************************************************/
+INT8C BIOReadTs(CPU_TS *ts);
+
+/********************************************************************
+* BIORxFlagSet() - Have the RX interrupt post flags to grp whenever
+*                  characters arrive, then take them with BIOReadTs()
+*                  until it returns 0. NULL for none.
+********************************************************************/
+void BIORxFlagSet(OS_FLAG_GRP *grp, OS_FLAGS flags);
+
 /********************************************************************
 * BIOGetChar() - Blocks until character is received
 *    return: ASCII character
@@ -74,18 +105,38 @@ INT8C BIOGetChar(void);  /* Blocks until a character is received */
 INT8U BIOGetStrg(INT8U strglen,INT8C *const strg); /*input a string */
 
 /********************************************************************
-* BIOWrite() - Sends an ASCII character
-*              Blocks as much as one character time
+* BIOWrite() - Queues an ASCII character for interrupt driven
+*              transmission. Only blocks when the TX ring is full.
 *    parameter: c is the ASCII character to be sent
 ********************************************************************/
 void BIOWrite(INT8C c);  /* Send an ascii character */
 
+/********************************************************************
+* BIOTxFlush() - Sends all queued characters by polling. Works with
+*                interrupts disabled.
+********************************************************************/
+void BIOTxFlush(void);
+
 /********************************************************************
 * BIOPutStrg() - Sends a C string
 *    parameter: strg is a pointer to the string
 ********************************************************************/
 void BIOPutStrg(const INT8C *const strg);
 
+/********************************************************************
+* BIOWriteV() - Sends nfrags fragments back to back with DMA, without
+*               copying them into the TX ring. Characters already queued
+*               with BIOWrite() go out first. One transfer at a time; a
+*               task blocks until the previous one is done.
+*    parameters: frags - fragment list, copied before return. The data
+*                        each fragment points to must not change until
+*                        done is called.
+*                nfrags - at most BIO_DMA_TCD_MAX (8)
+*                done - optional, called from the DMA ISR with p_arg
+*    return: BIO_WRV_OK, BIO_WRV_BUSY or BIO_WRV_ERR
+********************************************************************/
+INT8U BIOWriteV(const BIO_FRAG *frags, INT8U nfrags, BIO_TX_DONE done, void *p_arg);
+
 /*******************************************************************************************
 * BIOOutDecWord() - Outputs a decimal value of a 32-bit word.
 *    Parameters: binword is the word to be sent,
@@ -5,6 +5,17 @@
 * Requires the following be defined in app_cfg.h:
 *                   APP_CFG_SW_TASK_PRIO
 *                   APP_CFG_SW_TASK_STK_SIZE
+*                   APP_CFG_SW_IRQ_EN
+*
+* With APP_CFG_SW_IRQ_EN the task sleeps until a GPIO edge interrupt,
+* waits for SW_DB_TICKS without further edges and then reads the
+* switches. Otherwise it polls every SW_POLL_TICKS.
+*
+* The debounced switches feed a gesture engine that reports presses,
+* releases, long presses, accelerating auto-repeat, double taps and
+* SW2+SW3 chords (see SW_EVENT and SW_GESTURE_CFG in CsOS_SW.h).
+* Events go to consumers through a single producer (swTask), single
+* consumer lock-free queue; see SwPendBatch().
 *
 * 10/06/2024 TDM
 *********************************************************************
@@ -16,6 +27,7 @@
 #include "FRDM_MCXN947_GPIO.h"
 #include "CsOS_SW.h"
 #include "BasicIO.h"
+#include "CsOS_Trace.h"
 /********************************************************************
 * Module Defines
 * This version is designed for the FRDM_MCXN947 switches, which
@@ -24,17 +36,72 @@
 ********************************************************************/
 typedef enum{SW_OFF,SW_EDGE,SW_VERF} SWSTATES;
 
-/* Simple synchronous buffer to pass switch presses. */
+#define SW_POLL_TICKS   8u      /* Polled mode sample period */
+#define SW_DB_TICKS     5u      /* IRQ mode: quiet time after the last edge */
+
+/* Switch event queue. swTask only writes in, the consumer only writes
+ * out, both free running. flag is posted when the queue goes from
+ * empty to not empty, so a burst costs the consumer one wakeup. With
+ * a flag group set (SwFlagSet()) its flags are posted instead. */
+#define SW_EVQ_MASK     (SW_EVQ_SIZE - 1u)
 typedef struct{
-    INT8U buffer;
+    SW_EVENT events[SW_EVQ_SIZE];
+    volatile INT16U in;
+    volatile INT16U out;
+    INT32U drops;       /* Events lost to a full queue */
     OS_SEM flag;
+    OS_FLAG_GRP *grp;
+    OS_FLAGS grp_flags;
 }SW_BUFFER;
+/* Gesture engine, swTask only. SWSTATES are used per press:
+ *   SW_OFF  - no switch down, or waiting for all up after a chord
+ *             or a change of switch (lockout)
+ *   SW_EDGE - first switch down, waiting out the chord window
+ *   SW_VERF - press reported, timing SW_LONG and SW_REPEAT
+ * Times are OS ticks. */
+typedef struct{
+    SWSTATES state;
+    SW_T keys;          /* Debounced switches */
+    SW_T key;           /* Switch or chord being reported */
+    INT8U lockout;
+    INT8U held;         /* SW_LONG sent for this press */
+    INT8U dbl;          /* This press was a SW_DOUBLE */
+    OS_TICK t_down;     /* First edge */
+    OS_TICK t_next;     /* Next SW_LONG/SW_REPEAT */
+    OS_TICK period;     /* SW_REPEAT period */
+    CPU_TS ts;
+    SW_T last_key;      /* Last plain tap, for SW_DOUBLE */
+    OS_TICK t_up;       /* and when it was released */
+}SW_GESTURE;
+
+#define SW_MS_TICKS(ms)     ((OS_TICK)((((INT32U)(ms) * OS_CFG_TICK_RATE_HZ) + 999u) / 1000u))
+#define SW_TICK_DUE(now,t)  ((OS_TICK)((now) - (t)) < 0x80000000u)
 /********************************************************************
 * Private Resources
 ********************************************************************/
 static void swTask(void *p_arg);
+#if APP_CFG_SW_IRQ_EN
+static void swTaskIrq(void);
+#else
+static void swTaskPoll(void);
+#endif
 static SW_T swScan(void);
+static void swEvPut(SW_T key, SW_EDGE_T edge, CPU_TS ts);
+static INT8U swEvGet(SW_EVENT *events, INT8U max);
+static void swGestureKeys(SW_T keys, OS_TICK t_edge, CPU_TS ts);
+static void swGestureTime(OS_TICK now);
+#if APP_CFG_SW_IRQ_EN
+static OS_TICK swGestureTout(OS_TICK now);
+#endif
+static void swGestureStart(SW_T keys, OS_TICK t_edge, CPU_TS ts);
+static void swGesturePress(void);
+static void swGestureRelease(OS_TICK t_edge, CPU_TS ts);
 static SW_BUFFER swBuffer;
+static SW_GESTURE swGesture;
+static SW_GESTURE_CFG swGestureCfg = {
+    SW_CHORD_MS_DEF, SW_LONG_MS_DEF, SW_REPEAT_MS_DEF, SW_REPEAT_MIN_MS_DEF, SW_REPEAT_PCT_DEF,
+    {SW2_DOUBLE_MS_DEF, SW3_DOUBLE_MS_DEF, SW23_DOUBLE_MS_DEF}
+};
 /**********************************************************************************
 * Allocate task control blocks
 **********************************************************************************/
@@ -45,12 +112,87 @@ static OS_TCB swTaskTCB;
 static CPU_STK swTaskStk[APP_CFG_SW_TASK_STK_SIZE];
 
 /********************************************************************
-* SwPend() - A function to provide access to the switch buffer via a
-*             semaphore.
+* SwPend() - Waits for the next press. Releases are skipped.
 ********************************************************************/
 SW_T SwPend(INT16U tout, OS_ERR *os_err){
-    OSSemPend(&(swBuffer.flag),tout, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, os_err);
-    return(swBuffer.buffer);
+    SW_EVENT event;
+    do{
+        (void)SwPendBatch(&event, 1, tout, os_err);
+    }while((*os_err == OS_ERR_NONE) && (event.edge != SW_PRESS));
+    return (*os_err == OS_ERR_NONE) ? event.key : SWN;
+}
+
+/********************************************************************
+* SwPendBatch() - Copies up to max queued switch events, oldest
+*             first, to events[]. Only pends when the queue is empty.
+*             Single consumer: call from one task only.
+********************************************************************/
+INT8U SwPendBatch(SW_EVENT *events, INT8U max, INT16U tout, OS_ERR *os_err){
+    INT8U n = swEvGet(events, max);
+    while(n == 0){      /* flag can be left over from a burst already read */
+        (void)OSSemPend(&(swBuffer.flag), tout, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, os_err);
+        if(*os_err != OS_ERR_NONE){
+            return 0;
+        }else{
+        }
+        n = swEvGet(events, max);
+    }
+    *os_err = OS_ERR_NONE;
+    return n;
+}
+
+/********************************************************************
+* SwAcceptBatch() - SwPendBatch() that never pends. Returns 0 if the
+*             queue is empty. Single consumer.
+********************************************************************/
+INT8U SwAcceptBatch(SW_EVENT *events, INT8U max){
+    return swEvGet(events, max);
+}
+
+/********************************************************************
+* SwFlagSet() - Post flags to grp instead of the module semaphore
+*             when the queue goes from empty to not empty, so the
+*             consumer can wait on other events too. Posts them now
+*             if events are already queued. NULL goes back to the
+*             semaphore.
+********************************************************************/
+void SwFlagSet(OS_FLAG_GRP *grp, OS_FLAGS flags){
+    OS_ERR os_err;
+    CPU_SR_ALLOC();
+    CPU_CRITICAL_ENTER();
+    swBuffer.grp = grp;
+    swBuffer.grp_flags = flags;
+    CPU_CRITICAL_EXIT();
+    if((grp != (OS_FLAG_GRP *)0) && (swBuffer.in != swBuffer.out)){
+        (void)OSFlagPost(grp, flags, OS_OPT_POST_FLAG_SET, &os_err);
+        assert(os_err == OS_ERR_NONE);
+    }else{
+    }
+}
+
+/********************************************************************
+* SwDropCnt() - Number of events dropped because the queue was full.
+********************************************************************/
+INT32U SwDropCnt(void){
+    return swBuffer.drops;
+}
+
+/********************************************************************
+* SwGestureCfgSet(), SwGestureCfgGet() - Gesture timing. The copy is
+*             done with interrupts off so swTask never sees half of it.
+********************************************************************/
+void SwGestureCfgSet(const SW_GESTURE_CFG *cfg){
+    CPU_SR_ALLOC();
+    CPU_CRITICAL_ENTER();
+    swGestureCfg = *cfg;
+    CPU_CRITICAL_EXIT();
+}
+
+void SwGestureCfgGet(SW_GESTURE_CFG *cfg){
+    CPU_SR_ALLOC();
+    CPU_CRITICAL_ENTER();
+    *cfg = swGestureCfg;
+    CPU_CRITICAL_EXIT();
 }
 
 /********************************************************************
@@ -60,10 +202,24 @@ void SwInit(void){
 
     OS_ERR os_err;
 	/* Switch init */
+#if APP_CFG_SW_IRQ_EN
+    GpioSw2Init(GPIO_IRQ_EE);
+    GpioSw3Init(GPIO_IRQ_EE);
+    SW2_CLR_ISF();
+    SW3_CLR_ISF();
+#else
     GpioSw2Init(GPIO_IRQ_OFF);
     GpioSw3Init(GPIO_IRQ_OFF);
-    // Initialize the Switch Buffer and semaphore
-    swBuffer.buffer = SWN;
+#endif
+    // Initialize the Switch event queue and semaphore
+    swBuffer.in = 0;
+    swBuffer.out = 0;
+    swBuffer.drops = 0;
+    swBuffer.grp = (OS_FLAG_GRP *)0;
+    swGesture.state = SW_OFF;
+    swGesture.keys = SWN;
+    swGesture.lockout = FALSE;
+    swGesture.last_key = SWN;
     OSSemCreate(&(swBuffer.flag),"SW Semaphore",0,&os_err);
     assert(os_err == OS_ERR_NONE);
     //Create the switch task
@@ -81,78 +237,359 @@ void SwInit(void){
                 (OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR),
                 &os_err);
     assert(os_err == OS_ERR_NONE);
+#if APP_CFG_SW_IRQ_EN
+    NVIC_ClearPendingIRQ(GPIO00_IRQn);
+    NVIC_EnableIRQ(GPIO00_IRQn);
+#endif
 
 }
 
 /********************************************************************
 * swTask() - Read and debounce the switches and updates SwBuffer.
-*             It is decomposed into states for detecting and
-*             verifying switch presses. This task should be called
-*             periodically with a period greater than the worst case
-*             switch bounce time and less than the shortest switch
-*             activation time minus the bounce time. The switch must 
-*             be released to have multiple acknowledged presses.
-*             Treats the switches as active low.
 ********************************************************************/
 static void swTask(void *p_arg) {
+    (void)p_arg;
+#if APP_CFG_SW_IRQ_EN
+    swTaskIrq();
+#else
+    swTaskPoll();
+#endif
+}
+
+#if APP_CFG_SW_IRQ_EN
+/********************************************************************
+* swTaskIrq() - Edge triggered debounce. Sleeps on the task semaphore
+*             until GPIO00_IRQHandler() reports an edge, then extends
+*             the debounce window by SW_DB_TICKS for every further
+*             edge. Once the pins have been quiet for SW_DB_TICKS the
+*             switches are read and handed to the gesture engine.
+*             The pend timeout is the engine's next deadline (chord
+*             window, long press, repeat), so the task does not run
+*             at all while no switch is down.
+* (Private)
+********************************************************************/
+static void swTaskIrq(void) {
+    OS_ERR os_err;
+    OS_TICK now;
+    OS_TICK t_edge;
+    CPU_TS edge_ts;
+    while(1){
+        now = OSTimeGet(&os_err);
+        swGestureTime(now);
+        DB0_TURN_OFF();
+        (void)OSTaskSemPend(swGestureTout(now), OS_OPT_PEND_BLOCKING, &edge_ts, &os_err);
+        DB0_TURN_ON();
+#ifdef CS_HOST_POSIX
+        HostSwTaskWake();
+#endif
+        if(os_err == OS_ERR_NONE){
+            t_edge = OSTimeGet(&os_err);
+            do{         /* Debounce window, restarted by each bounce edge */
+                (void)OSTaskSemPend(SW_DB_TICKS, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+            }while(os_err == OS_ERR_NONE);
+            assert(os_err == OS_ERR_TIMEOUT);
+            swGestureKeys(swScan(), t_edge, edge_ts);  /* Timed from the first edge */
+        }else{      /* Gesture deadline */
+            assert(os_err == OS_ERR_TIMEOUT);
+        }
+    }
+}
+
+/********************************************************************
+* GPIO00_IRQHandler() - SW2/SW3 edge interrupt. Wakes swTask, which
+*             does the debouncing.
+********************************************************************/
+void GPIO00_IRQHandler(void){
+    OS_ERR os_err;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    OSIntEnter();
+    CPU_CRITICAL_EXIT();
+
+    SW2_CLR_ISF();
+    SW3_CLR_ISF();
+    CSOS_TRACE_MARK(CSOS_TRACE_MARK_SW_EDGE, 0u);
+    (void)OSTaskSemPost(&swTaskTCB, OS_OPT_POST_NONE, &os_err);
+
+    OSIntExit();
+}
+
+#else
+/********************************************************************
+* swTaskPoll() - Polled debounce. A switch state is accepted when
+*             two samples SW_POLL_TICKS apart agree, so the period
+*             must be greater than the worst case switch bounce time
+*             and less than the shortest switch activation time minus
+*             the bounce time. The gesture engine is run every sample.
+*             Treats the switches as active low.
+* (Private)
+********************************************************************/
+static void swTaskPoll(void) {
 
     OS_ERR os_err;
+    OS_TICK now;
     SW_T cur_sw;
-    SW_T last_sw = 0;
-    SWSTATES swstate = SW_OFF;
-    (void)p_arg;
+    SW_T last_sw = SWN;
+    SW_T db_sw = SWN;
     while(1){
         DB0_TURN_OFF();
-        OSTimeDly(8,OS_OPT_TIME_PERIODIC,&os_err);
+        OSTimeDly(SW_POLL_TICKS,OS_OPT_TIME_PERIODIC,&os_err);
 	    assert(os_err == OS_ERR_NONE);
         DB0_TURN_ON();
-	    /* Get switch input and convert to active high */
+#ifdef CS_HOST_POSIX
+        HostSwTaskWake();
+#endif
+        now = OSTimeGet(&os_err);
 	    cur_sw = swScan();
-        if(swstate == SW_OFF){    /* Sw released state */
-            if(cur_sw != SWN){
-                swstate = SW_EDGE;
-            }else{ /* wait for sw press */
-            }
-        }else if(swstate == SW_EDGE){     /* sw press detected state*/
-            if(cur_sw == last_sw){        /* sw press verified */
-                swstate = SW_VERF;
-                swBuffer.buffer = cur_sw;    /*update buffer */
-                (void)OSSemPost(&(swBuffer.flag), OS_OPT_POST_1, &os_err);   /* Signal new data in buffer */
-        	    assert(os_err == OS_ERR_NONE);
-            }else if( cur_sw == SWN){        /* Invalidated, start over */
-                swstate = SW_OFF;
-            }else{                          /*Invalidated, diff key edge*/
-            }
-        }else if(swstate == SW_VERF){     /* sw press verified state */
-            if((cur_sw == SWN) || (cur_sw != last_sw)){
-                swstate = SW_OFF;
-            }else{ /* wait for release or key change */
-            }
-        }else{ /* In case of error */
-            swstate = SW_OFF;             /* Should never get here */
+        if((cur_sw == last_sw) && (cur_sw != db_sw)){     /* Change verified */
+            db_sw = cur_sw;
+            swGestureKeys(cur_sw, now, OS_TS_GET());
+        }else{      /* Bouncing or no change */
         }
         last_sw = cur_sw;                 /* Save key for next time */
-    
+        swGestureTime(now);
     }
 }
+#endif
+
+/********************************************************************
+* swEvPut() - Producer side of the event queue, swTask only. The
+*             entry is written before in is advanced, so the consumer
+*             never sees a partly written event. Drops the event if
+*             the queue is full.
+* (Private)
+********************************************************************/
+static void swEvPut(SW_T key, SW_EDGE_T edge, CPU_TS ts){
+    OS_ERR os_err;
+    INT16U in = swBuffer.in;
+    SW_EVENT *event;
+
+    if((INT16U)(in - swBuffer.out) >= SW_EVQ_SIZE){
+        swBuffer.drops++;
+    }else{
+        event = &swBuffer.events[in & SW_EVQ_MASK];
+        event->key = key;
+        event->edge = edge;
+        event->ts = ts;
+        CSOS_TRACE_MARK(CSOS_TRACE_MARK_SW_EV, ((INT32U)key << 8) | (INT32U)edge);
+#ifdef CS_HOST_POSIX
+        HostSwEvent((INT32U)key, (INT32U)edge);
+#endif
+        __DMB();
+        swBuffer.in = (INT16U)(in + 1u);
+        __DMB();
+        if(in != swBuffer.out){
+        }else if(swBuffer.grp != (OS_FLAG_GRP *)0){    /* Was empty, wake the consumer */
+            (void)OSFlagPost(swBuffer.grp, swBuffer.grp_flags, OS_OPT_POST_FLAG_SET, &os_err);
+            assert(os_err == OS_ERR_NONE);
+        }else{
+            (void)OSSemPost(&(swBuffer.flag), OS_OPT_POST_1, &os_err);
+            assert(os_err == OS_ERR_NONE);
+        }
+    }
+}
+
+/********************************************************************
+* swEvGet() - Consumer side of the event queue. Copies up to max
+*             events, then releases their slots by advancing out.
+* (Private)
+********************************************************************/
+static INT8U swEvGet(SW_EVENT *events, INT8U max){
+    INT16U out = swBuffer.out;
+    INT16U in = swBuffer.in;
+    INT8U n = 0;
+
+    __DMB();
+    while((out != in) && (n < max)){
+        events[n] = swBuffer.events[out & SW_EVQ_MASK];
+        out++;
+        n++;
+    }
+    __DMB();
+    swBuffer.out = out;
+    return n;
+}
+
+/********************************************************************
+* swGestureKeys() - Gesture engine input: the debounced switches
+*             changed to keys. t_edge and ts are from the first edge.
+* (Private)
+********************************************************************/
+static void swGestureKeys(SW_T keys, OS_TICK t_edge, CPU_TS ts){
+    SW_GESTURE *g = &swGesture;
+
+    if(keys == g->keys){            /* Bounce that settled back */
+        return;
+    }else{
+    }
+    g->keys = keys;
+    if(g->state == SW_EDGE){        /* In the chord window */
+        if(keys == SWN){            /* Tap shorter than the window */
+            swGesturePress();
+            swGestureRelease(t_edge, ts);
+        }else if(keys == SW23){     /* Chord */
+            g->key = SW23;
+            swGesturePress();
+        }else{                      /* Switched keys, report both */
+            swGesturePress();
+            swGestureRelease(t_edge, ts);
+            swGestureStart(keys, t_edge, ts);
+        }
+    }else if(g->state == SW_VERF){
+        /* Any change ends the press. Keys still down from it, or a late
+         * second key, are ignored until everything is up. */
+        swGestureRelease(t_edge, ts);
+        g->lockout = (INT8U)((keys & g->key) != 0);
+        swGestureStart(keys, t_edge, ts);
+    }else{
+        swGestureStart(keys, t_edge, ts);
+    }
+}
+
+/********************************************************************
+* swGestureStart() - A switch went down from SW_OFF. Both at once is
+*             a chord at once, as is any switch with chords off.
+* (Private)
+********************************************************************/
+static void swGestureStart(SW_T keys, OS_TICK t_edge, CPU_TS ts){
+    SW_GESTURE *g = &swGesture;
+
+    if(keys == SWN){
+        g->lockout = FALSE;
+    }else if(g->lockout == FALSE){
+        g->key = keys;
+        g->t_down = t_edge;
+        g->ts = ts;
+        if((keys == SW23) || (swGestureCfg.chord_ms == 0)){
+            swGesturePress();
+        }else{
+            g->state = SW_EDGE;
+        }
+    }else{      /* Wait for all up */
+    }
+}
+
+/********************************************************************
+* swGesturePress() - Report the press, or SW_DOUBLE if the same key
+*             was tapped and released within its double_ms.
+* (Private)
+********************************************************************/
+static void swGesturePress(void){
+    SW_GESTURE *g = &swGesture;
+    INT16U dbl_ms = swGestureCfg.double_ms[g->key - 1u];
+
+    if((dbl_ms != 0) && (g->key == g->last_key) &&
+       ((OS_TICK)(g->t_down - g->t_up) <= SW_MS_TICKS(dbl_ms))){
+        g->dbl = TRUE;
+        swEvPut(g->key, SW_DOUBLE, g->ts);
+    }else{
+        g->dbl = FALSE;
+        swEvPut(g->key, SW_PRESS, g->ts);
+    }
+    g->state = SW_VERF;
+    g->held = FALSE;
+    g->t_next = g->t_down + SW_MS_TICKS(swGestureCfg.long_ms);
+    g->period = SW_MS_TICKS(swGestureCfg.repeat_ms);
+}
+
+/********************************************************************
+* swGestureRelease() - Report the release. A plain tap can start a
+*             double tap; a double tap or a long press cannot.
+* (Private)
+********************************************************************/
+static void swGestureRelease(OS_TICK t_edge, CPU_TS ts){
+    SW_GESTURE *g = &swGesture;
+
+    swEvPut(g->key, SW_RELEASE, ts);
+    if((g->dbl == FALSE) && (g->held == FALSE)){
+        g->last_key = g->key;
+    }else{
+        g->last_key = SWN;
+    }
+    g->t_up = t_edge;
+    g->state = SW_OFF;
+}
+
+/********************************************************************
+* swGestureTime() - Gesture engine timers: end of the chord window,
+*             then SW_LONG and SW_REPEAT while held. Each repeat
+*             period is repeat_pct of the last, down to repeat_min_ms.
+* (Private)
+********************************************************************/
+static void swGestureTime(OS_TICK now){
+    SW_GESTURE *g = &swGesture;
+    OS_TICK min;
+
+    if((g->state == SW_EDGE) &&
+       SW_TICK_DUE(now, g->t_down + SW_MS_TICKS(swGestureCfg.chord_ms))){
+        swGesturePress();
+    }else{
+    }
+    if((g->state == SW_VERF) && (swGestureCfg.long_ms != 0) && SW_TICK_DUE(now, g->t_next)){
+        if(g->held == FALSE){
+            g->held = TRUE;
+            swEvPut(g->key, SW_LONG, OS_TS_GET());
+        }else{
+            swEvPut(g->key, SW_REPEAT, OS_TS_GET());
+            min = SW_MS_TICKS(swGestureCfg.repeat_min_ms);
+            g->period = (g->period * swGestureCfg.repeat_pct) / 100u;
+            if(g->period < min){
+                g->period = min;
+            }else{
+            }
+        }
+        g->t_next += g->period;
+        if(SW_TICK_DUE(now, g->t_next)){    /* Late, do not burst */
+            g->t_next = now + g->period;
+        }else{
+        }
+    }else{
+    }
+}
+
+#if APP_CFG_SW_IRQ_EN
+/********************************************************************
+* swGestureTout() - Ticks until the next gesture deadline, 0 (no
+*             timeout) when there is none.
+* (Private)
+********************************************************************/
+static OS_TICK swGestureTout(OS_TICK now){
+    SW_GESTURE *g = &swGesture;
+    OS_TICK tout;
+
+    if(g->state == SW_EDGE){
+        tout = g->t_down + SW_MS_TICKS(swGestureCfg.chord_ms) - now;
+    }else if((g->state == SW_VERF) && (swGestureCfg.long_ms != 0)){
+        tout = g->t_next - now;
+    }else{
+        return 0;
+    }
+    if((tout == 0) || (tout >= 0x80000000u)){     /* Due or overdue */
+        tout = 1;
+    }else{
+    }
+    return tout;
+}
+#endif
 
 /********************************************************************
 * swScan() - Scans the SW2 and SW3 on the FRDM-MCXN947 board and
 *            returns a switch code. Assumes switches are active low.
-*           - Only allows one switch to be pressed at a time.
+*           - Both down is SW23.
 * (Private)
 ********************************************************************/
 static SW_T swScan(void) {
     INT32U sw_bits;
-    INT8U swcode;
+    INT8U swcode = SWN;
     sw_bits = (SW2_INPUT|SW3_INPUT);
     if((sw_bits & GPIO_PIN(SW2_BIT)) == 0){
-        swcode = SW2;
-    }else if((sw_bits & GPIO_PIN(SW3_BIT)) == 0){
-        swcode = SW3;
+        swcode |= SW2;
+    }else{
+    }
+    if((sw_bits & GPIO_PIN(SW3_BIT)) == 0){
+        swcode |= SW3;
     }else{
-        swcode = SWN;
     }
-    return swcode;
+    return (SW_T)swcode;
 }
-
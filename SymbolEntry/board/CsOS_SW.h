@@ -14,9 +14,61 @@
 #ifndef CS_SW_DEF
 #define CS_SW_DEF
 /*********************************************************************
-* SW_T - Switch values
+* SW_T - Switch values. A bit per switch, SW23 is the SW2+SW3 chord.
 ********************************************************************/
-typedef enum {SWN,SW2,SW3} SW_T;
+typedef enum {SWN,SW2,SW3,SW23} SW_T;
+
+/*********************************************************************
+* SW_EVENT - Switch event, queued by the switch task
+*          key - SW2, SW3 or SW23
+*          edge - gesture:
+*               SW_PRESS   key down (after the chord window)
+*               SW_RELEASE key up
+*               SW_LONG    held for long_ms, once per press
+*               SW_REPEAT  still held, at an accelerating rate
+*               SW_DOUBLE  replaces SW_PRESS for a second press
+*                          within double_ms of the last release
+*          ts - CPU_TS of the first edge (IRQ mode) or of the sample
+*               that verified it (polled mode)
+********************************************************************/
+typedef enum {SW_PRESS,SW_RELEASE,SW_LONG,SW_REPEAT,SW_DOUBLE} SW_EDGE_T;
+
+typedef struct{
+    SW_T key;
+    SW_EDGE_T edge;
+    CPU_TS ts;
+}SW_EVENT;
+
+#define SW_EVQ_SIZE     16u     /* Queue depth, must be a power of two */
+
+/*********************************************************************
+* SW_GESTURE_CFG - Gesture timing, in ms. See SwGestureCfgSet().
+*          chord_ms - a second switch down within this of the first
+*               is SW23. Single presses are reported this late.
+*               0 turns chords off.
+*          long_ms - hold time for SW_LONG, 0 turns LONG and REPEAT off
+*          repeat_ms - first SW_REPEAT period after SW_LONG
+*          repeat_min_ms - shortest SW_REPEAT period
+*          repeat_pct - each period is this % of the one before
+*          double_ms[] - SW2, SW3, SW23 double tap window, 0 is off
+********************************************************************/
+typedef struct{
+    INT16U chord_ms;
+    INT16U long_ms;
+    INT16U repeat_ms;
+    INT16U repeat_min_ms;
+    INT8U repeat_pct;
+    INT16U double_ms[SW23];
+}SW_GESTURE_CFG;
+
+#define SW_CHORD_MS_DEF         40u
+#define SW_LONG_MS_DEF          500u
+#define SW_REPEAT_MS_DEF        200u
+#define SW_REPEAT_MIN_MS_DEF    40u
+#define SW_REPEAT_PCT_DEF       80u
+#define SW2_DOUBLE_MS_DEF       300u
+#define SW3_DOUBLE_MS_DEF       0u      /* Two quick sends are two sends */
+#define SW23_DOUBLE_MS_DEF      300u    /* Starts or cancels a composition (menu.h) */
 
 /*********************************************************************
 * SWPend - Pend on SW press
@@ -27,6 +79,49 @@ typedef enum {SWN,SW2,SW3} SW_T;
 ********************************************************************/
 SW_T SwPend(INT16U tout, OS_ERR *os_err);
 
+/*********************************************************************
+* SwPendBatch - Pend on switch events and take all that are queued
+*          events - destination, room for max events
+*          tout - semaphore timeout, only used when the queue is empty
+*          *err - destination of err code
+*          return - number of events copied, 0 on timeout/error
+*
+*          Events are copied oldest first. A burst of presses
+*          is returned by one call. Only one task may consume events,
+*          through either SwPend or SwPendBatch.
+********************************************************************/
+INT8U SwPendBatch(SW_EVENT *events, INT8U max, INT16U tout, OS_ERR *os_err);
+
+/*********************************************************************
+* SwAcceptBatch - SwPendBatch without pending
+*          return - number of events copied, 0 if none are queued
+*
+* SwFlagSet - Wait on switch events together with other events
+*          grp - flag group the consumer pends on, NULL for none
+*          flags - posted (set) to grp when the queue goes from empty
+*               to not empty, and by this call if it is not empty.
+*               The consumer then takes events with SwAcceptBatch
+*               until it returns 0.
+*
+*          While a group is set SwPend and SwPendBatch only return
+*          events that are already queued and otherwise time out.
+********************************************************************/
+INT8U SwAcceptBatch(SW_EVENT *events, INT8U max);
+void SwFlagSet(OS_FLAG_GRP *grp, OS_FLAGS flags);
+
+/*********************************************************************
+* SwDropCnt - Number of events lost because the queue was full
+********************************************************************/
+INT32U SwDropCnt(void);
+
+/*********************************************************************
+* SwGestureCfgSet - Change the gesture timing. Can be called from
+*          any task.
+* SwGestureCfgGet - Copy the timing in use, defaults after SwInit()
+********************************************************************/
+void SwGestureCfgSet(const SW_GESTURE_CFG *cfg);
+void SwGestureCfgGet(SW_GESTURE_CFG *cfg);
+
 /*********************************************************************
 * SWInit
 ********************************************************************/
@@ -0,0 +1,169 @@
+/******************************************************************************************
+ * CsOS_Tick.c - Dynamic Cs/OS3 tick on LPTMR1, see CsOS_Tick.h.
+ ******************************************************************************************/
+#include "MCUType.h"
+#include "os.h"
+#include "CsOS_Tick.h"
+
+#if (OS_CFG_DYN_TICK_EN > 0u)
+
+#define CSOS_TICK_CNTS  (CSOS_TICK_CLK_HZ / OS_CFG_TICK_RATE_HZ)   /* LPTMR counts per tick */
+
+/* LPTMR1 register access. CNR is latched by a write before it is read. The host build
+ * models the counter and the compare in host/host_bsp.c. */
+#ifdef CS_HOST_POSIX
+#define TICK_CSR_WR(v)  HostLptmrCsrWr(LPTMR1, (uint32_t)(v))
+#define TICK_CNR_RD()   HostLptmrCnrRd(LPTMR1)
+#else
+#define TICK_CSR_WR(v)  (LPTMR1->CSR = (INT32U)(v))
+#define TICK_CNR_RD()   (LPTMR1->CNR = 0u, LPTMR1->CNR)
+#endif
+
+static OS_TICK csosTickBase;            /* OSTickCtr when the counter was started */
+static INT32U csosTickCarry;            /* Counts past csosTickBase at the start */
+static INT8U csosTickRunning = FALSE;
+
+static void csosTickStart(OS_TICK ticks, INT32U cnt);
+
+/******************************************************************************************
+ * CsOSTickInit()
+ ******************************************************************************************/
+void CsOSTickInit(void){
+    CPU_SR_ALLOC();
+
+    /* Enable clock path for LPTMR */
+    SYSCON->CLOCK_CTRL |= SYSCON_CLOCK_CTRL_CLKIN_ENA_FM_USBH_LPT(1);
+    TICK_CSR_WR(LPTMR_CSR_TEN(0));
+    LPTMR1->PSR = LPTMR_PSR_PCS(3) | LPTMR_PSR_PBYP(1);
+    NVIC_ClearPendingIRQ(LPTMR1_IRQn);
+    NVIC_EnableIRQ(LPTMR1_IRQn);
+
+    /* Program the step the kernel asked for before the timer ran */
+    CPU_CRITICAL_ENTER();
+    csosTickBase = OSTickCtr;
+    csosTickCarry = 0u;
+    csosTickRunning = TRUE;
+    (void)OS_DynTickSet(OSTickCtrStep);
+    CPU_CRITICAL_EXIT();
+}
+
+/******************************************************************************************
+ * OS_DynTickGet() - Ticks gone by since the kernel last advanced OSTickCtr. Masks
+ *                   interrupts itself: with OS_CFG_ISR_POST_DEFERRED_EN the kernel calls
+ *                   it with only the scheduler locked.
+ ******************************************************************************************/
+OS_TICK OS_DynTickGet(void){
+    OS_TICK hw;
+    OS_TICK done;
+    CPU_SR_ALLOC();
+
+    if(csosTickRunning == FALSE){
+        return 0u;
+    }else{
+    }
+    CPU_CRITICAL_ENTER();
+    hw = (OS_TICK)((csosTickCarry + TICK_CNR_RD()) / CSOS_TICK_CNTS);
+    done = OSTickCtr - csosTickBase;
+    CPU_CRITICAL_EXIT();
+    return (hw > done) ? (hw - done) : 0u;
+}
+
+/******************************************************************************************
+ * OS_DynTickSet() - Interrupt in ticks from OSTickCtr, 0 for no timeout. The kernel has
+ *                   already added the elapsed ticks to OSTickCtr. Masks interrupts
+ *                   itself, as OS_DynTickGet() does.
+ *    return: the step programmed, which is capped at CSOS_TICK_STEP_MAX
+ ******************************************************************************************/
+OS_TICK OS_DynTickSet(OS_TICK ticks){
+    CPU_SR_ALLOC();
+
+    if((ticks == 0u) || (ticks > CSOS_TICK_STEP_MAX)){
+        ticks = CSOS_TICK_STEP_MAX;
+    }else{
+    }
+    if(csosTickRunning != FALSE){
+        CPU_CRITICAL_ENTER();
+        csosTickStart(ticks, TICK_CNR_RD());
+        CPU_CRITICAL_EXIT();
+    }else{
+    }
+    return ticks;
+}
+
+/******************************************************************************************
+ * csosTickStart() - Restart the counter with its compare ticks from OSTickCtr. cnt is
+ *                   CNR just before the restart; the counts it holds past the ticks the
+ *                   kernel has taken are carried into the new run.
+ ******************************************************************************************/
+static void csosTickStart(OS_TICK ticks, INT32U cnt){
+    OS_TICK hw;
+    OS_TICK done;
+    INT32U cmp;
+
+    TICK_CSR_WR(LPTMR_CSR_TEN(0));         /* Stops and clears CNR and TCF */
+
+    hw = (OS_TICK)((csosTickCarry + cnt) / CSOS_TICK_CNTS);
+    done = OSTickCtr - csosTickBase;
+    if(done > hw){
+        done = hw;
+    }else{
+    }
+    csosTickCarry = csosTickCarry + cnt - ((INT32U)done * CSOS_TICK_CNTS);
+    csosTickBase = OSTickCtr;
+
+    /* TCF sets as CNR goes past CMR, at carry + CMR + 1 = ticks * CSOS_TICK_CNTS */
+    cmp = (INT32U)ticks * CSOS_TICK_CNTS;
+    cmp = (cmp > (csosTickCarry + 1u)) ? (cmp - csosTickCarry - 1u) : 0u;
+    LPTMR1->CMR = LPTMR_CMR_COMPARE(cmp);
+    NVIC_ClearPendingIRQ(LPTMR1_IRQn);
+    TICK_CSR_WR(LPTMR_CSR_TEN(1) | LPTMR_CSR_TFC(1) | LPTMR_CSR_TIE(1));
+}
+
+/******************************************************************************************
+ * CsOSTickIdle() - The core clock, and with it the DWT cycle counter behind
+ *                  CPU_TS_TmrRd(), stops in WFI; LPTMR1 keeps counting.
+ ******************************************************************************************/
+INT32U CsOSTickIdle(void){
+    INT32U start;
+    INT32U cnt;
+
+    CPU_IntDis();
+    if(csosTickRunning != FALSE){
+        start = TICK_CNR_RD();
+        CPU_WaitForInt();
+        cnt = TICK_CNR_RD() - start;
+    }else{
+        CPU_WaitForInt();
+        cnt = 0u;
+    }
+    CPU_IntEn();
+    return cnt;
+}
+
+/******************************************************************************************
+ * LPTMR1_IRQHandler() - Compare match: the step has run out. Hands the elapsed ticks to
+ *                   the kernel, which readies the tasks due and programs the next step.
+ *                   A match left over from a step that was replaced finds no whole tick
+ *                   and does nothing.
+ ******************************************************************************************/
+void LPTMR1_IRQHandler(void){
+    OS_TICK ticks;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    OSIntEnter();
+    TICK_CSR_WR(LPTMR_CSR_TEN(1) | LPTMR_CSR_TFC(1) | LPTMR_CSR_TIE(1) | LPTMR_CSR_TCF(1));
+    ticks = OS_DynTickGet();
+    if(ticks != 0u){
+        OSTimeDynTick(ticks);
+    }else{
+    }
+#ifdef CS_HOST_POSIX
+    HostTickIrq((uint32_t)ticks);
+#endif
+    CPU_CRITICAL_EXIT();
+
+    OSIntExit();
+}
+
+#endif /* OS_CFG_DYN_TICK_EN */
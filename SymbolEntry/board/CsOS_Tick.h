@@ -0,0 +1,45 @@
+/******************************************************************************************
+ * CsOS_Tick.h - Dynamic (tickless) Cs/OS3 tick on LPTMR1.
+ *
+ * With OS_CFG_DYN_TICK_EN the kernel no longer takes an interrupt every tick. It tells
+ * the BSP how many ticks away the next timeout is (OS_DynTickSet()) and asks how many
+ * ticks have gone by since it last counted them (OS_DynTickGet()). This module keeps
+ * the time in LPTMR1, a free running 32-bit counter on the 24MHz LPTMR clock, and
+ * sets its compare to the next timeout. The interrupt hands the elapsed ticks to
+ * OSTimeDynTick(), so an idle system takes one interrupt per timeout instead of
+ * OS_CFG_TICK_RATE_HZ, and the core sleeps in WFI (App_OS_IdleTaskHook()) in between.
+ *
+ * A new step restarts the counter. The counts into the current tick are carried over,
+ * so the kernel time does not drift by a partial tick per restart; only the few counts
+ * between reading CNR and restarting are lost.
+ *
+ * The host build (CS_HOST_POSIX) runs the same code on the LPTMR1 model in
+ * host/host_bsp.c, which reports the interrupt rate and the kernel time error on exit.
+ ******************************************************************************************/
+#ifndef CSOS_TICK_INCL
+#define CSOS_TICK_INCL
+
+/******************************************************************************************
+ * Configuration
+ ******************************************************************************************/
+#define CSOS_TICK_CLK_HZ    24000000u   /* LPTMR PSR_PCS(3), prescaler bypassed */
+#define CSOS_TICK_STEP_MAX  100000u     /* Longest step in ticks, keeps the counter from
+                                           wrapping: 100s at 1kHz is 2.4e9 counts */
+
+/******************************************************************************************
+ * CsOSTickInit() - Starts the dynamic tick. Call once from the start task, where the
+ *                  periodic build calls OS_CPU_SysTickInitFreq(). The kernel time before
+ *                  this call does not advance.
+ ******************************************************************************************/
+void CsOSTickInit(void);
+
+/******************************************************************************************
+ * CsOSTickIdle() - Sleeps in WFI until the next interrupt, for the idle task hook.
+ *                  Interrupts are masked around the sleep, so the counter cannot be
+ *                  restarted while it is read; WFI still wakes on the pending interrupt,
+ *                  which runs once this returns.
+ *    return: LPTMR counts spent asleep, 0 before CsOSTickInit()
+ ******************************************************************************************/
+INT32U CsOSTickIdle(void);
+
+#endif
@@ -0,0 +1,125 @@
+/******************************************************************************************
+ * CsOS_Trace.c - Cs/OS3 trace recorder, see CsOS_Trace.h.
+ ******************************************************************************************/
+#include "MCUType.h"
+#include "CsOS_Trace.h"
+
+#if (OS_CFG_TRACE_EN > 0u)
+
+#define CSOS_TRACE_MASK (CSOS_TRACE_SIZE - 1u)
+
+#if ((CSOS_TRACE_SIZE & CSOS_TRACE_MASK) != 0u)
+#error "CSOS_TRACE_SIZE must be a power of 2"
+#endif
+
+/* Exception number of the running ISR. The host port keeps it for its signal handler. */
+#ifdef CS_HOST_POSIX
+#define TRACE_IPSR()    CPU_HostIntCurGet()
+#else
+#define TRACE_IPSR()    ((CPU_INT08U)__get_IPSR())
+#endif
+
+static CSOS_TRACE_EV csosTraceBuf[CSOS_TRACE_SIZE];
+static CPU_INT32U csosTraceHead = 0u;           /* Records claimed since the start */
+static CPU_INT08U csosTraceOn = TRUE;
+static CSOS_TRACE_OBJ csosTraceObj[CSOS_TRACE_OBJ_MAX];
+static CPU_INT08U csosTraceObjCnt = 0u;
+
+/******************************************************************************************
+ * CsOSTraceRec()
+ ******************************************************************************************/
+void CsOSTraceRec(CPU_INT08U type, CPU_INT08U id, CPU_INT16U arg){
+    CSOS_TRACE_EV *ev;
+
+    if(__atomic_load_n(&csosTraceOn, __ATOMIC_RELAXED) == FALSE){
+        return;
+    }else{
+    }
+    ev = &csosTraceBuf[__atomic_fetch_add(&csosTraceHead, 1u, __ATOMIC_RELAXED) & CSOS_TRACE_MASK];
+    ev->type = CSOS_TRACE_NONE;
+    ev->ts = (CPU_INT32U)CPU_TS_TmrRd();
+    ev->id = id;
+    ev->arg = arg;
+    __atomic_store_n(&ev->type, type, __ATOMIC_RELEASE);
+}
+
+/******************************************************************************************
+ * CsOSTraceIsrEnter()
+ ******************************************************************************************/
+void CsOSTraceIsrEnter(CPU_INT08U nesting){
+    CsOSTraceRec(CSOS_TRACE_ISR_ENTER, TRACE_IPSR(), nesting);
+}
+
+/******************************************************************************************
+ * CsOSTraceObjNew()
+ ******************************************************************************************/
+CPU_INT08U CsOSTraceObjNew(CPU_INT08U kind, const CPU_CHAR *name, CPU_INT08U prio){
+    CPU_INT08U i = __atomic_fetch_add(&csosTraceObjCnt, 1u, __ATOMIC_RELAXED);
+
+    if(i >= CSOS_TRACE_OBJ_MAX){
+        csosTraceObjCnt = CSOS_TRACE_OBJ_MAX;
+        return 0u;
+    }else{
+    }
+    csosTraceObj[i].name = name;
+    csosTraceObj[i].kind = kind;
+    csosTraceObj[i].prio = prio;
+    return (CPU_INT08U)(i + 1u);
+}
+
+/******************************************************************************************
+ * CsOSTraceObjGet()
+ ******************************************************************************************/
+const CSOS_TRACE_OBJ *CsOSTraceObjGet(CPU_INT08U id){
+    if((id == 0u) || (id > csosTraceObjCnt) || (id > CSOS_TRACE_OBJ_MAX)){
+        return (const CSOS_TRACE_OBJ *)0;
+    }else{
+    }
+    return &csosTraceObj[id - 1u];
+}
+
+/******************************************************************************************
+ * CsOSTraceStop()
+ ******************************************************************************************/
+void CsOSTraceStop(void){
+    __atomic_store_n(&csosTraceOn, FALSE, __ATOMIC_SEQ_CST);
+}
+
+/******************************************************************************************
+ * CsOSTraceStart()
+ ******************************************************************************************/
+void CsOSTraceStart(void){
+    CPU_INT32U i;
+
+    for(i = 0u; i < CSOS_TRACE_SIZE; i++){
+        csosTraceBuf[i].type = CSOS_TRACE_NONE;
+    }
+    __atomic_store_n(&csosTraceHead, 0u, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&csosTraceOn, TRUE, __ATOMIC_SEQ_CST);
+}
+
+/******************************************************************************************
+ * CsOSTraceCount()
+ ******************************************************************************************/
+CPU_INT32U CsOSTraceCount(void){
+    CPU_INT32U head = __atomic_load_n(&csosTraceHead, __ATOMIC_SEQ_CST);
+    return (head > CSOS_TRACE_SIZE) ? CSOS_TRACE_SIZE : head;
+}
+
+/******************************************************************************************
+ * CsOSTraceLost()
+ ******************************************************************************************/
+CPU_INT32U CsOSTraceLost(void){
+    CPU_INT32U head = __atomic_load_n(&csosTraceHead, __ATOMIC_SEQ_CST);
+    return (head > CSOS_TRACE_SIZE) ? (head - CSOS_TRACE_SIZE) : 0u;
+}
+
+/******************************************************************************************
+ * CsOSTraceEvGet()
+ ******************************************************************************************/
+const CSOS_TRACE_EV *CsOSTraceEvGet(CPU_INT32U i){
+    CPU_INT32U head = __atomic_load_n(&csosTraceHead, __ATOMIC_SEQ_CST);
+    return &csosTraceBuf[(head - CsOSTraceCount() + i) & CSOS_TRACE_MASK];
+}
+
+#endif /* OS_CFG_TRACE_EN */
@@ -0,0 +1,123 @@
+/******************************************************************************************
+ * CsOS_Trace.h - Cs/OS3 trace recorder.
+ *
+ * With OS_CFG_TRACE_EN (os_cfg.h, needs OS_CFG_DBG_EN) the kernel's OS_TRACE_* hooks,
+ * mapped in Cs-CFG/os_trace_events.h, write 8-byte records into a RAM ring: task
+ * switches, ISR enter and exit, semaphore and task semaphore post/pend, tick updates and
+ * tick list updates. The application adds its own points with CSOS_TRACE_MARK().
+ *
+ * Records are stamped with CPU_TS_TmrRd() (DWT CYCCNT on the target, ns in the host
+ * build). A writer claims its slot with one atomic add on the ring head and fills it in
+ * place, so recording does not mask interrupts and an ISR can record over a task
+ * half way through its own record. The type is written last, so a slot read while it is
+ * being filled shows CSOS_TRACE_NONE. The ring keeps the last CSOS_TRACE_SIZE records.
+ *
+ * To read the ring, stop it, walk it oldest first with CsOSTraceEvGet() and start it
+ * again. SendTrace() in menu.c streams it over BasicIO when the receiver sends
+ * MENU_CMD_TRACE; SymbolReceiver/trace2json.py turns the dump into Chrome/Perfetto JSON.
+ *
+ * Without OS_CFG_TRACE_EN only CSOS_TRACE_MARK() is defined, and it compiles to nothing.
+ ******************************************************************************************/
+#ifndef CSOS_TRACE_INCL
+#define CSOS_TRACE_INCL
+
+#include "cpu.h"
+#include "cpu_core.h"
+#include "os_cfg.h"
+
+/******************************************************************************************
+ * Application marks, the id of a CSOS_TRACE_USER record
+ ******************************************************************************************/
+#define CSOS_TRACE_MARK_SW_EDGE 1u      /* GPIO00 switch edge, arg: 0 */
+#define CSOS_TRACE_MARK_SW_EV   2u      /* Switch event queued, arg: key << 8 | edge */
+#define CSOS_TRACE_MARK_IDX     3u      /* Symbol selected, arg: symbol index */
+#define CSOS_TRACE_MARK_SENT    4u      /* Symbol sent, arg: symbol index */
+
+#if (OS_CFG_TRACE_EN > 0u)
+
+/******************************************************************************************
+ * Configuration
+ ******************************************************************************************/
+#define CSOS_TRACE_SIZE     1024u       /* Records in the ring, a power of 2 */
+#define CSOS_TRACE_OBJ_MAX  16u         /* Named tasks and semaphores */
+
+/******************************************************************************************
+ * Record types. The values are the stream format, SymbolReceiver/trace2json.py knows them.
+ ******************************************************************************************/
+#define CSOS_TRACE_NONE             0u  /* Slot being written */
+#define CSOS_TRACE_TASK_IN          1u  /* id: task, arg: priority */
+#define CSOS_TRACE_TASK_READY       2u  /* id: task */
+#define CSOS_TRACE_ISR_ENTER        3u  /* id: exception number (IPSR), arg: nesting */
+#define CSOS_TRACE_ISR_EXIT         4u  /* arg: nesting left */
+#define CSOS_TRACE_ISR_EXIT_SCHED   5u  /* ISR exit that switches task */
+#define CSOS_TRACE_SEM_POST         6u  /* id: semaphore */
+#define CSOS_TRACE_SEM_PEND         7u  /* id: semaphore, taken without blocking */
+#define CSOS_TRACE_SEM_PEND_BLOCK   8u  /* id: semaphore */
+#define CSOS_TRACE_TSEM_POST        9u  /* id: task posted to */
+#define CSOS_TRACE_TSEM_PEND        10u /* id: task */
+#define CSOS_TRACE_TSEM_PEND_BLOCK  11u /* id: task */
+#define CSOS_TRACE_TICK             12u /* arg: OSTickCtr, low 16 bits */
+#define CSOS_TRACE_TICK_LIST_BEGIN  13u /* arg: ticks passed to OS_TickListUpdate() */
+#define CSOS_TRACE_TICK_LIST_END    14u /* arg: tasks readied or timed out */
+#define CSOS_TRACE_USER             15u /* CSOS_TRACE_MARK(), id: CSOS_TRACE_MARK_x, arg: see the mark */
+
+#define CSOS_TRACE_OBJ_TASK         'T'
+#define CSOS_TRACE_OBJ_SEM          'S'
+
+typedef struct{
+    CPU_INT32U ts;          /* CPU_TS_TmrRd() */
+    CPU_INT08U type;        /* CSOS_TRACE_x */
+    CPU_INT08U id;          /* Object ID (1 up, 0 unknown), IRQ or mark */
+    CPU_INT16U arg;
+}CSOS_TRACE_EV;
+
+typedef struct{
+    const CPU_CHAR *name;
+    CPU_INT08U kind;        /* CSOS_TRACE_OBJ_TASK or CSOS_TRACE_OBJ_SEM */
+    CPU_INT08U prio;        /* Task priority at creation */
+}CSOS_TRACE_OBJ;
+
+/******************************************************************************************
+ * CsOSTraceRec() - Adds a record. Any context, no locks.
+ ******************************************************************************************/
+void CsOSTraceRec(CPU_INT08U type, CPU_INT08U id, CPU_INT16U arg);
+
+/******************************************************************************************
+ * CsOSTraceIsrEnter() - CSOS_TRACE_ISR_ENTER with the running exception number.
+ ******************************************************************************************/
+void CsOSTraceIsrEnter(CPU_INT08U nesting);
+
+/******************************************************************************************
+ * CsOSTraceObjNew() - Names a task or semaphore as it is created.
+ *    return: its ID for records, 0 once CSOS_TRACE_OBJ_MAX are taken
+ ******************************************************************************************/
+CPU_INT08U CsOSTraceObjNew(CPU_INT08U kind, const CPU_CHAR *name, CPU_INT08U prio);
+
+/******************************************************************************************
+ * CsOSTraceObjGet() - Object id, a null pointer if there is none.
+ ******************************************************************************************/
+const CSOS_TRACE_OBJ *CsOSTraceObjGet(CPU_INT08U id);
+
+/******************************************************************************************
+ * CsOSTraceStop(), CsOSTraceStart() - Stop recording to read the ring, then clear it and
+ *                  record again. Recording is on from reset.
+ ******************************************************************************************/
+void CsOSTraceStop(void);
+void CsOSTraceStart(void);
+
+/******************************************************************************************
+ * CsOSTraceCount() - Records held, up to CSOS_TRACE_SIZE.
+ * CsOSTraceLost()  - Records overwritten since the last start.
+ * CsOSTraceEvGet() - Record i, 0 the oldest. Only while stopped.
+ ******************************************************************************************/
+CPU_INT32U CsOSTraceCount(void);
+CPU_INT32U CsOSTraceLost(void);
+const CSOS_TRACE_EV *CsOSTraceEvGet(CPU_INT32U i);
+
+#define CSOS_TRACE_MARK(mark, arg)  CsOSTraceRec(CSOS_TRACE_USER, (CPU_INT08U)(mark), (CPU_INT16U)(arg))
+
+#else
+#define CSOS_TRACE_MARK(mark, arg)
+#endif /* OS_CFG_TRACE_EN */
+
+#endif
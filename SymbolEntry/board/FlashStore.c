@@ -0,0 +1,265 @@
+/******************************************************************************************
+ * FlashStore.c - One small record in a dedicated flash sector, see FlashStore.h.
+ ******************************************************************************************/
+#include "MCUType.h"
+#include "FlashStore.h"
+#include "cpu.h"
+#include <string.h>
+
+#define FLASH_STORE_SLOTS   (FLASH_STORE_SECTOR_SIZE / FLASH_STORE_SLOT_SIZE)
+#define FLASH_STORE_NONE    0xFFFFu
+
+/* Slot header, bytes only so the layout is the same in the host build. Multi-byte
+ * fields are little endian. An erased slot reads seq 0xFFFFFFFF. */
+typedef struct{
+    INT8U seq[4];
+    INT8U len;
+    INT8U rsvd;
+    INT8U crc[2];       /* CRC-16/CCITT-FALSE over len and data */
+}FLASH_STORE_HDR;
+
+static INT16U flashStoreLatest(INT32U *seq);
+static INT8U flashStoreSlotValid(const INT8U *slot);
+static INT8U flashStoreSlotErased(const INT8U *slot);
+static INT16U flashStoreCrc(INT8U len, const INT8U *data);
+static INT32U flashStoreSeq(const FLASH_STORE_HDR *hdr);
+
+/******************************************************************************************
+ * FlashStoreLoad()
+ ******************************************************************************************/
+INT8U FlashStoreLoad(void *data, INT8U len){
+    INT32U seq;
+    INT16U slot = flashStoreLatest(&seq);
+    const INT8U *p;
+
+    if(slot == FLASH_STORE_NONE){
+        return FALSE;
+    }else{
+    }
+    p = FlashStoreHwBase() + ((INT32U)slot * FLASH_STORE_SLOT_SIZE);
+    if(((const FLASH_STORE_HDR *)p)->len != len){
+        return FALSE;
+    }else{
+    }
+    (void)memcpy(data, p + FLASH_STORE_HDR_SIZE, len);
+    return TRUE;
+}
+
+/******************************************************************************************
+ * FlashStoreSave() - Programs the slot after the latest record, erasing the sector first
+ *                    if there is none left.
+ ******************************************************************************************/
+INT8U FlashStoreSave(const void *data, INT8U len){
+    static INT32U page[FLASH_STORE_SLOT_SIZE / 4u];
+    FLASH_STORE_HDR *hdr = (FLASH_STORE_HDR *)page;
+    INT32U seq;
+    INT16U slot = flashStoreLatest(&seq);
+    INT16U crc;
+    const INT8U *p;
+
+    if(len > FLASH_STORE_DATA_MAX){
+        return FALSE;
+    }else{
+    }
+    if(slot == FLASH_STORE_NONE){
+        seq = 0;
+        slot = 0;
+    }else{
+        seq++;
+        slot++;
+    }
+    /* Skip slots left partly programmed by a reset */
+    while((slot < FLASH_STORE_SLOTS) &&
+          (flashStoreSlotErased(FlashStoreHwBase() + ((INT32U)slot * FLASH_STORE_SLOT_SIZE)) == FALSE)){
+        slot++;
+    }
+    if(slot >= FLASH_STORE_SLOTS){
+        if(FlashStoreHwErase() == FALSE){
+            return FALSE;
+        }else{
+        }
+        slot = 0;
+    }else{
+    }
+
+    (void)memset(page, 0xFF, sizeof(page));
+    crc = flashStoreCrc(len, (const INT8U *)data);
+    hdr->seq[0] = (INT8U)seq;
+    hdr->seq[1] = (INT8U)(seq >> 8);
+    hdr->seq[2] = (INT8U)(seq >> 16);
+    hdr->seq[3] = (INT8U)(seq >> 24);
+    hdr->len = len;
+    hdr->rsvd = 0xFFu;
+    hdr->crc[0] = (INT8U)crc;
+    hdr->crc[1] = (INT8U)(crc >> 8);
+    (void)memcpy((INT8U *)page + FLASH_STORE_HDR_SIZE, data, len);
+    if(FlashStoreHwProgram((INT32U)slot * FLASH_STORE_SLOT_SIZE, page) == FALSE){
+        return FALSE;
+    }else{
+    }
+    p = FlashStoreHwBase() + ((INT32U)slot * FLASH_STORE_SLOT_SIZE);
+    return (INT8U)(memcmp(p, page, FLASH_STORE_HDR_SIZE + (INT32U)len) == 0);
+}
+
+/******************************************************************************************
+ * flashStoreLatest() - Valid slot with the highest seq, FLASH_STORE_NONE if there is none.
+ ******************************************************************************************/
+static INT16U flashStoreLatest(INT32U *seq){
+    const INT8U *base = FlashStoreHwBase();
+    const FLASH_STORE_HDR *hdr;
+    INT16U latest = FLASH_STORE_NONE;
+    INT16U slot;
+
+    for(slot = 0; slot < FLASH_STORE_SLOTS; slot++){
+        hdr = (const FLASH_STORE_HDR *)(base + ((INT32U)slot * FLASH_STORE_SLOT_SIZE));
+        if((flashStoreSlotValid((const INT8U *)hdr) != FALSE) &&
+           ((latest == FLASH_STORE_NONE) || (flashStoreSeq(hdr) > *seq))){
+            latest = slot;
+            *seq = flashStoreSeq(hdr);
+        }else{
+        }
+    }
+    return latest;
+}
+
+/******************************************************************************************
+ * flashStoreSlotValid() - Programmed, sane length and the CRC matches.
+ ******************************************************************************************/
+static INT8U flashStoreSlotValid(const INT8U *slot){
+    const FLASH_STORE_HDR *hdr = (const FLASH_STORE_HDR *)slot;
+    return (INT8U)((flashStoreSeq(hdr) != 0xFFFFFFFFu) && (hdr->len <= FLASH_STORE_DATA_MAX) &&
+                   ((hdr->crc[0] | ((INT16U)hdr->crc[1] << 8)) ==
+                    flashStoreCrc(hdr->len, slot + FLASH_STORE_HDR_SIZE)));
+}
+
+/******************************************************************************************
+ * flashStoreSeq()
+ ******************************************************************************************/
+static INT32U flashStoreSeq(const FLASH_STORE_HDR *hdr){
+    return (INT32U)hdr->seq[0] | ((INT32U)hdr->seq[1] << 8) |
+           ((INT32U)hdr->seq[2] << 16) | ((INT32U)hdr->seq[3] << 24);
+}
+
+/******************************************************************************************
+ * flashStoreSlotErased() - All 0xFF, so it can be programmed.
+ ******************************************************************************************/
+static INT8U flashStoreSlotErased(const INT8U *slot){
+    INT16U i;
+    for(i = 0; i < FLASH_STORE_SLOT_SIZE; i++){
+        if(slot[i] != 0xFFu){
+            return FALSE;
+        }else{
+        }
+    }
+    return TRUE;
+}
+
+/******************************************************************************************
+ * flashStoreCrc() - CRC-16/CCITT-FALSE, bitwise, over len then data.
+ ******************************************************************************************/
+static INT16U flashStoreCrc(INT8U len, const INT8U *data){
+    INT16U crc = 0xFFFFu;
+    INT16U i;
+    INT8U bit;
+    INT8U byte;
+
+    for(i = 0; i <= len; i++){
+        byte = (i == 0) ? len : data[i - 1u];
+        crc ^= (INT16U)((INT16U)byte << 8);
+        for(bit = 0; bit < 8u; bit++){
+            if((crc & 0x8000u) != 0){
+                crc = (INT16U)((crc << 1) ^ 0x1021u);
+            }else{
+                crc = (INT16U)(crc << 1);
+            }
+        }
+    }
+    return crc;
+}
+
+#ifndef CS_HOST_POSIX
+/******************************************************************************************
+ * MCXN947 ROM flash driver, reached through the ROM API tree (MCXN94x reference manual,
+ * ROM API chapter). The driver keeps its state in a caller supplied flash config, which
+ * is only used here. Flash operations run from ROM, so interrupts stay masked to keep
+ * code fetches off the flash while it is busy.
+ ******************************************************************************************/
+typedef struct{
+    INT32U version;
+    INT32S (*init)(void *config);
+    INT32S (*erase_sector)(void *config, INT32U start, INT32U len, INT32U key);
+    INT32S (*program_phrase)(void *config, INT32U start, const INT8U *src, INT32U len);
+    INT32S (*program_page)(void *config, INT32U start, const INT8U *src, INT32U len);
+}FLASH_STORE_ROM_DRV;
+
+typedef struct{
+    void (*run_bootloader)(void *arg);
+    INT32U version;
+    const char *copyright;
+    INT32U reserved0;
+    const FLASH_STORE_ROM_DRV *flash;
+}FLASH_STORE_ROM_API;
+
+#define FLASH_STORE_ROM         ((const FLASH_STORE_ROM_API *)0x1303FC00u)
+#define FLASH_STORE_ERASE_KEY   0x6B65666Bu     /* "kefk", kFLASH_ApiEraseKey */
+#define FLASH_STORE_ROM_OK      0
+
+static INT32U flashStoreCfg[64];        /* flash_config_t, opaque here */
+static INT8U flashStoreInitDone = FALSE;
+
+static INT8U flashStoreRomInit(void);
+
+/******************************************************************************************
+ * FlashStoreHwBase()
+ ******************************************************************************************/
+const INT8U *FlashStoreHwBase(void){
+    return (const INT8U *)FLASH_STORE_ADDR;
+}
+
+/******************************************************************************************
+ * FlashStoreHwErase()
+ ******************************************************************************************/
+INT8U FlashStoreHwErase(void){
+    INT32S status;
+    CPU_SR_ALLOC();
+
+    if(flashStoreRomInit() == FALSE){
+        return FALSE;
+    }else{
+    }
+    CPU_CRITICAL_ENTER();
+    status = FLASH_STORE_ROM->flash->erase_sector(flashStoreCfg, FLASH_STORE_ADDR,
+                                                  FLASH_STORE_SECTOR_SIZE, FLASH_STORE_ERASE_KEY);
+    CPU_CRITICAL_EXIT();
+    return (INT8U)(status == FLASH_STORE_ROM_OK);
+}
+
+/******************************************************************************************
+ * FlashStoreHwProgram()
+ ******************************************************************************************/
+INT8U FlashStoreHwProgram(INT32U offset, const INT32U *page){
+    INT32S status;
+    CPU_SR_ALLOC();
+
+    if(flashStoreRomInit() == FALSE){
+        return FALSE;
+    }else{
+    }
+    CPU_CRITICAL_ENTER();
+    status = FLASH_STORE_ROM->flash->program_page(flashStoreCfg, FLASH_STORE_ADDR + offset,
+                                                  (const INT8U *)page, FLASH_STORE_SLOT_SIZE);
+    CPU_CRITICAL_EXIT();
+    return (INT8U)(status == FLASH_STORE_ROM_OK);
+}
+
+/******************************************************************************************
+ * flashStoreRomInit() - FLASH_Init() once, before the first erase or program.
+ ******************************************************************************************/
+static INT8U flashStoreRomInit(void){
+    if(flashStoreInitDone == FALSE){
+        flashStoreInitDone = (INT8U)(FLASH_STORE_ROM->flash->init(flashStoreCfg) == FLASH_STORE_ROM_OK);
+    }else{
+    }
+    return flashStoreInitDone;
+}
+#endif /* CS_HOST_POSIX */
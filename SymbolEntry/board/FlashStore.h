@@ -0,0 +1,59 @@
+/******************************************************************************************
+ * FlashStore.h - Keeps one small record in a dedicated flash sector across resets.
+ *
+ * The sector is split into FLASH_STORE_SLOT_SIZE slots (one flash page each). Every save
+ * programs the next erased slot with [seq][len][crc16][data], so the sector is only erased
+ * once all slots are used. Load takes the valid slot with the highest seq, so a save cut
+ * short by a reset leaves the previous record in place.
+ *
+ * FlashStoreHwBase(), FlashStoreHwErase() and FlashStoreHwProgram() are the only parts
+ * that touch the flash. FlashStore.c implements them with the MCXN947 ROM flash driver;
+ * the host build (CS_HOST_POSIX) replaces them with a file backed model in host/host_bsp.c.
+ *
+ * FLASH_STORE_ADDR is the last sector of the 2MB internal flash, which must be kept out of
+ * the application's flash region in the linker settings. The project's memory map, which
+ * the managed linker scripts of both the Debug and Release builds come from, ends
+ * PROGRAM_FLASH1 at 0x1FE000 (size 0xFE000) for this.
+ ******************************************************************************************/
+#ifndef FLASH_STORE_INCL
+#define FLASH_STORE_INCL
+
+#include "MCUType.h"
+
+/******************************************************************************************
+ * Configuration
+ ******************************************************************************************/
+#define FLASH_STORE_ADDR        0x001FE000u /* Sector address (target) */
+#define FLASH_STORE_SECTOR_SIZE 8192u       /* FSL_FEATURE_SYSCON_FLASH_SECTOR_SIZE_BYTES */
+#define FLASH_STORE_SLOT_SIZE   128u        /* FSL_FEATURE_SYSCON_FLASH_PAGE_SIZE_BYTES */
+#define FLASH_STORE_HDR_SIZE    8u
+#define FLASH_STORE_DATA_MAX    (FLASH_STORE_SLOT_SIZE - FLASH_STORE_HDR_SIZE)
+
+/******************************************************************************************
+ * FlashStoreLoad() - Copies the latest saved record to data.
+ *    parameters: data - destination, len - record size expected
+ *    return: TRUE if a valid record of exactly len bytes was found
+ ******************************************************************************************/
+INT8U FlashStoreLoad(void *data, INT8U len);
+
+/******************************************************************************************
+ * FlashStoreSave() - Programs data as the new record. Blocks, with interrupts masked
+ *                    while the flash is busy: about a page program, plus a sector erase
+ *                    when the sector is full.
+ *    parameters: data, len - record, len <= FLASH_STORE_DATA_MAX
+ *    return: TRUE if the record was programmed and reads back
+ ******************************************************************************************/
+INT8U FlashStoreSave(const void *data, INT8U len);
+
+/******************************************************************************************
+ * Flash access (FlashStore.c on the target, host_bsp.c in the host build)
+ *    FlashStoreHwBase() - the sector, memory mapped
+ *    FlashStoreHwErase() - erase the sector to 0xFF
+ *    FlashStoreHwProgram() - program one FLASH_STORE_SLOT_SIZE page at offset
+ *    The last two return TRUE on success.
+ ******************************************************************************************/
+const INT8U *FlashStoreHwBase(void);
+INT8U FlashStoreHwErase(void);
+INT8U FlashStoreHwProgram(INT32U offset, const INT32U *page);
+
+#endif
@@ -0,0 +1,191 @@
+# symcat_gen.py
+# Builds the MCU's symbol catalog (source/SymCatalog.c and .h) from a text or CSV source.
+#
+#   python3 catalog/symcat_gen.py [source] [outdir]     (defaults: catalog/symbols.txt, source)
+#
+# Text source (see symbols.txt):
+#   [Category name]       starts a category
+#   <glyph> <glyph> ...   symbols, white space separated
+#   # ...                 comment
+# CSV source (*.csv), one symbol per row, optional header row "category,glyph":
+#   category,glyph[,anything else]
+#
+# Output is one packed UTF-8 blob plus 16-bit offset tables, all const so they stay in
+# flash. Symbols are numbered in source order, grouped by category in order of first
+# appearance, so every category is a run of consecutive IDs.
+
+import csv
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEF_SRC = os.path.join(HERE, "symbols.txt")
+DEF_OUT = os.path.join(HERE, "..", "source")
+
+ID_NONE = 0xFFFF    # SYMCAT_ID_NONE, never a symbol ID
+OFF_MAX = 0xFFFF    # Offsets are INT16U
+CAT_MAX = 0xFF      # Categories are INT8U
+GLYPH_MAX = 24      # Bytes, SYMPROTO_PAYLOAD_MAX: a glyph is sent in one SYMPROTO_DEF payload
+
+def fail(msg: str):
+    sys.stderr.write(f"symcat_gen: {msg}\n")
+    sys.exit(1)
+
+def read_text(path: str) -> list[tuple[str, str]]:
+    rows = []
+    cat = None
+    with open(path, encoding="utf-8") as f:
+        for n, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            if line.startswith("[") and line.endswith("]"):
+                cat = line[1:-1].strip()
+                continue
+            if cat is None:
+                fail(f"{path}:{n}: symbol before the first [category]")
+            rows += [(cat, glyph) for glyph in line.split()]
+    return rows
+
+def read_csv(path: str) -> list[tuple[str, str]]:
+    rows = []
+    with open(path, encoding="utf-8", newline="") as f:
+        for n, rec in enumerate(csv.reader(f), 1):
+            if not rec or rec[0].startswith("#"):
+                continue
+            if n == 1 and [r.strip().lower() for r in rec[:2]] == ["category", "glyph"]:
+                continue
+            if len(rec) < 2 or not rec[0].strip() or not rec[1].strip():
+                fail(f"{path}:{n}: expected category,glyph")
+            rows.append((rec[0].strip(), rec[1].strip()))
+    return rows
+
+def build(rows: list[tuple[str, str]]):
+    # Group by category, keeping the order categories and symbols were first seen in
+    cats = {}
+    for cat, glyph in rows:
+        glyphs = cats.setdefault(cat, [])
+        if glyph in glyphs:
+            fail(f"'{glyph}' is in [{cat}] twice")
+        if "\0" in glyph:
+            fail(f"NUL in '{glyph}'")
+        if len(glyph.encode("utf-8")) > GLYPH_MAX:
+            fail(f"'{glyph}' is {len(glyph.encode('utf-8'))} bytes of UTF-8, at most {GLYPH_MAX}")
+        glyphs.append(glyph)
+    if not cats:
+        fail("no symbols")
+    if len(cats) > CAT_MAX:
+        fail(f"{len(cats)} categories, at most {CAT_MAX}")
+
+    glyphs = [g for gs in cats.values() for g in gs]
+    if len(glyphs) >= ID_NONE:
+        fail(f"{len(glyphs)} symbols, at most {ID_NONE - 1}")
+
+    # Glyphs then category names, each NUL terminated
+    blob = bytearray()
+    sym_off = []
+    for g in glyphs:
+        sym_off.append(len(blob))
+        blob += g.encode("utf-8") + b"\0"
+    sym_off.append(len(blob))
+    cat_name = []
+    cat_first = []
+    first = 0
+    for cat, gs in cats.items():
+        cat_name.append(len(blob))
+        cat_first.append(first)
+        first += len(gs)
+        blob += cat.encode("utf-8") + b"\0"
+    cat_first.append(first)
+    if len(blob) > OFF_MAX:
+        fail(f"blob is {len(blob)} bytes, offsets are 16-bit")
+    return glyphs, list(cats.keys()), blob, sym_off, cat_first, cat_name
+
+def catalog_hash(glyphs: list[str]) -> int:
+    # 32-bit FNV-1a over id (16-bit LE), length and bytes of every glyph, as MenuCatalogHash()
+    h = 0x811C9DC5
+    for i, g in enumerate(glyphs):
+        data = g.encode("utf-8")
+        for b in bytes([i & 0xFF, (i >> 8) & 0xFF, len(data) & 0xFF]) + data:
+            h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+def c_str(s: str) -> str:
+    # C string literal, UTF-8 kept as is
+    return '"' + s.replace("\\", "\\\\").replace('"', '\\"') + '\\0"'
+
+def c_table(values: list[int], per_line: int = 12) -> str:
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(f"{v}u" for v in values[i:i + per_line]))
+    return ",\n".join(lines)
+
+def write(outdir: str, src: str, glyphs, cats, blob, sym_off, cat_first, cat_name):
+    note = f"Generated by catalog/symcat_gen.py from catalog/{os.path.basename(src)}. Do not edit."
+    h = f"""/* SymCatalog.h - {note} */
+#ifndef SYMCATALOG_H
+#define SYMCATALOG_H
+
+#include "MCUType.h"
+
+#define SYMCAT_SYM_COUNT    {len(glyphs)}u
+#define SYMCAT_CAT_COUNT    {len(cats)}u
+#define SYMCAT_BLOB_SIZE    {len(blob)}u
+#define SYMCAT_ID_NONE      0x{ID_NONE:04X}u
+#define SYMCAT_GLYPH_MAX    {max(len(g.encode("utf-8")) for g in glyphs)}u   /* Longest glyph, UTF-8 bytes */
+#define SYMCAT_HASH         0x{catalog_hash(glyphs):08X}u   /* Same as the catalog stream's hash; */
+                                            /* tells saved symbol IDs from an older catalog */
+
+/*****************************************************************************************
+* Packed symbol catalog, in flash.
+*   SymCatBlob      every glyph, then every category name, UTF-8, each NUL terminated
+*   SymCatSymOff    glyph i is at SymCatBlob[SymCatSymOff[i]], and is
+*                   SymCatSymOff[i + 1] - SymCatSymOff[i] - 1 bytes long
+*   SymCatCatFirst  category c holds symbols SymCatCatFirst[c] to SymCatCatFirst[c + 1] - 1
+*   SymCatCatName   name of category c is at SymCatBlob[SymCatCatName[c]]
+*****************************************************************************************/
+extern const INT8C SymCatBlob[SYMCAT_BLOB_SIZE];
+extern const INT16U SymCatSymOff[SYMCAT_SYM_COUNT + 1u];
+extern const INT16U SymCatCatFirst[SYMCAT_CAT_COUNT + 1u];
+extern const INT16U SymCatCatName[SYMCAT_CAT_COUNT];
+
+#endif
+"""
+    blob_lines = []
+    for i, g in enumerate(glyphs):
+        blob_lines.append(f"    {c_str(g):<16}/* {i} */")
+    for c, name in enumerate(cats):
+        blob_lines.append(f"    {c_str(name):<16}/* category {c} */")
+    c = f"""/* SymCatalog.c - {note} */
+#include "SymCatalog.h"
+
+const INT8C SymCatBlob[SYMCAT_BLOB_SIZE] =
+{chr(10).join(blob_lines)};
+
+const INT16U SymCatSymOff[SYMCAT_SYM_COUNT + 1u] = {{
+{c_table(sym_off)}
+}};
+
+const INT16U SymCatCatFirst[SYMCAT_CAT_COUNT + 1u] = {{
+{c_table(cat_first)}
+}};
+
+const INT16U SymCatCatName[SYMCAT_CAT_COUNT] = {{
+{c_table(cat_name)}
+}};
+"""
+    for name, text in (("SymCatalog.h", h), ("SymCatalog.c", c)):
+        with open(os.path.join(outdir, name), "w", encoding="utf-8", newline="\n") as f:
+            f.write(text)
+
+def main():
+    src = sys.argv[1] if len(sys.argv) > 1 else DEF_SRC
+    outdir = sys.argv[2] if len(sys.argv) > 2 else DEF_OUT
+    rows = read_csv(src) if src.lower().endswith(".csv") else read_text(src)
+    glyphs, cats, blob, sym_off, cat_first, cat_name = build(rows)
+    write(outdir, src, glyphs, cats, blob, sym_off, cat_first, cat_name)
+    print(f"symcat_gen: {len(glyphs)} symbols in {len(cats)} categories, "
+          f"{len(blob) + 2 * (len(sym_off) + len(cat_first) + len(cat_name))} bytes of flash")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,233 @@
+/*****************************************************************************************
+* MCXN947_cm33_core0.h - Host (Linux) stand-in for the MCXN947 device header.
+*
+* Only used by the host build (-DCS_HOST_POSIX), where this directory is placed ahead of
+* everything else on the include path so MCUType.h picks it up unchanged.
+*
+* Declares just the peripherals and bit fields the application uses. The registers are
+* plain memory; their behavior is modeled by host_bsp.c:
+*   LPUART4 - 8-word TX FIFO drained to stdout at the programmed bit rate, with TXCOUNT,
+*             TDRE, TC and the TX watermark interrupt. Writing DATA while the FIFO is
+*             full is reported as an overrun. RX bytes come from stdin.
+*   GPIO0   - SW2/SW3 inputs (PDIR) are driven from the keyboard, edge flags and
+*             GPIO00_IRQn are raised as configured by ICR. Each press and release
+*             replays a recorded contact bounce waveform (HOST_SW_BOUNCE).
+*   DMA0    - BIO_dma.h TCD chains on the BasicIO TX channel are walked by a model
+*             thread (host_bsp.c BIODmaStart()) that feeds the LPUART4 TX FIFO while
+*             TDMAE is set and the FIFO is at or below TXWATER, then raises
+*             EDMA_0_CH0_IRQn.
+*   LPTMR0  - Raises LPTMR0_IRQn every (CMR + 1) counts of HOST_LPTMR_CLK_HZ while TEN
+*             and TIE are set.
+*   LPTMR1  - Free running counter (TFC set) of HOST_LPTMR_CLK_HZ since TEN was set,
+*             read through CNR, raising LPTMR1_IRQn once as it goes past CMR. The Cs/OS3
+*             dynamic tick (board/CsOS_Tick.c).
+*   CTIMER4 - No timer, just its interrupt: raised by NVIC_SetPendingIRQ() for the
+*             kernel benchmarks (source/KBench.c).
+* NVIC calls map onto the Cs/CPU host interrupt layer (Cs-CPU/Posix).
+*****************************************************************************************/
+#ifndef MCXN947_CM33_CORE0_H_
+#define MCXN947_CM33_CORE0_H_
+
+#ifndef CS_HOST_POSIX
+#error "host/MCXN947_cm33_core0.h is only for the host build"
+#endif
+
+#include <stdint.h>
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+
+/*****************************************************************************************
+* Interrupt numbers (same values as the device)
+*****************************************************************************************/
+typedef enum{
+    EDMA_0_CH0_IRQn = 1,
+    GPIO00_IRQn = 17,
+    LP_FLEXCOMM4_IRQn = 39,
+    CTIMER4_IRQn = 56,
+    LPTMR0_IRQn = 143,
+    LPTMR1_IRQn = 144
+}IRQn_Type;
+
+#define HOST_LPTMR_CLK_HZ   24000000u   /* LPTMR clock selected by PSR_PCS(3) */
+#define HOST_LPUART_CLK_HZ  50000000u   /* LP_FLEXCOMM4 functional clock */
+
+/*****************************************************************************************
+* SYSCON
+*****************************************************************************************/
+typedef struct{
+    __IO uint32_t AHBCLKCTRLSET[4];
+    __IO uint32_t AHBCLKCTRLCLR[4];
+    __IO uint32_t FCCLKSEL[10];
+    __IO uint32_t CLOCK_CTRL;
+}SYSCON_Type;
+
+#define SYSCON_AHBCLKCTRL0_PORT0(x)  (((uint32_t)(x)) << 13u)
+#define SYSCON_AHBCLKCTRL0_PORT1(x)  (((uint32_t)(x)) << 14u)
+#define SYSCON_AHBCLKCTRL0_PORT2(x)  (((uint32_t)(x)) << 15u)
+#define SYSCON_AHBCLKCTRL0_GPIO0(x)  (((uint32_t)(x)) << 19u)
+#define SYSCON_AHBCLKCTRL0_GPIO1(x)  (((uint32_t)(x)) << 20u)
+#define SYSCON_AHBCLKCTRL0_GPIO2(x)  (((uint32_t)(x)) << 21u)
+#define SYSCON_AHBCLKCTRL1_FC4(x)    (((uint32_t)(x)) << 15u)
+#define SYSCON_FCCLKSEL_SEL(x)       (((uint32_t)(x)) & 0x7u)
+#define SYSCON_CLOCK_CTRL_CLKIN_ENA_FM_USBH_LPT(x) (((uint32_t)(x)) << 5u)
+
+/*****************************************************************************************
+* PORT
+*****************************************************************************************/
+typedef struct{
+    __IO uint32_t PCR[32];
+}PORT_Type;
+
+#define PORT_PCR_MUX(x)     ((((uint32_t)(x)) << 8u) & 0xF00u)
+#define PORT_PCR_IBE(x)     ((((uint32_t)(x)) << 12u) & 0x1000u)
+
+/*****************************************************************************************
+* GPIO
+*****************************************************************************************/
+typedef struct{
+    __IO uint32_t PDOR;
+    __O  uint32_t PSOR;
+    __O  uint32_t PCOR;
+    __O  uint32_t PTOR;
+    __I  uint32_t PDIR;
+    __IO uint32_t PDDR;
+    __IO uint32_t ICR[32];
+    __IO uint32_t ISFR[2];
+}GPIO_Type;
+
+#define GPIO_ICR_IRQC_MASK  0xF0000u
+#define GPIO_ICR_IRQC(x)    ((((uint32_t)(x)) << 16u) & GPIO_ICR_IRQC_MASK)
+
+/*****************************************************************************************
+* LP_FLEXCOMM
+*****************************************************************************************/
+typedef struct{
+    __IO uint32_t PSELID;
+}LP_FLEXCOMM_Type;
+
+#define LP_FLEXCOMM_PSELID_PERSEL(x) (((uint32_t)(x)) & 0x7u)
+
+/*****************************************************************************************
+* LPUART
+*****************************************************************************************/
+typedef struct{
+    __I  uint32_t VERID;
+    __I  uint32_t PARAM;
+    __IO uint32_t GLOBAL;
+    __IO uint32_t PINCFG;
+    __IO uint32_t BAUD;
+    __IO uint32_t STAT;
+    __IO uint32_t CTRL;
+    __IO uint32_t DATA;
+    __IO uint32_t MATCH;
+    __IO uint32_t MODIR;
+    __IO uint32_t FIFO;
+    __IO uint32_t WATER;
+}LPUART_Type;
+
+#define LPUART_GLOBAL_RST_MASK      0x2u
+#define LPUART_BAUD_SBR(x)          (((uint32_t)(x)) & 0x1FFFu)
+#define LPUART_BAUD_OSR(x)          ((((uint32_t)(x)) << 24u) & 0x1F000000u)
+#define LPUART_BAUD_TDMAE_MASK      0x800000u
+#define LPUART_STAT_RDRF_MASK       0x200000u
+#define LPUART_STAT_TC_MASK         0x400000u
+#define LPUART_STAT_TDRE_MASK       0x800000u
+#define LPUART_CTRL_RE_MASK         0x40000u
+#define LPUART_CTRL_TE_MASK         0x80000u
+#define LPUART_CTRL_RIE_MASK        0x200000u
+#define LPUART_CTRL_TIE_MASK        0x800000u
+#define LPUART_FIFO_RXFE_MASK       0x8u
+#define LPUART_FIFO_TXFE_MASK       0x80u
+#define LPUART_FIFO_RXFLUSH_MASK    0x4000u
+#define LPUART_FIFO_TXFLUSH_MASK    0x8000u
+#define LPUART_WATER_TXWATER(x)     (((uint32_t)(x)) & 0x7u)
+#define LPUART_WATER_TXWATER_MASK   0x7u
+#define LPUART_WATER_TXCOUNT_MASK   0xF00u
+#define LPUART_WATER_TXCOUNT_SHIFT  8u
+#define LPUART_WATER_RXWATER(x)     ((((uint32_t)(x)) << 16u) & 0x70000u)
+
+/*****************************************************************************************
+* LPTMR
+*****************************************************************************************/
+typedef struct{
+    __IO uint32_t CSR;
+    __IO uint32_t PSR;
+    __IO uint32_t CMR;
+    __IO uint32_t CNR;
+}LPTMR_Type;
+
+#define LPTMR_CSR_TEN(x)        (((uint32_t)(x)) & 0x1u)
+#define LPTMR_CSR_TFC(x)        ((((uint32_t)(x)) << 2u) & 0x4u)
+#define LPTMR_CSR_TIE(x)        ((((uint32_t)(x)) << 6u) & 0x40u)
+#define LPTMR_CSR_TCF(x)        ((((uint32_t)(x)) << 7u) & 0x80u)
+#define LPTMR_PSR_PCS(x)        (((uint32_t)(x)) & 0x3u)
+#define LPTMR_PSR_PBYP(x)       ((((uint32_t)(x)) << 2u) & 0x4u)
+#define LPTMR_CMR_COMPARE(x)    ((uint32_t)(x))
+
+/*****************************************************************************************
+* Peripheral instances (host_bsp.c)
+*****************************************************************************************/
+extern SYSCON_Type HostSYSCON;
+extern PORT_Type HostPORT[3];
+extern GPIO_Type HostGPIO[3];
+extern LP_FLEXCOMM_Type HostLP_FLEXCOMM4;
+extern LPUART_Type HostLPUART4;
+extern LPTMR_Type HostLPTMR0;
+extern LPTMR_Type HostLPTMR1;
+
+#define SYSCON          (&HostSYSCON)
+#define PORT0           (&HostPORT[0])
+#define PORT1           (&HostPORT[1])
+#define PORT2           (&HostPORT[2])
+#define GPIO0           (&HostGPIO[0])
+#define GPIO1           (&HostGPIO[1])
+#define GPIO2           (&HostGPIO[2])
+#define LP_FLEXCOMM4    (&HostLP_FLEXCOMM4)
+#define LPUART4         (&HostLPUART4)
+#define LPTMR0          (&HostLPTMR0)
+#define LPTMR1          (&HostLPTMR1)
+
+/*****************************************************************************************
+* Register side effects that plain memory cannot model. Used by the drivers through
+* their CS_HOST_POSIX seams.
+*****************************************************************************************/
+void HostLpuartDataWr(LPUART_Type *base, uint32_t data);
+uint32_t HostLpuartDataRd(LPUART_Type *base);
+void HostLpuartCtrlWr(LPUART_Type *base, uint32_t ctrl);
+void HostLptmrCsrWr(LPTMR_Type *base, uint32_t csr);
+uint32_t HostLptmrCnrRd(LPTMR_Type *base);
+
+/*****************************************************************************************
+* Measurement hooks called by the drivers in the host build (host_bsp.c). Reported on exit.
+*   HostSwTaskWake() - the switch task woke up to look at the switches
+*   HostSwEvent()    - a switch event was queued (SW_T key, SW_EDGE_T edge); latency of
+*                      presses is taken from their first edge
+*   HostTickIrq()    - the dynamic tick interrupt handed ticks to the kernel (0: none due)
+*   HostAppTaskWake() - the application task came out of its wait
+* HostBenchDone() waits for LPUART4 to send what it holds and exits (APP_CFG_KBENCH_EN).
+*****************************************************************************************/
+void HostAppTaskWake(void);
+void HostBenchDone(void);
+void HostSwTaskWake(void);
+void HostSwEvent(uint32_t key, uint32_t edge);
+void HostTickIrq(uint32_t ticks);
+
+/*****************************************************************************************
+* Core
+*****************************************************************************************/
+extern uint32_t SystemCoreClock;
+
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t prio);
+
+#define __BKPT(x)   __builtin_trap()
+#define __DMB()     __sync_synchronize()
+#define __DSB()     __sync_synchronize()
+#define __ISB()     __sync_synchronize()
+
+#endif /* MCXN947_CM33_CORE0_H_ */
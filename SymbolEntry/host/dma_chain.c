@@ -0,0 +1,139 @@
+/*****************************************************************************************
+* dma_chain.c - Checks the eDMA descriptor chains BIODmaTcdChain() (board/BIO_dma.c)
+*   builds for BIOWriteV(), on the host, without the DMA model in host_bsp.c.
+*
+* Cases: 1 fragment, BIO_DMA_TCD_MAX fragments, one more than that, zero length
+* fragments mixed in, only zero length fragments, and a fragment longer than
+* BIO_DMA_CITER_MAX. For every TCD built it checks the fields against the fragment:
+*   SADDR, SLAST, DADDR, NBYTES 1, CITER = BITER = length
+* then the links: CSR ESG and DLAST_SGA pointing at the next TCD on all but the last,
+* CSR INTMAJOR|DREQ and no DLAST_SGA on the last. The chains that cannot be built must
+* return 0. Prints one line per case and exits 1 on the first failure.
+*
+* From SymbolEntry/:
+*   gcc -O2 -Wall -DCS_HOST_POSIX \
+*       -Ihost -Isource -Iboard -ICsOS/Cs-CFG -ICsOS/Cs-CPU/Posix -ICsOS/Cs-CPU -ICsOS/Cs-LIB -ICsOS/Cs-OS3 \
+*       host/dma_chain.c board/BIO_dma.c -o dma_chain
+*   ./dma_chain
+*****************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MCUType.h"
+#include "BIO_dma.h"
+
+#define CHAIN_FRAGS_MAX  (2u * BIO_DMA_TCD_MAX)
+
+static BIO_DMA_TCD chainTcd[BIO_DMA_TCD_MAX + 1u];  /* One spare, must stay untouched */
+static BIO_FRAG chainFrag[CHAIN_FRAGS_MAX];
+static INT8C chainData[CHAIN_FRAGS_MAX][4];
+static volatile INT32U chainDest;
+
+static INT8U chainCase(const char *name, const INT16U *lens, INT8U nfrags, INT8U expect);
+static INT8U chainCheck(INT8U used, INT8U nfrags);
+
+int main(void){
+    static const INT16U one[] = {5u};
+    static const INT16U max[] = {1u, 2u, 3u, 4u, 1u, 2u, 3u, 4u};
+    static const INT16U over[] = {1u, 2u, 3u, 4u, 1u, 2u, 3u, 4u, 1u};
+    static const INT16U zeros[] = {0u, 3u, 0u, 0u, 4u, 0u};
+    static const INT16U zeros_max[] = {1u, 0u, 2u, 3u, 0u, 4u, 1u, 2u, 0u, 3u, 4u, 0u};
+    static const INT16U all_zero[] = {0u, 0u, 0u};
+    static const INT16U too_long[] = {2u, BIO_DMA_CITER_MAX + 1u};
+    INT8U ok = TRUE;
+
+#if BIO_DMA_TCD_MAX != 8u
+#error "dma_chain.c: the cases are written for BIO_DMA_TCD_MAX 8"
+#endif
+    ok &= chainCase("1 fragment", one, 1u, 1u);
+    ok &= chainCase("BIO_DMA_TCD_MAX fragments", max, 8u, 8u);
+    ok &= chainCase("BIO_DMA_TCD_MAX + 1 fragments", over, 9u, 0u);
+    ok &= chainCase("zero length fragments skipped", zeros, 6u, 2u);
+    ok &= chainCase("BIO_DMA_TCD_MAX among zero length", zeros_max, 12u, 8u);
+    ok &= chainCase("only zero length fragments", all_zero, 3u, 0u);
+    ok &= chainCase("fragment over BIO_DMA_CITER_MAX", too_long, 2u, 0u);
+    return (ok != FALSE) ? 0 : 1;
+}
+
+/*****************************************************************************************
+* chainCase() - Builds a chain from fragments of the given lengths and checks it.
+*    expect: TCDs the chain should use, 0 if BIODmaTcdChain() must refuse it
+*    return: TRUE if it passed
+*****************************************************************************************/
+static INT8U chainCase(const char *name, const INT16U *lens, INT8U nfrags, INT8U expect){
+    static INT8C long_data[BIO_DMA_CITER_MAX + 1u];
+    INT8U i;
+    INT8U used;
+    INT8U ok;
+
+    for(i = 0; i < nfrags; i++){
+        chainFrag[i].ptr = (lens[i] > sizeof(chainData[i])) ? long_data : chainData[i];
+        chainFrag[i].len = lens[i];
+    }
+    (void)memset(chainTcd, 0xA5, sizeof(chainTcd));
+    used = BIODmaTcdChain(chainTcd, BIO_DMA_TCD_MAX, chainFrag, nfrags, &chainDest);
+    if(used != expect){
+        (void)printf("FAIL %s: %u TCDs, expected %u\n", name, (unsigned)used, (unsigned)expect);
+        return FALSE;
+    }else if(used == 0){
+        ok = TRUE;
+    }else{
+        ok = chainCheck(used, nfrags);
+    }
+    (void)printf("%s %s: %u TCDs\n", (ok != FALSE) ? "PASS" : "FAIL", name, (unsigned)used);
+    return ok;
+}
+
+/*****************************************************************************************
+* chainCheck() - The used TCDs follow the non-zero fragments in order and are linked,
+*   and the spare TCD after them was not written.
+*****************************************************************************************/
+static INT8U chainCheck(INT8U used, INT8U nfrags){
+    const BIO_DMA_TCD *tcd;
+    BIO_DMA_TCD spare;
+    INT8U f = 0;
+    INT8U t;
+
+    for(t = 0; t < used; t++){
+        while((f < nfrags) && (chainFrag[f].len == 0)){
+            f++;
+        }
+        if(f >= nfrags){
+            (void)printf("  TCD %u has no fragment\n", (unsigned)t);
+            return FALSE;
+        }else{
+        }
+        tcd = &chainTcd[t];
+        if((tcd->SADDR != (BIO_DMA_ADDR)chainFrag[f].ptr) || (tcd->NBYTES != 1u) ||
+           (tcd->CITER != chainFrag[f].len) || (tcd->BITER != chainFrag[f].len) ||
+           (tcd->SLAST != -(INT32S)chainFrag[f].len) || (tcd->DADDR != (BIO_DMA_ADDR)&chainDest)){
+            (void)printf("  TCD %u does not match fragment %u\n", (unsigned)t, (unsigned)f);
+            return FALSE;
+        }else if((t < (used - 1u)) &&
+                 ((tcd->CSR != BIO_DMA_CSR_ESG) || (tcd->DLAST_SGA != (BIO_DMA_ADDR)&chainTcd[t + 1u]))){
+            (void)printf("  TCD %u is not linked to the next one\n", (unsigned)t);
+            return FALSE;
+        }else if((t == (used - 1u)) &&
+                 ((tcd->CSR != (BIO_DMA_CSR_INTMAJOR | BIO_DMA_CSR_DREQ)) || (tcd->DLAST_SGA != 0u))){
+            (void)printf("  last TCD %u does not end the chain\n", (unsigned)t);
+            return FALSE;
+        }else{
+        }
+        f++;
+    }
+    while(f < nfrags){
+        if(chainFrag[f].len != 0){
+            (void)printf("  fragment %u has no TCD\n", (unsigned)f);
+            return FALSE;
+        }else{
+        }
+        f++;
+    }
+    (void)memset(&spare, 0xA5, sizeof(spare));
+    if(memcmp(&chainTcd[BIO_DMA_TCD_MAX], &spare, sizeof(spare)) != 0){
+        (void)printf("  TCD past ntcd written\n");
+        return FALSE;
+    }else{
+    }
+    return TRUE;
+}
@@ -0,0 +1,1342 @@
+/*****************************************************************************************
+* host_bsp.c - Host (Linux) board support for the CS_HOST_POSIX build.
+*
+* Takes the place of the startup code, the clock configuration and the FRDM-MCXN947
+* peripherals used by the application (see MCXN947_cm33_core0.h):
+*   - Installs the application's IRQ handlers in the Cs/CPU host vector table.
+*   - LPUART4: TX FIFO model drained to stdout at the programmed bit rate, RX bytes are
+*     read from stdin. This is also the register test double for the BasicIO TX path:
+*     a FIFO overrun means the driver wrote DATA without room and is reported on exit.
+*     With HOST_UART_PTY set the UART is a pseudo-terminal instead, whose name is printed
+*     at startup: SymbolReceiver/symbol_bridge.py can open it like the board's port, and
+*     RX arrives at the programmed bit rate. Keys still press the switches.
+*   - SW2/SW3: keys '2' and '3' hold the switch down for HOST_SW_PRESS_MS. Press and
+*     release replay the contact bounce trace selected by the HOST_SW_BOUNCE environment
+*     variable (0 clean, 1 short, 2 long; default 1). Press-to-event latency and switch
+*     task wakeups (HostSwEvent(), HostSwTaskWake()) are reported on exit, and so are the
+*     application task's wakeups (HostAppTaskWake()).
+*   - Gesture test harness: HOST_SW_SCRIPT=<file> replays a timestamped pin script on
+*     SW2/SW3, checks the switch events against the script's expectations and exits with
+*     the result (0 pass, 1 fail). Format in host/sw_gestures.txt.
+*   - DMA0: BasicIO TX channel, walks the BIO_dma.h TCD chain into the LPUART4 TX FIFO.
+*   - Flash: the FlashStore.h sector, kept in the file named by HOST_FLASH_FILE so it
+*     survives a restart (erased at every start without it). Erases and programs are
+*     counted and reported on exit.
+*   - LPTMR0: periodic model thread.
+*   - LPTMR1: the dynamic tick's free running counter and compare (HostLptmrCsrWr(),
+*     HostLptmrCnrRd()). On exit, the tick interrupts per second against the periodic
+*     tick's OS_CFG_TICK_RATE_HZ, the kernel time against the wall clock at each
+*     interrupt, and how late the interrupts were taken (HostTickIrq()).
+*   - CTIMER4: only its interrupt, for the kernel benchmarks (APP_CFG_KBENCH_EN), which
+*     exit through HostBenchDone() once their results are out.
+*   - 'q' (or Ctrl-C) exits and restores the terminal.
+* The model threads never take interrupts; they raise them with CPU_HostIntSrcPendSet().
+*****************************************************************************************/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "MCUType.h"
+#include "FRDM_MCXN947_GPIO.h"
+#include "FRDM_MCXN947ClkCfg.h"
+#include "BIO_dma.h"
+#include "FlashStore.h"
+#include "cpu.h"
+#include "os.h"
+#include "CsOS_SW.h"
+
+#define HOST_SW_PRESS_MS        120u
+#define HOST_SW_GAP_MS          60u         /* Released time before the next queued key */
+#define HOST_LPTMR_DEF_NS       1000000u    /* Used while CMR is still 0 */
+#define HOST_NS_PER_S           1000000000uLL
+#define HOST_UART_FIFO_SIZE     8u
+#define HOST_SW_BOUNCE_DEF      1u
+#define HOST_SW_BOUNCE_MAX      8u
+#define HOST_SW_SCRIPT_START_MS 300u        /* Boot time before the script starts */
+#define HOST_SW_SCRIPT_TAIL_MS  1000u       /* Run on after the last pin change */
+#define HOST_SW_SCRIPT_TOL_MS   30u         /* Event time must be within this of expected */
+#define HOST_SW_SCRIPT_EXP_MAX  64u
+#define HOST_SW_SCRIPT_TX_MAX   16u         /* # expect_tx lines */
+#define HOST_SW_SCRIPT_TX_LEN   96u
+#define HOST_SW_TX_LOG_SIZE     65536u      /* UART output kept for them */
+#define HOST_SW_LOG_MAX         256u
+
+/*****************************************************************************************
+* Application IRQ handlers. Weak so that handlers the application does not define stay
+* out of the vector table.
+*****************************************************************************************/
+void GPIO00_IRQHandler(void) __attribute__((weak));
+void LP_FLEXCOMM4_IRQHandler(void) __attribute__((weak));
+void LPTMR0_IRQHandler(void) __attribute__((weak));
+void LPTMR1_IRQHandler(void) __attribute__((weak));
+void EDMA_0_CH0_IRQHandler(void) __attribute__((weak));
+void CTIMER4_IRQHandler(void) __attribute__((weak));
+
+/*****************************************************************************************
+* Peripheral instances
+*****************************************************************************************/
+SYSCON_Type HostSYSCON;
+PORT_Type HostPORT[3];
+GPIO_Type HostGPIO[3];
+LP_FLEXCOMM_Type HostLP_FLEXCOMM4;
+LPUART_Type HostLPUART4;
+LPTMR_Type HostLPTMR0;
+LPTMR_Type HostLPTMR1;
+uint32_t SystemCoreClock;
+
+/*****************************************************************************************
+* Private Resources
+*****************************************************************************************/
+static void hostBspInit(void) __attribute__((constructor));
+static void hostVectInstall(IRQn_Type irq, void (*isr)(void));
+static void *hostKeyTask(void *p_arg);
+static INT8U hostUartRx(uint8_t c);
+static void hostUartPtyOpen(void);
+static void *hostUartPtyTask(void *p_arg);
+static void *hostLptmrTask(void *p_arg);
+static void *hostTickTask(void *p_arg);
+static void hostTickReport(void);
+static void hostIntDisReport(void);
+static void *hostUartTxTask(void *p_arg);
+static void *hostDmaTask(void *p_arg);
+static void hostUartTxRegsUpdate(void);
+static INT64U hostUartCharNs(void);
+static void hostUartReport(void);
+static void hostSwPress(INT32U pin);
+static void hostGpioEdge(INT32U pin, INT8U rising);
+static void hostTermRestore(void);
+static void hostSigIntHandler(int sig);
+static void hostSleepMs(INT32U ms);
+static void hostSleepUntilUs(const struct timespec *t0, INT32U us);
+static void hostSleepUntilNs(INT64U t_ns);
+static INT64U hostNowNs(void);
+static void hostSwWave(INT32U pin, INT8U press);
+static void hostSwReport(void);
+static void hostFlashSync(void);
+static void hostFlashReport(void);
+static void *hostSwScriptTask(void *p_arg);
+static INT8U hostSwScriptCheck(void);
+static INT32U hostSwKeysParse(const char *str);
+
+/* Recorded contact bounce: times in us, from the first edge, at which the pin toggles.
+ * An odd number of toggles, so the pin ends at the new level. */
+typedef struct{
+    const char *name;
+    INT8U press_cnt;
+    INT32U press[HOST_SW_BOUNCE_MAX];
+    INT8U release_cnt;
+    INT32U release[HOST_SW_BOUNCE_MAX];
+}HOST_SW_BOUNCE;
+
+static const HOST_SW_BOUNCE hostSwBounce[] = {
+    {"clean", 1, {0}, 1, {0}},
+    {"short", 5, {0, 60, 140, 390, 800}, 3, {0, 120, 310}},
+    {"long",  7, {0, 40, 95, 600, 1150, 2300, 3900}, 5, {0, 250, 700, 1600, 2100}}
+};
+static const HOST_SW_BOUNCE *hostSwTrace = &hostSwBounce[HOST_SW_BOUNCE_DEF];
+
+/* Switch measurements. Written by the key thread (press) and the kernel thread (hooks). */
+static volatile INT64U hostSwPressNs;
+static INT32U hostSwPressCnt;
+static INT32U hostSwEventCnt;
+static INT32U hostSwWakeCnt;
+static INT32U hostAppWakeCnt;
+static INT64U hostSwLatSumNs;
+static INT64U hostSwLatMinNs = UINT64_MAX;
+static INT64U hostSwLatMaxNs;
+static INT64U hostStartNs;
+
+/* Gesture script. Expectations are read by the script thread; the log is written by the
+ * kernel thread (HostSwEvent()) and read by the script thread once the script is done. */
+typedef struct{
+    INT32U ms;          /* From the script start */
+    INT32U key;         /* SW_T */
+    INT32U edge;        /* SW_EDGE_T */
+}HOST_SW_EXPECT;
+
+typedef struct{
+    INT64U ns;          /* From the script start */
+    INT32U key;
+    INT32U edge;
+    INT8U matched;
+}HOST_SW_LOG;
+
+static const char *hostSwScriptFile;
+static volatile INT64U hostSwScriptT0Ns;    /* 0 until the script starts */
+static HOST_SW_EXPECT hostSwExpect[HOST_SW_SCRIPT_EXP_MAX];
+static INT32U hostSwExpectCnt;
+static HOST_SW_LOG hostSwLog[HOST_SW_LOG_MAX];
+static INT32U hostSwLogCnt;
+static const char *const hostSwEdgeName[] = {"press", "release", "long", "repeat", "double"};
+static const char *const hostSwKeyName[] = {"-", "2", "3", "23"};
+
+/* UART output expectations, read by the script thread. The log is written by the TX
+ * thread while a script is given and read by the script thread once it is done. */
+static char hostSwExpectTx[HOST_SW_SCRIPT_TX_MAX][HOST_SW_SCRIPT_TX_LEN];
+static INT32U hostSwExpectTxCnt;
+static char hostSwTxLog[HOST_SW_TX_LOG_SIZE];
+static INT32U hostSwTxLogCnt;
+
+/* FlashStore sector, kernel thread only */
+static INT8U hostFlash[FLASH_STORE_SECTOR_SIZE];
+static const char *hostFlashFile;
+static INT32U hostFlashEraseCnt;
+static INT32U hostFlashProgCnt;
+
+static struct termios hostTermSaved;
+static INT8U hostTermIsRaw = FALSE;
+static volatile uint32_t hostUartRxData;
+static int hostUartFd = STDOUT_FILENO;     /* TX goes here: stdout or the pty master */
+static int hostUartPtySlaveFd = -1;        /* Held open so the master outlives the receiver */
+
+/* LPUART4 TX FIFO and shifter. Guarded by hostUartLock; the kernel thread also blocks
+ * its interrupt signals while holding it so an ISR cannot spin on its own lock. */
+static pthread_mutex_t hostUartLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t hostUartCond = PTHREAD_COND_INITIALIZER;
+static uint8_t hostUartTxFifo[HOST_UART_FIFO_SIZE];
+static INT32U hostUartTxIn;
+static INT32U hostUartTxOut;
+static INT8U hostUartTxBusy = FALSE;
+static INT32U hostUartTxOvfCnt;
+static pthread_cond_t hostUartSpaceCond = PTHREAD_COND_INITIALIZER;
+
+/* LPTMR1 counter and compare. Guarded by hostTickLock, which the kernel thread also takes
+ * with its interrupt signals blocked. The counter has run since hostTickStartNs, the
+ * start of run hostTickRun; a run raises at most one compare match. */
+static pthread_mutex_t hostTickLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t hostTickCond;
+static INT64U hostTickStartNs;
+static INT32U hostTickRun;
+static INT32U hostTickMatchRun;
+static volatile INT64U hostTickMatchNs;     /* Time of the last compare match */
+
+/* Dynamic tick measurements, kernel thread. T0/Ctr0 are taken when LPTMR1 first starts. */
+static INT64U hostTickT0Ns;
+static OS_TICK hostTickCtr0;
+static INT32U hostTickIrqCnt;
+static INT32U hostTickNoneCnt;
+static INT64U hostTickTicks;
+static INT64U hostTickLateSumNs;
+static INT64U hostTickLateMaxNs;
+static INT64S hostTickErrNs;
+static INT64S hostTickErrMaxNs;
+
+/* DMA0 BasicIO TX channel. Also guarded by hostUartLock. */
+static pthread_cond_t hostDmaCond = PTHREAD_COND_INITIALIZER;
+static const BIO_DMA_TCD *hostDmaTcd;
+
+/*****************************************************************************************
+* hostBspInit() - Runs before main(), like the reset handler on the target.
+*****************************************************************************************/
+static void hostBspInit(void){
+    pthread_t tid;
+    pthread_condattr_t cattr;
+    struct termios term;
+    INT32U i;
+
+    hostVectInstall(GPIO00_IRQn, GPIO00_IRQHandler);
+    hostVectInstall(LP_FLEXCOMM4_IRQn, LP_FLEXCOMM4_IRQHandler);
+    hostVectInstall(LPTMR0_IRQn, LPTMR0_IRQHandler);
+    hostVectInstall(LPTMR1_IRQn, LPTMR1_IRQHandler);
+    hostVectInstall(EDMA_0_CH0_IRQn, EDMA_0_CH0_IRQHandler);
+    hostVectInstall(CTIMER4_IRQn, CTIMER4_IRQHandler);
+
+    if(getenv("HOST_SW_BOUNCE") != NULL){
+        i = (INT32U)atoi(getenv("HOST_SW_BOUNCE"));
+        if(i < (sizeof(hostSwBounce) / sizeof(hostSwBounce[0]))){
+            hostSwTrace = &hostSwBounce[i];
+        }else{
+        }
+    }else{
+    }
+    hostSwScriptFile = getenv("HOST_SW_SCRIPT");
+
+    /* Flash comes up erased, or as the last run left it */
+    (void)memset(hostFlash, 0xFF, sizeof(hostFlash));
+    hostFlashFile = getenv("HOST_FLASH_FILE");
+    if(hostFlashFile != NULL){
+        FILE *f = fopen(hostFlashFile, "rb");
+        if(f != NULL){
+            (void)fread(hostFlash, 1, sizeof(hostFlash), f);
+            (void)fclose(f);
+        }else{
+        }
+    }else{
+    }
+    hostStartNs = hostNowNs();
+
+    /* Switches are active-low and released at reset, TX is idle */
+    *(volatile uint32_t *)&GPIO0->PDIR = GPIO_PIN(SW2_BIT) | GPIO_PIN(SW3_BIT);
+    LPUART4->STAT = LPUART_STAT_TDRE_MASK | LPUART_STAT_TC_MASK;
+
+    /* Single key presses, no echo */
+    if((isatty(STDIN_FILENO) != 0) && (tcgetattr(STDIN_FILENO, &hostTermSaved) == 0)){
+        term = hostTermSaved;
+        term.c_lflag &= ~(tcflag_t)(ICANON | ECHO);
+        term.c_cc[VMIN] = 1;
+        term.c_cc[VTIME] = 0;
+        (void)tcsetattr(STDIN_FILENO, TCSANOW, &term);
+        hostTermIsRaw = TRUE;
+        (void)atexit(hostTermRestore);
+        (void)signal(SIGINT, hostSigIntHandler);
+    }else{
+    }
+
+    (void)atexit(hostUartReport);
+    (void)atexit(hostSwReport);
+    (void)atexit(hostFlashReport);
+    (void)atexit(hostTickReport);
+    (void)atexit(hostIntDisReport);
+    (void)pthread_condattr_init(&cattr);
+    (void)pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(&hostTickCond, &cattr);
+    (void)pthread_create(&tid, NULL, hostKeyTask, NULL);
+    if(getenv("HOST_UART_PTY") != NULL){
+        hostUartPtyOpen();
+        (void)pthread_create(&tid, NULL, hostUartPtyTask, NULL);
+    }else{
+    }
+    (void)pthread_create(&tid, NULL, hostLptmrTask, NULL);
+    (void)pthread_create(&tid, NULL, hostTickTask, NULL);
+    (void)pthread_create(&tid, NULL, hostUartTxTask, NULL);
+    (void)pthread_create(&tid, NULL, hostDmaTask, NULL);
+    if(hostSwScriptFile != NULL){
+        (void)pthread_create(&tid, NULL, hostSwScriptTask, NULL);
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* FRDM_MCXN947InitBootClock() - Host clock "configuration"
+*****************************************************************************************/
+void FRDM_MCXN947InitBootClock(void){
+    SystemCoreClock = BOARD_BOOTCLOCKPLL150M_CORE_CLOCK;
+}
+
+/*****************************************************************************************
+* NVIC - External interrupt n is host interrupt source CPU_INT_EXT0 + n.
+*****************************************************************************************/
+void NVIC_EnableIRQ(IRQn_Type irq){
+    CPU_IntSrcEn((CPU_INT08U)(CPU_INT_EXT0 + (CPU_INT08U)irq));
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq){
+    CPU_IntSrcDis((CPU_INT08U)(CPU_INT_EXT0 + (CPU_INT08U)irq));
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irq){
+    CPU_IntSrcPendClr((CPU_INT08U)(CPU_INT_EXT0 + (CPU_INT08U)irq));
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type irq){
+    CPU_HostIntSrcPendSet((CPU_INT08U)(CPU_INT_EXT0 + (CPU_INT08U)irq));
+}
+
+void NVIC_SetPriority(IRQn_Type irq, uint32_t prio){
+    (void)irq;
+    (void)prio;
+}
+
+/*****************************************************************************************
+* HostLpuartDataWr() - LPUART DATA write: push one character into the TX FIFO.
+*****************************************************************************************/
+void HostLpuartDataWr(LPUART_Type *base, uint32_t data){
+    CPU_SR cpu_sr;
+    (void)base;
+    cpu_sr = CPU_SR_Save();
+    (void)pthread_mutex_lock(&hostUartLock);
+    if((LPUART4->CTRL & LPUART_CTRL_TE_MASK) == 0){
+    }else if((hostUartTxIn - hostUartTxOut) >= HOST_UART_FIFO_SIZE){
+        hostUartTxOvfCnt++;
+    }else{
+        hostUartTxFifo[hostUartTxIn % HOST_UART_FIFO_SIZE] = (uint8_t)data;
+        hostUartTxIn++;
+        hostUartTxRegsUpdate();
+        (void)pthread_cond_signal(&hostUartCond);
+    }
+    (void)pthread_mutex_unlock(&hostUartLock);
+    CPU_SR_Restore(cpu_sr);
+}
+
+/*****************************************************************************************
+* HostLpuartCtrlWr() - LPUART CTRL write. Setting TIE while TDRE is set interrupts at
+*   once, as on the device.
+*****************************************************************************************/
+void HostLpuartCtrlWr(LPUART_Type *base, uint32_t ctrl){
+    CPU_SR cpu_sr;
+    (void)base;
+    cpu_sr = CPU_SR_Save();
+    (void)pthread_mutex_lock(&hostUartLock);
+    LPUART4->CTRL = ctrl;
+    hostUartTxRegsUpdate();
+    (void)pthread_mutex_unlock(&hostUartLock);
+    CPU_SR_Restore(cpu_sr);
+}
+
+/*****************************************************************************************
+* HostLpuartDataRd() - LPUART DATA read: return the received character and clear RDRF.
+*****************************************************************************************/
+uint32_t HostLpuartDataRd(LPUART_Type *base){
+    uint32_t data = hostUartRxData;
+    (void)__atomic_fetch_and(&base->STAT, ~LPUART_STAT_RDRF_MASK, __ATOMIC_SEQ_CST);
+    return data;
+}
+
+/*****************************************************************************************
+* hostVectInstall() - Put an application IRQ handler in the host vector table.
+*****************************************************************************************/
+static void hostVectInstall(IRQn_Type irq, void (*isr)(void)){
+    if(isr != NULL){
+        CPU_HostIntVectSet((CPU_INT08U)(CPU_INT_EXT0 + (CPU_INT08U)irq), isr);
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* hostKeyTask() - Keyboard thread. Switch keys, quit, everything else is UART RX.
+*   A received character is dropped if the previous one was not read (overrun).
+*****************************************************************************************/
+static void *hostKeyTask(void *p_arg){
+    char c;
+    (void)p_arg;
+    CPU_HostThreadSigBlock();
+    while(read(STDIN_FILENO, &c, 1) == 1){
+        if(c == '2'){
+            hostSwPress(GPIO_PIN(SW2_BIT));
+        }else if(c == '3'){
+            hostSwPress(GPIO_PIN(SW3_BIT));
+        }else if(c == 'q'){
+            exit(0);
+        }else{
+            (void)hostUartRx((uint8_t)c);
+        }
+    }
+    return NULL;
+}
+
+/*****************************************************************************************
+* hostUartRx() - A character arrives at LPUART4. Sets RDRF and raises the RX interrupt.
+*    return: FALSE if the receiver is off or still holds the last one (overrun)
+*****************************************************************************************/
+static INT8U hostUartRx(uint8_t c){
+    if(((LPUART4->CTRL & LPUART_CTRL_RE_MASK) == 0) ||
+       ((LPUART4->STAT & LPUART_STAT_RDRF_MASK) != 0)){
+        return FALSE;
+    }else{
+    }
+    hostUartRxData = (uint32_t)c;
+    (void)__atomic_fetch_or(&LPUART4->STAT, LPUART_STAT_RDRF_MASK, __ATOMIC_SEQ_CST);
+    if((LPUART4->CTRL & LPUART_CTRL_RIE_MASK) != 0){
+        NVIC_SetPendingIRQ(LP_FLEXCOMM4_IRQn);
+    }else{
+    }
+    return TRUE;
+}
+
+/*****************************************************************************************
+* hostUartPtyOpen() - HOST_UART_PTY: make LPUART4 a pseudo-terminal. The master is
+*   non-blocking so that, like the real UART with nothing attached, TX is dropped while no
+*   one reads it rather than stalling the firmware.
+*****************************************************************************************/
+static void hostUartPtyOpen(void){
+    struct termios term;
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if((fd < 0) || (grantpt(fd) != 0) || (unlockpt(fd) != 0)){
+        perror("host: HOST_UART_PTY");
+        exit(1);
+    }else{
+    }
+    hostUartPtySlaveFd = open(ptsname(fd), O_RDWR | O_NOCTTY);
+    if((hostUartPtySlaveFd >= 0) && (tcgetattr(hostUartPtySlaveFd, &term) == 0)){
+        cfmakeraw(&term);
+        (void)tcsetattr(hostUartPtySlaveFd, TCSANOW, &term);
+    }else{
+    }
+    (void)fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fprintf(stderr, "host: LPUART4 on %s\n", ptsname(fd));
+    hostUartFd = fd;
+}
+
+/*****************************************************************************************
+* hostUartPtyTask() - HOST_UART_PTY receive thread. Each character takes one character
+*   time on the line, then waits for RDRF to clear instead of overrunning. Deadlines are
+*   absolute so that sleep overshoot doesn't slow the line down.
+*****************************************************************************************/
+static void *hostUartPtyTask(void *p_arg){
+    struct pollfd pfd;
+    uint8_t c;
+    INT64U char_ns;
+    INT64U next_ns = 0;
+    (void)p_arg;
+    CPU_HostThreadSigBlock();
+    pfd.fd = hostUartFd;
+    pfd.events = POLLIN;
+    while(1){
+        if(read(hostUartFd, &c, 1) != 1){
+            (void)poll(&pfd, 1, 100);
+            continue;
+        }else{
+        }
+        char_ns = hostUartCharNs();
+        if(next_ns < hostNowNs()){
+            next_ns = hostNowNs();          /* Line was idle */
+        }else{
+        }
+        do{
+            next_ns += char_ns;
+            hostSleepUntilNs(next_ns);
+        }while(hostUartRx(c) == FALSE);
+    }
+    return NULL;
+}
+
+/*****************************************************************************************
+* hostSwPress() - Hold an active-low switch down for HOST_SW_PRESS_MS, with bounce, then
+*   leave it up for HOST_SW_GAP_MS so typed-ahead keys are separate presses.
+*****************************************************************************************/
+static void hostSwPress(INT32U pin){
+    hostSwWave(pin, TRUE);
+    hostSleepMs(HOST_SW_PRESS_MS);
+    hostSwWave(pin, FALSE);
+    hostSleepMs(HOST_SW_GAP_MS);
+}
+
+/*****************************************************************************************
+* hostSwWave() - Replay the selected bounce trace for a press (falling) or release.
+*   The press time used for latency is the first edge.
+*****************************************************************************************/
+static void hostSwWave(INT32U pin, INT8U press){
+    volatile uint32_t *pdir = (volatile uint32_t *)&GPIO0->PDIR;
+    const INT32U *us;
+    INT8U cnt;
+    INT8U i;
+    INT8U low;
+    struct timespec t0;
+
+    if(press != FALSE){
+        us = hostSwTrace->press;
+        cnt = hostSwTrace->press_cnt;
+        hostSwPressNs = hostNowNs();
+        hostSwPressCnt++;
+    }else{
+        us = hostSwTrace->release;
+        cnt = hostSwTrace->release_cnt;
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(i = 0; i < cnt; i++){
+        hostSleepUntilUs(&t0, us[i]);
+        low = (INT8U)((press != FALSE) == ((i & 1u) == 0u));
+        if(low != FALSE){
+            (void)__atomic_fetch_and(pdir, ~(uint32_t)pin, __ATOMIC_SEQ_CST);
+        }else{
+            (void)__atomic_fetch_or(pdir, (uint32_t)pin, __ATOMIC_SEQ_CST);
+        }
+        hostGpioEdge(pin, (INT8U)!low);
+    }
+}
+
+/*****************************************************************************************
+* HostSwTaskWake(), HostSwEvent() - Switch driver measurement hooks. Kernel thread.
+*****************************************************************************************/
+void HostSwTaskWake(void){
+    hostSwWakeCnt++;
+}
+
+void HostSwEvent(uint32_t key, uint32_t edge){
+    INT64U now = hostNowNs();
+    INT64U lat = now - hostSwPressNs;
+    INT64U t0 = hostSwScriptT0Ns;
+    INT32U n = __atomic_load_n(&hostSwLogCnt, __ATOMIC_SEQ_CST);
+
+    if((t0 != 0u) && (n < HOST_SW_LOG_MAX)){
+        hostSwLog[n].ns = now - t0;
+        hostSwLog[n].key = key;
+        hostSwLog[n].edge = edge;
+        hostSwLog[n].matched = FALSE;
+        __atomic_store_n(&hostSwLogCnt, n + 1u, __ATOMIC_SEQ_CST);
+    }else{
+    }
+    if((edge != SW_PRESS) && (edge != SW_DOUBLE)){
+        return;
+    }else{
+    }
+    hostSwEventCnt++;
+    hostSwLatSumNs += lat;
+    if(lat < hostSwLatMinNs){
+        hostSwLatMinNs = lat;
+    }else{
+    }
+    if(lat > hostSwLatMaxNs){
+        hostSwLatMaxNs = lat;
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* HostAppTaskWake() - Application task measurement hook. Kernel thread.
+*****************************************************************************************/
+void HostAppTaskWake(void){
+    hostAppWakeCnt++;
+}
+
+/*****************************************************************************************
+* HostBenchDone() - The kernel benchmarks are done. Waits for the TX chain and the FIFO
+*   to empty, so stdout has every result, and exits. Kernel thread.
+*****************************************************************************************/
+void HostBenchDone(void){
+    while((__atomic_load_n(&hostDmaTcd, __ATOMIC_SEQ_CST) != NULL) ||
+          ((__atomic_load_n(&LPUART4->STAT, __ATOMIC_SEQ_CST) & LPUART_STAT_TC_MASK) == 0)){
+        hostSleepMs(1u);
+    }
+    exit(0);
+}
+
+/*****************************************************************************************
+* hostSwReport() - Switch latency and wakeups on exit, if a switch was pressed, then the
+*   application task's wakeups.
+*****************************************************************************************/
+static void hostSwReport(void){
+    double run_s = (double)(hostNowNs() - hostStartNs) / 1e9;
+    if(hostSwPressCnt != 0u){
+        (void)fprintf(stderr, "host: SW bounce '%s': %u presses, %u events", hostSwTrace->name,
+                      (unsigned)hostSwPressCnt, (unsigned)hostSwEventCnt);
+        if(hostSwEventCnt != 0u){
+            (void)fprintf(stderr, ", latency ms min/avg/max %.2f/%.2f/%.2f",
+                          (double)hostSwLatMinNs / 1e6,
+                          (double)hostSwLatSumNs / 1e6 / (double)hostSwEventCnt,
+                          (double)hostSwLatMaxNs / 1e6);
+        }else{
+        }
+        (void)fprintf(stderr, ", switch task wakeups %u (%.1f/s)\n", (unsigned)hostSwWakeCnt,
+                      (double)hostSwWakeCnt / run_s);
+    }else{
+    }
+    (void)fprintf(stderr, "host: app task wakeups %u in %.1f s (%.1f/min)\n", (unsigned)hostAppWakeCnt,
+                  run_s, (double)hostAppWakeCnt * 60.0 / run_s);
+}
+
+/*****************************************************************************************
+* hostSwScriptTask() - Gesture script thread. Script lines:
+*     <ms> <pins>                   SW2/SW3 down from <ms> on: '-' none, '2', '3' or '23'
+*     # expect <ms> <key> <gesture> the switch task reports <gesture> for <key> at <ms>
+*     # expect_tx <line>            <line> goes out on the UART, whole and after the
+*                                   previous expect_tx's line
+*   Times are from the script start. Pin changes replay the HOST_SW_BOUNCE trace; SW2
+*   changes before SW3 when both do. Anything else is a comment.
+*****************************************************************************************/
+static void *hostSwScriptTask(void *p_arg){
+    FILE *f;
+    char line[128];
+    char pins[8];
+    char key[8];
+    char edge[16];
+    unsigned ms;
+    INT32U end_ms = 0;
+    INT32U cur = 0;
+    INT32U next;
+    INT32U i;
+    struct timespec t0;
+    HOST_SW_EXPECT *exp;
+    (void)p_arg;
+    CPU_HostThreadSigBlock();
+
+    f = fopen(hostSwScriptFile, "r");
+    if(f == NULL){
+        perror(hostSwScriptFile);
+        exit(2);
+    }else{
+    }
+    hostSleepMs(HOST_SW_SCRIPT_START_MS);
+    (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+    hostSwScriptT0Ns = hostNowNs();
+    while(fgets(line, (int)sizeof(line), f) != NULL){
+        if(sscanf(line, " # expect_tx %95[^\r\n]", hostSwExpectTx[hostSwExpectTxCnt]) == 1){
+            if(hostSwExpectTxCnt < HOST_SW_SCRIPT_TX_MAX - 1u){
+                hostSwExpectTxCnt++;
+            }else{
+                (void)fprintf(stderr, "host: script: too many expect_tx: %s", line);
+            }
+        }else if(sscanf(line, " # expect %u %7s %15s", &ms, key, edge) == 3){
+            exp = &hostSwExpect[hostSwExpectCnt];
+            exp->ms = ms;
+            exp->key = hostSwKeysParse(key);
+            exp->edge = sizeof(hostSwEdgeName) / sizeof(hostSwEdgeName[0]);
+            for(i = 0; i < (sizeof(hostSwEdgeName) / sizeof(hostSwEdgeName[0])); i++){
+                if(strcmp(edge, hostSwEdgeName[i]) == 0){
+                    exp->edge = i;
+                }else{
+                }
+            }
+            if((exp->key != SWN) && (exp->edge < i) && (hostSwExpectCnt < HOST_SW_SCRIPT_EXP_MAX - 1u)){
+                hostSwExpectCnt++;
+            }else{
+                (void)fprintf(stderr, "host: script: bad expectation: %s", line);
+            }
+        }else if((sscanf(line, " %u %7s", &ms, pins) == 2)){
+            next = hostSwKeysParse(pins);
+            hostSleepUntilUs(&t0, ms * 1000u);
+            if(((cur ^ next) & SW2) != 0){
+                hostSwWave(GPIO_PIN(SW2_BIT), (INT8U)((next & SW2) != 0));
+            }else{
+            }
+            if(((cur ^ next) & SW3) != 0){
+                hostSwWave(GPIO_PIN(SW3_BIT), (INT8U)((next & SW3) != 0));
+            }else{
+            }
+            cur = next;
+            end_ms = ms;
+        }else{
+        }
+    }
+    (void)fclose(f);
+    hostSleepUntilUs(&t0, (end_ms + HOST_SW_SCRIPT_TAIL_MS) * 1000u);
+    exit((hostSwScriptCheck() != FALSE) ? 0 : 1);
+    return NULL;
+}
+
+/*****************************************************************************************
+* hostSwKeysParse() - "-", "2", "3" or "23" to SW_T bits.
+*****************************************************************************************/
+static INT32U hostSwKeysParse(const char *str){
+    INT32U keys = SWN;
+    if(strchr(str, '2') != NULL){
+        keys |= SW2;
+    }else{
+    }
+    if(strchr(str, '3') != NULL){
+        keys |= SW3;
+    }else{
+    }
+    return keys;
+}
+
+/*****************************************************************************************
+* hostSwScriptCheck() - Match each expectation to the first unmatched event of the same
+*   key and gesture within HOST_SW_SCRIPT_TOL_MS, and print its latency. Then find each
+*   expect_tx line in the UART output, in script order. Fails on a missing event or
+*   line, or on an unexpected event other than a release.
+*****************************************************************************************/
+static INT8U hostSwScriptCheck(void){
+    INT32U n = __atomic_load_n(&hostSwLogCnt, __ATOMIC_SEQ_CST);
+    INT32U tx_cnt = __atomic_load_n(&hostSwTxLogCnt, __ATOMIC_SEQ_CST);
+    INT32U tx_pos = 0;
+    INT32U tx_ok = 0;
+    char want[HOST_SW_SCRIPT_TX_LEN + 2u];
+    size_t want_len;
+    const char *hit;
+    INT32U i;
+    INT32U j;
+    INT32U ok_cnt = 0;
+    INT32U extra_cnt = 0;
+    double lat;
+    double lat_sum = 0.0;
+    double lat_max = 0.0;
+    HOST_SW_EXPECT *exp;
+    HOST_SW_LOG *ev;
+
+    for(i = 0; i < hostSwExpectCnt; i++){
+        exp = &hostSwExpect[i];
+        for(j = 0; j < n; j++){
+            ev = &hostSwLog[j];
+            lat = (double)ev->ns / 1e6 - (double)exp->ms;
+            if((ev->matched == FALSE) && (ev->key == exp->key) && (ev->edge == exp->edge) &&
+               (lat >= -(double)HOST_SW_SCRIPT_TOL_MS) && (lat <= (double)HOST_SW_SCRIPT_TOL_MS)){
+                break;
+            }else{
+            }
+        }
+        if(j < n){
+            ev->matched = TRUE;
+            ok_cnt++;
+            lat_sum += lat;
+            if(lat > lat_max){
+                lat_max = lat;
+            }else{
+            }
+            (void)fprintf(stderr, "host: script %6u ms SW%-2s %-7s ok      %+6.1f ms\n",
+                          (unsigned)exp->ms, hostSwKeyName[exp->key], hostSwEdgeName[exp->edge], lat);
+        }else{
+            (void)fprintf(stderr, "host: script %6u ms SW%-2s %-7s MISSING\n",
+                          (unsigned)exp->ms, hostSwKeyName[exp->key], hostSwEdgeName[exp->edge]);
+        }
+    }
+    for(j = 0; j < n; j++){
+        ev = &hostSwLog[j];
+        if((ev->matched == FALSE) && (ev->edge != SW_RELEASE)){
+            extra_cnt++;
+            (void)fprintf(stderr, "host: script %8.1f ms SW%-2s %-7s UNEXPECTED\n",
+                          (double)ev->ns / 1e6, hostSwKeyName[ev->key & 3u], hostSwEdgeName[ev->edge]);
+        }else{
+        }
+    }
+    for(i = 0; i < hostSwExpectTxCnt; i++){
+        want_len = strlen(hostSwExpectTx[i]);
+        (void)memcpy(want, hostSwExpectTx[i], want_len);
+        want[want_len++] = '\r';
+        want[want_len++] = '\n';
+        j = tx_pos;
+        do{                                 /* Only at the start of a line */
+            hit = memmem(&hostSwTxLog[j], tx_cnt - j, want, want_len);
+            if(hit != NULL){
+                j = (INT32U)(hit - hostSwTxLog) + (INT32U)want_len;
+            }else{
+            }
+        }while((hit != NULL) && (hit != hostSwTxLog) && (hit[-1] != '\n'));
+        if(hit != NULL){
+            tx_pos = j;
+            tx_ok++;
+            (void)fprintf(stderr, "host: script tx \"%s\" ok\n", hostSwExpectTx[i]);
+        }else{
+            (void)fprintf(stderr, "host: script tx \"%s\" MISSING\n", hostSwExpectTx[i]);
+        }
+    }
+    (void)fprintf(stderr, "host: script %s: %u/%u expected, %u unexpected",
+                  ((ok_cnt == hostSwExpectCnt) && (tx_ok == hostSwExpectTxCnt) && (extra_cnt == 0u)) ? "PASS" : "FAIL",
+                  (unsigned)(ok_cnt + tx_ok), (unsigned)(hostSwExpectCnt + hostSwExpectTxCnt), (unsigned)extra_cnt);
+    if(ok_cnt != 0u){
+        (void)fprintf(stderr, ", latency ms avg/max %.1f/%.1f", lat_sum / (double)ok_cnt, lat_max);
+    }else{
+    }
+    (void)fprintf(stderr, "\n");
+    return (INT8U)((ok_cnt == hostSwExpectCnt) && (tx_ok == hostSwExpectTxCnt) && (extra_cnt == 0u));
+}
+
+/*****************************************************************************************
+* hostGpioEdge() - Apply the pin's ICR IRQC setting to an edge on a GPIO0 input.
+*   Level settings are treated as the edge into that level.
+*****************************************************************************************/
+static void hostGpioEdge(INT32U pin, INT8U rising){
+    INT32U irqc;
+    INT8U flag;
+    INT8U bit = (INT8U)__builtin_ctzl(pin);
+
+    irqc = (GPIO0->ICR[bit] & GPIO_ICR_IRQC_MASK) >> 16u;
+    switch(irqc){
+    case GPIO_IRQ_DMA_RE: case GPIO_IRQ_ISF_RE: case GPIO_IRQ_RE: case GPIO_IRQ_ONE:
+        flag = rising;
+        break;
+    case GPIO_IRQ_DMA_FE: case GPIO_IRQ_ISF_FE: case GPIO_IRQ_FE: case GPIO_IRQ_ZERO:
+        flag = (INT8U)!rising;
+        break;
+    case GPIO_IRQ_DMA_EE: case GPIO_IRQ_ISF_EE: case GPIO_IRQ_EE:
+        flag = TRUE;
+        break;
+    default:
+        flag = FALSE;
+        break;
+    }
+    if(flag != FALSE){
+        (void)__atomic_fetch_or(&GPIO0->ISFR[0], (uint32_t)pin, __ATOMIC_SEQ_CST);
+        if((irqc >= GPIO_IRQ_ZERO) && (irqc <= GPIO_IRQ_ONE)){
+            NVIC_SetPendingIRQ(GPIO00_IRQn);
+        }else{
+        }
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* hostLptmrTask() - LPTMR0 model. Compare match every (CMR + 1) timer counts.
+*****************************************************************************************/
+static void *hostLptmrTask(void *p_arg){
+    struct timespec next;
+    INT64U period_ns;
+    (void)p_arg;
+    CPU_HostThreadSigBlock();
+    (void)clock_gettime(CLOCK_MONOTONIC, &next);
+    while(1){
+        if(LPTMR0->CMR != 0u){
+            period_ns = ((INT64U)LPTMR0->CMR + 1u) * 1000000000uLL / HOST_LPTMR_CLK_HZ;
+        }else{
+            period_ns = HOST_LPTMR_DEF_NS;
+        }
+        next.tv_nsec += (long)period_ns;
+        while(next.tv_nsec >= 1000000000L){
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR){}
+        if((LPTMR0->CSR & (LPTMR_CSR_TEN(1) | LPTMR_CSR_TIE(1))) == (LPTMR_CSR_TEN(1) | LPTMR_CSR_TIE(1))){
+            (void)__atomic_fetch_or(&LPTMR0->CSR, LPTMR_CSR_TCF(1), __ATOMIC_SEQ_CST);
+            NVIC_SetPendingIRQ(LPTMR0_IRQn);
+        }else{
+        }
+    }
+    return NULL;
+}
+
+/*****************************************************************************************
+* HostLptmrCsrWr() - LPTMR1 CSR write. TCF is write 1 to clear. Setting TEN starts the
+*   counter from 0, clearing it stops the counter and clears TCF. Free running (TFC) is
+*   assumed: a run raises one compare match and the counter does not wrap.
+*****************************************************************************************/
+void HostLptmrCsrWr(LPTMR_Type *base, uint32_t csr){
+    CPU_SR cpu_sr;
+    uint32_t old;
+    cpu_sr = CPU_SR_Save();
+    (void)pthread_mutex_lock(&hostTickLock);
+    old = base->CSR;
+    if((csr & LPTMR_CSR_TCF(1)) != 0){
+        csr &= ~LPTMR_CSR_TCF(1);
+    }else{
+        csr |= old & LPTMR_CSR_TCF(1);
+    }
+    if((csr & LPTMR_CSR_TEN(1)) == 0){
+        csr &= ~LPTMR_CSR_TCF(1);
+    }else if((old & LPTMR_CSR_TEN(1)) == 0){
+        hostTickStartNs = hostNowNs();
+        hostTickRun++;
+        if(hostTickT0Ns == 0u){
+            hostTickT0Ns = hostTickStartNs;
+            hostTickCtr0 = OSTickCtr;
+        }else{
+        }
+    }else{
+    }
+    base->CSR = csr;
+    (void)pthread_cond_signal(&hostTickCond);
+    (void)pthread_mutex_unlock(&hostTickLock);
+    CPU_SR_Restore(cpu_sr);
+}
+
+/*****************************************************************************************
+* HostLptmrCnrRd() - LPTMR1 CNR read, the counts since TEN was set.
+*****************************************************************************************/
+uint32_t HostLptmrCnrRd(LPTMR_Type *base){
+    CPU_SR cpu_sr;
+    INT64U cnt = 0;
+    cpu_sr = CPU_SR_Save();
+    (void)pthread_mutex_lock(&hostTickLock);
+    if((base->CSR & LPTMR_CSR_TEN(1)) != 0){
+        cnt = (hostNowNs() - hostTickStartNs) * HOST_LPTMR_CLK_HZ / HOST_NS_PER_S;
+    }else{
+    }
+    (void)pthread_mutex_unlock(&hostTickLock);
+    CPU_SR_Restore(cpu_sr);
+    return (uint32_t)cnt;
+}
+
+/*****************************************************************************************
+* hostTickTask() - LPTMR1 compare. Waits for the time the counter goes past CMR in the
+*   current run, sets TCF and raises LPTMR1_IRQn if TIE is set. A CSR write wakes it to
+*   look again.
+*****************************************************************************************/
+static void *hostTickTask(void *p_arg){
+    struct timespec ts;
+    INT64U match_ns;
+    INT32U run;
+    INT8U raise;
+    (void)p_arg;
+    CPU_HostThreadSigBlock();
+    (void)pthread_mutex_lock(&hostTickLock);
+    while(1){
+        run = hostTickRun;
+        if(((LPTMR1->CSR & (LPTMR_CSR_TEN(1) | LPTMR_CSR_TIE(1))) != (LPTMR_CSR_TEN(1) | LPTMR_CSR_TIE(1))) ||
+           (hostTickMatchRun == run)){
+            (void)pthread_cond_wait(&hostTickCond, &hostTickLock);
+            continue;
+        }else{
+        }
+        match_ns = hostTickStartNs + ((((INT64U)LPTMR1->CMR + 1u) * HOST_NS_PER_S) +
+                                      HOST_LPTMR_CLK_HZ - 1u) / HOST_LPTMR_CLK_HZ;
+        if(hostNowNs() < match_ns){
+            ts.tv_sec = (time_t)(match_ns / HOST_NS_PER_S);
+            ts.tv_nsec = (long)(match_ns % HOST_NS_PER_S);
+            (void)pthread_cond_timedwait(&hostTickCond, &hostTickLock, &ts);
+            continue;
+        }else{
+        }
+        hostTickMatchRun = run;
+        hostTickMatchNs = match_ns;
+        LPTMR1->CSR |= LPTMR_CSR_TCF(1);
+        raise = (INT8U)((LPTMR1->CSR & LPTMR_CSR_TIE(1)) != 0);
+        (void)pthread_mutex_unlock(&hostTickLock);
+        if(raise != FALSE){
+            NVIC_SetPendingIRQ(LPTMR1_IRQn);
+        }else{
+        }
+        (void)pthread_mutex_lock(&hostTickLock);
+    }
+    return NULL;
+}
+
+/*****************************************************************************************
+* HostTickIrq() - Dynamic tick measurement hook, kernel thread. The kernel time error is
+*   OSTickCtr against the time since LPTMR1 first started; a whole tick less is exact
+*   (OSTickCtr counts whole ticks), anything beyond that is time lost by the restarts.
+*   With OS_CFG_ISR_POST_DEFERRED_EN the ISR handler task has yet to add this interrupt's
+*   ticks, so they are added here.
+*****************************************************************************************/
+void HostTickIrq(uint32_t ticks){
+    INT64U now = hostNowNs();
+    INT64U match_ns = hostTickMatchNs;
+    INT64U late = (now > match_ns) ? (now - match_ns) : 0u;
+    OS_TICK ctr = OSTickCtr;
+    INT64S err;
+
+    hostTickIrqCnt++;
+    if(ticks == 0u){
+        hostTickNoneCnt++;
+        return;
+    }else{
+    }
+    hostTickTicks += ticks;
+    hostTickLateSumNs += late;
+    if(late > hostTickLateMaxNs){
+        hostTickLateMaxNs = late;
+    }else{
+    }
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    ctr += (OS_TICK)ticks;
+#endif
+    err = (INT64S)((INT64U)(OS_TICK)(ctr - hostTickCtr0) * (HOST_NS_PER_S / OS_CFG_TICK_RATE_HZ)) -
+          (INT64S)(now - hostTickT0Ns);
+    hostTickErrNs = err;
+    if(((err < 0) ? -err : err) > hostTickErrMaxNs){
+        hostTickErrMaxNs = (err < 0) ? -err : err;
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* hostTickReport() - Dynamic tick interrupt rate and accuracy on exit, if it ran.
+*****************************************************************************************/
+static void hostTickReport(void){
+    double run_s;
+    INT32U n = hostTickIrqCnt - hostTickNoneCnt;
+    if(hostTickT0Ns == 0u){
+        return;
+    }else{
+    }
+    run_s = (double)(hostNowNs() - hostTickT0Ns) / 1e9;
+    (void)fprintf(stderr, "host: dyn tick: %u interrupts in %.1f s (%.1f/s, periodic %u/s), %u with no tick due,"
+                  " %u restarts\n", (unsigned)hostTickIrqCnt, run_s, (double)hostTickIrqCnt / run_s,
+                  (unsigned)OS_CFG_TICK_RATE_HZ, (unsigned)hostTickNoneCnt, (unsigned)hostTickRun);
+    if(n != 0u){
+        (void)fprintf(stderr, "host: dyn tick: %.1f ticks per interrupt, kernel time error us last/max %+.1f/%.1f,"
+                      " interrupt late us avg/max %.1f/%.1f\n",
+                      (double)hostTickTicks / (double)n, (double)hostTickErrNs / 1e3,
+                      (double)hostTickErrMaxNs / 1e3, (double)hostTickLateSumNs / 1e3 / (double)n,
+                      (double)hostTickLateMaxNs / 1e3);
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* hostIntDisReport() - Longest time interrupts were disabled, from CPU_IntDisMeasMaxGet(),
+*   when built with CPU_CFG_INT_DIS_MEAS_EN, and the ISR post queue use when posts from
+*   ISRs are deferred (OS_CFG_ISR_POST_DEFERRED_EN).
+*****************************************************************************************/
+static void hostIntDisReport(void){
+#ifdef CPU_CFG_INT_DIS_MEAS_EN
+    (void)fprintf(stderr, "host: interrupts disabled max %.1f us\n",
+                  (double)CPU_IntDisMeasMaxGet() / 1e3);
+#endif
+#if (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    (void)fprintf(stderr, "host: ISR post queue: %u of %u slots used at most, %u posts lost\n",
+                  (unsigned)OSIntQNbrEntriesMax, (unsigned)OS_CFG_INT_Q_SIZE, (unsigned)OSIntQOvfCtr);
+#endif
+}
+
+/*****************************************************************************************
+* hostUartTxTask() - LPUART4 transmitter. Moves one character at a time from the FIFO
+*   to the shifter (stdout) and holds it for one character time. Back to back characters
+*   keep to the bit rate on absolute deadlines, sleep overshoot doesn't add up.
+*****************************************************************************************/
+static void *hostUartTxTask(void *p_arg){
+    uint8_t c;
+    INT64U char_ns;
+    INT64U next_ns = 0;
+    (void)p_arg;
+    CPU_HostThreadSigBlock();
+    (void)pthread_mutex_lock(&hostUartLock);
+    while(1){
+        while(hostUartTxIn == hostUartTxOut){
+            (void)pthread_cond_wait(&hostUartCond, &hostUartLock);
+        }
+        c = hostUartTxFifo[hostUartTxOut % HOST_UART_FIFO_SIZE];
+        hostUartTxOut++;
+        hostUartTxBusy = TRUE;
+        hostUartTxRegsUpdate();
+        (void)pthread_cond_broadcast(&hostUartSpaceCond);
+        char_ns = hostUartCharNs();
+        (void)pthread_mutex_unlock(&hostUartLock);
+
+        if(next_ns < hostNowNs()){
+            next_ns = hostNowNs();          /* Shifter was idle */
+        }else{
+        }
+        while((write(hostUartFd, &c, 1) < 0) && (errno == EINTR)){}
+        if((hostSwScriptFile != NULL) && (hostSwTxLogCnt < HOST_SW_TX_LOG_SIZE)){
+            hostSwTxLog[hostSwTxLogCnt] = (char)c;
+            __atomic_store_n(&hostSwTxLogCnt, hostSwTxLogCnt + 1u, __ATOMIC_SEQ_CST);
+        }else{
+        }
+        next_ns += char_ns;
+        hostSleepUntilNs(next_ns);
+
+        (void)pthread_mutex_lock(&hostUartLock);
+        hostUartTxBusy = FALSE;
+        hostUartTxRegsUpdate();
+    }
+    return NULL;
+}
+
+/*****************************************************************************************
+* BIODmaInit(), BIODmaStart(), BIODmaDoneClr() - Host versions of the BIO_dma.c DMA0
+*   register access. See BIO_dma.h.
+*****************************************************************************************/
+void BIODmaInit(void){
+    NVIC_ClearPendingIRQ(EDMA_0_CH0_IRQn);
+    NVIC_EnableIRQ(EDMA_0_CH0_IRQn);
+}
+
+void BIODmaStart(const BIO_DMA_TCD *tcd){
+    CPU_SR cpu_sr;
+    cpu_sr = CPU_SR_Save();
+    (void)pthread_mutex_lock(&hostUartLock);
+    hostDmaTcd = tcd;
+    LPUART4->BAUD |= LPUART_BAUD_TDMAE_MASK;
+    (void)pthread_cond_signal(&hostDmaCond);
+    (void)pthread_mutex_unlock(&hostUartLock);
+    CPU_SR_Restore(cpu_sr);
+}
+
+void BIODmaDoneClr(void){
+    CPU_SR cpu_sr;
+    cpu_sr = CPU_SR_Save();
+    (void)pthread_mutex_lock(&hostUartLock);
+    LPUART4->BAUD &= ~LPUART_BAUD_TDMAE_MASK;
+    (void)pthread_mutex_unlock(&hostUartLock);
+    CPU_SR_Restore(cpu_sr);
+}
+
+/*****************************************************************************************
+* FlashStoreHwBase(), FlashStoreHwErase(), FlashStoreHwProgram() - Host versions of the
+*   FlashStore.c flash access. Programming can only clear bits, as on the device.
+*****************************************************************************************/
+const INT8U *FlashStoreHwBase(void){
+    return hostFlash;
+}
+
+INT8U FlashStoreHwErase(void){
+    (void)memset(hostFlash, 0xFF, sizeof(hostFlash));
+    hostFlashEraseCnt++;
+    hostFlashSync();
+    return TRUE;
+}
+
+INT8U FlashStoreHwProgram(INT32U offset, const INT32U *page){
+    const INT8U *src = (const INT8U *)page;
+    INT32U i;
+    if(((offset % FLASH_STORE_SLOT_SIZE) != 0u) || (offset >= FLASH_STORE_SECTOR_SIZE)){
+        return FALSE;
+    }else{
+    }
+    for(i = 0; i < FLASH_STORE_SLOT_SIZE; i++){
+        hostFlash[offset + i] &= src[i];
+    }
+    hostFlashProgCnt++;
+    hostFlashSync();
+    return TRUE;
+}
+
+/*****************************************************************************************
+* hostFlashSync() - Write the sector back to HOST_FLASH_FILE.
+*****************************************************************************************/
+static void hostFlashSync(void){
+    FILE *f;
+    if(hostFlashFile != NULL){
+        f = fopen(hostFlashFile, "wb");
+        if(f != NULL){
+            (void)fwrite(hostFlash, 1, sizeof(hostFlash), f);
+            (void)fclose(f);
+        }else{
+        }
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* hostFlashReport() - Flash wear on exit, if the flash was written.
+*****************************************************************************************/
+static void hostFlashReport(void){
+    if((hostFlashEraseCnt + hostFlashProgCnt) != 0u){
+        (void)fprintf(stderr, "host: flash: %u page programs, %u sector erases\n",
+                      (unsigned)hostFlashProgCnt, (unsigned)hostFlashEraseCnt);
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* hostDmaTask() - DMA0 BasicIO TX channel. Runs each TCD's major loop one byte per
+*   LPUART TX request (TDMAE set and FIFO at or below TXWATER), follows DLAST_SGA while
+*   ESG is set and raises EDMA_0_CH0_IRQn at the end of a chain with INTMAJOR.
+*****************************************************************************************/
+static void *hostDmaTask(void *p_arg){
+    BIO_DMA_TCD tcd;
+    INT32U i;
+    (void)p_arg;
+    CPU_HostThreadSigBlock();
+    (void)pthread_mutex_lock(&hostUartLock);
+    while(1){
+        while(hostDmaTcd == NULL){
+            (void)pthread_cond_wait(&hostDmaCond, &hostUartLock);
+        }
+        tcd = *hostDmaTcd;
+        for(i = 0; i < tcd.CITER; i++){
+            while(((LPUART4->BAUD & LPUART_BAUD_TDMAE_MASK) == 0) ||
+                  ((hostUartTxIn - hostUartTxOut) > (LPUART4->WATER & LPUART_WATER_TXWATER_MASK))){
+                (void)pthread_cond_wait(&hostUartSpaceCond, &hostUartLock);
+            }
+            hostUartTxFifo[hostUartTxIn % HOST_UART_FIFO_SIZE] =
+                *(const uint8_t *)(tcd.SADDR + (INT32U)tcd.SOFF * i);
+            hostUartTxIn++;
+            hostUartTxRegsUpdate();
+            (void)pthread_cond_signal(&hostUartCond);
+        }
+        if((tcd.CSR & BIO_DMA_CSR_ESG) != 0){
+            hostDmaTcd = (const BIO_DMA_TCD *)tcd.DLAST_SGA;
+        }else{
+            hostDmaTcd = NULL;
+            if((tcd.CSR & BIO_DMA_CSR_INTMAJOR) != 0){
+                NVIC_SetPendingIRQ(EDMA_0_CH0_IRQn);
+            }else{
+            }
+        }
+    }
+    return NULL;
+}
+
+/*****************************************************************************************
+* hostUartTxRegsUpdate() - Recompute TXCOUNT, TDRE and TC, and raise the TX interrupt
+*   while TIE and TDRE are both set. Called with hostUartLock held.
+*****************************************************************************************/
+static void hostUartTxRegsUpdate(void){
+    INT32U cnt = hostUartTxIn - hostUartTxOut;
+    INT32U water = LPUART4->WATER;
+    INT32U set = 0;
+    INT32U clr;
+
+    LPUART4->WATER = (water & ~LPUART_WATER_TXCOUNT_MASK) |
+                     ((cnt << LPUART_WATER_TXCOUNT_SHIFT) & LPUART_WATER_TXCOUNT_MASK);
+    if(cnt <= (water & LPUART_WATER_TXWATER_MASK)){
+        set |= LPUART_STAT_TDRE_MASK;
+    }else{
+    }
+    if((cnt == 0) && (hostUartTxBusy == FALSE)){
+        set |= LPUART_STAT_TC_MASK;
+    }else{
+    }
+    clr = (LPUART_STAT_TDRE_MASK | LPUART_STAT_TC_MASK) & ~set;
+    (void)__atomic_fetch_or(&LPUART4->STAT, set, __ATOMIC_SEQ_CST);
+    (void)__atomic_fetch_and(&LPUART4->STAT, ~clr, __ATOMIC_SEQ_CST);
+    if(((set & LPUART_STAT_TDRE_MASK) != 0) && ((LPUART4->CTRL & LPUART_CTRL_TIE_MASK) != 0)){
+        NVIC_SetPendingIRQ(LP_FLEXCOMM4_IRQn);
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* hostUartCharNs() - One character time (start + 8 data + stop) from BAUD.
+*****************************************************************************************/
+static INT64U hostUartCharNs(void){
+    INT32U sbr = LPUART4->BAUD & 0x1FFFu;
+    INT32U osr = ((LPUART4->BAUD >> 24u) & 0x1Fu) + 1u;
+    INT64U char_ns;
+    if(sbr == 0u){
+        char_ns = 0u;
+    }else{
+        char_ns = (10uLL * 1000000000uLL * osr * sbr) / HOST_LPUART_CLK_HZ;
+    }
+    return char_ns;
+}
+
+/*****************************************************************************************
+* hostUartReport() - Report TX FIFO overruns on exit.
+*****************************************************************************************/
+static void hostUartReport(void){
+    static const char msg[] = "host: LPUART4 TX FIFO overruns: ";
+    char num[12];
+    INT8U i = sizeof(num);
+    INT32U n = hostUartTxOvfCnt;
+    if(n != 0u){
+        do{
+            i--;
+            num[i] = (char)('0' + (n % 10u));
+            n /= 10u;
+        }while((n != 0u) && (i > 0u));
+        (void)write(STDERR_FILENO, msg, sizeof(msg) - 1u);
+        (void)write(STDERR_FILENO, &num[i], sizeof(num) - i);
+        (void)write(STDERR_FILENO, "\n", 1);
+    }else{
+    }
+}
+
+/*****************************************************************************************
+* hostTermRestore(), hostSigIntHandler() - Put the terminal back on the way out.
+*****************************************************************************************/
+static void hostTermRestore(void){
+    if(hostTermIsRaw != FALSE){
+        (void)tcsetattr(STDIN_FILENO, TCSANOW, &hostTermSaved);
+    }else{
+    }
+}
+
+static void hostSigIntHandler(int sig){
+    (void)sig;
+    hostTermRestore();
+    _exit(1);
+}
+
+/*****************************************************************************************
+* hostSleepMs() - Model thread delay.
+*****************************************************************************************/
+static void hostSleepMs(INT32U ms){
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ms / 1000u);
+    ts.tv_nsec = (long)(ms % 1000u) * 1000000L;
+    while(nanosleep(&ts, &ts) != 0){}
+}
+
+/*****************************************************************************************
+* hostSleepUntilUs() - Model thread delay until us after t0.
+*****************************************************************************************/
+static void hostSleepUntilUs(const struct timespec *t0, INT32U us){
+    struct timespec t = *t0;
+    t.tv_sec += (time_t)(us / 1000000u);
+    t.tv_nsec += (long)(us % 1000000u) * 1000L;
+    if(t.tv_nsec >= 1000000000L){
+        t.tv_nsec -= 1000000000L;
+        t.tv_sec++;
+    }else{
+    }
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) == EINTR){}
+}
+
+/*****************************************************************************************
+* hostSleepUntilNs() - Model thread delay until hostNowNs() reaches t_ns.
+*****************************************************************************************/
+static void hostSleepUntilNs(INT64U t_ns){
+    struct timespec t;
+    t.tv_sec = (time_t)(t_ns / HOST_NS_PER_S);
+    t.tv_nsec = (long)(t_ns % HOST_NS_PER_S);
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) == EINTR){}
+}
+
+/*****************************************************************************************
+* hostNowNs() - CLOCK_MONOTONIC in ns.
+*****************************************************************************************/
+static INT64U hostNowNs(void){
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((INT64U)ts.tv_sec * 1000000000uLL) + (INT64U)ts.tv_nsec;
+}
@@ -0,0 +1,212 @@
+/*****************************************************************************************
+* pend_bench.c - Critical section lengths of the Cs/OS3 pend lists (os_core.c) on the host,
+*   for the sorted walk (OS_CFG_PEND_LIST_BITMAP_EN 0) or the priority bitmap (1).
+*
+* For 1 to 64 waiters on one semaphore, replays the same seeded workload: the waiters
+* pend one after the other at random priorities, as tasks blocking in OSSemPend() would,
+* then they are posted to one at a time, highest priority first, as OSSemPost() does.
+* Reported, in ns:
+*   insert  - OS_PendListInsertPrio(), the variable part of OS_Pend() with interrupts
+*             masked, over all the waiters
+*   lowest  - the same for a waiter below all the others, the walk's worst case
+*   chprio  - OS_PendListChangePrio() of that waiter to the top, as a mutex owner
+*             inheriting a priority while it waits on something else
+*   post    - OS_PendListRemove() of the highest waiter, the pend list part of OS_Post()
+* Each workload runs BENCH_PASSES times and every event keeps its fastest pass, which
+* takes out host preemption, then the maximum over the run is reported. Every pass also
+* checks the list is in priority order, FIFO within a priority.
+*
+* Kernel only, no OSStart(): the TCBs are dummies that never run. Periodic tick, so no
+* tick timer is needed.
+*
+* From SymbolEntry/, once per structure (B=0 walk, B=1 bitmap):
+*   gcc -O2 -DCS_HOST_POSIX -DOS_CFG_DYN_TICK_EN=0u -DOS_CFG_PEND_LIST_BITMAP_EN=${B}u \
+*       -Ihost -Isource -Iboard -ICsOS/Cs-CFG -ICsOS/Cs-CPU/Posix -ICsOS/Cs-CPU -ICsOS/Cs-LIB -ICsOS/Cs-OS3 \
+*       host/pend_bench.c CsOS/Cs-OS3/os_*.c CsOS/Cs-LIB/lib_*.c CsOS/Cs-CPU/cpu_core.c \
+*       CsOS/Cs-CFG/os_app_hooks.c CsOS/Cs-CPU/Posix/cpu_c.c CsOS/Cs-CPU/Posix/os_cpu_c.c \
+*       -o pend_bench$B -lpthread -lrt
+*   ./pend_bench$B
+*****************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "os.h"
+#include "cpu.h"
+
+#define BENCH_WAITERS_MAX 64u
+#define BENCH_PASSES      5u
+#define BENCH_PRIO_LO     (OS_CFG_PRIO_MAX - 2u)  /* Below every random priority */
+#define BENCH_PRIO_SPAN   (BENCH_PRIO_LO - 1u)     /* Random priorities are 1 to this */
+
+static OS_SEM benchSem;
+static OS_TCB benchTcb[BENCH_WAITERS_MAX];
+static CPU_TS benchIns[BENCH_WAITERS_MAX];         /* Fastest pass per insert */
+static CPU_TS benchPost[BENCH_WAITERS_MAX];        /* Fastest pass per post */
+static CPU_TS benchLowest;
+static CPU_TS benchChPrio;
+static CPU_INT32U benchSeed;
+
+static CPU_BOOLEAN benchRun(CPU_INT32U nwaiters);
+static CPU_TS benchInsert(OS_TCB *p_tcb);
+static CPU_BOOLEAN benchCheck(void);
+static OS_PRIO benchRand(void);
+
+int main(void){
+    static const CPU_INT32U nwaiters[] = {1u, 2u, 4u, 8u, 16u, 32u, 64u};
+    OS_ERR os_err;
+    CPU_INT32U n;
+    CPU_INT32U pass;
+    CPU_INT32U i;
+    CPU_TS ins_max;
+    CPU_TS post_max;
+
+    CPU_Init();
+    OSInit(&os_err);
+    if(os_err != OS_ERR_NONE){
+        (void)fprintf(stderr, "pend_bench: OSInit() error %u\n", (unsigned)os_err);
+        return 1;
+    }else{
+    }
+    OSSemCreate(&benchSem, "Bench Sem", 0u, &os_err);
+    if(os_err != OS_ERR_NONE){
+        (void)fprintf(stderr, "pend_bench: OSSemCreate() error %u\n", (unsigned)os_err);
+        return 1;
+    }else{
+    }
+#if (OS_CFG_PEND_LIST_BITMAP_EN > 0u)
+    (void)printf("priority bitmap\n");
+#else
+    (void)printf("sorted walk\n");
+#endif
+    (void)printf("waiters  insert max  lowest  chprio  post max   (ns, priorities 1-%u)\n",
+                 (unsigned)BENCH_PRIO_SPAN);
+
+    for(n = 0; n < (sizeof(nwaiters) / sizeof(nwaiters[0])); n++){
+        for(i = 0; i < BENCH_WAITERS_MAX; i++){
+            benchIns[i] = (CPU_TS)-1;
+            benchPost[i] = (CPU_TS)-1;
+        }
+        benchLowest = (CPU_TS)-1;
+        benchChPrio = (CPU_TS)-1;
+        for(pass = 0; pass < BENCH_PASSES; pass++){
+            if(benchRun(nwaiters[n]) == DEF_FALSE){
+                (void)fprintf(stderr, "pend_bench: pend list out of order, %u waiters\n",
+                              (unsigned)nwaiters[n]);
+                return 1;
+            }else{
+            }
+        }
+
+        ins_max = 0;
+        post_max = 0;
+        for(i = 0; i < nwaiters[n]; i++){
+            ins_max = (benchIns[i] > ins_max) ? benchIns[i] : ins_max;
+            post_max = (benchPost[i] > post_max) ? benchPost[i] : post_max;
+        }
+        (void)printf("%7u  %10u  %6u  %6u  %8u\n", (unsigned)nwaiters[n], (unsigned)ins_max,
+                     (unsigned)benchLowest, (unsigned)benchChPrio, (unsigned)post_max);
+    }
+    return 0;
+}
+
+/*****************************************************************************************
+* benchRun() - One pass of the workload for nwaiters waiters. The seed restarts every
+*   pass, so event i is the same operation on the same pend list in every pass. Returns
+*   DEF_FALSE if the list was ever out of order.
+*****************************************************************************************/
+static CPU_BOOLEAN benchRun(CPU_INT32U nwaiters){
+    OS_TCB *p_tcb;
+    CPU_TS t0;
+    CPU_TS t1;
+    CPU_TS t;
+    CPU_INT32U i;
+    CPU_BOOLEAN ok = DEF_TRUE;
+    CPU_SR_ALLOC();
+
+    benchSeed = 12345u;
+    (void)memset(benchTcb, 0, sizeof(benchTcb));
+    for(i = 0; i < nwaiters; i++){
+        benchTcb[i].TaskState = OS_TASK_STATE_PEND;
+        benchTcb[i].PendOn = OS_TASK_PEND_ON_SEM;
+        benchTcb[i].Prio = (i < (nwaiters - 1u)) ? benchRand() : (OS_PRIO)BENCH_PRIO_LO;
+        t = benchInsert(&benchTcb[i]);
+        if(t < benchIns[i]){
+            benchIns[i] = t;
+        }else{
+        }
+    }
+    benchLowest = (benchIns[nwaiters - 1u] < benchLowest) ? benchIns[nwaiters - 1u] : benchLowest;
+    ok = (benchCheck() == DEF_FALSE) ? DEF_FALSE : ok;
+
+    /* The lowest waiter inherits the top priority, as OS_TaskChangePrio() does it */
+    p_tcb = &benchTcb[nwaiters - 1u];
+    CPU_CRITICAL_ENTER();
+    t0 = OS_TS_GET();
+    p_tcb->Prio = 0u;
+    OS_PendListChangePrio(p_tcb);
+    t1 = OS_TS_GET();
+    CPU_CRITICAL_EXIT();
+    benchChPrio = ((t1 - t0) < benchChPrio) ? (t1 - t0) : benchChPrio;
+    ok = (benchCheck() == DEF_FALSE) ? DEF_FALSE : ok;
+    ok = (benchSem.PendList.HeadPtr != p_tcb) ? DEF_FALSE : ok;
+
+    /* Post to the highest waiter until none are left */
+    for(i = 0; i < nwaiters; i++){
+        CPU_CRITICAL_ENTER();
+        p_tcb = benchSem.PendList.HeadPtr;
+        t0 = OS_TS_GET();
+        OS_PendListRemove(p_tcb);
+        t1 = OS_TS_GET();
+        CPU_CRITICAL_EXIT();
+        benchPost[i] = ((t1 - t0) < benchPost[i]) ? (t1 - t0) : benchPost[i];
+        ok = (benchCheck() == DEF_FALSE) ? DEF_FALSE : ok;
+    }
+    ok = (benchSem.PendList.HeadPtr != (OS_TCB *)0) ? DEF_FALSE : ok;
+    return ok;
+}
+
+/*****************************************************************************************
+* benchInsert() - What OS_Pend() does with interrupts masked, timing the pend list part.
+*****************************************************************************************/
+static CPU_TS benchInsert(OS_TCB *p_tcb){
+    CPU_TS t0;
+    CPU_TS t1;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    p_tcb->PendObjPtr = (OS_PEND_OBJ *)((void *)&benchSem);
+    t0 = OS_TS_GET();
+    OS_PendListInsertPrio(&benchSem.PendList, p_tcb);
+    t1 = OS_TS_GET();
+    CPU_CRITICAL_EXIT();
+    return t1 - t0;
+}
+
+/*****************************************************************************************
+* benchCheck() - The pend list is linked both ways and in priority order, FIFO within a
+*   priority (benchTcb[] is in pend order, so a lower index must come first).
+*****************************************************************************************/
+static CPU_BOOLEAN benchCheck(void){
+    OS_TCB *p_tcb;
+    OS_TCB *p_prev = (OS_TCB *)0;
+
+    for(p_tcb = benchSem.PendList.HeadPtr; p_tcb != (OS_TCB *)0; p_tcb = p_tcb->PendNextPtr){
+        if(p_tcb->PendPrevPtr != p_prev){
+            return DEF_FALSE;
+        }else if((p_prev != (OS_TCB *)0) && ((p_prev->Prio > p_tcb->Prio) ||
+                 ((p_prev->Prio == p_tcb->Prio) && (p_prev > p_tcb)))){
+            return DEF_FALSE;
+        }else{
+        }
+        p_prev = p_tcb;
+    }
+    return (benchSem.PendList.TailPtr == p_prev) ? DEF_TRUE : DEF_FALSE;
+}
+
+/*****************************************************************************************
+* benchRand() - Priority, 1 to BENCH_PRIO_SPAN. LCG, so runs repeat exactly.
+*****************************************************************************************/
+static OS_PRIO benchRand(void){
+    benchSeed = (benchSeed * 1103515245u) + 12345u;
+    return (OS_PRIO)(((benchSeed >> 16) % BENCH_PRIO_SPAN) + 1u);
+}
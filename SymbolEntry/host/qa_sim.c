@@ -0,0 +1,212 @@
+/*****************************************************************************************
+* qa_sim.c - Replays a symbol usage trace against the menu navigation and reports the
+*   average number of button presses per symbol sent, with and without the quick access
+*   ring (source/QuickAccess.c, linked in unchanged with the flash store stubbed out).
+*
+*   Flat       - SW2 / SW2+SW3 through the whole table in ID order
+*   Categories - double tap SW2 (2 presses) to the next category, then SW2 / SW2+SW3
+*                within it; the selection stays on the symbol just sent
+*   Quick ring - as Categories, plus the ring after the last category; every send
+*                selects the top of the ring, as SetLastSentSymbol() does
+* Each count includes the SW3 press that sends the symbol.
+*
+* From SymbolEntry/:
+*   gcc -O2 -Wall -DCS_HOST_POSIX -Ihost -Isource -Iboard -ICsOS/Cs-CFG \
+*       host/qa_sim.c source/QuickAccess.c source/SymCatalog.c -o qa_sim
+*   ./qa_sim host/usage.trace
+* The trace is glyphs separated by white space, in the order they were sent; '#' starts
+* a comment.
+*****************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "SymCatalog.h"
+#include "QuickAccess.h"
+#include "FlashStore.h"
+
+#define SIM_QUICK   SYMCAT_CAT_COUNT    /* CATEGORY_QUICK */
+#define SIM_NCAT    (SYMCAT_CAT_COUNT + 1u)
+
+static INT16U simLookup(const char *glyph);
+static INT8U simCategoryOf(INT16U id);
+static INT32U simSteps(INT32S from, INT32S to, INT32S cnt);
+static INT32U simCatSteps(INT8U from, INT8U to, INT8U quick_empty);
+
+/*****************************************************************************************
+* FlashStoreLoad(), FlashStoreSave() - No flash, the ring starts empty.
+*****************************************************************************************/
+INT8U FlashStoreLoad(void *data, INT8U len){
+    (void)data;
+    (void)len;
+    return FALSE;
+}
+
+INT8U FlashStoreSave(const void *data, INT8U len){
+    (void)data;
+    (void)len;
+    return TRUE;
+}
+
+int main(int argc, char *argv[]){
+    FILE *f;
+    char word[64];
+    int c;
+    INT32U len;
+    INT16U id;
+    INT8U cat;
+    INT8U rank;
+    INT32U n = 0;
+    INT32U unknown = 0;
+    INT32U ring_hits = 0;
+    INT32U flat = 0;
+    INT32U bycat = 0;
+    INT32U quick = 0;
+    INT32U cost;
+    INT32U alt;
+    INT16U flat_pos = 0;
+    INT16U cat_pos = 0;
+
+    if(argc != 2){
+        (void)fprintf(stderr, "usage: %s <usage trace>\n", argv[0]);
+        return 2;
+    }else{
+    }
+    f = fopen(argv[1], "r");
+    if(f == NULL){
+        perror(argv[1]);
+        return 2;
+    }else{
+    }
+    QAInit();
+
+    for(;;){
+        /* Next word, skipping comments */
+        len = 0;
+        while(((c = fgetc(f)) != EOF) && ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'))){
+        }
+        if(c == '#'){
+            while(((c = fgetc(f)) != EOF) && (c != '\n')){
+            }
+            continue;
+        }else{
+        }
+        while((c != EOF) && (c != ' ') && (c != '\t') && (c != '\r') && (c != '\n')){
+            if(len < (sizeof(word) - 1u)){
+                word[len++] = (char)c;
+            }else{
+            }
+            c = fgetc(f);
+        }
+        if(len == 0){
+            break;
+        }else{
+        }
+        word[len] = '\0';
+        id = simLookup(word);
+        if(id == SYMCAT_ID_NONE){
+            unknown++;
+            continue;
+        }else{
+        }
+        cat = simCategoryOf(id);
+        n++;
+
+        /* Flat */
+        flat += simSteps(flat_pos, id, SYMCAT_SYM_COUNT) + 1u;
+        flat_pos = id;
+
+        /* Categories */
+        if(simCategoryOf(cat_pos) == cat){
+            cost = simSteps(cat_pos, id, SymCatCatFirst[cat + 1u] - SymCatCatFirst[cat]);
+        }else{
+            cost = 2u * simCatSteps(simCategoryOf(cat_pos), cat, TRUE) +
+                   simSteps(SymCatCatFirst[cat], id, SymCatCatFirst[cat + 1u] - SymCatCatFirst[cat]);
+        }
+        bycat += cost + 1u;
+        cat_pos = id;
+
+        /* Quick ring: starts on the top of the ring, or on category 0 while it is empty */
+        if(QACount() == 0){
+            cost = (cat == 0) ? 0u : (2u * simCatSteps(0, cat, TRUE));
+            cost += simSteps(SymCatCatFirst[cat], id, SymCatCatFirst[cat + 1u] - SymCatCatFirst[cat]);
+        }else{
+            cost = 2u * simCatSteps(SIM_QUICK, cat, FALSE) +
+                   simSteps(SymCatCatFirst[cat], id, SymCatCatFirst[cat + 1u] - SymCatCatFirst[cat]);
+            rank = QARank(id);
+            if(rank != QA_RANK_NONE){
+                alt = simSteps(0, rank, QACount());
+                if(alt <= cost){
+                    cost = alt;
+                    ring_hits++;
+                }else{
+                }
+            }else{
+            }
+        }
+        quick += cost + 1u;
+        QAUpdate(id);
+    }
+    (void)fclose(f);
+
+    if(n == 0){
+        (void)fprintf(stderr, "%s: no symbols from the catalog\n", argv[1]);
+        return 1;
+    }else{
+    }
+    (void)printf("%u symbols sent (%u not in the catalog), %u categories, ring of %u\n",
+                 (unsigned)n, (unsigned)unknown, (unsigned)SYMCAT_CAT_COUNT, (unsigned)APP_CFG_QA_SIZE);
+    (void)printf("presses per symbol: flat %.2f  categories %.2f  quick ring %.2f (%u%% ring hits)\n",
+                 (double)flat / n, (double)bycat / n, (double)quick / n, (unsigned)((ring_hits * 100u) / n));
+    return 0;
+}
+
+/*****************************************************************************************
+* simLookup() - Symbol ID of a glyph, SYMCAT_ID_NONE if it is not in the catalog.
+*****************************************************************************************/
+static INT16U simLookup(const char *glyph){
+    INT16U id;
+    for(id = 0; id < SYMCAT_SYM_COUNT; id++){
+        if(strcmp(&SymCatBlob[SymCatSymOff[id]], glyph) == 0){
+            return id;
+        }else{
+        }
+    }
+    return SYMCAT_ID_NONE;
+}
+
+/*****************************************************************************************
+* simCategoryOf() - Category holding a symbol ID.
+*****************************************************************************************/
+static INT8U simCategoryOf(INT16U id){
+    INT8U cat = 0;
+    while(id >= SymCatCatFirst[cat + 1u]){
+        cat++;
+    }
+    return cat;
+}
+
+/*****************************************************************************************
+* simSteps() - SW2 or SW2+SW3 presses from one position to another in a ring of cnt.
+*****************************************************************************************/
+static INT32U simSteps(INT32S from, INT32S to, INT32S cnt){
+    INT32S fwd = (((to - from) % cnt) + cnt) % cnt;
+    return (INT32U)((fwd <= (cnt - fwd)) ? fwd : (cnt - fwd));
+}
+
+/*****************************************************************************************
+* simCatSteps() - Double taps from one category to another, as StepCategory(1) moves.
+*****************************************************************************************/
+static INT32U simCatSteps(INT8U from, INT8U to, INT8U quick_empty){
+    INT32U steps = 0;
+    while(from != to){
+        from = (INT8U)((from + 1u) % SIM_NCAT);
+        if((from == SIM_QUICK) && (quick_empty != FALSE)){
+            from = 0;
+        }else{
+        }
+        steps++;
+    }
+    return steps;
+}
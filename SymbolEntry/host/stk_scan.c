@@ -0,0 +1,342 @@
+/*****************************************************************************************
+* stk_scan.c - Stack checks of the Cs/OS3 statistic task (os_stat.c) on the host: the
+*   passes of OS_StatTaskStkScan() against a full OSTaskStkChk() of every stack.
+*
+* Six stacks sized like the application's (start, symbol, switch, ISR handler, idle and
+* statistic tasks) start with a task frame at the top, then the same seeded workload runs
+* for SCAN_RUNS stat task runs: now and then a task goes deeper into its stack, up to its
+* peak in scanStkPeak[], pushing words that are mostly non-zero, and every run it rewrites
+* some of what it already uses, zeros included. After every run:
+*   - no stack may show more used than a full scan does (the mark lags, never leads)
+* and every SCAN_FREEZE runs the stacks stop changing until the scans catch up:
+*   - each stack must match the full scan within two passes of the words budget
+* Reported, for budgets of 0 (full scans, as OS_CFG_STAT_TASK_STK_CHK_WORDS 0) and up:
+*   words   - stack entries read per run, avg
+*   scan    - ns reading the six stacks in one stat task run, avg and max, without the
+*             critical sections: OS_StatStkScan() from the TCB fields read beforehand,
+*             or for full scans the zero count loop of OSTaskStkChk() (scanZeros()).
+*             Each is the time of SCAN_REPS repeats of the run divided by SCAN_REPS
+*   check   - ns for the stack checks of one stat task run as OS_StatTask() does them,
+*             avg and max. There is one critical section per stack either way, and on
+*             the host those mask signals, a system call each
+*   catchup - most runs a stack took to match the full scan once it stopped changing
+* A run keeps its fastest of SCAN_PASSES passes, which takes out host preemption.
+*
+* Kernel only, no OSStart(): the TCBs are dummies that never run. Periodic tick, so no
+* tick timer is needed.
+*
+* From SymbolEntry/:
+*   gcc -O2 -DCS_HOST_POSIX -DOS_CFG_DYN_TICK_EN=0u \
+*       -Ihost -Isource -Iboard -ICsOS/Cs-CFG -ICsOS/Cs-CPU/Posix -ICsOS/Cs-CPU -ICsOS/Cs-LIB -ICsOS/Cs-OS3 \
+*       host/stk_scan.c CsOS/Cs-OS3/os_*.c CsOS/Cs-LIB/lib_*.c CsOS/Cs-CPU/cpu_core.c \
+*       CsOS/Cs-CFG/os_app_hooks.c CsOS/Cs-CPU/Posix/cpu_c.c CsOS/Cs-CPU/Posix/os_cpu_c.c \
+*       -o stk_scan -lpthread -lrt
+*   ./stk_scan
+*****************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "os.h"
+#include "cpu.h"
+
+#define SCAN_TASKS    6u
+#define SCAN_STK_MAX  128u
+#define SCAN_FRAME    18u    /* Task frame OSTaskStkInit() leaves at the top */
+#define SCAN_RUNS     2000u
+#define SCAN_FREEZE   50u
+#define SCAN_PASSES   5u
+#define SCAN_REPS     32u
+
+static const CPU_STK_SIZE scanStkSize[SCAN_TASKS] = {128u, 128u, 128u, 128u, 64u, 100u};
+static const CPU_STK_SIZE scanStkPeak[SCAN_TASKS] = { 72u,  60u,  48u,  64u, 30u,  44u};
+static CPU_STK scanStk[SCAN_TASKS][SCAN_STK_MAX];
+static OS_TCB scanTcb[SCAN_TASKS];
+static OS_TCB scanCopyTcb[SCAN_TASKS];              /* Every pass starts from these */
+static CPU_STK_SIZE scanDepth[SCAN_TASKS];          /* Deepest entry pushed, from the top */
+static CPU_INT32U scanSeed;
+static CPU_INT32U scanWords;                        /* Entries read by the run */
+static CPU_TS scanScanNs;                           /* Scan only time of the run */
+
+static CPU_BOOLEAN scanBudget(CPU_STK_SIZE words);
+static CPU_TS scanRun(CPU_STK_SIZE words);
+static CPU_TS scanOnly(CPU_STK_SIZE words);
+static CPU_STK_SIZE scanZeros(const OS_TCB *p_tcb);
+static void scanTouch(void);
+static CPU_STK_SIZE scanFull(OS_TCB *p_tcb);
+static CPU_STK_SIZE scanLeft(OS_TCB *p_tcb);
+static CPU_INT32U scanRand(CPU_INT32U span);
+
+int main(void){
+    static const CPU_STK_SIZE budgets[] = {0u, 8u, 16u, 32u, 64u};
+    OS_ERR os_err;
+    CPU_INT32U b;
+
+    CPU_Init();
+    OSInit(&os_err);
+    if(os_err != OS_ERR_NONE){
+        (void)fprintf(stderr, "stk_scan: OSInit() error %u\n", (unsigned)os_err);
+        return 1;
+    }else{
+    }
+    (void)printf("budget  words  scan avg  scan max  check avg  check max  catchup   (ns, %u stacks)\n",
+                 (unsigned)SCAN_TASKS);
+    for(b = 0; b < (sizeof(budgets) / sizeof(budgets[0])); b++){
+        if(scanBudget(budgets[b]) == DEF_FALSE){
+            return 1;
+        }else{
+        }
+    }
+    return 0;
+}
+
+/*****************************************************************************************
+* scanBudget() - The workload with 'words' entries per stack per run, 0 for full scans.
+*   Returns DEF_FALSE, after saying why, if a stack ever disagreed with a full scan.
+*****************************************************************************************/
+static CPU_BOOLEAN scanBudget(CPU_STK_SIZE words){
+    CPU_INT32U run;
+    CPU_INT32U catchup;
+    CPU_INT32U catchup_max = 0;
+    CPU_INT32U catchup_lim;
+    CPU_INT32U words_sum = 0;
+    CPU_INT32U i;
+    CPU_BOOLEAN match;
+    CPU_TS t;
+    CPU_TS t_max = 0;
+    CPU_INT64U t_sum = 0;
+    CPU_TS s_max = 0;
+    CPU_INT64U s_sum = 0;
+
+    scanSeed = 12345u;
+    (void)memset(scanStk, 0, sizeof(scanStk));
+    (void)memset(scanTcb, 0, sizeof(scanTcb));
+    for(i = 0; i < SCAN_TASKS; i++){
+        scanTcb[i].StkBasePtr = &scanStk[i][0];
+        scanTcb[i].StkSize = scanStkSize[i];
+        scanTcb[i].StkPtr = &scanStk[i][scanStkSize[i] - SCAN_FRAME];
+        scanTcb[i].Opt = OS_OPT_TASK_STK_CHK;
+        scanDepth[i] = SCAN_FRAME;
+        for(run = scanStkSize[i] - SCAN_FRAME; run < scanStkSize[i]; run++){
+            scanStk[i][run] = (CPU_STK)(run + 1u);
+        }
+    }
+    catchup_lim = (words == 0u) ? 1u : ((2u * ((SCAN_STK_MAX + words - 1u) / words)) + 1u);
+
+    for(run = 0; run < SCAN_RUNS; run++){
+        if((run % SCAN_FREEZE) == (SCAN_FREEZE - 1u)){
+            /* Stacks stop changing: every one must match a full scan in two passes */
+            catchup = 0;
+            do{
+                t = scanRun(words);
+                t_sum += t;
+                t_max = (t > t_max) ? t : t_max;
+                s_sum += scanScanNs;
+                s_max = (scanScanNs > s_max) ? scanScanNs : s_max;
+                words_sum += scanWords;
+                catchup++;
+                match = DEF_TRUE;
+                for(i = 0; i < SCAN_TASKS; i++){
+                    match = (scanTcb[i].StkFree != scanFull(&scanTcb[i])) ? DEF_FALSE : match;
+                }
+            }while((match == DEF_FALSE) && (catchup < catchup_lim));
+            if(match == DEF_FALSE){
+                (void)fprintf(stderr, "stk_scan: budget %u, run %u, no match after %u runs\n",
+                              (unsigned)words, (unsigned)run, (unsigned)catchup);
+                return DEF_FALSE;
+            }else{
+            }
+            catchup_max = (catchup > catchup_max) ? catchup : catchup_max;
+        }else{
+            scanTouch();
+            t = scanRun(words);
+            t_sum += t;
+            t_max = (t > t_max) ? t : t_max;
+            s_sum += scanScanNs;
+            s_max = (scanScanNs > s_max) ? scanScanNs : s_max;
+            words_sum += scanWords;
+            for(i = 0; i < SCAN_TASKS; i++){
+                if(scanTcb[i].StkFree < scanFull(&scanTcb[i])){
+                    (void)fprintf(stderr, "stk_scan: budget %u, run %u, stack %u shows %u free, full scan %u\n",
+                                  (unsigned)words, (unsigned)run, (unsigned)i,
+                                  (unsigned)scanTcb[i].StkFree, (unsigned)scanFull(&scanTcb[i]));
+                    return DEF_FALSE;
+                }else{
+                }
+            }
+        }
+    }
+    (void)printf("%6u  %5u  %8u  %8u  %9u  %9u  %7u\n", (unsigned)words,
+                 (unsigned)(words_sum / SCAN_RUNS), (unsigned)(s_sum / SCAN_RUNS), (unsigned)s_max,
+                 (unsigned)(t_sum / SCAN_RUNS), (unsigned)t_max, (unsigned)catchup_max);
+    return DEF_TRUE;
+}
+
+/*****************************************************************************************
+* scanRun() - The stack checks of one stat task run, as OS_StatTask() does them, timed.
+*   Every pass starts from the same TCBs and the fastest is returned; the last pass is
+*   left in place. The scan only time of the run goes to scanScanNs.
+*****************************************************************************************/
+static CPU_TS scanRun(CPU_STK_SIZE words){
+    OS_ERR os_err;
+    CPU_INT32U pass;
+    CPU_INT32U i;
+    CPU_TS t0;
+    CPU_TS t1;
+    CPU_TS t_min = (CPU_TS)-1;
+
+    (void)memcpy(scanCopyTcb, scanTcb, sizeof(scanTcb));
+    scanScanNs = scanOnly(words);
+    for(pass = 0; pass < SCAN_PASSES; pass++){
+        (void)memcpy(scanTcb, scanCopyTcb, sizeof(scanTcb));
+        t0 = OS_TS_GET();
+        for(i = 0; i < SCAN_TASKS; i++){
+            if(words == 0u){
+                OSTaskStkChk(&scanTcb[i], &scanTcb[i].StkFree, &scanTcb[i].StkUsed, &os_err);
+            }else{
+                OS_StatTaskStkScan(&scanTcb[i], words);
+            }
+        }
+        t1 = OS_TS_GET();
+        t_min = ((t1 - t0) < t_min) ? (t1 - t0) : t_min;
+    }
+
+    /* Entries read: a full scan reads the free ones and the first used one */
+    scanWords = 0;
+    for(i = 0; i < SCAN_TASKS; i++){
+        if(words == 0u){
+            scanWords += scanTcb[i].StkFree + 1u;
+        }else{
+            scanWords += scanLeft(&scanCopyTcb[i]) - scanTcb[i].StkScanIx;
+        }
+    }
+    return t_min;
+}
+
+/*****************************************************************************************
+* scanOnly() - The reads of one stat task run from the TCBs in scanCopyTcb[], without the
+*   critical sections around them, in ns per run: the fastest of SCAN_PASSES passes of
+*   SCAN_REPS repeats. The TCBs are not changed.
+*****************************************************************************************/
+static CPU_TS scanOnly(CPU_STK_SIZE words){
+    CPU_STK_SIZE free_stk[SCAN_TASKS];
+    CPU_STK_SIZE ix0[SCAN_TASKS];
+    CPU_STK_SIZE ix;
+    CPU_INT32U pass;
+    CPU_INT32U rep;
+    CPU_INT32U i;
+    CPU_TS t0;
+    CPU_TS t1;
+    CPU_TS t_min = (CPU_TS)-1;
+    volatile CPU_STK_SIZE sink;
+
+    for(i = 0; i < SCAN_TASKS; i++){
+        /* What OS_StatTaskStkScan() reads in its critical section */
+        if((scanCopyTcb[i].StkFree == 0u) && (scanCopyTcb[i].StkUsed == 0u)){
+            free_stk[i] = scanCopyTcb[i].StkSize;
+        }else{
+            free_stk[i] = scanCopyTcb[i].StkFree;
+        }
+        ix0[i] = scanCopyTcb[i].StkScanIx;
+    }
+    for(pass = 0; pass < SCAN_PASSES; pass++){
+        t0 = OS_TS_GET();
+        for(rep = 0; rep < SCAN_REPS; rep++){
+            for(i = 0; i < SCAN_TASKS; i++){
+                if(words == 0u){
+                    sink = scanZeros(&scanCopyTcb[i]);
+                }else{
+                    ix = ix0[i];
+                    sink = OS_StatStkScan(scanCopyTcb[i].StkBasePtr, scanCopyTcb[i].StkSize,
+                                          free_stk[i], &ix, words);
+                }
+            }
+            __asm__ volatile("" ::: "memory");  /* Read the stacks again every repeat */
+        }
+        t1 = OS_TS_GET();
+        t_min = ((t1 - t0) < t_min) ? (t1 - t0) : t_min;
+    }
+    (void)sink;
+    return t_min / SCAN_REPS;
+}
+
+/*****************************************************************************************
+* scanZeros() - The zero count loop of OSTaskStkChk(), stacks growing down, no redzone.
+*****************************************************************************************/
+static CPU_STK_SIZE scanZeros(const OS_TCB *p_tcb){
+    const CPU_STK *p_stk = p_tcb->StkBasePtr;
+    CPU_STK_SIZE free_stk = 0;
+
+    while((*p_stk == 0u) && (free_stk < p_tcb->StkSize)){
+        p_stk++;
+        free_stk++;
+    }
+    return free_stk;
+}
+
+/*****************************************************************************************
+* scanTouch() - What the tasks do to their stacks between two stat task runs. One in 32
+*   runs a task goes up to 12 entries deeper, to its peak at most, pushing words that are
+*   non-zero but for one in eight. Every run it rewrites up to 8 of the entries above its
+*   deepest non-zero one, zeros included.
+*****************************************************************************************/
+static void scanTouch(void){
+    CPU_INT32U i;
+    CPU_STK_SIZE depth;
+    CPU_STK_SIZE e;
+    CPU_STK_SIZE lowest;
+    CPU_INT32U n;
+    CPU_STK *p_stk;
+
+    for(i = 0; i < SCAN_TASKS; i++){
+        p_stk = &scanStk[i][0];
+        if((scanRand(32u) == 0u) && (scanDepth[i] < scanStkPeak[i])){
+            depth = scanDepth[i] + 1u + scanRand(12u);
+            depth = (depth > scanStkPeak[i]) ? scanStkPeak[i] : depth;
+            for(e = scanStkSize[i] - depth; e < (scanStkSize[i] - scanDepth[i]); e++){
+                p_stk[e] = (scanRand(8u) == 0u) ? 0u : (CPU_STK)(scanRand(0xFFFFu) + 1u);
+            }
+            scanDepth[i] = depth;
+        }else{
+        }
+        for(lowest = 0; (lowest < scanStkSize[i]) && (p_stk[lowest] == 0u); lowest++){
+        }
+        for(n = scanRand(9u); n > 0u; n--){
+            e = lowest + 1u + scanRand(scanStkSize[i] - lowest - 1u);
+            p_stk[e] = (scanRand(4u) == 0u) ? 0u : (CPU_STK)(scanRand(0xFFFFu) + 1u);
+        }
+    }
+}
+
+/*****************************************************************************************
+* scanFull() - Free entries on a stack by a full OSTaskStkChk().
+*****************************************************************************************/
+static CPU_STK_SIZE scanFull(OS_TCB *p_tcb){
+    CPU_STK_SIZE free_stk;
+    CPU_STK_SIZE used_stk;
+    OS_ERR os_err;
+
+    OSTaskStkChk(p_tcb, &free_stk, &used_stk, &os_err);
+    return free_stk;
+}
+
+/*****************************************************************************************
+* scanLeft() - Entries the pass of OS_StatTaskStkScan() has left to check: those below
+*   the mark when a new pass starts, the whole stack if it was never checked.
+*****************************************************************************************/
+static CPU_STK_SIZE scanLeft(OS_TCB *p_tcb){
+    if(p_tcb->StkScanIx != 0u){
+        return p_tcb->StkScanIx;
+    }else if((p_tcb->StkFree == 0u) && (p_tcb->StkUsed == 0u)){
+        return p_tcb->StkSize;
+    }else{
+        return p_tcb->StkFree;
+    }
+}
+
+/*****************************************************************************************
+* scanRand() - 0 to span - 1. LCG, so runs repeat exactly.
+*****************************************************************************************/
+static CPU_INT32U scanRand(CPU_INT32U span){
+    scanSeed = (scanSeed * 1103515245u) + 12345u;
+    return (scanSeed >> 8) % span;
+}
@@ -0,0 +1,211 @@
+/*****************************************************************************************
+* tick_bench.c - Critical section lengths of the Cs/OS3 tick list (os_tick.c) on the host,
+*   for the sorted delta list (OS_CFG_TICK_WHEEL_EN 0) or the tick wheel (1).
+*
+* For 4 to 256 delayed tasks, replays the same seeded workload: every tick runs
+* OS_TickUpdate() and every task it readies is delayed again, as a task looping on
+* OSTimeDly() would be. Reported, in ns:
+*   insert  - OS_TickListInsertDly(), the variable part of OSTimeDly()/OS_Pend() with
+*             interrupts masked
+*   longest - the same for a delay longer than every other, the sorted list's worst case
+*   tick    - OS_TickListUpdate() as timed by the kernel (OSTickTime)
+* Each workload runs BENCH_PASSES times and every event keeps its fastest pass, which
+* takes out host preemption, then the maximum over the run is reported.
+*
+* Kernel only, no OSStart(): the TCBs are dummies that never run. Periodic tick, so no
+* tick timer is needed.
+*
+* From SymbolEntry/, once per structure (W=0 list, W=1 wheel):
+*   gcc -O2 -DCS_HOST_POSIX -DOS_CFG_DYN_TICK_EN=0u -DOS_CFG_TICK_WHEEL_EN=${W}u \
+*       -Ihost -Isource -Iboard -ICsOS/Cs-CFG -ICsOS/Cs-CPU/Posix -ICsOS/Cs-CPU -ICsOS/Cs-LIB -ICsOS/Cs-OS3 \
+*       host/tick_bench.c CsOS/Cs-OS3/os_*.c CsOS/Cs-LIB/lib_*.c CsOS/Cs-CPU/cpu_core.c \
+*       CsOS/Cs-CFG/os_app_hooks.c CsOS/Cs-CPU/Posix/cpu_c.c CsOS/Cs-CPU/Posix/os_cpu_c.c \
+*       -o tick_bench$W -lpthread -lrt
+*   ./tick_bench$W
+*****************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "os.h"
+#include "cpu.h"
+
+#define BENCH_TASKS_MAX 256u
+#define BENCH_TICKS     20000u      /* Ticks per workload */
+#define BENCH_DLY_MAX   500u        /* Delays are 1 to BENCH_DLY_MAX ticks, as the app's */
+#define BENCH_PASSES    5u
+#define BENCH_PRIO      10u
+#define BENCH_EV_MAX    (BENCH_TICKS * 2u)
+
+static OS_TCB benchTcb[BENCH_TASKS_MAX];
+static CPU_TS benchTick[BENCH_TICKS];            /* Fastest pass per tick */
+static CPU_TS benchIns[BENCH_EV_MAX];            /* Fastest pass per insert */
+static CPU_INT32U benchSeed;
+
+static void benchRun(CPU_INT32U ntasks, CPU_INT32U *nins);
+static CPU_TS benchInsert(OS_TCB *p_tcb, OS_TICK dly);
+static CPU_TS benchLongest(CPU_INT32U ntasks);
+static OS_TICK benchRand(void);
+
+int main(void){
+    static const CPU_INT32U ntasks[] = {4u, 8u, 16u, 32u, 64u, 128u, 256u};
+    OS_ERR os_err;
+    CPU_INT32U n;
+    CPU_INT32U pass;
+    CPU_INT32U nins = 0;
+    CPU_INT32U i;
+    CPU_TS ins_max;
+    CPU_TS tick_max;
+    CPU_TS longest;
+
+    CPU_Init();
+    OSInit(&os_err);
+    if(os_err != OS_ERR_NONE){
+        (void)fprintf(stderr, "tick_bench: OSInit() error %u\n", (unsigned)os_err);
+        return 1;
+    }else{
+    }
+#if (OS_CFG_TICK_WHEEL_EN > 0u)
+    (void)printf("tick wheel, %u spokes\n", (unsigned)OS_CFG_TICK_WHEEL_SIZE);
+#else
+    (void)printf("sorted delta list\n");
+#endif
+    (void)printf("tasks  insert max  longest  tick max   (ns, %u ticks, delays 1-%u)\n",
+                 (unsigned)BENCH_TICKS, (unsigned)BENCH_DLY_MAX);
+
+    for(n = 0; n < (sizeof(ntasks) / sizeof(ntasks[0])); n++){
+        for(i = 0; i < BENCH_TICKS; i++){
+            benchTick[i] = (CPU_TS)-1;
+        }
+        for(i = 0; i < BENCH_EV_MAX; i++){
+            benchIns[i] = (CPU_TS)-1;
+        }
+        for(pass = 0; pass < BENCH_PASSES; pass++){
+            benchRun(ntasks[n], &nins);
+        }
+        longest = benchLongest(ntasks[n]);
+
+        ins_max = 0;
+        for(i = 0; i < nins; i++){
+            ins_max = (benchIns[i] > ins_max) ? benchIns[i] : ins_max;
+        }
+        tick_max = 0;
+        for(i = 0; i < BENCH_TICKS; i++){
+            tick_max = (benchTick[i] > tick_max) ? benchTick[i] : tick_max;
+        }
+        (void)printf("%5u  %10u  %7u  %8u\n", (unsigned)ntasks[n], (unsigned)ins_max,
+                     (unsigned)longest, (unsigned)tick_max);
+    }
+    return 0;
+}
+
+/*****************************************************************************************
+* benchRun() - One pass of the workload for ntasks delayed tasks. The seed restarts every
+*   pass, so event i is the same operation on the same tick list in every pass.
+*****************************************************************************************/
+static void benchRun(CPU_INT32U ntasks, CPU_INT32U *nins){
+    OS_TCB *p_tcb;
+    CPU_TS t;
+    CPU_INT32U ev = 0;
+    CPU_INT32U tick;
+    CPU_INT32U i;
+
+    benchSeed = 12345u;
+    (void)memset(benchTcb, 0, sizeof(benchTcb));
+    for(i = 0; i < ntasks; i++){
+        benchTcb[i].Prio = BENCH_PRIO;
+        benchTcb[i].TaskState = OS_TASK_STATE_DLY;     /* Not in the ready list yet */
+        (void)benchInsert(&benchTcb[i], benchRand());
+    }
+    for(tick = 0; tick < BENCH_TICKS; tick++){
+        OS_TickUpdate(1u);
+        t = OSTickTime;
+        if(t < benchTick[tick]){
+            benchTick[tick] = t;
+        }else{
+        }
+        for(i = 0; i < ntasks; i++){
+            p_tcb = &benchTcb[i];
+            if(p_tcb->TaskState == OS_TASK_STATE_RDY){
+                t = benchInsert(p_tcb, benchRand());
+                if((ev < BENCH_EV_MAX) && (t < benchIns[ev])){
+                    benchIns[ev] = t;
+                }else{
+                }
+                ev++;
+            }else{
+            }
+        }
+    }
+    /* Leave nothing in the tick list for the next run */
+    for(i = 0; i < ntasks; i++){
+        CPU_SR_ALLOC();
+        CPU_CRITICAL_ENTER();
+        OS_TickListRemove(&benchTcb[i]);
+        CPU_CRITICAL_EXIT();
+    }
+    *nins = (ev < BENCH_EV_MAX) ? ev : BENCH_EV_MAX;
+}
+
+/*****************************************************************************************
+* benchInsert() - What OSTimeDly() does with interrupts masked, timing the tick list part.
+*****************************************************************************************/
+static CPU_TS benchInsert(OS_TCB *p_tcb, OS_TICK dly){
+    OS_ERR os_err;
+    CPU_TS t0;
+    CPU_TS t1;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    if(p_tcb->TaskState == OS_TASK_STATE_RDY){
+        OS_RdyListRemove(p_tcb);
+    }else{
+    }
+    t0 = OS_TS_GET();
+    OS_TickListInsertDly(p_tcb, dly, OS_OPT_TIME_DLY, &os_err);
+    t1 = OS_TS_GET();
+    CPU_CRITICAL_EXIT();
+    return t1 - t0;
+}
+
+/*****************************************************************************************
+* benchLongest() - ntasks delayed, then a delay past all of them, fastest of the passes.
+*****************************************************************************************/
+static CPU_TS benchLongest(CPU_INT32U ntasks){
+    CPU_TS best = (CPU_TS)-1;
+    CPU_TS t;
+    CPU_INT32U pass;
+    CPU_INT32U i;
+    CPU_SR_ALLOC();
+
+    benchSeed = 12345u;
+    (void)memset(benchTcb, 0, sizeof(benchTcb));
+    for(i = 0; i < ntasks; i++){
+        benchTcb[i].Prio = BENCH_PRIO;
+        benchTcb[i].TaskState = OS_TASK_STATE_DLY;     /* Not in the ready list yet */
+        if(i < (ntasks - 1u)){
+            (void)benchInsert(&benchTcb[i], benchRand());
+        }else{
+        }
+    }
+    for(pass = 0; pass < BENCH_PASSES; pass++){
+        t = benchInsert(&benchTcb[ntasks - 1u], BENCH_DLY_MAX + 1u);
+        best = (t < best) ? t : best;
+        CPU_CRITICAL_ENTER();
+        OS_TickListRemove(&benchTcb[ntasks - 1u]);
+        CPU_CRITICAL_EXIT();
+    }
+    for(i = 0; i < (ntasks - 1u); i++){
+        CPU_CRITICAL_ENTER();
+        OS_TickListRemove(&benchTcb[i]);
+        CPU_CRITICAL_EXIT();
+    }
+    return best;
+}
+
+/*****************************************************************************************
+* benchRand() - Delay, 1 to BENCH_DLY_MAX ticks. LCG, so runs repeat exactly.
+*****************************************************************************************/
+static OS_TICK benchRand(void){
+    benchSeed = (benchSeed * 1103515245u) + 12345u;
+    return (OS_TICK)(((benchSeed >> 16) % BENCH_DLY_MAX) + 1u);
+}
@@ -0,0 +1,389 @@
+/* KBench.c */
+#include "KBench.h"
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "os.h"
+#include "BasicIO.h"
+
+#if APP_CFG_KBENCH_EN
+
+#define KBENCH_HELPERS  4u                  /* Helper tasks, APP_CFG_KBENCH_PRIO and up */
+#define KBENCH_FLAG_EV  ((OS_FLAGS)0x01u)
+#define KBENCH_IRQn     CTIMER4_IRQn        /* Not used by the application */
+
+typedef enum {
+    KBENCH_TS_READ,
+    KBENCH_SEM,
+    KBENCH_TASK_SEM,
+    KBENCH_Q,
+    KBENCH_DATA,
+    KBENCH_MUTEX,
+    KBENCH_FLAG,
+    KBENCH_ISR,
+    KBENCH_COUNT
+} KBENCH_ID;
+
+/* One benchmark, in timestamp counts */
+typedef struct {
+    INT32U n;
+    CPU_TS32 min;
+    CPU_TS32 max;
+    INT64U sum;
+} KBENCH_STATS;
+
+static const INT8C *const kbench_names[KBENCH_COUNT] = {
+    "ts_read",
+    "sem",
+    "task_sem",
+    "q_rtrip",
+    "data",
+    "mutex_pi",
+    "flag_4w",
+    "isr_wake"
+};
+
+static KBENCH_STATS kbench_stats[KBENCH_COUNT];
+static KBENCH_ID kbench_cur;                /* Benchmark KBenchRec() records to */
+static volatile CPU_TS32 kbench_t0;         /* Start of a span another context ends */
+static volatile INT32U kbench_flag_wakes;
+
+static OS_TCB kbench_tcb[KBENCH_HELPERS];
+static CPU_STK kbench_stk[KBENCH_HELPERS][APP_CFG_KBENCH_STK_SIZE];
+
+static OS_SEM kbench_sem;
+static OS_Q kbench_q_req;
+static OS_Q kbench_q_ack;
+static OS_DATA kbench_data;
+static CPU_TS32 kbench_data_buf[1];
+static OS_MUTEX kbench_mutex;
+static OS_FLAG_GRP kbench_flags;
+
+static void KBenchSpawn(INT8U i, OS_TASK_PTR task);
+static void KBenchKill(INT8U n);
+static void KBenchRec(CPU_TS32 ts_cnts);
+static void KBenchSend(void);
+static void KBenchSemTask(void *p_arg);
+static void KBenchTaskSemTask(void *p_arg);
+static void KBenchQTask(void *p_arg);
+static void KBenchDataTask(void *p_arg);
+static void KBenchMutexTask(void *p_arg);
+static void KBenchFlagTask(void *p_arg);
+
+/*****************************************************************************************
+* KBenchRun()
+*   One benchmark at a time: its helpers are created, block in their pend at once (they
+*   are above the caller), and are deleted when it is done. Nothing is sent until the
+*   last one is, so the UART interrupts stay out of the spans.
+*****************************************************************************************/
+void KBenchRun(void) {
+    OS_ERR os_err;
+    INT32U i;
+    INT8U h;
+    CPU_TS32 t0;
+    CPU_TS32 t1;
+    OS_MSG_SIZE size;
+    CPU_TS32 *msg;
+
+    OSSemCreate(&kbench_sem, "KBench Sem", 0, &os_err);
+    assert(os_err == OS_ERR_NONE);
+    OSQCreate(&kbench_q_req, "KBench Q Req", 1, &os_err);
+    assert(os_err == OS_ERR_NONE);
+    OSQCreate(&kbench_q_ack, "KBench Q Ack", 1, &os_err);
+    assert(os_err == OS_ERR_NONE);
+    OSDataCreate(&kbench_data, "KBench Data", kbench_data_buf, 1, sizeof(CPU_TS32), &os_err);
+    assert(os_err == OS_ERR_NONE);
+    OSMutexCreate(&kbench_mutex, "KBench Mutex", &os_err);
+    assert(os_err == OS_ERR_NONE);
+    OSFlagCreate(&kbench_flags, "KBench Flags", 0, &os_err);
+    assert(os_err == OS_ERR_NONE);
+
+    kbench_cur = KBENCH_TS_READ;
+    for (i = 0; i < APP_CFG_KBENCH_ITER; i++) {
+        t0 = (CPU_TS32)CPU_TS_TmrRd();
+        t1 = (CPU_TS32)CPU_TS_TmrRd();
+        KBenchRec(t1 - t0);
+    }
+
+    kbench_cur = KBENCH_SEM;
+    KBenchSpawn(0, KBenchSemTask);
+    for (i = 0; i < APP_CFG_KBENCH_ITER; i++) {
+        kbench_t0 = (CPU_TS32)CPU_TS_TmrRd();
+        (void)OSSemPost(&kbench_sem, OS_OPT_POST_1, &os_err);
+        assert(os_err == OS_ERR_NONE);
+    }
+    KBenchKill(1);
+
+    kbench_cur = KBENCH_TASK_SEM;
+    KBenchSpawn(0, KBenchTaskSemTask);
+    for (i = 0; i < APP_CFG_KBENCH_ITER; i++) {
+        kbench_t0 = (CPU_TS32)CPU_TS_TmrRd();
+        (void)OSTaskSemPost(&kbench_tcb[0], OS_OPT_POST_NONE, &os_err);
+        assert(os_err == OS_ERR_NONE);
+    }
+    KBenchKill(1);
+
+    /* The helper's reply is queued before the caller pends for it */
+    kbench_cur = KBENCH_Q;
+    KBenchSpawn(0, KBenchQTask);
+    for (i = 0; i < APP_CFG_KBENCH_ITER; i++) {
+        t0 = (CPU_TS32)CPU_TS_TmrRd();
+        OSQPost(&kbench_q_req, &t0, sizeof(t0), OS_OPT_POST_FIFO, &os_err);
+        assert(os_err == OS_ERR_NONE);
+        msg = (CPU_TS32 *)OSQPend(&kbench_q_ack, 0, OS_OPT_PEND_BLOCKING, &size, (CPU_TS *)0, &os_err);
+        t1 = (CPU_TS32)CPU_TS_TmrRd();
+        assert((os_err == OS_ERR_NONE) && (msg == &t0));
+        KBenchRec(t1 - t0);
+    }
+    KBenchKill(1);
+
+    kbench_cur = KBENCH_DATA;
+    KBenchSpawn(0, KBenchDataTask);
+    for (i = 0; i < APP_CFG_KBENCH_ITER; i++) {
+        t0 = (CPU_TS32)CPU_TS_TmrRd();
+        OSDataPost(&kbench_data, &t0, sizeof(t0), OS_OPT_POST_FIFO, &os_err);
+        assert(os_err == OS_ERR_NONE);
+    }
+    KBenchKill(1);
+
+    /* The helper only runs between the caller's pend and post, so the mutex is free */
+    /* at the top of the loop and the helper always finds it owned */
+    kbench_cur = KBENCH_MUTEX;
+    KBenchSpawn(0, KBenchMutexTask);
+    for (i = 0; i < APP_CFG_KBENCH_ITER; i++) {
+        OSMutexPend(&kbench_mutex, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+        assert(os_err == OS_ERR_NONE);
+        (void)OSTaskSemPost(&kbench_tcb[0], OS_OPT_POST_NONE, &os_err);
+        assert(os_err == OS_ERR_NONE);
+        assert(OSTCBCurPtr->Prio == APP_CFG_KBENCH_PRIO);      /* Inherited */
+        OSMutexPost(&kbench_mutex, OS_OPT_POST_NONE, &os_err);
+        assert(os_err == OS_ERR_NONE);
+    }
+    KBenchKill(1);
+
+    /* The post readies every waiter without switching and the flag is cleared before */
+    /* they run and pend again. The scheduler is locked so that an interrupt can't let */
+    /* them run first, find the flag still set and spin */
+    kbench_cur = KBENCH_FLAG;
+    kbench_flag_wakes = 0;
+    for (h = 0; h < KBENCH_HELPERS; h++) {
+        KBenchSpawn(h, KBenchFlagTask);
+    }
+    for (i = 0; i < APP_CFG_KBENCH_ITER; i++) {
+        OSSchedLock(&os_err);
+        assert(os_err == OS_ERR_NONE);
+        t0 = (CPU_TS32)CPU_TS_TmrRd();
+        (void)OSFlagPost(&kbench_flags, KBENCH_FLAG_EV, OS_OPT_POST_FLAG_SET | OS_OPT_POST_NO_SCHED, &os_err);
+        t1 = (CPU_TS32)CPU_TS_TmrRd();
+        assert(os_err == OS_ERR_NONE);
+        KBenchRec(t1 - t0);
+        (void)OSFlagPost(&kbench_flags, KBENCH_FLAG_EV, OS_OPT_POST_FLAG_CLR | OS_OPT_POST_NO_SCHED, &os_err);
+        assert(os_err == OS_ERR_NONE);
+        OSSchedUnlock(&os_err);
+        assert(os_err == OS_ERR_NONE);
+    }
+    assert(kbench_flag_wakes == (APP_CFG_KBENCH_ITER * KBENCH_HELPERS));
+    KBenchKill(KBENCH_HELPERS);
+
+    /* Waits for each one, the host's interrupts are not taken at once */
+    kbench_cur = KBENCH_ISR;
+    KBenchSpawn(0, KBenchTaskSemTask);
+    NVIC_ClearPendingIRQ(KBENCH_IRQn);
+    NVIC_EnableIRQ(KBENCH_IRQn);
+    for (i = 0; i < APP_CFG_KBENCH_ITER; i++) {
+        NVIC_SetPendingIRQ(KBENCH_IRQn);
+        while (*(volatile INT32U *)&kbench_stats[KBENCH_ISR].n == i) {
+        }
+    }
+    NVIC_DisableIRQ(KBENCH_IRQn);
+    KBenchKill(1);
+
+    KBenchSend();
+    BIOTxFlush();
+#ifdef CS_HOST_POSIX
+    HostBenchDone();
+#endif
+}
+
+/*****************************************************************************************
+* CTIMER4_IRQHandler() - isr_wake. Starts the span and wakes the helper.
+*****************************************************************************************/
+void CTIMER4_IRQHandler(void) {
+    OS_ERR os_err;
+    CPU_SR_ALLOC();
+
+    kbench_t0 = (CPU_TS32)CPU_TS_TmrRd();
+    CPU_CRITICAL_ENTER();
+    OSIntEnter();
+    CPU_CRITICAL_EXIT();
+
+    (void)OSTaskSemPost(&kbench_tcb[0], OS_OPT_POST_NONE, &os_err);
+
+    OSIntExit();
+}
+
+/*****************************************************************************************
+* KBenchSpawn()
+*   Helper i at APP_CFG_KBENCH_PRIO + i. It runs until its first pend before this returns.
+*****************************************************************************************/
+static void KBenchSpawn(INT8U i, OS_TASK_PTR task) {
+    OS_ERR os_err;
+
+    OSTaskCreate(&kbench_tcb[i],
+                 "KBench Helper",
+                 task,
+                 (void *)0,
+                 APP_CFG_KBENCH_PRIO + i,
+                 &kbench_stk[i][0],
+                 (APP_CFG_KBENCH_STK_SIZE / 10u),
+                 APP_CFG_KBENCH_STK_SIZE,
+                 0,
+                 0,
+                 (void *)0,
+                 (OS_OPT_TASK_NONE),
+                 &os_err);
+    assert(os_err == OS_ERR_NONE);
+}
+
+/*****************************************************************************************
+* KBenchKill()
+*   Deletes helpers 0 to n - 1, pending where the benchmark left them.
+*****************************************************************************************/
+static void KBenchKill(INT8U n) {
+    OS_ERR os_err;
+    INT8U i;
+
+    for (i = 0; i < n; i++) {
+        OSTaskDel(&kbench_tcb[i], &os_err);
+        assert(os_err == OS_ERR_NONE);
+    }
+}
+
+/*****************************************************************************************
+* KBenchRec()
+*   Adds a span to the current benchmark. Only one context records at a time.
+*****************************************************************************************/
+static void KBenchRec(CPU_TS32 ts_cnts) {
+    KBENCH_STATS *st = &kbench_stats[kbench_cur];
+
+    if ((st->n == 0) || (ts_cnts < st->min)) {
+        st->min = ts_cnts;
+    }
+    if (ts_cnts > st->max) {
+        st->max = ts_cnts;
+    }
+    st->sum += ts_cnts;
+    st->n++;
+}
+
+/*****************************************************************************************
+* KBenchSend()
+*   The results, in the format given in KBench.h.
+*****************************************************************************************/
+static void KBenchSend(void) {
+    CPU_ERR cpu_err;
+    const KBENCH_STATS *st;
+    KBENCH_ID b;
+
+    BIOPutStrg("KBENCH_TS_HZ: ");
+    BIOOutDecWord((INT32U)CPU_TS_TmrFreqGet(&cpu_err), 10, BIO_OD_MODE_AL);
+    BIOPutStrg("\r\n");
+    for (b = (KBENCH_ID)0; b < KBENCH_COUNT; b++) {
+        st = &kbench_stats[b];
+        BIOPutStrg("KBENCH: ");
+        BIOPutStrg(kbench_names[b]);
+        BIOWrite(' ');
+        BIOOutDecWord(st->n, 10, BIO_OD_MODE_AL);
+        BIOOutDecWord(st->min, 10, BIO_OD_MODE_AL);
+        BIOOutDecWord((st->n != 0) ? (INT32U)(st->sum / st->n) : 0, 10, BIO_OD_MODE_AL);
+        BIOOutDecWord(st->max, 10, BIO_OD_MODE_AL);
+        BIOPutStrg("\r\n");
+    }
+#ifdef CPU_CFG_INT_DIS_MEAS_EN
+    BIOPutStrg("KBENCH_INT_DIS_MAX: ");
+    BIOOutDecWord((INT32U)CPU_IntDisMeasMaxGet(), 10, BIO_OD_MODE_AL);
+    BIOPutStrg("\r\n");
+#endif
+    BIOPutStrg("KBENCH_END\r\n");
+}
+
+/*****************************************************************************************
+* Helper tasks. Each ends the span the caller or the ISR started, except q_rtrip's,
+* which replies, and flag_4w's, which only count their wakeups.
+*****************************************************************************************/
+static void KBenchSemTask(void *p_arg) {
+    OS_ERR os_err;
+
+    (void)p_arg;
+    while (1) {
+        (void)OSSemPend(&kbench_sem, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+        KBenchRec((CPU_TS32)CPU_TS_TmrRd() - kbench_t0);
+        assert(os_err == OS_ERR_NONE);
+    }
+}
+
+static void KBenchTaskSemTask(void *p_arg) {
+    OS_ERR os_err;
+
+    (void)p_arg;
+    while (1) {
+        (void)OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+        KBenchRec((CPU_TS32)CPU_TS_TmrRd() - kbench_t0);
+        assert(os_err == OS_ERR_NONE);
+    }
+}
+
+static void KBenchQTask(void *p_arg) {
+    OS_ERR os_err;
+    OS_MSG_SIZE size;
+    void *msg;
+
+    (void)p_arg;
+    while (1) {
+        msg = OSQPend(&kbench_q_req, 0, OS_OPT_PEND_BLOCKING, &size, (CPU_TS *)0, &os_err);
+        assert(os_err == OS_ERR_NONE);
+        OSQPost(&kbench_q_ack, msg, size, OS_OPT_POST_FIFO, &os_err);
+        assert(os_err == OS_ERR_NONE);
+    }
+}
+
+static void KBenchDataTask(void *p_arg) {
+    OS_ERR os_err;
+    CPU_TS32 t0;
+
+    (void)p_arg;
+    while (1) {
+        OSDataPend(&kbench_data, 0, OS_OPT_PEND_BLOCKING, &t0, sizeof(t0), &os_err);
+        KBenchRec((CPU_TS32)CPU_TS_TmrRd() - t0);
+        assert(os_err == OS_ERR_NONE);
+    }
+}
+
+static void KBenchMutexTask(void *p_arg) {
+    OS_ERR os_err;
+
+    (void)p_arg;
+    while (1) {
+        (void)OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+        assert(os_err == OS_ERR_NONE);
+        kbench_t0 = (CPU_TS32)CPU_TS_TmrRd();
+        OSMutexPend(&kbench_mutex, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+        KBenchRec((CPU_TS32)CPU_TS_TmrRd() - kbench_t0);
+        assert(os_err == OS_ERR_NONE);
+        OSMutexPost(&kbench_mutex, OS_OPT_POST_NONE, &os_err);
+        assert(os_err == OS_ERR_NONE);
+    }
+}
+
+static void KBenchFlagTask(void *p_arg) {
+    OS_ERR os_err;
+
+    (void)p_arg;
+    while (1) {
+        (void)OSFlagPend(&kbench_flags, KBENCH_FLAG_EV, 0,
+                         OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+        assert(os_err == OS_ERR_NONE);
+        kbench_flag_wakes++;
+    }
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef KBENCH_H
+#define KBENCH_H
+
+#include "MCUType.h"
+#include "app_cfg.h"
+
+/*****************************************************************************************
+* Kernel benchmarks: the cost of the Cs/OS3 services the application is built on, timed
+* with CPU_TS_TmrRd() (DWT cycles on the board, ns in the host build). Each one runs
+* APP_CFG_KBENCH_ITER times against helper tasks at APP_CFG_KBENCH_PRIO and up, all above
+* the caller:
+*   ts_read   - two CPU_TS_TmrRd() back to back, the overhead in every other span
+*   sem       - OSSemPost() to a helper pending in OSSemPend() running
+*   task_sem  - OSTaskSemPost() to a helper pending in OSTaskSemPend() running
+*   q_rtrip   - OSQPost() to a helper in OSQPend() and its OSQPost() back, until the
+*               caller's OSQPend() has the reply
+*   data      - OSDataPost() of a CPU_TS32 to a helper in OSDataPend() running
+*   mutex_pi  - a helper's OSMutexPend() on a mutex the caller holds, through the caller
+*               inheriting its priority and OSMutexPost(), until the helper owns it
+*   flag_4w   - OSFlagPost() readying 4 helpers in OSFlagPend(), without the switches
+*   isr_wake  - interrupt entry, OSTaskSemPost() from the ISR and OSIntExit(), until
+*               the helper runs. The interrupt is CTIMER4's, unused and raised by software
+*
+* Results go out on LPUART4 as text, one line per benchmark, in timestamp counts:
+*   "KBENCH: <name> <iterations> <min> <avg> <max>\r\n"
+* after "KBENCH_TS_HZ: <counts per second>\r\n" and before "KBENCH_END\r\n". With
+* CPU_CFG_INT_DIS_MEAS_EN defined, "KBENCH_INT_DIS_MAX: <counts>\r\n" comes just before
+* the end: CPU_IntDisMeasMaxGet(), the longest interrupts have been disabled since reset.
+*
+* With APP_CFG_KBENCH_EN at 0 this module is empty.
+*****************************************************************************************/
+
+#if APP_CFG_KBENCH_EN
+
+/* run every benchmark and send the results; call from a task below APP_CFG_KBENCH_PRIO */
+/* + 3 with the kernel started. The host build exits once they have gone out */
+void KBenchRun(void);
+
+#endif
+
+#endif
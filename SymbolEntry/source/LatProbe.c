@@ -0,0 +1,155 @@
+/* LatProbe.c */
+#include "LatProbe.h"
+#include "MCUType.h"
+#include "app_cfg.h"
+
+#if APP_CFG_LAT_PROBE_EN
+
+#define LAT_HIST_SUB_BITS   3u                          /* Buckets per power of 2: 8 */
+#define LAT_HIST_SUB        (1u << LAT_HIST_SUB_BITS)
+#define LAT_HIST_LINEAR     (2u * LAT_HIST_SUB)         /* Below this, one bucket per us */
+#define LAT_HIST_OCT_FIRST  (LAT_HIST_SUB_BITS + 1u)    /* log2(LAT_HIST_LINEAR) */
+#define LAT_HIST_OCT_END    24u                         /* 2^24 us and up go in the last bucket */
+#define LAT_HIST_BUCKETS    (LAT_HIST_LINEAR + ((LAT_HIST_OCT_END - LAT_HIST_OCT_FIRST) * LAT_HIST_SUB))
+
+/* One probe */
+typedef struct {
+    INT32U hist[LAT_HIST_BUCKETS];
+    INT32U count;
+    INT32U max;
+    CPU_TS32 t0;                    /* LatProbeStart() */
+} LAT_HIST;
+
+static LAT_HIST lat_probes[LAT_PROBE_COUNT];
+
+/* Kept to 8 characters, SYMPROTO_LAT carries them after 16 bytes of stats */
+static const INT8C *const lat_names[LAT_PROBE_COUNT] = {
+    "sw_task",
+    "sw_idx",
+    "sw_sent",
+    "step",
+    "send"
+};
+
+static INT16U LatBucket(INT32U us);
+static INT32U LatBucketTop(INT16U b);
+static INT32U LatPercentile(const LAT_HIST *h, INT32U pct);
+
+/*****************************************************************************************
+* LatProbeStart()
+*****************************************************************************************/
+void LatProbeStart(LAT_PROBE p) {
+    lat_probes[p].t0 = (CPU_TS32)CPU_TS_TmrRd();
+}
+
+/*****************************************************************************************
+* LatProbeEnd()
+*****************************************************************************************/
+void LatProbeEnd(LAT_PROBE p) {
+    LatProbeRec(p, (CPU_TS32)((CPU_TS32)CPU_TS_TmrRd() - lat_probes[p].t0));
+}
+
+/*****************************************************************************************
+* LatProbeRec()
+*   Converts to us outside the critical section, which only covers the three updates.
+*****************************************************************************************/
+void LatProbeRec(LAT_PROBE p, CPU_TS32 ts_cnts) {
+    LAT_HIST *h = &lat_probes[p];
+    INT32U us = CPU_TS32_to_uSec(ts_cnts);
+    INT16U b = LatBucket(us);
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    h->hist[b]++;
+    h->count++;
+    if (us > h->max) {
+        h->max = us;
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*****************************************************************************************
+* LatProbeStats()
+*   Walks the histogram twice with interrupts masked, so a record from an ISR can't land
+*   between the count and the walk.
+*****************************************************************************************/
+void LatProbeStats(LAT_PROBE p, LAT_STATS *stats) {
+    const LAT_HIST *h = &lat_probes[p];
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    stats->count = h->count;
+    stats->max = h->max;
+    stats->p50 = LatPercentile(h, 50u);
+    stats->p99 = LatPercentile(h, 99u);
+    CPU_CRITICAL_EXIT();
+}
+
+/*****************************************************************************************
+* LatProbeName()
+*****************************************************************************************/
+const INT8C *LatProbeName(LAT_PROBE p) {
+    return lat_names[p];
+}
+
+/*****************************************************************************************
+* LatBucket()
+*   us below LAT_HIST_LINEAR are their own bucket. Above, the top bit picks the power of
+*   2 and the LAT_HIST_SUB_BITS below it the step within it.
+*****************************************************************************************/
+static INT16U LatBucket(INT32U us) {
+    INT8U oct;
+
+    if (us < LAT_HIST_LINEAR) {
+        return (INT16U)us;
+    }
+    oct = (INT8U)(31u - CPU_CntLeadZeros((CPU_DATA)us));
+    if (oct >= LAT_HIST_OCT_END) {
+        return (INT16U)(LAT_HIST_BUCKETS - 1u);
+    }
+    return (INT16U)(LAT_HIST_LINEAR + ((oct - LAT_HIST_OCT_FIRST) * LAT_HIST_SUB) +
+                    ((us >> (oct - LAT_HIST_SUB_BITS)) & (LAT_HIST_SUB - 1u)));
+}
+
+/*****************************************************************************************
+* LatBucketTop()
+*   Largest us value that falls in a bucket
+*****************************************************************************************/
+static INT32U LatBucketTop(INT16U b) {
+    INT8U oct;
+    INT32U step;
+
+    if (b < LAT_HIST_LINEAR) {
+        return b;
+    }
+    oct = (INT8U)(LAT_HIST_OCT_FIRST + ((b - LAT_HIST_LINEAR) / LAT_HIST_SUB));
+    step = (INT32U)1u << (oct - LAT_HIST_SUB_BITS);
+    return ((LAT_HIST_SUB + ((b - LAT_HIST_LINEAR) % LAT_HIST_SUB) + 1u) * step) - 1u;
+}
+
+/*****************************************************************************************
+* LatPercentile()
+*   Top of the bucket holding the pct'th percentile sample (nearest rank), no more than
+*   the max. 0 with no samples.
+*****************************************************************************************/
+static INT32U LatPercentile(const LAT_HIST *h, INT32U pct) {
+    INT32U rank;
+    INT32U seen = 0;
+    INT32U top;
+    INT16U b;
+
+    if (h->count == 0) {
+        return 0;
+    }
+    rank = (INT32U)((((CPU_INT64U)h->count * pct) + 99u) / 100u);
+    for (b = 0; b < LAT_HIST_BUCKETS; b++) {
+        seen += h->hist[b];
+        if (seen >= rank) {
+            break;
+        }
+    }
+    top = LatBucketTop(b);
+    return (top < h->max) ? top : h->max;
+}
+
+#endif
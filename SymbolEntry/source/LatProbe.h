@@ -0,0 +1,70 @@
+#ifndef LATPROBE_H
+#define LATPROBE_H
+
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "cpu.h"
+#include "cpu_core.h"
+
+/*****************************************************************************************
+* Latency probes: named spans timed with CPU_TS_TmrRd() (the DWT cycle counter on the
+* board, ns in the host build), converted with CPU_TS32_to_uSec() and kept as a histogram
+* per probe, so a run reads as p50/p99/max instead of one line per event.
+*
+* Buckets are log-linear in us: one per us below LAT_HIST_LINEAR, then LAT_HIST_SUB per
+* power of 2, so a percentile is at most 1/LAT_HIST_SUB (12.5%) above the true value. Spans
+* of 2^LAT_HIST_OCT_END us (16.7 s) and more share the last bucket. The max is exact.
+*
+* A span can't be longer than the timestamp timer wraps, 28 s on the board at 150MHz
+* and 4.2 s on the host.
+*
+* With APP_CFG_LAT_PROBE_EN at 0 the LAT_PROBE_x() macros compile to nothing.
+*****************************************************************************************/
+
+typedef enum {
+    LAT_SW_TASK,        /* Switch edge (SW_EVENT ts) to the menu task taking the press */
+    LAT_SW_IDX,         /* Switch edge to SYMBOL_IDX queued, SW2 press */
+    LAT_SW_SENT,        /* Switch edge to SYMBOL_SENT queued, SW3 press */
+    LAT_STEP,           /* StepSymbol() for an SW2 press */
+    LAT_SEND,           /* SetLastSentSymbol() for an SW3 press, with the quick ring update */
+    LAT_PROBE_COUNT
+} LAT_PROBE;
+
+/* Summary of one probe, in us */
+typedef struct {
+    INT32U count;
+    INT32U p50;
+    INT32U p99;
+    INT32U max;
+} LAT_STATS;
+
+#if APP_CFG_LAT_PROBE_EN
+
+/* start a span; START and END of a probe are paired in one task */
+#define LAT_PROBE_START(p)          LatProbeStart(p)
+
+/* end the span and record it */
+#define LAT_PROBE_END(p)            LatProbeEnd(p)
+
+/* record the span from a CPU_TS taken earlier, e.g. in an ISR */
+#define LAT_PROBE_SINCE(p, ts0)     LatProbeRec((p), (CPU_TS32)(CPU_TS_TmrRd() - (CPU_TS32)(ts0)))
+
+void LatProbeStart(LAT_PROBE p);
+void LatProbeEnd(LAT_PROBE p);
+
+/* record a span of ts_cnts timestamp counts, any context */
+void LatProbeRec(LAT_PROBE p, CPU_TS32 ts_cnts);
+
+/* count, p50, p99 and max since startup; count 0 if the probe never fired */
+void LatProbeStats(LAT_PROBE p, LAT_STATS *stats);
+
+/* probe name, for the dump */
+const INT8C *LatProbeName(LAT_PROBE p);
+
+#else
+#define LAT_PROBE_START(p)
+#define LAT_PROBE_END(p)
+#define LAT_PROBE_SINCE(p, ts0)
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+/* QuickAccess.c */
+#include "QuickAccess.h"
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "SymCatalog.h"
+#include "FlashStore.h"
+
+#define QA_DECAY_SHIFT  3u          /* Scores lose 1/8 per send */
+#define QA_HIT          1024u       /* Added per send; a symbol sent every time settles at 8192 */
+#define QA_SCORE_MAX    0xFFFFu
+
+/* Ring entry */
+typedef struct {
+    INT16U id;
+    INT16U score;
+} QA_ENTRY;
+
+/* What goes to flash */
+typedef struct {
+    INT32U cat_hash;                /* SYMCAT_HASH of the catalog the ids belong to */
+    INT8U count;
+    INT8U rsvd[3];
+    QA_ENTRY entries[APP_CFG_QA_SIZE];
+} QA_RING;
+
+static QA_RING qa_ring;
+static INT8U qa_dirty = FALSE;
+
+/*****************************************************************************************
+* QAInit()
+*   Loads the saved ring. Anything that doesn't fit this catalog starts empty.
+*****************************************************************************************/
+void QAInit(void) {
+    INT8U i;
+
+    if ((FlashStoreLoad(&qa_ring, (INT8U)sizeof(qa_ring)) == FALSE) ||
+        (qa_ring.cat_hash != SYMCAT_HASH) || (qa_ring.count > APP_CFG_QA_SIZE)) {
+        qa_ring.count = 0;
+    }
+    for (i = 0; i < qa_ring.count; i++) {
+        if (qa_ring.entries[i].id >= SYMCAT_SYM_COUNT) {
+            qa_ring.count = 0;
+        }
+    }
+    qa_ring.cat_hash = SYMCAT_HASH;
+    qa_dirty = FALSE;
+}
+
+/*****************************************************************************************
+* QAUpdate()
+*   Decay every score, credit the sent symbol (taking the lowest slot if it is new), then
+*   move it up past any entry it now scores at least as well as. Ties go to the most recent.
+*****************************************************************************************/
+void QAUpdate(INT16U id) {
+    QA_ENTRY *e = qa_ring.entries;
+    QA_ENTRY tmp;
+    INT8U r;
+
+    if (id >= SYMCAT_SYM_COUNT) {
+        return;
+    }
+    for (r = 0; r < qa_ring.count; r++) {
+        e[r].score = (INT16U)(e[r].score - (e[r].score >> QA_DECAY_SHIFT));
+    }
+    r = QARank(id);
+    if (r == QA_RANK_NONE) {
+        if (qa_ring.count < APP_CFG_QA_SIZE) {
+            r = qa_ring.count++;
+        } else {
+            r = APP_CFG_QA_SIZE - 1u;
+        }
+        e[r].id = id;
+        e[r].score = 0;
+    }
+    e[r].score = (e[r].score > (QA_SCORE_MAX - QA_HIT)) ? QA_SCORE_MAX : (INT16U)(e[r].score + QA_HIT);
+    while ((r > 0) && (e[r].score >= e[r - 1u].score)) {
+        tmp = e[r - 1u];
+        e[r - 1u] = e[r];
+        e[r] = tmp;
+        r--;
+    }
+    qa_dirty = TRUE;
+}
+
+/*****************************************************************************************
+* QACount()
+*****************************************************************************************/
+INT8U QACount(void) {
+    return qa_ring.count;
+}
+
+/*****************************************************************************************
+* QAGet()
+*****************************************************************************************/
+INT16U QAGet(INT8U rank) {
+    return (rank < qa_ring.count) ? qa_ring.entries[rank].id : SYMCAT_ID_NONE;
+}
+
+/*****************************************************************************************
+* QARank()
+*****************************************************************************************/
+INT8U QARank(INT16U id) {
+    INT8U r;
+
+    for (r = 0; r < qa_ring.count; r++) {
+        if (qa_ring.entries[r].id == id) {
+            return r;
+        }
+    }
+    return QA_RANK_NONE;
+}
+
+/*****************************************************************************************
+* QADirty()
+*****************************************************************************************/
+INT8U QADirty(void) {
+    return qa_dirty;
+}
+
+/*****************************************************************************************
+* QAFlush()
+*   Stays dirty if programming failed, so the next flush tries again
+*****************************************************************************************/
+void QAFlush(void) {
+    if (qa_dirty != FALSE) {
+        qa_dirty = (INT8U)(FlashStoreSave(&qa_ring, (INT8U)sizeof(qa_ring)) == FALSE);
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef QUICKACCESS_H
+#define QUICKACCESS_H
+
+#include "MCUType.h"
+
+/*****************************************************************************************
+* Quick access ring: the APP_CFG_QA_SIZE most used symbols, best first.
+*
+* Every send decays all scores by 1/2^QA_DECAY_SHIFT and adds QA_HIT to the sent symbol,
+* so the rank mixes how often and how recently a symbol was sent. A symbol that is not in
+* the ring replaces the lowest ranked one. The ring is kept in flash (FlashStore.h) with
+* the catalog hash, and dropped at load if the catalog has changed since.
+*
+* No OS calls: the menu task is the only user.
+*****************************************************************************************/
+
+#define QA_RANK_NONE    0xFFu
+
+/* load the ring saved in flash, or start empty */
+void QAInit(void);
+
+/* a symbol was sent */
+void QAUpdate(INT16U id);
+
+/* number of symbols in the ring */
+INT8U QACount(void);
+
+/* symbol at a rank, 0 is the best; SYMCAT_ID_NONE past the end */
+INT16U QAGet(INT8U rank);
+
+/* rank of a symbol, QA_RANK_NONE if not in the ring */
+INT8U QARank(INT16U id);
+
+/* TRUE if the ring changed since it was last saved */
+INT8U QADirty(void);
+
+/* save the ring to flash if it changed */
+void QAFlush(void);
+
+#endif
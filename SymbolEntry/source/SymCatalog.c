@@ -0,0 +1,286 @@
+/* SymCatalog.c - Generated by catalog/symcat_gen.py from catalog/symbols.txt. Do not edit. */
+#include "SymCatalog.h"
+
+const INT8C SymCatBlob[SYMCAT_BLOB_SIZE] =
+    "π\0"           /* 0 */
+    "α\0"           /* 1 */
+    "β\0"           /* 2 */
+    "γ\0"           /* 3 */
+    "δ\0"           /* 4 */
+    "ε\0"           /* 5 */
+    "ζ\0"           /* 6 */
+    "η\0"           /* 7 */
+    "θ\0"           /* 8 */
+    "ι\0"           /* 9 */
+    "κ\0"           /* 10 */
+    "λ\0"           /* 11 */
+    "μ\0"           /* 12 */
+    "ν\0"           /* 13 */
+    "ξ\0"           /* 14 */
+    "ο\0"           /* 15 */
+    "ρ\0"           /* 16 */
+    "σ\0"           /* 17 */
+    "τ\0"           /* 18 */
+    "υ\0"           /* 19 */
+    "φ\0"           /* 20 */
+    "χ\0"           /* 21 */
+    "ψ\0"           /* 22 */
+    "ω\0"           /* 23 */
+    "Α\0"           /* 24 */
+    "Β\0"           /* 25 */
+    "Γ\0"           /* 26 */
+    "Δ\0"           /* 27 */
+    "Ε\0"           /* 28 */
+    "Ζ\0"           /* 29 */
+    "Η\0"           /* 30 */
+    "Θ\0"           /* 31 */
+    "Ι\0"           /* 32 */
+    "Κ\0"           /* 33 */
+    "Λ\0"           /* 34 */
+    "Μ\0"           /* 35 */
+    "Ν\0"           /* 36 */
+    "Ξ\0"           /* 37 */
+    "Ο\0"           /* 38 */
+    "Π\0"           /* 39 */
+    "Ρ\0"           /* 40 */
+    "Σ\0"           /* 41 */
+    "Τ\0"           /* 42 */
+    "Υ\0"           /* 43 */
+    "Φ\0"           /* 44 */
+    "Χ\0"           /* 45 */
+    "Ψ\0"           /* 46 */
+    "Ω\0"           /* 47 */
+    "ϑ\0"           /* 48 */
+    "ϕ\0"           /* 49 */
+    "ϵ\0"           /* 50 */
+    "ς\0"           /* 51 */
+    "ϖ\0"           /* 52 */
+    "ϱ\0"           /* 53 */
+    "ϰ\0"           /* 54 */
+    "∑\0"           /* 55 */
+    "∏\0"           /* 56 */
+    "∐\0"           /* 57 */
+    "∫\0"           /* 58 */
+    "∬\0"           /* 59 */
+    "∭\0"           /* 60 */
+    "∮\0"           /* 61 */
+    "∯\0"           /* 62 */
+    "∂\0"           /* 63 */
+    "∇\0"           /* 64 */
+    "∆\0"           /* 65 */
+    "√\0"           /* 66 */
+    "∛\0"           /* 67 */
+    "∜\0"           /* 68 */
+    "±\0"           /* 69 */
+    "∓\0"           /* 70 */
+    "×\0"           /* 71 */
+    "÷\0"           /* 72 */
+    "·\0"           /* 73 */
+    "∘\0"           /* 74 */
+    "∗\0"           /* 75 */
+    "⋅\0"           /* 76 */
+    "⊕\0"           /* 77 */
+    "⊖\0"           /* 78 */
+    "⊗\0"           /* 79 */
+    "⊘\0"           /* 80 */
+    "⊙\0"           /* 81 */
+    "†\0"           /* 82 */
+    "‡\0"           /* 83 */
+    "=\0"           /* 84 */
+    "≠\0"           /* 85 */
+    "≈\0"           /* 86 */
+    "≉\0"           /* 87 */
+    "≡\0"           /* 88 */
+    "≢\0"           /* 89 */
+    "≅\0"           /* 90 */
+    "≃\0"           /* 91 */
+    "∼\0"           /* 92 */
+    "≤\0"           /* 93 */
+    "≥\0"           /* 94 */
+    "≪\0"           /* 95 */
+    "≫\0"           /* 96 */
+    "≲\0"           /* 97 */
+    "≳\0"           /* 98 */
+    "≺\0"           /* 99 */
+    "≻\0"           /* 100 */
+    "∝\0"           /* 101 */
+    "∞\0"           /* 102 */
+    "‖\0"           /* 103 */
+    "∣\0"           /* 104 */
+    "∤\0"           /* 105 */
+    "⌈\0"           /* 106 */
+    "⌉\0"           /* 107 */
+    "⌊\0"           /* 108 */
+    "⌋\0"           /* 109 */
+    "⟨\0"           /* 110 */
+    "⟩\0"           /* 111 */
+    "⟦\0"           /* 112 */
+    "⟧\0"           /* 113 */
+    "′\0"           /* 114 */
+    "″\0"           /* 115 */
+    "‴\0"           /* 116 */
+    "←\0"           /* 117 */
+    "→\0"           /* 118 */
+    "↑\0"           /* 119 */
+    "↓\0"           /* 120 */
+    "↔\0"           /* 121 */
+    "↕\0"           /* 122 */
+    "↖\0"           /* 123 */
+    "↗\0"           /* 124 */
+    "↘\0"           /* 125 */
+    "↙\0"           /* 126 */
+    "⇐\0"           /* 127 */
+    "⇒\0"           /* 128 */
+    "⇑\0"           /* 129 */
+    "⇓\0"           /* 130 */
+    "⇔\0"           /* 131 */
+    "⇕\0"           /* 132 */
+    "⟵\0"           /* 133 */
+    "⟶\0"           /* 134 */
+    "⟷\0"           /* 135 */
+    "⟸\0"           /* 136 */
+    "⟹\0"           /* 137 */
+    "⟺\0"           /* 138 */
+    "↦\0"           /* 139 */
+    "⟼\0"           /* 140 */
+    "↪\0"           /* 141 */
+    "↩\0"           /* 142 */
+    "↺\0"           /* 143 */
+    "↻\0"           /* 144 */
+    "⇌\0"           /* 145 */
+    "⇋\0"           /* 146 */
+    "⇄\0"           /* 147 */
+    "⇆\0"           /* 148 */
+    "↠\0"           /* 149 */
+    "↣\0"           /* 150 */
+    "⤳\0"           /* 151 */
+    "∈\0"           /* 152 */
+    "∉\0"           /* 153 */
+    "∋\0"           /* 154 */
+    "∌\0"           /* 155 */
+    "⊂\0"           /* 156 */
+    "⊃\0"           /* 157 */
+    "⊆\0"           /* 158 */
+    "⊇\0"           /* 159 */
+    "⊄\0"           /* 160 */
+    "⊅\0"           /* 161 */
+    "⊊\0"           /* 162 */
+    "⊋\0"           /* 163 */
+    "∪\0"           /* 164 */
+    "∩\0"           /* 165 */
+    "⋃\0"           /* 166 */
+    "⋂\0"           /* 167 */
+    "∅\0"           /* 168 */
+    "∖\0"           /* 169 */
+    "∁\0"           /* 170 */
+    "△\0"           /* 171 */
+    "∀\0"           /* 172 */
+    "∃\0"           /* 173 */
+    "∄\0"           /* 174 */
+    "¬\0"           /* 175 */
+    "∧\0"           /* 176 */
+    "∨\0"           /* 177 */
+    "⊻\0"           /* 178 */
+    "⊼\0"           /* 179 */
+    "⊽\0"           /* 180 */
+    "⊤\0"           /* 181 */
+    "⊥\0"           /* 182 */
+    "⊢\0"           /* 183 */
+    "⊣\0"           /* 184 */
+    "⊨\0"           /* 185 */
+    "∴\0"           /* 186 */
+    "∵\0"           /* 187 */
+    "∎\0"           /* 188 */
+    "≔\0"           /* 189 */
+    "ℕ\0"           /* 190 */
+    "ℤ\0"           /* 191 */
+    "ℚ\0"           /* 192 */
+    "ℝ\0"           /* 193 */
+    "ℂ\0"           /* 194 */
+    "ℍ\0"           /* 195 */
+    "ℙ\0"           /* 196 */
+    "𝔽\0"           /* 197 */
+    "ℵ\0"           /* 198 */
+    "ℶ\0"           /* 199 */
+    "℘\0"           /* 200 */
+    "µ\0"           /* 201 */
+    "Ω\0"           /* 202 */
+    "℧\0"           /* 203 */
+    "°\0"           /* 204 */
+    "℃\0"           /* 205 */
+    "℉\0"           /* 206 */
+    "Å\0"           /* 207 */
+    "ℏ\0"           /* 208 */
+    "ℓ\0"           /* 209 */
+    "‰\0"           /* 210 */
+    "‱\0"           /* 211 */
+    "℮\0"           /* 212 */
+    "²\0"           /* 213 */
+    "³\0"           /* 214 */
+    "¹\0"           /* 215 */
+    "⁰\0"           /* 216 */
+    "⁴\0"           /* 217 */
+    "⁵\0"           /* 218 */
+    "⁶\0"           /* 219 */
+    "⁷\0"           /* 220 */
+    "⁸\0"           /* 221 */
+    "⁹\0"           /* 222 */
+    "⁻\0"           /* 223 */
+    "⁺\0"           /* 224 */
+    "ⁿ\0"           /* 225 */
+    "ⁱ\0"           /* 226 */
+    "₀\0"           /* 227 */
+    "₁\0"           /* 228 */
+    "₂\0"           /* 229 */
+    "₃\0"           /* 230 */
+    "₄\0"           /* 231 */
+    "₅\0"           /* 232 */
+    "₆\0"           /* 233 */
+    "₇\0"           /* 234 */
+    "₈\0"           /* 235 */
+    "₉\0"           /* 236 */
+    "₋\0"           /* 237 */
+    "₊\0"           /* 238 */
+    "½\0"           /* 239 */
+    "⅓\0"           /* 240 */
+    "⅔\0"           /* 241 */
+    "¼\0"           /* 242 */
+    "¾\0"           /* 243 */
+    "⅛\0"           /* 244 */
+    "Greek\0"       /* category 0 */
+    "Operators\0"   /* category 1 */
+    "Arrows\0"      /* category 2 */
+    "Sets and logic\0"/* category 3 */
+    "Units\0"       /* category 4 */;
+
+const INT16U SymCatSymOff[SYMCAT_SYM_COUNT + 1u] = {
+    0u, 3u, 6u, 9u, 12u, 15u, 18u, 21u, 24u, 27u, 30u, 33u,
+    36u, 39u, 42u, 45u, 48u, 51u, 54u, 57u, 60u, 63u, 66u, 69u,
+    72u, 75u, 78u, 81u, 84u, 87u, 90u, 93u, 96u, 99u, 102u, 105u,
+    108u, 111u, 114u, 117u, 120u, 123u, 126u, 129u, 132u, 135u, 138u, 141u,
+    144u, 147u, 150u, 153u, 156u, 159u, 162u, 165u, 169u, 173u, 177u, 181u,
+    185u, 189u, 193u, 197u, 201u, 205u, 209u, 213u, 217u, 221u, 224u, 228u,
+    231u, 234u, 237u, 241u, 245u, 249u, 253u, 257u, 261u, 265u, 269u, 273u,
+    277u, 279u, 283u, 287u, 291u, 295u, 299u, 303u, 307u, 311u, 315u, 319u,
+    323u, 327u, 331u, 335u, 339u, 343u, 347u, 351u, 355u, 359u, 363u, 367u,
+    371u, 375u, 379u, 383u, 387u, 391u, 395u, 399u, 403u, 407u, 411u, 415u,
+    419u, 423u, 427u, 431u, 435u, 439u, 443u, 447u, 451u, 455u, 459u, 463u,
+    467u, 471u, 475u, 479u, 483u, 487u, 491u, 495u, 499u, 503u, 507u, 511u,
+    515u, 519u, 523u, 527u, 531u, 535u, 539u, 543u, 547u, 551u, 555u, 559u,
+    563u, 567u, 571u, 575u, 579u, 583u, 587u, 591u, 595u, 599u, 603u, 607u,
+    611u, 615u, 619u, 623u, 627u, 631u, 635u, 639u, 642u, 646u, 650u, 654u,
+    658u, 662u, 666u, 670u, 674u, 678u, 682u, 686u, 690u, 694u, 698u, 702u,
+    706u, 710u, 714u, 718u, 722u, 726u, 731u, 735u, 739u, 743u, 746u, 749u,
+    753u, 756u, 760u, 764u, 767u, 771u, 775u, 779u, 783u, 787u, 790u, 793u,
+    796u, 800u, 804u, 808u, 812u, 816u, 820u, 824u, 828u, 832u, 836u, 840u,
+    844u, 848u, 852u, 856u, 860u, 864u, 868u, 872u, 876u, 880u, 884u, 888u,
+    891u, 895u, 899u, 902u, 905u, 909u
+};
+
+const INT16U SymCatCatFirst[SYMCAT_CAT_COUNT + 1u] = {
+    0u, 55u, 117u, 152u, 201u, 245u
+};
+
+const INT16U SymCatCatName[SYMCAT_CAT_COUNT] = {
+    909u, 915u, 925u, 932u, 947u
+};
@@ -0,0 +1,28 @@
+/* SymCatalog.h - Generated by catalog/symcat_gen.py from catalog/symbols.txt. Do not edit. */
+#ifndef SYMCATALOG_H
+#define SYMCATALOG_H
+
+#include "MCUType.h"
+
+#define SYMCAT_SYM_COUNT    245u
+#define SYMCAT_CAT_COUNT    5u
+#define SYMCAT_BLOB_SIZE    953u
+#define SYMCAT_ID_NONE      0xFFFFu
+#define SYMCAT_GLYPH_MAX    4u   /* Longest glyph, UTF-8 bytes */
+#define SYMCAT_HASH         0x3BF19FAFu   /* Same as the catalog stream's hash; */
+                                            /* tells saved symbol IDs from an older catalog */
+
+/*****************************************************************************************
+* Packed symbol catalog, in flash.
+*   SymCatBlob      every glyph, then every category name, UTF-8, each NUL terminated
+*   SymCatSymOff    glyph i is at SymCatBlob[SymCatSymOff[i]], and is
+*                   SymCatSymOff[i + 1] - SymCatSymOff[i] - 1 bytes long
+*   SymCatCatFirst  category c holds symbols SymCatCatFirst[c] to SymCatCatFirst[c + 1] - 1
+*   SymCatCatName   name of category c is at SymCatBlob[SymCatCatName[c]]
+*****************************************************************************************/
+extern const INT8C SymCatBlob[SYMCAT_BLOB_SIZE];
+extern const INT16U SymCatSymOff[SYMCAT_SYM_COUNT + 1u];
+extern const INT16U SymCatCatFirst[SYMCAT_CAT_COUNT + 1u];
+extern const INT16U SymCatCatName[SYMCAT_CAT_COUNT];
+
+#endif
@@ -0,0 +1,95 @@
+/* SymProto.c */
+#include "SymProto.h"
+#include "MCUType.h"
+#include "BasicIO.h"
+
+#define SYMPROTO_HDR_LEN    4u
+#define SYMPROTO_CRC_LEN    2u
+#define SYMPROTO_PKT_MAX    (SYMPROTO_HDR_LEN + SYMPROTO_PAYLOAD_MAX + SYMPROTO_CRC_LEN)
+#define SYMPROTO_FRAME_MAX  (SYMPROTO_PKT_MAX + 2u)   /* COBS overhead byte + 0x00 */
+
+/* Sequence number of the next packet */
+static INT8U symproto_seq = 0;
+
+static INT16U SymProtoCrc16(const INT8U *data, INT8U len);
+static INT8U SymProtoCobsEncode(const INT8U *src, INT8U len, INT8U *dst);
+
+/*****************************************************************************************
+* SymProtoSend()
+*   Builds [type][id lo][id hi][seq][payload][crc16], COBS encodes it and queues the frame with
+*   its 0x00 delimiter. Payloads longer than SYMPROTO_PAYLOAD_MAX are cut short.
+*****************************************************************************************/
+void SymProtoSend(INT8U type, INT16U id, const INT8U *payload, INT8U len) {
+    INT8U pkt[SYMPROTO_PKT_MAX];
+    INT8U frame[SYMPROTO_FRAME_MAX];
+    INT8U n = 0;
+    INT8U i;
+    INT16U crc;
+
+    if (len > SYMPROTO_PAYLOAD_MAX) {
+        len = SYMPROTO_PAYLOAD_MAX;
+    }
+    pkt[n++] = type;
+    pkt[n++] = (INT8U)id;
+    pkt[n++] = (INT8U)(id >> 8);
+    pkt[n++] = symproto_seq++;
+    for (i = 0; i < len; i++) {
+        pkt[n++] = payload[i];
+    }
+    crc = SymProtoCrc16(pkt, n);
+    pkt[n++] = (INT8U)crc;
+    pkt[n++] = (INT8U)(crc >> 8);
+
+    n = SymProtoCobsEncode(pkt, n, frame);
+    frame[n++] = 0x00u;
+    for (i = 0; i < n; i++) {
+        BIOWrite((INT8C)frame[i]);
+    }
+}
+
+/*****************************************************************************************
+* SymProtoCrc16()
+*   CRC-16/CCITT-FALSE, bitwise. Packets are a few bytes so no table.
+*****************************************************************************************/
+static INT16U SymProtoCrc16(const INT8U *data, INT8U len) {
+    INT16U crc = 0xFFFFu;
+    INT8U i;
+    INT8U bit;
+
+    for (i = 0; i < len; i++) {
+        crc ^= (INT16U)((INT16U)data[i] << 8);
+        for (bit = 0; bit < 8u; bit++) {
+            if ((crc & 0x8000u) != 0) {
+                crc = (INT16U)((crc << 1) ^ 0x1021u);
+            } else {
+                crc = (INT16U)(crc << 1);
+            }
+        }
+    }
+    return crc;
+}
+
+/*****************************************************************************************
+* SymProtoCobsEncode()
+*   Consistent Overhead Byte Stuffing. dst gets len + 1 bytes with no 0x00 in them,
+*   the delimiter is not added. Only for len < 254. Returns the encoded length.
+*****************************************************************************************/
+static INT8U SymProtoCobsEncode(const INT8U *src, INT8U len, INT8U *dst) {
+    INT8U code_idx = 0;     /* Where the current block's length code goes */
+    INT8U code = 1;
+    INT8U n = 1;
+    INT8U i;
+
+    for (i = 0; i < len; i++) {
+        if (src[i] == 0x00u) {
+            dst[code_idx] = code;
+            code_idx = n++;
+            code = 1;
+        } else {
+            dst[n++] = src[i];
+            code++;
+        }
+    }
+    dst[code_idx] = code;
+    return n;
+}
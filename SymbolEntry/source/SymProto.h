@@ -0,0 +1,57 @@
+#ifndef SYMPROTO_H
+#define SYMPROTO_H
+
+#include "MCUType.h"
+
+/*****************************************************************************************
+* Binary serial protocol, used when APP_CFG_PROTO_BINARY is 1 (app_cfg.h).
+*
+* Packet, before framing:
+*   [type][id lo][id hi][seq][payload 0..SYMPROTO_PAYLOAD_MAX][crc16 lo][crc16 hi]
+*   id is 16-bit, little endian. seq counts every packet sent, mod 256, so the receiver can spot lost frames.
+*   crc16 is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over type..payload.
+* Each packet is COBS encoded and followed by a 0x00 delimiter. The decoder is
+* SymbolReceiver/symbol_bridge.py.
+*****************************************************************************************/
+
+/* Packet types */
+#define SYMPROTO_IDX    0x01u   /* id: selected symbol index, payload: none, or the event stamps */
+#define SYMPROTO_SENT   0x02u   /* id: sent symbol index, SYMPROTO_ID_NONE if none, payload: as IDX */
+#define SYMPROTO_LAT    0x03u   /* id: latency probe, payload: 32-bit count, p50, p99, max in us, LE,
+                                   then the name */
+#define SYMPROTO_CAT    0x04u   /* id: symbol count, payload: 32-bit catalog hash, LE */
+#define SYMPROTO_DEF    0x05u   /* id: symbol index, payload: UTF-8 glyph */
+#define SYMPROTO_GRP    0x06u   /* id: category, payload: 16-bit first index, 16-bit count, LE,
+                                   then the UTF-8 name, cut to fit */
+#define SYMPROTO_TRC_BEGIN  0x07u   /* id: trace record count, payload: 32-bit records lost, 32-bit
+                                       timestamp Hz, LE */
+#define SYMPROTO_TRC_OBJ    0x08u   /* id: trace object ID, payload: kind ('T' or 'S'), priority, name */
+#define SYMPROTO_TRC_EV     0x09u   /* id: index of the first record, payload: up to 3 records of
+                                       [32-bit ts][type][id][16-bit arg], LE (CsOS_Trace.h) */
+#define SYMPROTO_TRC_END    0x0Au   /* id: trace record count */
+#define SYMPROTO_SYNC       0x0Bu   /* id: 0, payload: 32-bit CPU_TS the request arrived, CPU_TS of
+                                       the reply, timestamp Hz, LE */
+#define SYMPROTO_COMP       0x0Cu   /* id: symbols staged, SYMPROTO_ID_NONE if not composing,
+                                       payload: their 16-bit indices, LE, in order */
+#define SYMPROTO_SEQ        0x0Du   /* id: symbol count, payload: none or the event stamps, then the
+                                       16-bit indices, LE, in order */
+#define SYMPROTO_PROF_BEGIN 0x0Eu   /* id: task count, payload: 32-bit timestamp Hz, LE */
+#define SYMPROTO_PROF_TASK  0x0Fu   /* id: task priority, payload: SYMPROTO_PROF_LEN byte record */
+
+/* Event stamps (APP_CFG_EV_STAMP_EN), the payload of an IDX, SENT or SEQ caused by a switch:
+ * 32-bit CPU_TS of the first switch edge, of the menu task taking the event and of the
+ * packet being queued for the UART, LE. */
+#define SYMPROTO_STAMP_LEN  12u
+
+/* Task profile record (OS_CFG_TASK_PROFILE_EN), the payload of a PROF_TASK and the hex of a
+ * TASK_PROF line, LE: 64-bit CPU_TS counts run, 32-bit switches in, switches out, longest
+ * run burst and longest ready to running in CPU_TS counts (OSTaskProfileGet()). */
+#define SYMPROTO_PROF_LEN   24u
+
+#define SYMPROTO_ID_NONE        0xFFFFu
+#define SYMPROTO_PAYLOAD_MAX    24u     /* Longest glyph, GRP header + name */
+
+/* Build, frame and queue one packet for transmission */
+void SymProtoSend(INT8U type, INT16U id, const INT8U *payload, INT8U len);
+
+#endif
@@ -6,8 +6,12 @@
 #include "FRDM_MCXN947ClkCfg.h"      /* Board-specific clock configuration */
 #include "app_cfg.h"                 /* Application configuration */
 #include "CsOS_SW.h"                 /* Switch handling functions */
+#include "CsOS_Tick.h"               /* Dynamic OS tick */
+#include "os_app_hooks.h"            /* Idle task hook, WFI with the dynamic tick */
 #include "menu.h"                    /* Menu handling functions and constants */
-#include "TimeCounter.h"	         /* Timer-handling function */
+#include "QuickAccess.h"             /* Most used symbols, saved in flash */
+#include "LatProbe.h"                /* Latency probes */
+#include "KBench.h"                  /* Kernel benchmarks */
 #include <stdio.h>					 /* Print functions */
 
 /*****************************************************************************************
@@ -22,6 +26,16 @@ static OS_TCB appTaskSymbolControlTCB;        /* Task Control Block for Symbol C
 static CPU_STK appStartTaskStk[APP_CFG_TASK_START_STK_SIZE];
 static CPU_STK appTaskSymbolControlStk[APP_CFG_TASK_SYMBOL_CONTROL_STK_SIZE];
 
+/*****************************************************************************************
+* Events appTaskSymbolControl waits for, all in one flag group.
+*****************************************************************************************/
+#define APP_EV_SW   ((OS_FLAGS)0x01u)    /* Switch events queued, SwFlagSet() */
+#define APP_EV_RX   ((OS_FLAGS)0x02u)    /* Receiver command characters, BIORxFlagSet() */
+
+static OS_FLAG_GRP appEvFlags;
+
+#define APP_SW_BATCH    4u       /* Switch events taken at a time, on the task's stack */
+
 /*****************************************************************************************
 * Task Function Prototypes.
 *   These tasks are private within this module and are declared here.
@@ -38,9 +52,6 @@ void main(void) {
     /* Initialize the clock for the board */
     FRDM_MCXN947InitBootClock();
 
-    /* Set up Basic IO for console communication at 115200 baud */
-    BIOOpen(BIO_BIT_RATE_115200);
-
     /* Disable all interrupts at the start (OS will manage interrupts later) */
     CPU_IntDis();
 
@@ -48,6 +59,9 @@ void main(void) {
     OSInit(&os_err);
     assert(os_err == OS_ERR_NONE);  /* Ensure OS initialization is successful */
 
+    /* Set up Basic IO for console communication at 115200 baud (needs the OS for its TX semaphore) */
+    BIOOpen(BIO_BIT_RATE_115200);
+
     /* Create the start task (first task to run) */
     OSTaskCreate(&appStartTaskTCB,
                  "Start Task",
@@ -80,7 +94,12 @@ static void appStartTask(void *p_arg) {
     (void)p_arg;  /* Avoid unused parameter warning */
 
     /* Initialize system tick for OS and calculate CPU usage statistics */
+#if (OS_CFG_DYN_TICK_EN > 0u)
+    CsOSTickInit();
+#else
     OS_CPU_SysTickInitFreq(SystemCoreClock);
+#endif
+    App_OS_SetAllHooks();    /* Before the idle count is calibrated, it counts the WFI sleep */
     OSStatTaskCPUUsageInit(&os_err);
     assert(os_err == OS_ERR_NONE);
 
@@ -90,7 +109,11 @@ static void appStartTask(void *p_arg) {
     GpioDBugBitsInit();
     SwInit();
     CPU_IntEn();
-    TCCounterInit();
+
+#if APP_CFG_KBENCH_EN
+    /* Time the kernel before the menu starts */
+    KBenchRun();
+#endif
 
     /* Create the Symbol Control task */
     OSTaskCreate(&appTaskSymbolControlTCB,
@@ -104,7 +127,7 @@ static void appStartTask(void *p_arg) {
              0,
              0,
              (void *) 0,
-             (OS_OPT_TASK_NONE),
+             (OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR),  /* .StkUsed, see app_cfg.h */
              &os_err);
     assert(os_err == OS_ERR_NONE); /* Ensure task creation is successful */
 
@@ -121,36 +144,155 @@ static void appStartTask(void *p_arg) {
 *****************************************************************************************/
 static void appTaskSymbolControl(void *p_arg) {
     OS_ERR os_err; /* Handle errors if Pend issues */
-    INT32U sw_in = 0; /* Switch needs to start as "not pressed" */
+    OS_FLAGS events;                 /* APP_EV_x that woke the task */
+    SW_EVENT sw_events[APP_SW_BATCH];
+    INT8U sw_cnt;
+    INT8U i;
+    OS_TICK last_sw = 0;             /* When a switch was last seen, for the flash flush */
+    OS_TICK idle;
+    OS_TICK tout;                    /* Until the flash flush is due, 0 if none is */
+    const OS_TICK flush_ticks = (APP_CFG_QA_FLUSH_MS * OS_CFG_TICK_RATE_HZ) / 1000u;
+    INT8C cmd;                       /* Receiver command, 0 if none */
+    CPU_TS cmd_ts;                   /* When it arrived */
+#if APP_CFG_EV_STAMP_EN
+    CPU_TS ts_task;                  /* When this task took the switch events */
+#endif
 
     (void)p_arg;
 
-    /* Start with the first symbol selected and draw full UI */
-    SetCurrentSymbolIndex(0);
+    /* One wait for every source */
+    OSFlagCreate(&appEvFlags, "App Events", 0, &os_err);
+    assert(os_err == OS_ERR_NONE);
+    SwFlagSet(&appEvFlags, APP_EV_SW);
+    BIORxFlagSet(&appEvFlags, APP_EV_RX);
+
+    /* Tell the receiver which symbol each ID is, then start at the top of the saved */
+    /* quick access ring, or the first symbol if it is empty */
+    QAInit();
+    SendSymbolCatalog();
+    SetCurrentCategory(CATEGORY_QUICK);
 
-    /* Look for switch presses */
+    /* Sleep until a switch event or a receiver command, or until the quick access ring */
+    /* is due to be saved. Nothing else wakes this task */
     while (1) {
 
-        sw_in = SwPend(OS_CFG_TICK_RATE_HZ / 10u, &os_err);
+        /* Save the quick access ring once the user pauses, so a burst of sends costs */
+        /* one flash write. Only then does the wait time out */
+        tout = 0;
+        if (QADirty()) {
+            idle = OSTimeGet(&os_err) - last_sw;
+            if (idle >= flush_ticks) {
+                QAFlush();
+            } else {
+                tout = flush_ticks - idle;
+            }
+        }
+
+        events = OSFlagPend(&appEvFlags, APP_EV_SW | APP_EV_RX, tout,
+                            OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_FLAG_CONSUME | OS_OPT_PEND_BLOCKING,
+                            (CPU_TS *)0, &os_err);
+#ifdef CS_HOST_POSIX
+        HostAppTaskWake();
+#endif
+        if (os_err == OS_ERR_TIMEOUT) {
+            continue;
+        }
+        assert(os_err == OS_ERR_NONE);
 
-        if (os_err == OS_ERR_NONE) {
+        /* A burst of presses is handled in one wakeup */
+        while (((events & APP_EV_SW) != 0u) && ((sw_cnt = SwAcceptBatch(sw_events, APP_SW_BATCH)) != 0)) {
 
-            if (sw_in == SW2) {
-                MenuTiming_Start();
-                INT8U next_index = (INT8U)((GetCurrentSymbolIndex() + 1u) % SYMBOL_COUNT);
-                SetCurrentSymbolIndex(next_index);     // Should prints SYMBOL_IDX: <sym>
-                MenuTiming_EndPrint("SW2");            // Prints MCU_SW2_MS: <ms>
-            }
-            else if (sw_in == SW3) {
-                MenuTiming_Start();
-                SetLastSentSymbol(GetCurrentSymbol()); // Prints SYMBOL_SENT: <sym>
-                MenuTiming_EndPrint("SW3");            // Prints MCU_SW3_MS: <ms>
+            last_sw = OSTimeGet(&os_err);
+#if APP_CFG_EV_STAMP_EN
+            ts_task = CPU_TS_TmrRd();
+#endif
+            for (i = 0; i < sw_cnt; i++) {
+                SW_EVENT *ev = &sw_events[i];
+#if APP_CFG_EV_STAMP_EN
+                MenuStamp(ev->ts, ts_task);        // For the line this event sends, if any
+#endif
+                if (ev->edge == SW_PRESS) {
+                    LAT_PROBE_SINCE(LAT_SW_TASK, ev->ts);
+                }
+                if (ev->edge == SW_RELEASE) {
+                    /* Swallowed on purpose: a release still carries its key, and the held */
+                    /* SW2 and SW2+SW3 branches below would scroll on it. Do not remove */
+                }
+                else if ((ev->key == SW2) && (ev->edge == SW_DOUBLE)) {
+                    StepCategory(1);                       // Double tap SW2: next category
+                }
+                else if ((ev->key == SW2) && (ev->edge == SW_PRESS)) {
+                    LAT_PROBE_START(LAT_STEP);
+                    StepSymbol(1);                         // Prints SYMBOL_IDX: <id> <sym>
+                    LAT_PROBE_END(LAT_STEP);
+                    LAT_PROBE_SINCE(LAT_SW_IDX, ev->ts);
+                }
+                else if (ev->key == SW2) {
+                    /* Held: scroll forward */
+                    StepSymbol(1);
+                }
+#if APP_CFG_COMPOSE_MAX
+                else if ((ev->key == SW23) && (ev->edge == SW_DOUBLE)) {
+                    /* Double tap SW2+SW3: start or cancel a composition. The first tap */
+                    /* stepped back, undo it */
+                    StepSymbol(1);
+                    if (IsComposing()) {
+                        CancelComposing();             // SYMBOL_COMP: --
+                    } else {
+                        StartComposing();              // SYMBOL_COMP:
+                    }
+                }
+#endif
+                else if (ev->key == SW23) {
+                    /* Chord, held or not: scroll back */
+                    StepSymbol(-1);
+                }
+#if APP_CFG_COMPOSE_MAX
+                else if ((ev->key == SW3) && (ev->edge == SW_PRESS) && IsComposing()) {
+                    (void)StageSymbol(GetCurrentSymbolIndex()); // SYMBOL_COMP: <id> <sym> ..., full: ignored
+                }
+                else if ((ev->key == SW3) && (ev->edge == SW_LONG) && IsComposing()) {
+                    /* Held SW3: the press staged the current symbol, send them all */
+                    CommitComposition();               // SYMBOL_SEQ: <id> <sym> ...
+                }
+#endif
+                else if ((ev->key == SW3) && (ev->edge == SW_PRESS)) {
+                    LAT_PROBE_START(LAT_SEND);
+                    SetLastSentSymbol(GetCurrentSymbolIndex()); // Prints SYMBOL_SENT: <id> <sym>
+                    LAT_PROBE_END(LAT_SEND);
+                    LAT_PROBE_SINCE(LAT_SW_SENT, ev->ts);
+                }
             }
+        }
 
-        } else if (os_err == OS_ERR_TIMEOUT) {
-            /* No button this cycle */
-        } else {
-            assert(0);
+        /* Receiver lost or mismatched the catalog, resend it and the current state. */
+        /* It can also ask for the latency probes, a clock sync sample and, with the trace */
+        /* recorder or the task profiles built in, the kernel trace or the profiles */
+        while (((events & APP_EV_RX) != 0u) && ((cmd = BIOReadTs(&cmd_ts)) != '\0')) {
+            if (cmd == MENU_CMD_CATALOG) {
+                SendSymbolCatalog();
+                UpdateMenu();
+            }
+#if APP_CFG_EV_STAMP_EN
+            else if (cmd == MENU_CMD_SYNC) {
+                SendSync(cmd_ts);
+            }
+#endif
+#if APP_CFG_LAT_PROBE_EN
+            else if (cmd == MENU_CMD_LATENCY) {
+                SendLatency();
+            }
+#endif
+#if (OS_CFG_TRACE_EN > 0u)
+            else if (cmd == MENU_CMD_TRACE) {
+                SendTrace();
+            }
+#endif
+#if (OS_CFG_TASK_PROFILE_EN > 0u) && (OS_CFG_DBG_EN > 0u)
+            else if (cmd == MENU_CMD_PROFILE) {
+                SendTaskProfile();
+            }
+#endif
         }
     }
 }
@@ -1,63 +1,494 @@
 /* menu.c */
 #include "menu.h"
 #include "MCUType.h"
+#include "os.h"
 #include "BasicIO.h"
-#include "TimeCounter.h"
+#include "app_cfg.h"
+#include "SymProto.h"
+#include "QuickAccess.h"
+#include "CsOS_Trace.h"
+#include "LatProbe.h"
+#include <string.h>
 
-/* Symbol table: ordered list of selectable symbols */
-/* As long as SYMBOL_COUNT and the python symbol list are appropriately */
-/* updated, you can add and remove whatever symbols you like here */
-static const INT8C *symbols[SYMBOL_COUNT] = {"π", "∑", "µ", "Ω", "∫"};
+/* Symbol table: SymCatalog.c, generated from catalog/symbols.txt by catalog/symcat_gen.py. */
+/* The receiver learns the table from SendSymbolCatalog(), so symbols and categories can be */
+/* added there freely. Only the indices below live in RAM, whatever the catalog size. */
 
-/* Tracks which symbol is currently active */
-static INT8U current_symbol_index = 0;
+/* SendSymbolCatalog() sends each glyph in one payload, and the catalog hash covers all of it */
+#if (SYMCAT_GLYPH_MAX > SYMPROTO_PAYLOAD_MAX)
+#error "Longest glyph in the catalog must fit one SYMPROTO_DEF payload"
+#endif
 
-/* Tracks last-sent symbol (NULL until first send) */
-static const INT8C *last_sent_symbol = (const INT8C *)0;
+/* Tracks which symbol is currently active, and its category */
+static INT16U current_symbol_index = 0;
+static INT8U current_category = 0;
+static INT8U quick_rank = 0;        /* Position in the quick access ring, if that is the category */
 
-/* Timer value initialization */
-static INT32U g_t0_ticks = 0;
-static INT8U  g_timing_armed = 0;
+/* Name of CATEGORY_QUICK */
+static const INT8C menu_quick_name[] = "Quick";
+
+/* Tracks last-sent symbol (SYMBOL_ID_NONE until first send) */
+static INT16U last_sent_index = SYMBOL_ID_NONE;
+
+#if APP_CFG_COMPOSE_MAX
+#if APP_CFG_PROTO_BINARY && (((APP_CFG_EV_STAMP_EN ? SYMPROTO_STAMP_LEN : 0u) + (2u * APP_CFG_COMPOSE_MAX)) > SYMPROTO_PAYLOAD_MAX)
+#error "APP_CFG_COMPOSE_MAX symbols and the stamps must fit one SYMPROTO_SEQ payload"
+#endif
+#if (APP_CFG_COMPOSE_MAX > 255u)
+#error "APP_CFG_COMPOSE_MAX must fit an INT8U"
+#endif
+
+/* Staged symbols, oldest first, see StartComposing() */
+static INT16U compose_buf[APP_CFG_COMPOSE_MAX];
+static INT8U compose_cnt = 0;
+static INT8U composing = FALSE;
+
+static void MenuCompose(void);
+static void MenuSeq(void);
+#endif
+
+static INT16U MenuSymbolLen(INT16U index);
+static INT8U MenuCategoryOf(INT16U index);
+static void MenuSelect(INT16U index);
+static void MenuEvent(INT8U type, INT16U id);
+static INT32U MenuCatalogHash(void);
+#if (OS_CFG_TRACE_EN > 0u)
+static void MenuTraceRec(INT8U *pl, const CSOS_TRACE_EV *ev);
+#endif
+
+#if (OS_CFG_TASK_PROFILE_EN > 0u) && (OS_CFG_DBG_EN > 0u)
+#define MENU_PROF_TASKS_MAX 16u     /* Tasks past this are left out of a SendTaskProfile() */
+
+static void MenuProfRec(INT8U *pl, const OS_TASK_PROFILE *prof);
+#endif
+
+#if APP_CFG_EV_STAMP_EN
+/* Switch event behind the next IDX or SENT, see MenuStamp() */
+typedef struct {
+    CPU_TS edge;
+    CPU_TS task;
+    INT8U armed;
+} MENU_STAMP;
+
+static MENU_STAMP menu_stamp;
+
+#if !APP_CFG_PROTO_BINARY
+static void MenuTsLine(CPU_TS tx);
+#endif
+#endif
+
+#if APP_CFG_PROTO_BINARY || ((OS_CFG_TASK_PROFILE_EN > 0u) && (OS_CFG_DBG_EN > 0u))
+static void MenuPut32(INT8U *pl, INT32U v);
+#endif
+
+#if !APP_CFG_PROTO_BINARY
+/* Menu lines are "<label><id> <glyph>\r\n" or "<label>--\r\n", sent as DMA
+ * fragments straight from these strings and the symbol table, so they must stay static */
+static const INT8C menu_idx_label[] = "SYMBOL_IDX: ";
+static const INT8C menu_sent_label[] = "SYMBOL_SENT: ";
+#if APP_CFG_COMPOSE_MAX
+static const INT8C menu_comp_label[] = "SYMBOL_COMP:";     /* Then " <id> <glyph>" each */
+static const INT8C menu_seq_label[] = "SYMBOL_SEQ:";
+#endif
+static const INT8C menu_none[] = "--";
+static const INT8C menu_crlf[] = "\r\n";
+static const INT8C menu_digits[] = "0123456789 ";   /* Also supplies the space */
+static const INT8C menu_pairs[] =                   /* Two digit groups, "00" to "99" */
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+#define MENU_LINE_FRAGS_MAX 7u      /* label, up to 3 digit groups, space, glyph, CRLF */
+
+static INT8U MenuLineFrags(BIO_FRAG *frags, const INT8C *label, INT16U id);
+static INT8U MenuIdFrags(BIO_FRAG *frags, INT16U id);
+#if APP_CFG_COMPOSE_MAX
+static void MenuListSend(const INT8C *label, const INT16U *ids, INT8U cnt);
+#endif
+static void MenuSend(const BIO_FRAG *frags, INT8U nfrags);
+#endif
 
 /*****************************************************************************************
 * UpdateMenu()
 *   Fully redraws the menu UI as 3 lines, top to bottom.
 *   Intended to keep python-friendly "full lines" with '\n' at end.
+*   In binary mode the same state goes out as an IDX and a SENT packet.
+*   With APP_CFG_COMPOSE_MAX the composition follows, see MenuCompose().
 *****************************************************************************************/
 void UpdateMenu(void) {
-    BIOPutStrg("SYMBOL_IDX: ");
-    BIOPutStrg(symbols[current_symbol_index]);
+#if APP_CFG_PROTO_BINARY
+    SymProtoSend(SYMPROTO_IDX, current_symbol_index, (const INT8U *)0, 0);
+    SymProtoSend(SYMPROTO_SENT, last_sent_index, (const INT8U *)0, 0);
+#else
+    BIO_FRAG frags[MENU_LINE_FRAGS_MAX];
+
+    MenuSend(frags, MenuLineFrags(frags, menu_idx_label, current_symbol_index));
+    MenuSend(frags, MenuLineFrags(frags, menu_sent_label, last_sent_index));
+#endif
+#if APP_CFG_COMPOSE_MAX
+    MenuCompose();
+#endif
+}
+
+
+/*****************************************************************************************
+* SendSymbolCatalog()
+*   Streams the symbol table so the receiver can build its ID -> glyph table:
+*     text:   "SYMBOL_CAT: <count> <hash>\r\n",
+*             "SYMBOL_GRP: <category> <first id> <count> <name>\r\n" each category, then
+*             "SYMBOL_DEF: <id> <glyph>\r\n" each symbol
+*     binary: SYMPROTO_CAT (id = count, payload = hash), SYMPROTO_GRP each, SYMPROTO_DEF each
+*   hash is MenuCatalogHash(), which the receiver recomputes over the entries it got.
+*   Sent at startup and whenever the receiver asks with MENU_CMD_CATALOG.
+*****************************************************************************************/
+void SendSymbolCatalog(void) {
+    INT32U hash = MenuCatalogHash();
+    INT16U i;
+    INT8U c;
+
+#if APP_CFG_PROTO_BINARY
+    INT8U pl[SYMPROTO_PAYLOAD_MAX];
+    INT8U n;
+    const INT8C *name;
+
+    pl[0] = (INT8U)hash;
+    pl[1] = (INT8U)(hash >> 8);
+    pl[2] = (INT8U)(hash >> 16);
+    pl[3] = (INT8U)(hash >> 24);
+    SymProtoSend(SYMPROTO_CAT, SYMBOL_COUNT, pl, 4);
+    for (c = 0; c < CATEGORY_COUNT; c++) {
+        pl[0] = (INT8U)SymCatCatFirst[c];
+        pl[1] = (INT8U)(SymCatCatFirst[c] >> 8);
+        pl[2] = (INT8U)(SymCatCatFirst[c + 1u] - SymCatCatFirst[c]);
+        pl[3] = (INT8U)((SymCatCatFirst[c + 1u] - SymCatCatFirst[c]) >> 8);
+        n = 4;
+        for (name = GetCategoryName(c); (*name != '\0') && (n < SYMPROTO_PAYLOAD_MAX); name++) {
+            pl[n++] = (INT8U)*name;
+        }
+        SymProtoSend(SYMPROTO_GRP, c, pl, n);
+    }
+    for (i = 0; i < SYMBOL_COUNT; i++) {
+        SymProtoSend(SYMPROTO_DEF, i, (const INT8U *)GetSymbol(i), (INT8U)MenuSymbolLen(i));
+    }
+#else
+    BIOPutStrg("SYMBOL_CAT: ");
+    BIOOutDecWord(SYMBOL_COUNT, 6, BIO_OD_MODE_AL);
+    BIOOutHexWord(hash);
     BIOPutStrg("\r\n");
+    for (c = 0; c < CATEGORY_COUNT; c++) {
+        BIOPutStrg("SYMBOL_GRP: ");
+        BIOOutDecWord(c, 4, BIO_OD_MODE_AL);
+        BIOOutDecWord(SymCatCatFirst[c], 6, BIO_OD_MODE_AL);
+        BIOOutDecWord((INT32U)SymCatCatFirst[c + 1u] - SymCatCatFirst[c], 6, BIO_OD_MODE_AL);
+        BIOPutStrg(GetCategoryName(c));
+        BIOPutStrg("\r\n");
+    }
+    for (i = 0; i < SYMBOL_COUNT; i++) {
+        BIOPutStrg("SYMBOL_DEF: ");
+        BIOOutDecWord(i, 6, BIO_OD_MODE_AL);
+        BIOPutStrg(GetSymbol(i));
+        BIOPutStrg("\r\n");
+    }
+#endif
+}
 
-    BIOPutStrg("SYMBOL_SENT: ");
-    if (last_sent_symbol != 0) {
-        BIOPutStrg(last_sent_symbol);
-    } else {
-        BIOPutStrg("--");
+
+#if (OS_CFG_TRACE_EN > 0u)
+/*****************************************************************************************
+* SendTrace()
+*   Streams the trace recorder's ring, oldest record first. Recording stops while the
+*   ring is read and starts again, empty, once it has been sent:
+*     text:   "TRACE_BEGIN: <count> <lost> <ts Hz>\r\n",
+*             "TRACE_OBJ: <id> <T|S> <prio> <name>\r\n" each task and semaphore,
+*             "TRACE_EV: <index> <record> ...\r\n", 8 records of 16 hex digits a line,
+*             "TRACE_END: <count>\r\n"
+*     binary: SYMPROTO_TRC_BEGIN, SYMPROTO_TRC_OBJ each, SYMPROTO_TRC_EV (3 records a
+*             packet), SYMPROTO_TRC_END
+*   Records are [32-bit ts][type][id][16-bit arg], little endian, in both.
+*   Sent when the receiver asks with MENU_CMD_TRACE.
+*****************************************************************************************/
+void SendTrace(void) {
+    CPU_ERR cpu_err;
+    INT32U cnt;
+    INT32U lost;
+    INT32U hz;
+    INT32U i;
+    INT8U id;
+    const CSOS_TRACE_OBJ *obj;
+    INT8U pl[SYMPROTO_PAYLOAD_MAX];
+
+    CsOSTraceStop();
+    cnt = CsOSTraceCount();
+    lost = CsOSTraceLost();
+    hz = (INT32U)CPU_TS_TmrFreqGet(&cpu_err);
+
+#if APP_CFG_PROTO_BINARY
+    INT8U n;
+    const CPU_CHAR *name;
+
+    pl[0] = (INT8U)lost;
+    pl[1] = (INT8U)(lost >> 8);
+    pl[2] = (INT8U)(lost >> 16);
+    pl[3] = (INT8U)(lost >> 24);
+    pl[4] = (INT8U)hz;
+    pl[5] = (INT8U)(hz >> 8);
+    pl[6] = (INT8U)(hz >> 16);
+    pl[7] = (INT8U)(hz >> 24);
+    SymProtoSend(SYMPROTO_TRC_BEGIN, (INT16U)cnt, pl, 8);
+    for (id = 1; (obj = CsOSTraceObjGet(id)) != (const CSOS_TRACE_OBJ *)0; id++) {
+        pl[0] = obj->kind;
+        pl[1] = obj->prio;
+        n = 2;
+        for (name = obj->name; (name != (const CPU_CHAR *)0) && (*name != '\0') && (n < SYMPROTO_PAYLOAD_MAX); name++) {
+            pl[n++] = (INT8U)*name;
+        }
+        SymProtoSend(SYMPROTO_TRC_OBJ, id, pl, n);
+    }
+    for (i = 0; i < cnt; i += 3u) {
+        for (n = 0; (n < 3u) && ((i + n) < cnt); n++) {
+            MenuTraceRec(&pl[8u * n], CsOSTraceEvGet(i + n));
+        }
+        SymProtoSend(SYMPROTO_TRC_EV, (INT16U)i, pl, (INT8U)(8u * n));
     }
+    SymProtoSend(SYMPROTO_TRC_END, (INT16U)cnt, (const INT8U *)0, 0);
+#else
+    INT8U b;
+
+    BIOPutStrg("TRACE_BEGIN: ");
+    BIOOutDecWord(cnt, 6, BIO_OD_MODE_AL);
+    BIOOutDecWord(lost, 10, BIO_OD_MODE_AL);
+    BIOOutDecWord(hz, 10, BIO_OD_MODE_AL);
     BIOPutStrg("\r\n");
+    for (id = 1; (obj = CsOSTraceObjGet(id)) != (const CSOS_TRACE_OBJ *)0; id++) {
+        BIOPutStrg("TRACE_OBJ: ");
+        BIOOutDecWord(id, 4, BIO_OD_MODE_AL);
+        BIOWrite((INT8C)obj->kind);
+        BIOWrite(' ');
+        BIOOutDecWord(obj->prio, 4, BIO_OD_MODE_AL);
+        BIOPutStrg((obj->name != (const CPU_CHAR *)0) ? (const INT8C *)obj->name : "?");
+        BIOPutStrg("\r\n");
+    }
+    for (i = 0; i < cnt; i++) {
+        if ((i % 8u) == 0) {
+            BIOPutStrg("TRACE_EV: ");
+            BIOOutDecWord(i, 6, BIO_OD_MODE_AL);
+        }
+        MenuTraceRec(pl, CsOSTraceEvGet(i));
+        for (b = 0; b < 8u; b++) {
+            BIOOutHexByte(pl[b]);
+        }
+        if (((i % 8u) == 7u) || ((i + 1u) == cnt)) {
+            BIOPutStrg("\r\n");
+        } else {
+            BIOWrite(' ');
+        }
+    }
+    BIOPutStrg("TRACE_END: ");
+    BIOOutDecWord(cnt, 6, BIO_OD_MODE_AL);
+    BIOPutStrg("\r\n");
+#endif
+    CsOSTraceStart();
 }
 
+/*****************************************************************************************
+* MenuTraceRec()
+*   One trace record as 8 bytes, little endian
+*****************************************************************************************/
+static void MenuTraceRec(INT8U *pl, const CSOS_TRACE_EV *ev) {
+    pl[0] = (INT8U)ev->ts;
+    pl[1] = (INT8U)(ev->ts >> 8);
+    pl[2] = (INT8U)(ev->ts >> 16);
+    pl[3] = (INT8U)(ev->ts >> 24);
+    pl[4] = ev->type;
+    pl[5] = ev->id;
+    pl[6] = (INT8U)ev->arg;
+    pl[7] = (INT8U)(ev->arg >> 8);
+}
+#endif
+
+#if APP_CFG_LAT_PROBE_EN
+/*****************************************************************************************
+* SendLatency()
+*   Summary of every latency probe, in us:
+*     text:   "LAT_PROBE: <name> <count> <p50> <p99> <max>\r\n" each probe
+*     binary: SYMPROTO_LAT each probe
+*   Sent when the receiver asks with MENU_CMD_LATENCY. The histograms keep counting.
+*****************************************************************************************/
+void SendLatency(void) {
+    LAT_STATS st;
+    LAT_PROBE p;
+
+    for (p = (LAT_PROBE)0; p < LAT_PROBE_COUNT; p++) {
+        LatProbeStats(p, &st);
+#if APP_CFG_PROTO_BINARY
+        INT8U pl[SYMPROTO_PAYLOAD_MAX];
+        INT8U n = 16;
+        const INT8C *name;
+
+        MenuPut32(&pl[0], st.count);
+        MenuPut32(&pl[4], st.p50);
+        MenuPut32(&pl[8], st.p99);
+        MenuPut32(&pl[12], st.max);
+        for (name = LatProbeName(p); (*name != '\0') && (n < SYMPROTO_PAYLOAD_MAX); name++) {
+            pl[n++] = (INT8U)*name;
+        }
+        SymProtoSend(SYMPROTO_LAT, (INT16U)p, pl, n);
+#else
+        BIOPutStrg("LAT_PROBE: ");
+        BIOPutStrg(LatProbeName(p));
+        BIOWrite(' ');
+        BIOOutDecWord(st.count, 10, BIO_OD_MODE_AL);
+        BIOOutDecWord(st.p50, 9, BIO_OD_MODE_AL);
+        BIOOutDecWord(st.p99, 9, BIO_OD_MODE_AL);
+        BIOOutDecWord(st.max, 9, BIO_OD_MODE_AL);
+        BIOPutStrg("\r\n");
+#endif
+    }
+}
+#endif
+
+#if (OS_CFG_TASK_PROFILE_EN > 0u) && (OS_CFG_DBG_EN > 0u)
+/*****************************************************************************************
+* SendTaskProfile()
+*   Run time profile of every task, see OSTaskProfileGet():
+*     text:   "TASK_PROF_BEGIN: <count> <ts Hz>\r\n", then
+*             "TASK_PROF: <prio> <record, 48 hex digits> <name>\r\n" each task
+*     binary: SYMPROTO_PROF_BEGIN, then SYMPROTO_PROF_TASK each task
+*   The record is SYMPROTO_PROF_LEN bytes, see SymProto.h. The tasks are snapshot with the
+*   scheduler locked, so none is deleted meanwhile, and sent after. Sent when the receiver
+*   asks with MENU_CMD_PROFILE. The statistics keep counting.
+*****************************************************************************************/
+void SendTaskProfile(void) {
+    static OS_TASK_PROFILE prof[MENU_PROF_TASKS_MAX];
+#if !APP_CFG_PROTO_BINARY
+    static const CPU_CHAR *name[MENU_PROF_TASKS_MAX];   /* Text only, packets have no room */
+#endif
+    OS_TCB *p_tcb;
+    OS_ERR os_err;
+    CPU_ERR cpu_err;
+    INT32U hz;
+    INT8U cnt = 0;
+    INT8U i;
+    INT8U pl[SYMPROTO_PAYLOAD_MAX];
+
+    OSSchedLock(&os_err);
+    for (p_tcb = OSTaskDbgListPtr; (p_tcb != (OS_TCB *)0) && (cnt < MENU_PROF_TASKS_MAX); p_tcb = p_tcb->DbgNextPtr) {
+        OSTaskProfileGet(p_tcb, &prof[cnt], &os_err);
+        if (os_err == OS_ERR_NONE) {
+#if !APP_CFG_PROTO_BINARY
+            name[cnt] = p_tcb->NamePtr;
+#endif
+            cnt++;
+        }
+    }
+    OSSchedUnlock(&os_err);
+    hz = (INT32U)CPU_TS_TmrFreqGet(&cpu_err);
+
+#if APP_CFG_PROTO_BINARY
+    MenuPut32(pl, hz);
+    SymProtoSend(SYMPROTO_PROF_BEGIN, cnt, pl, 4);
+    for (i = 0; i < cnt; i++) {
+        MenuProfRec(pl, &prof[i]);
+        SymProtoSend(SYMPROTO_PROF_TASK, prof[i].Prio, pl, SYMPROTO_PROF_LEN);
+    }
+#else
+    INT8U b;
+
+    BIOPutStrg("TASK_PROF_BEGIN: ");
+    BIOOutDecWord(cnt, 4, BIO_OD_MODE_AL);
+    BIOOutDecWord(hz, 10, BIO_OD_MODE_AL);
+    BIOPutStrg("\r\n");
+    for (i = 0; i < cnt; i++) {
+        BIOPutStrg("TASK_PROF: ");
+        BIOOutDecWord(prof[i].Prio, 4, BIO_OD_MODE_AL);
+        MenuProfRec(pl, &prof[i]);
+        for (b = 0; b < SYMPROTO_PROF_LEN; b++) {
+            BIOOutHexByte(pl[b]);
+        }
+        BIOWrite(' ');
+        BIOPutStrg((name[i] != (const CPU_CHAR *)0) ? (const INT8C *)name[i] : "?");
+        BIOPutStrg("\r\n");
+    }
+#endif
+}
+
+/*****************************************************************************************
+* MenuProfRec()
+*   One task profile as SYMPROTO_PROF_LEN bytes, little endian
+*****************************************************************************************/
+static void MenuProfRec(INT8U *pl, const OS_TASK_PROFILE *prof) {
+    MenuPut32(&pl[0], (INT32U)prof->CyclesRun);
+    MenuPut32(&pl[4], (INT32U)(prof->CyclesRun >> 32));
+    MenuPut32(&pl[8], (INT32U)prof->CtxSwInCtr);
+    MenuPut32(&pl[12], (INT32U)prof->CtxSwOutCtr);
+    MenuPut32(&pl[16], (INT32U)prof->CyclesBurstMax);
+    MenuPut32(&pl[20], (INT32U)prof->RdyToRunMax);
+}
+#endif
+
+#if APP_CFG_EV_STAMP_EN
+/*****************************************************************************************
+* MenuStamp()
+*   The next IDX or SENT goes out with edge, task and the CPU_TS it was queued at:
+*     text:   "SYMBOL_TS: <edge> <task> <tx>\r\n" after the line, 8 hex digits each
+*     binary: SYMPROTO_STAMP_LEN bytes of payload
+*   A stamp nothing was sent for is replaced by the next one.
+*****************************************************************************************/
+void MenuStamp(CPU_TS edge, CPU_TS task) {
+    menu_stamp.edge = edge;
+    menu_stamp.task = task;
+    menu_stamp.armed = TRUE;
+}
+
+/*****************************************************************************************
+* SendSync()
+*   One clock sync sample: when the request arrived and when the answer went out, in
+*   CPU_TS counts, and the counts per second:
+*     text:   "SYNC: <rx ts> <tx ts> <ts Hz>\r\n", timestamps as 8 hex digits
+*     binary: SYMPROTO_SYNC
+*   The receiver pairs them with its own send and receive times (symbol_bridge.py).
+*****************************************************************************************/
+void SendSync(CPU_TS rx_ts) {
+    CPU_ERR cpu_err;
+    INT32U hz = (INT32U)CPU_TS_TmrFreqGet(&cpu_err);
+    CPU_TS tx_ts = CPU_TS_TmrRd();
+
+#if APP_CFG_PROTO_BINARY
+    INT8U pl[12];
+
+    MenuPut32(&pl[0], rx_ts);
+    MenuPut32(&pl[4], tx_ts);
+    MenuPut32(&pl[8], hz);
+    SymProtoSend(SYMPROTO_SYNC, 0, pl, 12);
+#else
+    BIOPutStrg("SYNC: ");
+    BIOOutHexWord(rx_ts);
+    BIOWrite(' ');
+    BIOOutHexWord(tx_ts);
+    BIOWrite(' ');
+    BIOOutDecWord(hz, 10, BIO_OD_MODE_AL);
+    BIOPutStrg("\r\n");
+#endif
+}
+#endif
+
 
 /*****************************************************************************************
 * GetCurrentSymbolIndex()
 *****************************************************************************************/
-INT8U GetCurrentSymbolIndex(void) {
+INT16U GetCurrentSymbolIndex(void) {
     return current_symbol_index;
 }
 
 
 /*****************************************************************************************
 * SetCurrentSymbolIndex()
-*   Updates index then redraws menu
+*   Updates index and its category then redraws menu
 *****************************************************************************************/
-void SetCurrentSymbolIndex(INT8U index) {
+void SetCurrentSymbolIndex(INT16U index) {
     if (index < SYMBOL_COUNT) {
-        current_symbol_index = index;
-
-        BIOPutStrg("SYMBOL_IDX: ");
-        BIOPutStrg(symbols[current_symbol_index]);
-        BIOPutStrg("\r\n");
+        current_category = MenuCategoryOf(index);
+        MenuSelect(index);
     }
 }
 
@@ -66,61 +497,498 @@ void SetCurrentSymbolIndex(INT8U index) {
 * GetCurrentSymbol()
 *****************************************************************************************/
 const INT8C* GetCurrentSymbol(void) {
-    return symbols[current_symbol_index];
+    return GetSymbol(current_symbol_index);
+}
+
+
+/*****************************************************************************************
+* GetSymbol()
+*   Glyph of a symbol ID, straight from the flash table. NULL if index is out of range.
+*****************************************************************************************/
+const INT8C* GetSymbol(INT16U index) {
+    if (index >= SYMBOL_COUNT) {
+        return (const INT8C *)0;
+    }
+    return &SymCatBlob[SymCatSymOff[index]];
 }
 
 
 /*****************************************************************************************
 * SetLastSentSymbol()
-*   Call this when SW3 fires
+*   Call this when SW3 fires. Counts the send in the quick access ring, then goes back
+*   to the top of the ring so SW2 cycles the most used symbols first.
+*****************************************************************************************/
+void SetLastSentSymbol(INT16U index) {
+    last_sent_index = (index < SYMBOL_COUNT) ? index : SYMBOL_ID_NONE;
+    CSOS_TRACE_MARK(CSOS_TRACE_MARK_SENT, last_sent_index);
+    MenuEvent(SYMPROTO_SENT, last_sent_index);
+    if (last_sent_index != SYMBOL_ID_NONE) {
+        QAUpdate(last_sent_index);
+        SetCurrentCategory(CATEGORY_QUICK);
+    }
+}
+
+
+#if APP_CFG_COMPOSE_MAX
+/*****************************************************************************************
+* StartComposing()
+*   Starts an empty composition. The menu keeps working, SW3 stages instead of sending.
+*****************************************************************************************/
+void StartComposing(void) {
+    composing = TRUE;
+    compose_cnt = 0;
+    MenuCompose();
+}
+
+
+/*****************************************************************************************
+* IsComposing()
+*****************************************************************************************/
+INT8U IsComposing(void) {
+    return composing;
+}
+
+
+/*****************************************************************************************
+* StageSymbol()
+*   Appends a symbol to the composition and shows it. FALSE, and nothing sent, if not
+*   composing, the buffer is full or index is out of range.
+*****************************************************************************************/
+INT8U StageSymbol(INT16U index) {
+    if ((composing == FALSE) || (compose_cnt >= APP_CFG_COMPOSE_MAX) || (index >= SYMBOL_COUNT)) {
+        return FALSE;
+    }
+    compose_buf[compose_cnt] = index;
+    compose_cnt++;
+    MenuCompose();
+    return TRUE;
+}
+
+
+/*****************************************************************************************
+* CommitComposition()
+*   Sends the staged symbols as one SYMBOL_SEQ, which also ends the composition on the
+*   receiver's side. Then ranks each in the quick access ring, in order, and goes back to
+*   the top of the ring like SetLastSentSymbol(). An empty composition is just cancelled.
 *****************************************************************************************/
-void SetLastSentSymbol(const INT8C *sym) {
-    last_sent_symbol = sym;
+void CommitComposition(void) {
+    INT8U i;
 
-    BIOPutStrg("SYMBOL_SENT: ");
-    if (last_sent_symbol != 0) {
-        BIOPutStrg(last_sent_symbol);
+    if (composing == FALSE) {
+        return;
+    }
+    if (compose_cnt == 0) {
+        CancelComposing();
+        return;
+    }
+    composing = FALSE;
+    last_sent_index = compose_buf[compose_cnt - 1u];
+    MenuSeq();
+    for (i = 0; i < compose_cnt; i++) {
+        CSOS_TRACE_MARK(CSOS_TRACE_MARK_SENT, compose_buf[i]);
+        QAUpdate(compose_buf[i]);
+    }
+    compose_cnt = 0;
+    SetCurrentCategory(CATEGORY_QUICK);
+}
+
+
+/*****************************************************************************************
+* CancelComposing()
+*   Drops the staged symbols, nothing is sent
+*****************************************************************************************/
+void CancelComposing(void) {
+    composing = FALSE;
+    compose_cnt = 0;
+    MenuCompose();
+}
+
+
+/*****************************************************************************************
+* MenuCompose()
+*   Shows the composition:
+*     text:   "SYMBOL_COMP: <id> <glyph> ...\r\n" staged so far, "SYMBOL_COMP: --\r\n"
+*             when not composing
+*     binary: SYMPROTO_COMP
+*****************************************************************************************/
+static void MenuCompose(void) {
+#if APP_CFG_PROTO_BINARY
+    INT8U pl[2u * APP_CFG_COMPOSE_MAX];
+    INT8U i;
+
+    for (i = 0; i < compose_cnt; i++) {
+        pl[2u * i] = (INT8U)compose_buf[i];
+        pl[(2u * i) + 1u] = (INT8U)(compose_buf[i] >> 8);
+    }
+    SymProtoSend(SYMPROTO_COMP, (composing != FALSE) ? compose_cnt : SYMPROTO_ID_NONE, pl, (INT8U)(2u * compose_cnt));
+#else
+    BIO_FRAG frags[MENU_LINE_FRAGS_MAX];
+
+    if (composing != FALSE) {
+        MenuListSend(menu_comp_label, compose_buf, compose_cnt);
     } else {
-        BIOPutStrg("--");
+        frags[0].ptr = menu_comp_label;
+        frags[0].len = (INT16U)strlen(menu_comp_label);
+        frags[1].ptr = &menu_digits[10];
+        frags[1].len = 1;
+        frags[2].ptr = menu_none;
+        frags[2].len = 2;
+        frags[3].ptr = menu_crlf;
+        frags[3].len = 2;
+        MenuSend(frags, 4);
+    }
+#endif
+}
+
+
+/*****************************************************************************************
+* MenuSeq()
+*   Sends the composition, with the stamps from MenuStamp() if there are any:
+*     text:   "SYMBOL_SEQ: <id> <glyph> ...\r\n", then SYMBOL_TS
+*     binary: SYMPROTO_SEQ
+*****************************************************************************************/
+static void MenuSeq(void) {
+#if APP_CFG_PROTO_BINARY
+    INT8U pl[SYMPROTO_STAMP_LEN + (2u * APP_CFG_COMPOSE_MAX)];
+    INT8U n = 0;
+    INT8U i;
+
+#if APP_CFG_EV_STAMP_EN
+    if (menu_stamp.armed) {
+        menu_stamp.armed = FALSE;
+        MenuPut32(&pl[0], menu_stamp.edge);
+        MenuPut32(&pl[4], menu_stamp.task);
+        MenuPut32(&pl[8], CPU_TS_TmrRd());
+        n = SYMPROTO_STAMP_LEN;
+    }
+#endif
+    for (i = 0; i < compose_cnt; i++) {
+        pl[n++] = (INT8U)compose_buf[i];
+        pl[n++] = (INT8U)(compose_buf[i] >> 8);
+    }
+    SymProtoSend(SYMPROTO_SEQ, compose_cnt, pl, n);
+#else
+#if APP_CFG_EV_STAMP_EN
+    CPU_TS tx = CPU_TS_TmrRd();
+#endif
+
+    MenuListSend(menu_seq_label, compose_buf, compose_cnt);
+#if APP_CFG_EV_STAMP_EN
+    MenuTsLine(tx);
+#endif
+#endif
+}
+#endif
+
+
+/*****************************************************************************************
+* GetCurrentCategory()
+*****************************************************************************************/
+INT8U GetCurrentCategory(void) {
+    return current_category;
+}
+
+
+/*****************************************************************************************
+* SetCurrentCategory()
+*   Selects the first symbol of the category and redraws. An empty quick access ring
+*   selects the first symbol of the catalog instead.
+*****************************************************************************************/
+void SetCurrentCategory(INT8U cat) {
+    if ((cat == CATEGORY_QUICK) && (QACount() != 0)) {
+        current_category = CATEGORY_QUICK;
+        quick_rank = 0;
+        MenuSelect(QAGet(0));
+    } else if (cat <= CATEGORY_QUICK) {
+        SetCurrentSymbolIndex(SymCatCatFirst[(cat < CATEGORY_COUNT) ? cat : 0u]);
+    }
+}
+
+
+/*****************************************************************************************
+* GetCategoryName()
+*   NULL if cat is out of range
+*****************************************************************************************/
+const INT8C* GetCategoryName(INT8U cat) {
+    if (cat == CATEGORY_QUICK) {
+        return menu_quick_name;
+    }
+    if (cat >= CATEGORY_COUNT) {
+        return (const INT8C *)0;
+    }
+    return &SymCatBlob[SymCatCatName[cat]];
+}
+
+
+/*****************************************************************************************
+* StepCategory()
+*   Moves step categories on (back if negative), wrapping, to the first symbol.
+*   CATEGORY_QUICK comes after the last catalog category and is skipped while empty.
+*****************************************************************************************/
+void StepCategory(INT8S step) {
+    INT32S ncat = (INT32S)CATEGORY_COUNT + 1;
+    INT32S cat = ((INT32S)current_category + step) % ncat;
+
+    if (cat < 0) {
+        cat += ncat;
+    }
+    if ((cat == (INT32S)CATEGORY_QUICK) && (QACount() == 0) && (step != 0)) {
+        cat = (cat + ((step > 0) ? 1 : -1) + ncat) % ncat;
+    }
+    SetCurrentCategory((INT8U)cat);
+}
+
+
+/*****************************************************************************************
+* StepSymbol()
+*   Moves step symbols on (back if negative) within the current category, wrapping
+*****************************************************************************************/
+void StepSymbol(INT8S step) {
+    INT32S first;
+    INT32S cnt;
+    INT32S pos;
+
+    if (current_category == CATEGORY_QUICK) {
+        first = 0;
+        cnt = (INT32S)QACount();
+        pos = (INT32S)quick_rank;
+    } else {
+        first = (INT32S)SymCatCatFirst[current_category];
+        cnt = (INT32S)SymCatCatFirst[current_category + 1u] - first;
+        pos = (INT32S)current_symbol_index - first;
+    }
+    pos = (pos + step) % cnt;
+    if (pos < 0) {
+        pos += cnt;
+    }
+    if (current_category == CATEGORY_QUICK) {
+        quick_rank = (INT8U)pos;
+        MenuSelect(QAGet(quick_rank));
+    } else {
+        MenuSelect((INT16U)(first + pos));
     }
-    BIOPutStrg("\r\n");
 }
 
 /*****************************************************************************************
-* MenuTiming_Start()
-*   This grabs the start time of the menu
-****************************************************************************************/
-void MenuTiming_Start(void)
-{
-    g_t0_ticks = TCCountGet();
-    g_timing_armed = 1;
+* MenuSelect()
+*   Selects a symbol without changing the category, and redraws its line
+*****************************************************************************************/
+static void MenuSelect(INT16U index) {
+    current_symbol_index = index;
+    CSOS_TRACE_MARK(CSOS_TRACE_MARK_IDX, index);
+    MenuEvent(SYMPROTO_IDX, current_symbol_index);
 }
 
 /*****************************************************************************************
-* MenuTiming_()
-*   Prints: "<label>: <ms> ms" on terminal line 4
-****************************************************************************************/
-void MenuTiming_EndPrint(const INT8C *label)
-{
-    if (!g_timing_armed) {
+* MenuEvent()
+*   Sends a SYMBOL_IDX or SYMBOL_SENT (type SYMPROTO_IDX or SYMPROTO_SENT), with the
+*   stamps from MenuStamp() if there are any
+*****************************************************************************************/
+static void MenuEvent(INT8U type, INT16U id) {
+#if APP_CFG_PROTO_BINARY
+#if APP_CFG_EV_STAMP_EN
+    INT8U pl[SYMPROTO_STAMP_LEN];
+
+    if (menu_stamp.armed) {
+        menu_stamp.armed = FALSE;
+        MenuPut32(&pl[0], menu_stamp.edge);
+        MenuPut32(&pl[4], menu_stamp.task);
+        MenuPut32(&pl[8], CPU_TS_TmrRd());
+        SymProtoSend(type, id, pl, SYMPROTO_STAMP_LEN);
         return;
     }
+#endif
+    SymProtoSend(type, id, (const INT8U *)0, 0);
+#else
+    BIO_FRAG frags[MENU_LINE_FRAGS_MAX];
+#if APP_CFG_EV_STAMP_EN
+    CPU_TS tx = CPU_TS_TmrRd();
+#endif
 
-    INT32U t1 = TCCountGet();
-    INT32U dt_ticks = (INT32U)(t1 - g_t0_ticks);
-    INT32U dt_ms = dt_ticks;  /* TCCountGet is already ms ticks */
+    MenuSend(frags, MenuLineFrags(frags, (type == SYMPROTO_IDX) ? menu_idx_label : menu_sent_label, id));
+#if APP_CFG_EV_STAMP_EN
+    MenuTsLine(tx);
+#endif
+#endif
+}
 
-    /* Plain text, python-friendly */
-    BIOPutStrg("MCU_");
-    if (label != (const INT8C *)0) {
-        BIOPutStrg(label);          /* "SW2" or "SW3" */
+#if APP_CFG_EV_STAMP_EN && !APP_CFG_PROTO_BINARY
+/*****************************************************************************************
+* MenuTsLine()
+*   "SYMBOL_TS: <edge> <task> <tx>\r\n" for the line just sent, if a stamp is armed
+*****************************************************************************************/
+static void MenuTsLine(CPU_TS tx) {
+    if (menu_stamp.armed) {
+        menu_stamp.armed = FALSE;
+        BIOPutStrg("SYMBOL_TS: ");
+        BIOOutHexWord(menu_stamp.edge);
+        BIOWrite(' ');
+        BIOOutHexWord(menu_stamp.task);
+        BIOWrite(' ');
+        BIOOutHexWord(tx);
+        BIOPutStrg("\r\n");
+    }
+}
+#endif
+
+/*****************************************************************************************
+* MenuSymbolLen()
+*   Glyph length in bytes, from the offset table
+*****************************************************************************************/
+static INT16U MenuSymbolLen(INT16U index) {
+    return (INT16U)(SymCatSymOff[index + 1u] - SymCatSymOff[index] - 1u);
+}
+
+/*****************************************************************************************
+* MenuCategoryOf()
+*   Category holding a symbol, binary search of the category start IDs
+*****************************************************************************************/
+static INT8U MenuCategoryOf(INT16U index) {
+    INT8U lo = 0;
+    INT8U hi = CATEGORY_COUNT - 1u;
+    INT8U mid;
+
+    while (lo < hi) {
+        mid = (INT8U)((lo + hi + 1u) / 2u);
+        if (SymCatCatFirst[mid] <= index) {
+            lo = mid;
+        } else {
+            hi = (INT8U)(mid - 1u);
+        }
+    }
+    return lo;
+}
+
+/*****************************************************************************************
+* MenuCatalogHash()
+*   32-bit FNV-1a over id (16-bit, little endian), length and bytes of every symbol,
+*   in table order. Categories are not included.
+*****************************************************************************************/
+static INT32U MenuCatalogHash(void) {
+    INT32U hash = 0x811C9DC5u;
+    INT16U i;
+    const INT8C *c;
+
+    for (i = 0; i < SYMBOL_COUNT; i++) {
+        hash = (hash ^ (INT8U)i) * 0x01000193u;
+        hash = (hash ^ (INT8U)(i >> 8)) * 0x01000193u;
+        hash = (hash ^ (INT8U)MenuSymbolLen(i)) * 0x01000193u;
+        for (c = GetSymbol(i); *c != '\0'; c++) {
+            hash = (hash ^ (INT8U)*c) * 0x01000193u;
+        }
+    }
+    return hash;
+}
+
+#if APP_CFG_PROTO_BINARY || ((OS_CFG_TASK_PROFILE_EN > 0u) && (OS_CFG_DBG_EN > 0u))
+/*****************************************************************************************
+* MenuPut32()
+*   32-bit value into a payload, little endian
+*****************************************************************************************/
+static void MenuPut32(INT8U *pl, INT32U v) {
+    pl[0] = (INT8U)v;
+    pl[1] = (INT8U)(v >> 8);
+    pl[2] = (INT8U)(v >> 16);
+    pl[3] = (INT8U)(v >> 24);
+}
+#endif
+
+#if !APP_CFG_PROTO_BINARY
+/*****************************************************************************************
+* MenuLineFrags()
+*   Fills the fragments for "<label><id> <glyph>\r\n", or "<label>--\r\n" for
+*   SYMBOL_ID_NONE. Returns the count.
+*****************************************************************************************/
+static INT8U MenuLineFrags(BIO_FRAG *frags, const INT8C *label, INT16U id) {
+    INT8U n = 0;
+
+    frags[n].ptr = label;
+    frags[n++].len = (INT16U)strlen(label);
+    if (id >= SYMBOL_COUNT) {
+        frags[n].ptr = menu_none;
+        frags[n++].len = 2;
     } else {
-        BIOPutStrg("TIME");
+        n += MenuIdFrags(&frags[n], id);
     }
-    BIOPutStrg("_MS: ");
-    BIOOutDecWord(dt_ms, 4, BIO_OD_MODE_AR);
-    BIOPutStrg("\r\n");
+    frags[n].ptr = menu_crlf;
+    frags[n++].len = 2;
+    return n;
+}
+
+/*****************************************************************************************
+* MenuIdFrags()
+*   Fills the fragments for "<id> <glyph>", up to 5. The id is a single leading digit from
+*   menu_digits if it has an odd number of digits, then digit pairs from menu_pairs.
+*   Returns the count.
+*****************************************************************************************/
+static INT8U MenuIdFrags(BIO_FRAG *frags, INT16U id) {
+    INT8U n = 0;
+    INT8U odd = 1;
+    INT32U div = 1;
+
+    while ((id / div) >= 10u) {
+        div *= 10u;
+        odd ^= 1u;
+    }
+    if (odd != 0) {
+        frags[n].ptr = &menu_digits[(id / div) % 10u];
+        frags[n++].len = 1;
+        div /= 10u;
+    }
+    for (; div != 0; div /= 100u) {
+        frags[n].ptr = &menu_pairs[2u * ((id / (div / 10u)) % 100u)];
+        frags[n++].len = 2;
+    }
+    frags[n].ptr = &menu_digits[10];
+    frags[n++].len = 1;
+    frags[n].ptr = GetSymbol(id);
+    frags[n++].len = MenuSymbolLen(id);
+    return n;
+}
+
+#if APP_CFG_COMPOSE_MAX
+/*****************************************************************************************
+* MenuListSend()
+*   "<label> <id> <glyph> <id> <glyph> ...\r\n", one transfer a symbol so the fragment
+*   list stays MENU_LINE_FRAGS_MAX long
+*****************************************************************************************/
+static void MenuListSend(const INT8C *label, const INT16U *ids, INT8U cnt) {
+    BIO_FRAG frags[MENU_LINE_FRAGS_MAX];
+    INT8U n;
+    INT8U i;
 
-    g_timing_armed = 0;
+    frags[0].ptr = label;
+    frags[0].len = (INT16U)strlen(label);
+    n = 1;
+    for (i = 0; i < cnt; i++) {
+        frags[n].ptr = &menu_digits[10];
+        frags[n++].len = 1;
+        n += MenuIdFrags(&frags[n], ids[i]);
+        MenuSend(frags, n);
+        n = 0;
+    }
+    frags[n].ptr = menu_crlf;
+    frags[n++].len = 2;
+    MenuSend(frags, n);
+}
+#endif
+
+/*****************************************************************************************
+* MenuSend()
+*   Sends menu lines with BIOWriteV(), no copy into the TX ring. Falls back to the
+*   ring if the DMA can't be used from here.
+*****************************************************************************************/
+static void MenuSend(const BIO_FRAG *frags, INT8U nfrags) {
+    INT8U i;
+    INT16U j;
+
+    if (BIOWriteV(frags, nfrags, (BIO_TX_DONE)0, (void *)0) != BIO_WRV_OK) {
+        for (i = 0; i < nfrags; i++) {
+            for (j = 0; j < frags[i].len; j++) {
+                BIOWrite(frags[i].ptr[j]);
+            }
+        }
+    }
 }
+#endif
 
@@ -2,30 +2,111 @@
 #define MENU_H
 
 #include "MCUType.h"   /* For INT8U and INT8C types */
+#include "cpu.h"
+#include "cpu_core.h"  /* For CPU_TS */
+#include "SymCatalog.h" /* Generated symbol table, see catalog/symbols.txt */
 
-/* number of symbols */
-#define SYMBOL_COUNT 5
+/* number of symbols and categories */
+#define SYMBOL_COUNT    SYMCAT_SYM_COUNT
+#define CATEGORY_COUNT  SYMCAT_CAT_COUNT
+
+/* the quick access ring of most used symbols (QuickAccess.h), navigated as a category */
+#define CATEGORY_QUICK  CATEGORY_COUNT
+
+/* symbol index meaning "none" */
+#define SYMBOL_ID_NONE  SYMCAT_ID_NONE
+
+/* Character the receiver sends to ask for the symbol catalog again */
+#define MENU_CMD_CATALOG 'C'
+
+/* Character the receiver sends to ask for the kernel trace (OS_CFG_TRACE_EN) */
+#define MENU_CMD_TRACE 'T'
+
+/* Character the receiver sends to ask for the latency probes (APP_CFG_LAT_PROBE_EN) */
+#define MENU_CMD_LATENCY 'L'
+
+/* Character the receiver sends to sync its clock to CPU_TS (APP_CFG_EV_STAMP_EN) */
+#define MENU_CMD_SYNC 'S'
+
+/* Character the receiver sends to ask for the task profiles (OS_CFG_TASK_PROFILE_EN and OS_CFG_DBG_EN) */
+#define MENU_CMD_PROFILE 'P'
 
 /* redraw full menu UI */
 void UpdateMenu(void);
 
+/* stream the symbol catalog (IDs, glyphs, hash) to the receiver */
+void SendSymbolCatalog(void);
+
+/* stream the kernel trace recorder's ring (CsOS_Trace.h), OS_CFG_TRACE_EN only */
+void SendTrace(void);
+
+/* send count, p50, p99 and max of each latency probe (LatProbe.h), APP_CFG_LAT_PROBE_EN only */
+void SendLatency(void);
+
+/* send the run time profile of every task (OSTaskProfileGet()), OS_CFG_TASK_PROFILE_EN and */
+/* OS_CFG_DBG_EN only */
+void SendTaskProfile(void);
+
+/* stamp the next SYMBOL_IDX, SYMBOL_SENT or SYMBOL_SEQ with the switch event that caused it: the */
+/* first edge and when the menu task took it. APP_CFG_EV_STAMP_EN only */
+void MenuStamp(CPU_TS edge, CPU_TS task);
+
+/* answer a clock sync request that arrived at rx_ts (BIOReadTs()), APP_CFG_EV_STAMP_EN only */
+void SendSync(CPU_TS rx_ts);
+
 /* get current index */
-INT8U GetCurrentSymbolIndex(void);
+INT16U GetCurrentSymbolIndex(void);
 
-/* set current index + redraw */
-void SetCurrentSymbolIndex(INT8U index);
+/* set current index (and its category) + redraw */
+void SetCurrentSymbolIndex(INT16U index);
 
 /* get pointer to current symbol */
 const INT8C* GetCurrentSymbol(void);
 
-/* Set last sent symbol + redraw */
-void SetLastSentSymbol(const INT8C *sym);
+/* get pointer to any symbol, NULL if index is out of range */
+const INT8C* GetSymbol(INT16U index);
+
+/* Set last sent symbol + redraw, SYMBOL_ID_NONE for none. Also ranks it in the quick */
+/* access ring and selects the top of the ring. */
+void SetLastSentSymbol(INT16U index);
+
+/* Composition (APP_CFG_COMPOSE_MAX): symbols are staged in order and committed as one */
+/* SYMBOL_SEQ, which the receiver injects as one string. The menu keeps working meanwhile. */
+/* APP_CFG_COMPOSE_MAX > 0 only */
+
+/* start staging, empty + show it */
+void StartComposing(void);
+
+/* TRUE while staging */
+INT8U IsComposing(void);
+
+/* append a symbol + show it, FALSE if not composing, full or index is out of range */
+INT8U StageSymbol(INT16U index);
+
+/* send the staged symbols as one SYMBOL_SEQ, rank each in the quick access ring and */
+/* stop composing. Nothing is sent if none are staged */
+void CommitComposition(void);
+
+/* stop composing without sending + show it */
+void CancelComposing(void);
+
+/* Category-then-symbol navigation. Each catalog category is a run of consecutive indices, */
+/* CATEGORY_QUICK is the ring. */
+
+/* get current category */
+INT8U GetCurrentCategory(void);
+
+/* select the first symbol of a category + redraw */
+void SetCurrentCategory(INT8U cat);
+
+/* get category name, NULL if cat is out of range */
+const INT8C* GetCategoryName(INT8U cat);
 
-/* Record to start tracking time for an iteration */
-void MenuTiming_Start(void);
+/* move to the next (step > 0) or previous category, wrapping + redraw */
+void StepCategory(INT8S step);
 
-/* Stop tracking time at the end of an iteration */
-void MenuTiming_EndPrint(const INT8C *label);
+/* move to the next (step > 0) or previous symbol in the current category, wrapping + redraw */
+void StepSymbol(INT8S step);
 
 #endif
 
@@ -1,27 +1,132 @@
 # SymbolReceiver.py
 # Live mirror of MCU symbol state with clipboard copy on send
 # UI (two lines, ANSI redraw):
-#   Symbol Library: π [∑] µ Ω ∫
-#   Currently Copied Symbol: —
+#   Greek (1/5): π α [β] γ δ ε ζ η θ ...
+#   Currently Copied Symbol: —            (Composing (2): ∑ µ  while staging)
 
+import argparse  # For the port and --loopback
+import bisect  # For finding a symbol's category
+import collections  # For the clock sync samples
+import selectors  # For waiting on the port without polling
 import serial  # For connection to virtual port
 import sys     # For the terminal UI
 import time    # For recording response times and delaying a loop
-import pyperclip  # For clipboard ctrl+c commands
-import pyautogui # For running ctrl+v commands
+import symbol_inject  # For typing or pasting sent symbols into the focused app
 import subprocess # For debugging
 
 # ========== CONFIG ==========
 PORT = "/dev/cu.usbmodemO0LVP5LSL4VXL3"  # My current board's port
 BAUDRATE = 115200
-TIMEOUT = 0.2
+TIMEOUT = 0.2               # Read timeout where the port can't be waited on (no fileno())
+READ_MAX = 4096             # Most bytes taken per read; everything complete in them is handled
+LINE_MAX = 1024             # A text line longer than this is noise and dropped
+
+# Must match APP_CFG_PROTO_BINARY in the MCU's app_cfg.h
+# False: text lines (readable in any serial terminal, for debugging)
+# True:  COBS framed binary packets (SymProto.h)
+BINARY = False
 
 # ========== TRIGGER PHRASES ==========
 TRIG_IDX = "SYMBOL_IDX:"    # From MCU on startup + every SW2
 TRIG_SEND = "SYMBOL_SENT:"  # From MCU on SW3
-
-# Order MUST match MCU's menu.c for the bracket highlight to align
-SYMBOLS = ["π", "∑", "µ", "Ω", "∫"]
+TRIG_CAT = "SYMBOL_CAT:"    # Catalog header: count and hash
+TRIG_DEF = "SYMBOL_DEF:"    # Catalog entry: id and glyph
+TRIG_GRP = "SYMBOL_GRP:"    # Catalog category: number, first id, count, name
+TRIG_COMP = "SYMBOL_COMP:"  # Composition staged so far: <id> <glyph> ..., "--" when not composing
+TRIG_SEQ = "SYMBOL_SEQ:"    # Composition sent: <id> <glyph> ..., typed in as one string
+
+# Sent to the MCU to ask for the catalog again (MENU_CMD_CATALOG in menu.h)
+CMD_CATALOG = b"C"
+RESYNC_HOLDOFF_S = 1.0      # Don't ask again while a catalog may still be arriving
+
+# Kernel trace, when the MCU is built with OS_CFG_TRACE_EN (os_cfg.h). Dumps are appended
+# to TRACE_FILE for trace2json.py. TRACE_ON_SEND asks for one after every send, which
+# holds the edge to SYMBOL_SENT path of that press.
+TRACE_FILE = "trace.txt"
+TRACE_ON_SEND = False
+TRIG_TRACE = "TRACE_"       # TRACE_BEGIN, TRACE_OBJ, TRACE_EV, TRACE_END
+CMD_TRACE = b"T"            # MENU_CMD_TRACE in menu.h
+
+# Latency probes, when the MCU is built with APP_CFG_LAT_PROBE_EN (app_cfg.h). Every
+# LAT_EVERY_S the MCU is asked for each probe's count and p50/p99/max in us, shown from
+# row LAT_ROW down. 0 never asks.
+LAT_EVERY_S = 10.0
+LAT_ROW = 10
+TRIG_LAT = "LAT_PROBE:"     # LAT_PROBE: <name> <count> <p50> <p99> <max>
+CMD_LATENCY = b"L"          # MENU_CMD_LATENCY in menu.h
+
+# Task profiles, when the MCU is built with OS_CFG_TASK_PROFILE_EN and OS_CFG_DBG_EN
+# (os_cfg.h). Every PROF_EVERY_S the MCU is asked for each task's run time, switches, longest
+# run burst and longest wait from ready to running, shown from row PROF_ROW down with the
+# share of the CPU since the last answer. 0 never asks.
+PROF_EVERY_S = 0.0
+PROF_ROW = 19
+TRIG_PROF = "TASK_PROF"     # TASK_PROF_BEGIN: <count> <ts Hz>, TASK_PROF: <prio> <record hex> <name>
+CMD_PROFILE = b"P"          # MENU_CMD_PROFILE in menu.h
+
+# End-to-end latency, when the MCU is built with APP_CFG_EV_STAMP_EN (app_cfg.h). Each
+# SYMBOL_IDX/SYMBOL_SENT carries CPU_TS stamps (first switch edge, menu task, queued for the
+# UART) and every SYNC_EVERY_S a clock sync maps them onto this machine's clock. Each event's
+# latency is split into debounce, firmware, UART, parse and injection, shown from row E2E_ROW
+# and summed up on exit. E2E_FILE, if set, gets a CSV line per event: kind, edge stamp in
+# hex, then the stages, empty before the first sync (symbol_loadgen.py reads it).
+# SYNC_EVERY_S must stay under half the MCU's timestamp wrap (2.1 s in the host build, 14 s
+# on the board), and so must a latency to be measured.
+SYNC_EVERY_S = 1.0
+SYNC_SAMPLES = 32           # Recent samples kept
+SYNC_TOL_S = 0.5e-3         # Only samples within this of the least round trip delay are fitted
+SYNC_DRIFT_SPAN_S = 10.0    # and only fitted for drift once they span this long
+E2E_ROW = 16
+E2E_FILE = ""
+TRIG_SYNC = "SYNC:"         # SYNC: <rx ts> <tx ts> <ts Hz>
+TRIG_TS = "SYMBOL_TS:"      # SYMBOL_TS: <edge> <task> <tx>, after the line it stamps
+CMD_SYNC = b"S"             # MENU_CMD_SYNC in menu.h
+CHAR_S = 10 / BAUDRATE      # One character on the wire
+
+# Loopback: runs against the host build's pseudo-terminal (HOST_UART_PTY=1, see the README)
+# on Linux, without pasting into the focused app. Also --loopback on the command line.
+LOOPBACK = False
+
+# How sent symbols reach the focused app (symbol_inject.py): "paste" (clipboard and Cmd+V,
+# macOS), "xtest" (X11), "uinput" (Linux, also Wayland), "none", or "auto" for the first of
+# these that works here. Also --inject on the command line.
+INJECT = "auto"
+
+# ========== BINARY PACKETS ==========
+# [type][id lo][id hi][seq][payload][crc16 lo][crc16 hi], COBS encoded, 0x00 delimited
+PKT_IDX = 0x01      # id: selected symbol index
+PKT_SENT = 0x02     # id: sent symbol index, PKT_ID_NONE if none
+PKT_LAT = 0x03      # id: latency probe, payload: 32-bit count, p50, p99, max in us, name
+PKT_CAT = 0x04      # id: symbol count, payload: 32-bit catalog hash
+PKT_DEF = 0x05      # id: symbol index, payload: UTF-8 glyph
+PKT_GRP = 0x06      # id: category, payload: 16-bit first id, 16-bit count, UTF-8 name
+PKT_TRC_BEGIN = 0x07    # id: trace record count, payload: 32-bit lost, 32-bit timestamp Hz
+PKT_TRC_OBJ = 0x08      # id: trace object, payload: kind, priority, name
+PKT_TRC_EV = 0x09       # id: index of the first record, payload: up to 3 8-byte records
+PKT_TRC_END = 0x0A      # id: trace record count
+PKT_SYNC = 0x0B         # payload: 32-bit rx ts, tx ts, timestamp Hz
+PKT_COMP = 0x0C         # id: symbols staged, PKT_ID_NONE if not composing, payload: 16-bit ids
+PKT_SEQ = 0x0D          # id: symbol count, payload: stamps or nothing, then 16-bit ids
+PKT_PROF_BEGIN = 0x0E   # id: task count, payload: 32-bit timestamp Hz
+PKT_PROF_TASK = 0x0F    # id: task priority, payload: PKT_PROF_LEN byte record
+PKT_STAMP_LEN = 12      # IDX/SENT/SEQ payload: 32-bit edge, task, tx ts
+PKT_PROF_LEN = 24       # PROF_TASK payload: 64-bit ts counts run, 32-bit switches in, out,
+                        # longest burst and longest ready to running in ts counts
+PKT_ID_NONE = 0xFFFF
+PKT_MIN_LEN = 6     # type, id, seq, crc16
+
+# Events handed to the main loop by either decoder
+EV_IDX = "idx"
+EV_SEND = "send"
+EV_CAT = "cat"
+EV_DEF = "def"
+EV_GRP = "grp"
+EV_COMP = "comp"    # Staged ids, None when not composing
+EV_SEQ = "seq"      # Sent ids
+EV_TS = "ts"        # Stamps of the IDX, SENT or SEQ just before it
+
+# Symbols shown around the selection on the library line
+UI_WINDOW = 15
 
 # Debug prints. Displays the following:
 # Frontmost app 
@@ -39,42 +144,447 @@ def clear_screen():
     sys.stdout.write("\033[2J\033[H")
     sys.stdout.flush()
 
-def draw_ui(selected_symbol: str | None, last_sent: str | None):
+def draw_ui(catalog, sel_idx: int, last_sent: str | None, composing: list[str] | None = None):
     # Redraw the 2-line UI without scrolling
-    # Line 1: Symbol Library with brackets around the selected one
+    # Line 1: the selected symbol's category, with brackets around the selected one.
+    # Large categories only show the UI_WINDOW symbols around the selection.
     sys.stdout.write("\033[1;1H")  # Move to row 1, col 1
     sys.stdout.write("\033[K")     # Clear to end of line
-    sys.stdout.write("Symbol Library: ")
-
-    try:
-        sel_idx = SYMBOLS.index(selected_symbol) if selected_symbol else -1
-    except ValueError:
-        sel_idx = -1
 
-    for i, sym in enumerate(SYMBOLS):
+    cat = catalog.category_of(sel_idx)
+    if cat is None:
+        first, count = 0, len(catalog.glyphs)
+        sys.stdout.write("Symbol Library: ")
+    else:
+        first, count, name = catalog.groups[cat]
+        sys.stdout.write(f"{name} ({cat + 1}/{len(catalog.groups)}): ")
+
+    lo = max(first, min(sel_idx - UI_WINDOW // 2, first + count - UI_WINDOW))
+    hi = min(first + count, lo + UI_WINDOW)
+    if lo > first:
+        sys.stdout.write("… ")
+    for i in range(lo, hi):
+        sym = catalog.glyphs[i]
         if i == sel_idx:
             sys.stdout.write(f"[{sym}] ")
         else:
             sys.stdout.write(f"{sym} ")
+    if hi < first + count:
+        sys.stdout.write("…")
 
-    # Line 2: Currently Copied Symbol
+    # Line 2: Currently Copied Symbol, or what is staged while composing
     sys.stdout.write("\n\033[K")
-    sys.stdout.write("Currently Copied Symbol: ")
-    sys.stdout.write(last_sent if last_sent else "—")
+    if composing is not None:
+        sys.stdout.write(f"Composing ({len(composing)}): " + " ".join(composing))
+    else:
+        sys.stdout.write("Currently Copied Symbol: ")
+        sys.stdout.write(last_sent if last_sent else "—")
     sys.stdout.write("\033[K")
     sys.stdout.flush()
 
-def extract_symbol(line: str) -> str | None:
-    # Return the first non-empty token after the colon
+def extract_fields(line: str) -> list[str]:
+    # Whitespace separated tokens after the colon
     try:
-        rhs = line.split(":", 1)[1].strip()
-        return rhs.split()[0] if rhs else None
+        return line.split(":", 1)[1].split()
     except Exception:
+        return []
+
+def extract_id(line: str) -> int | None:
+    # "<label>: <id> <glyph>" -> id, "<label>: --" -> PKT_ID_NONE
+    fields = extract_fields(line)
+    if not fields:
+        return None
+    if fields[0] == "--":
+        return PKT_ID_NONE
+    try:
+        return int(fields[0])
+    except ValueError:
         return None
+
+def extract_ids(line: str) -> list[int] | None:
+    # "<label>: <id> <glyph> <id> <glyph> ..." -> ids, "<label>: --" -> None
+    fields = extract_fields(line)
+    if fields[:1] == ["--"]:
+        return None
+    try:
+        return [int(f) for f in fields[0::2]]
+    except ValueError:
+        return None
+
+def ids_of(payload: bytes) -> list[int]:
+    # 16-bit little endian ids
+    return [int.from_bytes(payload[i:i + 2], "little") for i in range(0, len(payload) - 1, 2)]
     
 def clipboard_copy_mac(text: str):
     subprocess.run("pbcopy", input=text, text=True, check=False)
 
+# ========== TEXT DECODER ==========
+class LineReader:
+    # Text counterpart of PacketReader: a line cut between two reads waits for its end,
+    # however long that takes, and every complete line in a read comes back at once.
+    # A run of LINE_MAX bytes without a newline is dropped and counted.
+    def __init__(self):
+        self.pending = bytearray()
+        self.dropped = 0
+
+    def lines(self, data: bytes) -> list[bytes]:
+        self.pending += data
+        end = self.pending.rfind(b"\n")
+        if end < 0:
+            if len(self.pending) > LINE_MAX:
+                self.pending.clear()
+                self.dropped += 1
+            return []
+        done = bytes(self.pending[:end + 1])
+        del self.pending[:end + 1]
+        return done.splitlines(keepends=True)
+
+# ========== BINARY DECODER ==========
+def crc16_ccitt(data: bytes) -> int:
+    # CRC-16/CCITT-FALSE, same as SymProtoCrc16() on the MCU
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+def cobs_decode(frame: bytes) -> bytes | None:
+    # Undo COBS stuffing of one frame (delimiter already removed)
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            return None
+        out += frame[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+class PacketReader:
+    # Splits the byte stream on 0x00 and checks each packet.
+    # Counts bad frames (COBS/length/CRC) and packets lost to sequence gaps.
+    def __init__(self):
+        self.pending = bytearray()
+        self.next_seq = None
+        self.lost = 0
+        self.bad = 0
+
+    def packets(self, data: bytes):
+        self.pending += data
+        while True:
+            end = self.pending.find(0)
+            if end < 0:
+                return
+            frame = bytes(self.pending[:end])
+            del self.pending[:end + 1]
+            if not frame:
+                continue
+            pkt = cobs_decode(frame)
+            if pkt is None or len(pkt) < PKT_MIN_LEN or \
+               crc16_ccitt(pkt[:-2]) != int.from_bytes(pkt[-2:], "little"):
+                self.bad += 1
+                continue
+            seq = pkt[3]
+            if self.next_seq is not None and seq != self.next_seq:
+                self.lost += (seq - self.next_seq) & 0xFF
+            self.next_seq = (seq + 1) & 0xFF
+            yield pkt[0], int.from_bytes(pkt[1:3], "little"), pkt[4:-2]
+
+def trace_line(ptype: int, pid: int, payload: bytes) -> str | None:
+    # Trace packet -> the MCU's text dump line, so trace2json.py reads either mode
+    if ptype == PKT_TRC_BEGIN and len(payload) == 8:
+        return f"TRACE_BEGIN: {pid} {int.from_bytes(payload[0:4], 'little')} {int.from_bytes(payload[4:8], 'little')}"
+    if ptype == PKT_TRC_OBJ and len(payload) >= 2:
+        return f"TRACE_OBJ: {pid} {chr(payload[0])} {payload[1]} {payload[2:].decode('utf-8', errors='replace')}"
+    if ptype == PKT_TRC_EV:
+        recs = " ".join(payload[i:i + 8].hex().upper() for i in range(0, len(payload) - 7, 8))
+        return f"TRACE_EV: {pid} {recs}"
+    if ptype == PKT_TRC_END:
+        return f"TRACE_END: {pid}"
+    return None
+
+def lat_line(pid: int, payload: bytes) -> str | None:
+    # Latency packet -> the MCU's text line
+    if len(payload) < 16:
+        return None
+    count, p50, p99, max_ = (int.from_bytes(payload[i:i + 4], "little") for i in range(0, 16, 4))
+    return f"{TRIG_LAT} {payload[16:].decode('utf-8', errors='replace') or pid} {count} {p50} {p99} {max_}"
+
+def prof_line(ptype: int, pid: int, payload: bytes) -> str | None:
+    # Task profile packet -> the MCU's text line, without the task name
+    if ptype == PKT_PROF_BEGIN and len(payload) == 4:
+        return f"{TRIG_PROF}_BEGIN: {pid} {int.from_bytes(payload, 'little')}"
+    if ptype == PKT_PROF_TASK and len(payload) == PKT_PROF_LEN:
+        return f"{TRIG_PROF}: {pid} {payload.hex().upper()}"
+    return None
+
+# ========== LATENCY PROBES ==========
+class LatencyView:
+    # One row per probe, in the order the MCU sends them
+    def __init__(self):
+        self.rows = {}
+
+    def show(self, line: str):
+        fields = line[len(TRIG_LAT):].split()
+        if len(fields) != 5:
+            return
+        name, count, p50, p99, max_ = fields
+        row = self.rows.setdefault(name, LAT_ROW + len(self.rows))
+        debug_line(row, f"MCU {name:<8} n={count:<6} p50 {p50:>6} us  p99 {p99:>6} us  max {max_:>6} us")
+
+# ========== TASK PROFILES ==========
+class TaskProfileView:
+    # One row per task, by priority. The MCU's counts only grow, so the CPU share is the
+    # difference from the last answer
+    def __init__(self):
+        self.hz = 0
+        self.rows = {}
+        self.prev = {}
+
+    def show(self, line: str):
+        fields = line.split()
+        if line.startswith(f"{TRIG_PROF}_BEGIN:"):
+            if len(fields) == 3 and fields[2].isdigit():
+                self.hz = int(fields[2])
+            return
+        if len(fields) < 3 or not self.hz or len(fields[2]) != 2 * PKT_PROF_LEN:
+            return
+        try:
+            prio, rec = int(fields[1]), bytes.fromhex(fields[2])
+        except ValueError:
+            return
+        name = " ".join(fields[3:]) or f"prio {prio}"
+        run = int.from_bytes(rec[0:8], "little")
+        sw_in, sw_out, burst, wait = (int.from_bytes(rec[i:i + 4], "little") for i in range(8, 24, 4))
+        t = time.monotonic()
+        share = ""
+        if prio in self.prev:
+            run0, t0 = self.prev[prio]
+            if t > t0 and run >= run0:
+                share = f"{100.0 * (run - run0) / self.hz / (t - t0):5.1f}%"
+        self.prev[prio] = (run, t)
+        row = self.rows.setdefault(prio, PROF_ROW + len(self.rows))
+        us = 1e6 / self.hz
+        debug_line(row, f"MCU {prio:>2} {name[:24]:<24} {share:>6} run {run / self.hz:9.3f} s  in/out {sw_in}/{sw_out}"
+                        f"  burst {burst * us:8.0f} us  rdy>run {wait * us:8.0f} us")
+
+# ========== END-TO-END LATENCY ==========
+class ClockSync:
+    # Maps the MCU's 32-bit CPU_TS counts onto time.perf_counter(). A sample is the
+    # request's send time t0, the MCU's receive and reply stamps t1 and t2, and the reply's
+    # arrival t3, with the characters' time on the wire taken off both ends. A reply queued
+    # behind other output has a long round trip and an off-center midpoint, so only samples
+    # close to the least delay count: their mean gives the offset and, once they span
+    # SYNC_DRIFT_SPAN_S, a line through them the drift as well.
+    def __init__(self):
+        self.hz = None
+        self.ref_raw = 0        # Last reply's tx stamp
+        self.ref_s = 0.0        # and its unwrapped MCU time
+        self.samples = collections.deque(maxlen=SYNC_SAMPLES)    # (MCU s, host s, delay s)
+        self.a = 0.0            # host = a + b * MCU
+        self.b = 1.0
+        self.t0 = None          # Request in flight
+        self.last_req = 0.0
+
+    @property
+    def ready(self) -> bool:
+        return bool(self.samples)
+
+    def counts_s(self, d: int) -> float:
+        # Signed difference of two stamps, in seconds
+        d &= 0xFFFFFFFF
+        return (d - (1 << 32) if d >= (1 << 31) else d) / self.hz
+
+    def mcu_s(self, raw: int) -> float:
+        return self.ref_s + self.counts_s(raw - self.ref_raw)
+
+    def to_host(self, raw: int) -> float:
+        return self.a + self.b * self.mcu_s(raw)
+
+    def request(self, ser):
+        self.last_req = time.perf_counter()
+        self.t0 = self.last_req
+        ser.write(CMD_SYNC)
+
+    def reply(self, t3: float, rx: int, tx: int, hz: int, nbytes: int):
+        if self.t0 is None or hz == 0:
+            return
+        t0, self.t0 = self.t0 + CHAR_S, None
+        t3 -= nbytes * CHAR_S
+        # Stamps can only be unwrapped across less than half a wrap
+        reset = self.hz != hz or (self.samples and t3 - self.samples[-1][1] > (1 << 31) / hz)
+        self.hz = hz
+        ref_raw, ref_s = (rx, 0.0) if reset else (self.ref_raw, self.ref_s)
+        t1 = ref_s + self.counts_s(rx - ref_raw)
+        t2 = ref_s + self.counts_s(tx - ref_raw)
+        delay = (t3 - t0) - (t2 - t1)
+        if delay < 0:
+            return              # A late reply to an earlier request
+        if reset:
+            self.samples.clear()
+            self.b = 1.0
+        self.ref_raw, self.ref_s = tx, t2
+        self.samples.append(((t1 + t2) / 2, (t0 + t3) / 2, delay))
+        least = min(smp[2] for smp in self.samples)
+        best = [smp for smp in self.samples if smp[2] <= least + SYNC_TOL_S]
+        mx = sum(smp[0] for smp in best) / len(best)
+        my = sum(smp[1] for smp in best) / len(best)
+        if best[-1][0] - best[0][0] >= SYNC_DRIFT_SPAN_S:
+            var = sum((smp[0] - mx) ** 2 for smp in best)
+            self.b = sum((smp[0] - mx) * (smp[1] - my) for smp in best) / var
+        self.a = my - self.b * mx
+
+    def status(self) -> str:
+        delay = min(smp[2] for smp in self.samples)
+        return (f"Clock sync: {len(self.samples)} samples, drift {(self.b - 1) * 1e6:+.1f} ppm, "
+                f"least round trip {delay * 1e3:.2f} ms")
+
+E2E_STAGES = ("debounce", "firmware", "uart", "parse", "inject", "total")
+
+class EndToEnd:
+    # Pairs each IDX/SENT's host times with the MCU's stamps for it. debounce: first edge to
+    # the menu task, firmware: to the line being queued, uart: to this end reading it, parse:
+    # to its handling starting, inject: typing it in and the redraw of its batch. All in ms.
+    # An event is only done once its batch has been drawn (done()), and its stamps may come
+    # in the same read or a later one, so a row is made by whichever of the two is last.
+    def __init__(self, sync: ClockSync):
+        self.sync = sync
+        self.rows = []
+        self.pending = None         # Last handled event, waiting for its stamps
+        self.batch = []             # Handled events of this read, waiting for the redraw
+        self.csv = open(E2E_FILE, "a", encoding="utf-8", buffering=1) if E2E_FILE else None
+
+    def handled(self, kind: str, t_rx: float, t_start: float):
+        # [kind, t_rx, t_start, t_done, stamps]
+        self.pending = [kind, t_rx, t_start, None, None]
+        self.batch.append(self.pending)
+
+    def stamped(self, edge: int, task: int, tx: int) -> str | None:
+        pending, self.pending = self.pending, None
+        if pending is None:
+            return None
+        pending[4] = (edge, task, tx)
+        return self.row(pending) if pending[3] is not None else None
+
+    def done(self, t_done: float) -> str | None:
+        # The batch has been drawn; rows for the events already stamped, the last one shown
+        shown = None
+        for ev in self.batch:
+            ev[3] = t_done
+            if ev[4] is not None:
+                shown = self.row(ev) or shown
+        self.batch = []
+        return shown
+
+    def row(self, ev: list) -> str | None:
+        kind, t_rx, t_start, t_done, (edge, task, tx) = ev
+        if not self.sync.ready:
+            if self.csv:
+                self.csv.write(f"{kind},{edge:08X}" + "," * len(E2E_STAGES) + "\n")   # Handled, not timed
+            return None
+        sync = self.sync
+        row = (sync.counts_s(task - edge), sync.counts_s(tx - task), t_rx - sync.to_host(tx),
+               t_start - t_rx, t_done - t_start, t_done - sync.to_host(edge))
+        row = tuple(v * 1e3 for v in row)
+        self.rows.append(row)
+        if self.csv:
+            self.csv.write(f"{kind},{edge:08X}," + ",".join(f"{v:.3f}" for v in row) + "\n")
+        return f"{kind}: " + "  ".join(f"{name} {v:.2f}" for name, v in zip(E2E_STAGES, row)) + " ms"
+
+    def report(self) -> str:
+        if not self.rows:
+            return "End to end: no stamped events (APP_CFG_EV_STAMP_EN, clock sync)"
+        out = [f"End to end, {len(self.rows)} events, ms:", f"{'':>10} {'p50':>9} {'p99':>9} {'max':>9}"]
+        for i, name in enumerate(E2E_STAGES):
+            vals = sorted(row[i] for row in self.rows)
+            pick = lambda pct: vals[min(len(vals) - 1, max(0, -(-len(vals) * pct // 100) - 1))]
+            out.append(f"{name:>10} {pick(50):9.3f} {pick(99):9.3f} {vals[-1]:9.3f}")
+        return "\n".join(out)
+
+# ========== KERNEL TRACE ==========
+class TraceCapture:
+    # Collects one dump and appends it to TRACE_FILE once TRACE_END is in
+    def __init__(self):
+        self.lines = None
+        self.saved = 0
+
+    def add(self, line: str) -> bool:
+        # True once a dump has been saved
+        if line.startswith("TRACE_BEGIN"):
+            self.lines = []
+        if self.lines is None:
+            return False
+        self.lines.append(line)
+        if not line.startswith("TRACE_END"):
+            return False
+        with open(TRACE_FILE, "a", encoding="utf-8") as f:
+            f.write("\n".join(self.lines) + "\n")
+        self.lines = None
+        self.saved += 1
+        return True
+
+# ========== SYMBOL CATALOG ==========
+def catalog_hash(glyphs: list[str]) -> int:
+    # 32-bit FNV-1a over id (16-bit LE), length and bytes of every entry (MenuCatalogHash())
+    h = 0x811C9DC5
+    for i, glyph in enumerate(glyphs):
+        data = glyph.encode("utf-8")
+        for b in bytes([i & 0xFF, (i >> 8) & 0xFF, len(data) & 0xFF]) + data:
+            h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+class SymbolCatalog:
+    # ID -> glyph table and categories learned from the MCU's SendSymbolCatalog().
+    # A new table only replaces the current one once all entries are in and the hash matches.
+    def __init__(self):
+        self.glyphs = []
+        self.groups = []            # (first id, count, name), in id order
+        self._pending = None
+        self._pending_groups = []
+        self._missing = 0
+        self._hash = 0
+
+    def begin(self, count: int, hash_: int):
+        self._pending = [None] * count
+        self._pending_groups = []
+        self._missing = count
+        self._hash = hash_
+
+    def group(self, cat: int, first: int, count: int, name: str):
+        # Categories come before the entries; they are not in the hash
+        if self._pending is not None and cat == len(self._pending_groups):
+            self._pending_groups.append((first, count, name))
+
+    def define(self, sym_id: int, glyph: str) -> bool | None:
+        # True: catalog complete and verified, False: mismatch, None: still arriving
+        if self._pending is None or sym_id >= len(self._pending):
+            return False
+        if self._pending[sym_id] is None:
+            self._missing -= 1
+        self._pending[sym_id] = glyph
+        if self._missing > 0:
+            return None
+        pending, self._pending = self._pending, None
+        if catalog_hash(pending) != self._hash:
+            return False
+        self.glyphs = pending
+        self.groups = self._pending_groups
+        return True
+
+    def lookup(self, sym_id: int) -> str | None:
+        return self.glyphs[sym_id] if 0 <= sym_id < len(self.glyphs) else None
+
+    def category_of(self, sym_id: int) -> int | None:
+        # Categories are runs of consecutive ids
+        firsts = [g[0] for g in self.groups]
+        cat = bisect.bisect_right(firsts, sym_id) - 1
+        if cat < 0 or sym_id >= self.groups[cat][0] + self.groups[cat][1]:
+            return None
+        return cat
+
 # ========== DEBUG HELPERS ==========
 def frontmost_app_name() -> str:
     try:
@@ -123,13 +633,21 @@ def timer_record(label: str | None = None):
 
 # ========== MAIN LOOP ==========
 def main():
-    selected_symbol = SYMBOLS[0]  # Assume default at boot
+    try:
+        injector = symbol_inject.open_injector("none" if LOOPBACK else INJECT)
+    except RuntimeError as e:
+        sys.exit(f"symbol_bridge: {e}, --inject none to only mirror the menu")
+    catalog = SymbolCatalog()
+    selected_id = 0  # Assume default at boot
     last_sent_symbol = None
+    composing = None  # Glyphs staged on the MCU, None when not composing
+    last_resync = 0.0
 
     clear_screen()
-    draw_ui(selected_symbol, last_sent_symbol)
+    draw_ui(catalog, selected_id, last_sent_symbol)
 
     last_idx_time = 0.0  # For host-side guard against spurious SEND after IDX
+    e2e = EndToEnd(ClockSync())  # Rows kept across reconnects
 
     while True:
         try:
@@ -137,59 +655,279 @@ def main():
 
             with serial.Serial(PORT, BAUDRATE, timeout=TIMEOUT) as ser:
                 ser.reset_input_buffer()
-
-                debug_line(4, "")  # Clear status line
+                reader = PacketReader()
+                lines = LineReader()
+                trace = TraceCapture()
+                latency = LatencyView()
+                last_lat = time.monotonic()
+                profile = TaskProfileView()
+                last_prof = time.monotonic()
+                sync = e2e.sync = ClockSync()     # The MCU may have restarted
+
+                # Sleep in the selector until the port has data or a request is due, then
+                # take everything it has without blocking. Without a fileno() (Windows),
+                # block in read() for up to TIMEOUT instead.
+                sel = selectors.DefaultSelector()
+                try:
+                    sel.register(ser.fileno(), selectors.EVENT_READ)
+                    ser.timeout = 0
+                except (AttributeError, OSError, ValueError):
+                    sel = None
+
+                def request_catalog(reason: str):
+                    # Unknown ID or hash mismatch: ask the MCU to stream its catalog again
+                    nonlocal last_resync
+                    now = time.monotonic()
+                    if now - last_resync >= RESYNC_HOLDOFF_S:
+                        last_resync = now
+                        ser.write(CMD_CATALOG)
+                        debug_line(4, f"Catalog resync ({reason})")
+
+                # The MCU only sends its catalog at boot, it may have been up for a while
+                request_catalog("connect")
 
                 while True:
-                    line = ser.readline().decode(errors="ignore").strip()
-                    if not line:
-                        continue
-
-                    if DEBUG:
-                        debug_line(6, f"RAW: {repr(line)}")
-                        debug_line(5, f"Frontmost: {frontmost_app_name()}")
-
-                    # ---- SW2 / selection updates ----
-                    if line.startswith(TRIG_IDX):
-                        timer_start()
-                        sym = extract_symbol(line)
-                        if sym:
-                            selected_symbol = sym
-                            draw_ui(selected_symbol, last_sent_symbol)
-                            timer_record("Menu update")
-                        if DEBUG:
-                            debug_line(7, "IDX handled")
-                        continue
-
-                    # ---- SW3 / send events ----
-                    if line.startswith(TRIG_SEND):
-                        timer_start()
-                        sym = extract_symbol(line)
-                        if sym:
-                            if sym == "--":
-                                last_sent_symbol = None
+                    events = []
+
+                    if LAT_EVERY_S and time.monotonic() - last_lat >= LAT_EVERY_S:
+                        last_lat = time.monotonic()
+                        ser.write(CMD_LATENCY)
+
+                    if PROF_EVERY_S and time.monotonic() - last_prof >= PROF_EVERY_S:
+                        last_prof = time.monotonic()
+                        ser.write(CMD_PROFILE)
+
+                    if SYNC_EVERY_S and time.perf_counter() - sync.last_req >= SYNC_EVERY_S:
+                        sync.request(ser)
+
+                    if sel is not None:
+                        due = [t for t in (last_lat + LAT_EVERY_S - time.monotonic() if LAT_EVERY_S else None,
+                                           last_prof + PROF_EVERY_S - time.monotonic() if PROF_EVERY_S else None,
+                                           sync.last_req + SYNC_EVERY_S - time.perf_counter() if SYNC_EVERY_S else None)
+                               if t is not None]
+                        if not sel.select(max(0.0, min(due)) if due else None):
+                            continue
+                        data = ser.read(READ_MAX)
+                    else:
+                        # Everything already received, or wait up to TIMEOUT for one byte
+                        data = ser.read(ser.in_waiting or 1)
+                    t_rx = time.perf_counter()
+
+                    if BINARY:
+                        for ptype, sym_id, payload in reader.packets(data):
+                            if DEBUG:
+                                debug_line(6, f"PKT: type={ptype} id={sym_id} payload={payload.hex()}")
+                            if ptype in (PKT_IDX, PKT_SENT):
+                                events.append((EV_IDX if ptype == PKT_IDX else EV_SEND, sym_id))
+                                if len(payload) == PKT_STAMP_LEN:
+                                    events.append((EV_TS, tuple(int.from_bytes(payload[i:i + 4], "little")
+                                                                for i in range(0, PKT_STAMP_LEN, 4))))
+                            elif ptype == PKT_COMP:
+                                events.append((EV_COMP, None if sym_id == PKT_ID_NONE else ids_of(payload)))
+                            elif ptype == PKT_SEQ:
+                                stamped = len(payload) == 2 * sym_id + PKT_STAMP_LEN
+                                events.append((EV_SEQ, ids_of(payload[PKT_STAMP_LEN:] if stamped else payload)))
+                                if stamped:
+                                    events.append((EV_TS, tuple(int.from_bytes(payload[i:i + 4], "little")
+                                                                for i in range(0, PKT_STAMP_LEN, 4))))
+                            elif ptype == PKT_SYNC and len(payload) == 12:
+                                sync.reply(t_rx, int.from_bytes(payload[0:4], "little"),
+                                           int.from_bytes(payload[4:8], "little"),
+                                           int.from_bytes(payload[8:12], "little"), len(payload) + 8)
+                            elif ptype == PKT_CAT and len(payload) == 4:
+                                events.append((EV_CAT, (sym_id, int.from_bytes(payload, "little"))))
+                            elif ptype == PKT_DEF:
+                                events.append((EV_DEF, (sym_id, payload.decode("utf-8", errors="replace"))))
+                            elif ptype == PKT_GRP and len(payload) >= 4:
+                                events.append((EV_GRP, (sym_id, int.from_bytes(payload[0:2], "little"),
+                                                        int.from_bytes(payload[2:4], "little"),
+                                                        payload[4:].decode("utf-8", errors="replace"))))
+                            elif ptype == PKT_LAT:
+                                lline = lat_line(sym_id, payload)
+                                if lline is not None:
+                                    latency.show(lline)
+                            elif ptype in (PKT_PROF_BEGIN, PKT_PROF_TASK):
+                                pline = prof_line(ptype, sym_id, payload)
+                                if pline is not None:
+                                    profile.show(pline)
+                            elif PKT_TRC_BEGIN <= ptype <= PKT_TRC_END:
+                                tline = trace_line(ptype, sym_id, payload)
+                                if tline is not None and trace.add(tline):
+                                    debug_line(4, f"Trace {trace.saved} saved to {TRACE_FILE}")
+                            elif DEBUG:
+                                debug_line(7, "Unknown packet (ignored)")
+                        if reader.lost or reader.bad:
+                            debug_line(8, f"Lost packets: {reader.lost}  Bad frames: {reader.bad}")
+                    else:
+                        for raw in lines.lines(data):
+                            line = raw.decode(errors="ignore").strip()
+                            if not line:
+                                continue
+
+                            if DEBUG:
+                                debug_line(6, f"RAW: {repr(line)}")
+                                debug_line(5, f"Frontmost: {frontmost_app_name()}")
+
+                            if line.startswith(TRIG_IDX):
+                                events.append((EV_IDX, extract_id(line)))
+                            elif line.startswith(TRIG_SEND):
+                                events.append((EV_SEND, extract_id(line)))
+                            elif line.startswith(TRIG_COMP):
+                                events.append((EV_COMP, extract_ids(line)))
+                            elif line.startswith(TRIG_SEQ):
+                                events.append((EV_SEQ, extract_ids(line) or []))
+                            elif line.startswith((TRIG_CAT, TRIG_DEF, TRIG_GRP)):
+                                fields = extract_fields(line)
+                                try:
+                                    if line.startswith(TRIG_CAT):
+                                        events.append((EV_CAT, (int(fields[0]), int(fields[1], 16))))
+                                    elif line.startswith(TRIG_GRP):
+                                        events.append((EV_GRP, (int(fields[0]), int(fields[1]), int(fields[2]),
+                                                                " ".join(fields[3:]))))
+                                    else:
+                                        events.append((EV_DEF, (int(fields[0]), fields[1])))
+                                except (IndexError, ValueError):
+                                    request_catalog("bad catalog line")
+                            elif line.startswith(TRIG_LAT):
+                                latency.show(line)
+                            elif line.startswith(TRIG_PROF):
+                                profile.show(line)
+                            elif line.startswith((TRIG_SYNC, TRIG_TS)):
+                                fields = extract_fields(line)
+                                try:
+                                    if line.startswith(TRIG_SYNC):
+                                        sync.reply(t_rx, int(fields[0], 16), int(fields[1], 16), int(fields[2]), len(raw))
+                                    else:
+                                        events.append((EV_TS, (int(fields[0], 16), int(fields[1], 16), int(fields[2], 16))))
+                                except (IndexError, ValueError):
+                                    pass
+                            elif line.startswith(TRIG_TRACE):
+                                if trace.add(line):
+                                    debug_line(4, f"Trace {trace.saved} saved to {TRACE_FILE}")
+                            elif DEBUG:
+                                # Unknown message type
+                                debug_line(7, "Unknown message (ignored)")
+                        if DEBUG and lines.dropped:
+                            debug_line(8, f"Dropped lines: {lines.dropped}")
+
+                    # Everything complete in this read is handled before the one redraw
+                    redraw = False
+                    sends = 0
+                    for kind, arg in events:
+                        # ---- Catalog handshake ----
+                        if kind == EV_CAT:
+                            catalog.begin(*arg)
+                            continue
+
+                        if kind == EV_GRP:
+                            catalog.group(*arg)
+                            continue
+
+                        if kind == EV_DEF:
+                            done = catalog.define(*arg)
+                            if done is False:
+                                request_catalog("hash mismatch")
+                            elif done:
+                                debug_line(4, "")
+                                redraw = True
+                            continue
+
+                        # ---- End-to-end stamps of the event just handled ----
+                        if kind == EV_TS:
+                            row = e2e.stamped(*arg)
+                            if row is not None:
+                                debug_line(E2E_ROW, row)
+                                debug_line(E2E_ROW + 1, sync.status())
+                            continue
+
+                        # ---- SW2 / selection updates ----
+                        if kind == EV_IDX:
+                            t_start = time.perf_counter()
+                            if arg is None or catalog.lookup(arg) is None:
+                                request_catalog(f"unknown id {arg}")
                             else:
-                                last_sent_symbol = sym
-
-                            draw_ui(selected_symbol, last_sent_symbol)
-                            t_handle = timer_record("Menu + copy update")   # Any dalay after this point is a hardware issue
-
-                            # OS-dependent step (not counted)
-                            if sym != "--":
+                                if not redraw:
+                                    timer_start()
+                                selected_id = arg
+                                redraw = True
+                                e2e.handled(kind, t_rx, t_start)
+                            if DEBUG:
+                                debug_line(7, "IDX handled")
+                            continue
+
+                        # ---- SW3 / send events ----
+                        if kind == EV_SEND:
+                            t_start = time.perf_counter()
+                            if arg == PKT_ID_NONE:
+                                sym = None
+                            else:
+                                sym = catalog.lookup(arg) if arg is not None else None
+                                if sym is None:
+                                    request_catalog(f"unknown id {arg}")
+                                    continue
+
+                            if not redraw:
+                                timer_start()
+                            last_sent_symbol = sym
+                            redraw = True
+                            sends += 1
+
+                            # OS-dependent step, not in the menu timing but in the end-to-end inject.
+                            # Every send is injected, only the last one is shown.
+                            if sym is not None:
                                 try:
-                                    pyperclip.copy(sym)
-                                    pyautogui.hotkey("command", "v")
+                                    injector.type(sym)
                                 except Exception:
                                     pass
-                        continue
-
-
-                    # Unknown message type
-                    if DEBUG:
-                        debug_line(7, "Unknown message (ignored)")
+                            e2e.handled(kind, t_rx, t_start)
+                            continue
+
+                        # ---- Composition: staged, then sent as one string ----
+                        if kind == EV_COMP:
+                            glyphs = None if arg is None else [catalog.lookup(i) for i in arg]
+                            if glyphs is not None and None in glyphs:
+                                request_catalog("unknown id in composition")
+                                continue
+                            composing = glyphs
+                            redraw = True
+                            continue
+
+                        if kind == EV_SEQ:
+                            t_start = time.perf_counter()
+                            glyphs = [catalog.lookup(i) for i in arg]
+                            if not glyphs or None in glyphs:
+                                request_catalog("unknown id in sequence")
+                                continue
+
+                            if not redraw:
+                                timer_start()
+                            last_sent_symbol = "".join(glyphs)
+                            composing = None
+                            redraw = True
+                            sends += 1
+
+                            # One injection for the whole sequence
+                            try:
+                                injector.type(last_sent_symbol)
+                            except Exception:
+                                pass
+                            e2e.handled(kind, t_rx, t_start)
+
+                    if redraw:
+                        draw_ui(catalog, selected_id, last_sent_symbol, composing)
+                        timer_record(f"Menu update ({len(events)} messages)")  # Any dalay after this point is a hardware issue
+                    row = e2e.done(time.perf_counter())
+                    if row is not None:
+                        debug_line(E2E_ROW, row)
+                        debug_line(E2E_ROW + 1, sync.status())
+
+                    if TRACE_ON_SEND and sends:
+                        ser.write(CMD_TRACE)
 
         except KeyboardInterrupt:
+            injector.close()
             sys.stdout.write("\nExiting.\n")
+            sys.stdout.write(e2e.report() + "\n")
             return
 
         except serial.SerialException:
@@ -205,4 +943,21 @@ def main():
                 time.sleep(1)
 
 if __name__ == "__main__":
+    ap = argparse.ArgumentParser(description="Mirror the MCU's symbol menu and type sent symbols into the focused app")
+    ap.add_argument("port", nargs="?", default=PORT, help=f"serial port, default {PORT}")
+    ap.add_argument("--loopback", action="store_true",
+                    help="same as --inject none, for the host build's pseudo-terminal")
+    ap.add_argument("--inject", choices=("auto",) + tuple(symbol_inject.BACKENDS), default=INJECT,
+                    help=f"how sent symbols are typed into the focused app, default {INJECT}")
+    ap.add_argument("--binary", action="store_true", help="COBS framed packets, as BINARY = True")
+    ap.add_argument("--baud", type=int, default=BAUDRATE, help=f"bit rate, default {BAUDRATE}")
+    ap.add_argument("--e2e-file", default=E2E_FILE, help="append end-to-end rows to this CSV")
+    args = ap.parse_args()
+    PORT = args.port
+    LOOPBACK = args.loopback or LOOPBACK
+    INJECT = args.inject
+    BINARY = args.binary or BINARY
+    BAUDRATE = args.baud
+    CHAR_S = 10 / BAUDRATE
+    E2E_FILE = args.e2e_file
     main()
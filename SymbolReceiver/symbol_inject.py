@@ -0,0 +1,353 @@
+# symbol_inject.py
+# Ways for symbol_bridge.py to put a sent symbol into the focused app. A backend is opened
+# once and keeps its handle (X connection, uinput device), so a symbol costs no process
+# spawn:
+#   paste   copy to the clipboard and press Cmd+V (macOS) or Ctrl+V. Replaces the user's
+#           clipboard, and pyautogui sleeps pyautogui.PAUSE (0.1 s) after the keys.
+#   xtest   X11, and X apps under XWayland: every codepoint is one key press through the
+#           XTEST extension, on a spare keycode remapped to its keysym if the layout lacks it.
+#   uinput  Linux virtual keyboard, any session including Wayland: Ctrl+Shift+U, the hex
+#           codepoint and Space, which GTK and IBus take as Unicode entry. Needs write access
+#           to /dev/uinput and a layout with the hex digits where US QWERTY has them.
+#   none    nothing, for --loopback
+#
+# Run on its own it benchmarks every backend that opens, typing catalog symbols into a
+# window of its own and timing each one until its key events reach that window:
+#
+#   xvfb-run -s "-screen 0 640x480x24" python3 symbol_inject.py -n 500
+#   python3 symbol_inject.py --backends xtest,xdotool       # on the current $DISPLAY
+#
+# xdotool (one `xdotool type` process per symbol) is timed as well when it is installed,
+# as the cost of spawning per event. uinput events don't reach Xvfb, which reads no input
+# devices, so only its write is timed.
+
+import argparse
+import os
+import struct
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+# ========== PASTE ==========
+class PasteInjector:
+    name = "paste"
+
+    def __init__(self):
+        import pyperclip  # For clipboard ctrl+c commands
+        import pyautogui  # For running ctrl+v commands
+        self.pyperclip = pyperclip
+        self.pyautogui = pyautogui
+        self.mod = "command" if sys.platform == "darwin" else "ctrl"
+
+    def type(self, text: str):
+        self.pyperclip.copy(text)
+        self.pyautogui.hotkey(self.mod, "v")
+
+    def close(self):
+        pass
+
+# ========== XTEST ==========
+def keysym_of(ch: str) -> int:
+    # X keysym of one codepoint: Latin-1 is its own keysym, the rest 0x01000000 + codepoint
+    cp = ord(ch)
+    if ch == "\n":
+        return 0xFF0D           # XK_Return
+    if ch == "\t":
+        return 0xFF09           # XK_Tab
+    if 0x20 <= cp <= 0x7E or 0xA0 <= cp <= 0xFF:
+        return cp
+    return 0x01000000 | cp
+
+class XTestInjector:
+    name = "xtest"
+
+    def __init__(self, display: str | None = None):
+        from Xlib import X, XK, display as xdisplay
+        from Xlib.ext import xtest
+        self.X = X
+        self.xtest = xtest
+        self.d = xdisplay.Display(display)
+        if not self.d.has_extension("XTEST"):
+            self.d.close()
+            raise RuntimeError("X server has no XTEST extension")
+        lo = self.d.display.info.min_keycode
+        hi = self.d.display.info.max_keycode
+        keymap = self.d.get_keyboard_mapping(lo, hi - lo + 1)
+        # Keycodes with nothing on them, lent out least recently used first. A symbol's
+        # codepoints get different ones, so an app that reads the mapping late (on the
+        # MappingNotify of an earlier remap) still sees each key as it was sent.
+        self.spare = [lo + i for i, syms in enumerate(keymap) if not any(syms)]
+        if not self.spare:
+            self.d.close()
+            raise RuntimeError("no spare keycode to remap")
+        self.lent = {}          # keysym -> spare keycode
+        self.shift = self.d.keysym_to_keycode(XK.XK_Shift_L)
+
+    def key_for(self, keysym: int) -> tuple[int, bool]:
+        # (keycode, needs Shift). Spare keycodes are only found through self.lent, the
+        # cached keymap may not have caught up with a remap yet.
+        kc = self.lent.get(keysym)
+        if kc is None:
+            for kc, index in self.d.keysym_to_keycodes(keysym):
+                if kc not in self.spare and (index == 0 or (index == 1 and self.shift)):
+                    return kc, index == 1
+            kc = self.spare[0]
+            self.lent = {sym: k for sym, k in self.lent.items() if k != kc}
+            self.lent[keysym] = kc
+            self.d.change_keyboard_mapping(kc, [(keysym, keysym)])
+        self.spare.remove(kc)
+        self.spare.append(kc)   # Most recently used last
+        return kc, False
+
+    def type(self, text: str):
+        # Take in our own MappingNotify events, so keysym_to_keycodes() knows the remaps
+        while self.d.pending_events():
+            ev = self.d.next_event()
+            if ev.type == self.X.MappingNotify:
+                self.d.refresh_keyboard_mapping(ev)
+        for ch in text:
+            kc, shift = self.key_for(keysym_of(ch))
+            if shift:
+                self.xtest.fake_input(self.d, self.X.KeyPress, self.shift)
+            self.xtest.fake_input(self.d, self.X.KeyPress, kc)
+            self.xtest.fake_input(self.d, self.X.KeyRelease, kc)
+            if shift:
+                self.xtest.fake_input(self.d, self.X.KeyRelease, self.shift)
+        self.d.flush()          # One write for the whole symbol
+
+    def close(self):
+        for kc in self.lent.values():
+            self.d.change_keyboard_mapping(kc, [(0, 0)])
+        self.d.close()
+
+# ========== UINPUT ==========
+UI_SET_EVBIT = 0x40045564   # _IOW('U', 100, int)
+UI_SET_KEYBIT = 0x40045565  # _IOW('U', 101, int)
+UI_DEV_CREATE = 0x5501      # _IO('U', 1)
+UI_DEV_DESTROY = 0x5502     # _IO('U', 2)
+EV_SYN = 0
+EV_KEY = 1
+KEY_LEFTCTRL = 29
+KEY_LEFTSHIFT = 42
+KEY_U = 22
+KEY_SPACE = 57
+KEY_HEX = (11, 2, 3, 4, 5, 6, 7, 8, 9, 10, 30, 48, 46, 32, 18, 33)     # 0-9, a-f
+INPUT_EVENT = struct.Struct("llHHi")        # struct input_event: timeval, type, code, value
+UINPUT_USER_DEV = struct.Struct("80s4HI256i")   # name, input_id, ff_effects_max, abs axes
+
+class UinputInjector:
+    name = "uinput"
+    SETTLE_S = 0.5          # For the session to pick up the new device before the first symbol
+
+    def __init__(self, path: str = "/dev/uinput"):
+        import fcntl
+        self.fcntl = fcntl
+        self.fd = os.open(path, os.O_WRONLY | os.O_NONBLOCK)
+        try:
+            fcntl.ioctl(self.fd, UI_SET_EVBIT, EV_KEY)
+            for key in (KEY_LEFTCTRL, KEY_LEFTSHIFT, KEY_U, KEY_SPACE) + KEY_HEX:
+                fcntl.ioctl(self.fd, UI_SET_KEYBIT, key)
+            os.write(self.fd, UINPUT_USER_DEV.pack(b"symbol_bridge", 0x06, 0x1209, 0x5359, 1, 0, *([0] * 256)))
+            fcntl.ioctl(self.fd, UI_DEV_CREATE)
+        except OSError:
+            os.close(self.fd)
+            raise
+        time.sleep(self.SETTLE_S)
+
+    @staticmethod
+    def events(text: str) -> bytes:
+        # Key events for the whole text; the kernel stamps them as they are written
+        out = bytearray()
+
+        def key(code: int, value: int):
+            out.extend(INPUT_EVENT.pack(0, 0, EV_KEY, code, value))
+            out.extend(INPUT_EVENT.pack(0, 0, EV_SYN, 0, 0))
+
+        for ch in text:
+            key(KEY_LEFTCTRL, 1)
+            key(KEY_LEFTSHIFT, 1)
+            key(KEY_U, 1)
+            key(KEY_U, 0)
+            key(KEY_LEFTSHIFT, 0)
+            key(KEY_LEFTCTRL, 0)
+            for digit in f"{ord(ch):x}":
+                key(KEY_HEX[int(digit, 16)], 1)
+                key(KEY_HEX[int(digit, 16)], 0)
+            key(KEY_SPACE, 1)
+            key(KEY_SPACE, 0)
+        return bytes(out)
+
+    def type(self, text: str):
+        os.write(self.fd, self.events(text))
+
+    def close(self):
+        self.fcntl.ioctl(self.fd, UI_DEV_DESTROY)
+        os.close(self.fd)
+
+# ========== NONE ==========
+class NullInjector:
+    name = "none"
+
+    def type(self, text: str):
+        pass
+
+    def close(self):
+        pass
+
+# ========== SELECTION ==========
+BACKENDS = {"paste": PasteInjector, "xtest": XTestInjector, "uinput": UinputInjector, "none": NullInjector}
+
+def open_injector(name: str = "auto"):
+    # The named backend, or for "auto" the first that opens: paste on macOS; xtest with an
+    # X display, then uinput, then paste elsewhere
+    if name != "auto":
+        try:
+            return BACKENDS[name]()
+        except Exception as e:
+            raise RuntimeError(f"{name}: {e}") from e
+    if sys.platform == "darwin":
+        order = ["paste"]
+    else:
+        order = (["xtest"] if os.environ.get("DISPLAY") else []) + ["uinput", "paste"]
+    errors = []
+    for n in order:
+        try:
+            return BACKENDS[n]()
+        except Exception as e:
+            errors.append(f"{n}: {e}")
+    raise RuntimeError("no way to inject symbols (" + "; ".join(errors) + ")")
+
+# ========== BENCHMARK ==========
+class XdotoolInjector:
+    # Not a backend: a process per symbol, what the others avoid
+    name = "xdotool"
+
+    def __init__(self):
+        import shutil
+        import subprocess
+        if not shutil.which("xdotool"):
+            raise RuntimeError("xdotool not installed")
+        self.subprocess = subprocess
+
+    def type(self, text: str):
+        self.subprocess.run(["xdotool", "type", "--delay", "0", "--", text], check=False)
+
+    def close(self):
+        pass
+
+class Target:
+    # A focused window on its own connection, decoding the key events it gets
+    def __init__(self, display: str | None):
+        from Xlib import X, display as xdisplay
+        self.X = X
+        self.d = xdisplay.Display(display)
+        screen = self.d.screen()
+        self.win = screen.root.create_window(0, 0, 320, 80, 0, screen.root_depth,
+                                             event_mask=X.KeyPressMask | X.KeyReleaseMask | X.StructureNotifyMask)
+        self.win.map()
+        while self.d.next_event().type != X.MapNotify:
+            pass
+        self.win.set_input_focus(X.RevertToParent, X.CurrentTime)
+        self.d.sync()
+        self.modifiers = {kc for mod in self.d.get_modifier_mapping() for kc in mod if kc}
+
+    def drain(self):
+        while self.d.pending_events():
+            self.take(self.d.next_event())
+
+    def take(self, ev) -> str | None:
+        # The character of a key release, None for anything else
+        if ev.type == self.X.MappingNotify:
+            self.d.refresh_keyboard_mapping(ev)
+            return None
+        if ev.type != self.X.KeyRelease or ev.detail in self.modifiers:
+            return None
+        sym = self.d.keycode_to_keysym(ev.detail, 1 if ev.state & self.X.ShiftMask else 0)
+        if sym == 0xFF0D:
+            return "\n"
+        if sym == 0xFF09:
+            return "\t"
+        if sym & 0xFF000000 == 0x01000000:
+            return chr(sym & 0xFFFFFF)
+        return chr(sym) if sym < 0x100 else "?"
+
+    def wait(self, count: int, timeout: float) -> str | None:
+        # The next count characters, None if they don't all come in time
+        import select
+        got = ""
+        end = time.perf_counter() + timeout
+        while len(got) < count:
+            if not self.d.pending_events():
+                left = end - time.perf_counter()
+                if left <= 0 or not select.select([self.d.fileno()], [], [], left)[0]:
+                    return None
+            ch = self.take(self.d.next_event())
+            if ch is not None:
+                got += ch
+        return got
+
+def pct(vals: list[float], p: float) -> float:
+    # Nearest rank
+    vals = sorted(vals)
+    return vals[min(len(vals) - 1, max(0, -(-len(vals) * p // 100) - 1))] if vals else 0.0
+
+def bench(inj, target: Target | None, glyphs: list[str], n: int) -> str:
+    # Per symbol: the call, and with a target until its last key release arrives
+    calls = []
+    arrived = []
+    wrong = 0
+    lost = 0
+    for i in range(n):
+        sym = glyphs[i % len(glyphs)]
+        if target:
+            target.drain()
+        t0 = time.perf_counter()
+        inj.type(sym)
+        calls.append((time.perf_counter() - t0) * 1e3)
+        if target is None:
+            continue
+        # A paste is one Ctrl+V, anything else one key per codepoint
+        got = target.wait(1 if inj.name == "paste" else len(sym), 1.0)
+        if got is None:
+            lost += 1
+            continue
+        arrived.append((time.perf_counter() - t0) * 1e3)
+        if inj.name != "paste" and got != sym:
+            wrong += 1
+    line = f"{inj.name:>8} call p50 {pct(calls, 50):8.3f} p99 {pct(calls, 99):8.3f} ms"
+    if target is None:
+        return line + "   (not received by the X server)"
+    return line + (f"   arrived p50 {pct(arrived, 50):8.3f} p99 {pct(arrived, 99):8.3f} ms"
+                   f"   {wrong} wrong, {lost} lost of {n}")
+
+def main():
+    ap = argparse.ArgumentParser(description="Per-symbol latency of each injection backend")
+    ap.add_argument("-n", type=int, default=200, help="symbols per backend, default 200")
+    ap.add_argument("--backends", default="xtest,xdotool,paste,uinput", help="comma separated, in this order")
+    ap.add_argument("--display", help="X display, default $DISPLAY")
+    args = ap.parse_args()
+
+    sys.path.insert(0, os.path.join(HERE, "..", "SymbolEntry", "catalog"))
+    import symcat_gen  # For the symbols the MCU would send
+    glyphs = [g for _, g in symcat_gen.read_text(symcat_gen.DEF_SRC)]
+
+    target = Target(args.display) if args.display or os.environ.get("DISPLAY") else None
+    extra = {"xdotool": XdotoolInjector}
+    print(f"symbol_inject: {args.n} symbols each, {len(glyphs)} in the catalog")
+    for name in args.backends.split(","):
+        try:
+            if name == "xtest":
+                inj = XTestInjector(args.display)
+            else:
+                inj = extra.get(name, BACKENDS.get(name))()
+        except Exception as e:
+            print(f"{name:>8} not available: {e}")
+            continue
+        try:
+            print(bench(inj, target if name != "uinput" else None, glyphs, args.n))
+        finally:
+            inj.close()
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,460 @@
+# symbol_loadgen.py
+# Load generator for symbol_bridge.py. Plays the MCU on a pseudo-terminal (Linux): streams
+# the catalog, answers the receiver's catalog and clock sync requests, and sends stamped
+# SYMBOL_IDX/SYMBOL_SENT events at a set rate, in bursts, with injected errors. The
+# bridge runs on the other end with --loopback and writes its end-to-end rows to a CSV,
+# from which this prints throughput, dropped events, latency percentiles and the bridge's
+# CPU time per event.
+#
+#   python3 symbol_loadgen.py --rate 200 --duration 10 --garbage 0.05 --split 0.1
+#   python3 symbol_loadgen.py --rate 200 --save baseline.json       # record a baseline
+#   python3 symbol_loadgen.py --rate 200 --baseline baseline.json   # exit 1 on a regression
+#
+# Framing is the MCU's (menu.c, SymProto.c): text lines with a SYMBOL_TS line after each
+# event, or COBS packets with the stamps as payload (--binary). Stamps are this machine's
+# clock in us, 32 bits; the bridge takes the rate from the sync reply. Bytes go out at
+# --baud like the board's UART; --flood writes them as fast as the bridge reads and shifts
+# the sync stamps by the wire time the bridge allows for, so its clock sync still holds.
+# An event's latency runs from when it was scheduled, so a bridge that falls behind is
+# charged for the backlog.
+#
+# Error injection, each a probability per event:
+#   --garbage  a line of random bytes (a bad frame in binary mode) before the event
+#   --split    the event written in two parts, --split-ms apart
+#   --partial  text: the glyph cut mid UTF-8 sequence; binary: the frame cut short. Cut
+#              frames are expected to be lost and are not counted as drops.
+
+import argparse
+import json
+import os
+import random
+import select
+import signal
+import subprocess
+import sys
+import time
+import tty
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(HERE, "..", "SymbolEntry", "catalog"))
+import symcat_gen  # noqa: E402  For the catalog and its hash, as the MCU build has them
+
+# ========== PROTOCOL (menu.h, SymProto.h) ==========
+CMD_CATALOG = b"C"
+CMD_SYNC = b"S"
+PKT_IDX = 0x01
+PKT_SENT = 0x02
+PKT_CAT = 0x04
+PKT_DEF = 0x05
+PKT_GRP = 0x06
+PKT_SYNC = 0x0B
+ID_NONE = 0xFFFF
+TS_HZ = 1_000_000   # us: a backlog of seconds stays well inside half the 32-bit wrap
+
+def ts(t: float) -> int:
+    return int(t * TS_HZ) & 0xFFFFFFFF
+
+def ts_now() -> int:
+    return ts(time.perf_counter())
+
+def crc16_ccitt(data: bytes) -> int:
+    # CRC-16/CCITT-FALSE, SymProtoCrc16()
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+def cobs_encode(data: bytes) -> bytes:
+    # SymProtoCobsEncode(), without the delimiter
+    out = bytearray([0])
+    code_at = 0
+    for b in data:
+        if b:
+            out.append(b)
+        if not b or len(out) - code_at == 0xFF:
+            out[code_at] = len(out) - code_at
+            code_at = len(out)
+            out.append(0)
+    out[code_at] = len(out) - code_at
+    return bytes(out)
+
+class Mcu:
+    # Encodes what the MCU would send, in either framing
+    def __init__(self, binary: bool, glyphs: list[str], cats: list[str], cat_first: list[int]):
+        self.binary = binary
+        self.glyphs = glyphs
+        self.cats = cats
+        self.cat_first = cat_first
+        self.seq = 0
+
+    def packet(self, ptype: int, pid: int, payload: bytes = b"") -> bytes:
+        pkt = bytes([ptype, pid & 0xFF, pid >> 8, self.seq]) + payload
+        self.seq = (self.seq + 1) & 0xFF
+        pkt += crc16_ccitt(pkt).to_bytes(2, "little")
+        return cobs_encode(pkt) + b"\0"
+
+    def catalog(self) -> list[bytes]:
+        # SendSymbolCatalog() then UpdateMenu()
+        h = symcat_gen.catalog_hash(self.glyphs)
+        out = []
+        if self.binary:
+            out.append(self.packet(PKT_CAT, len(self.glyphs), h.to_bytes(4, "little")))
+            for c, name in enumerate(self.cats):
+                first, cnt = self.cat_first[c], self.cat_first[c + 1] - self.cat_first[c]
+                out.append(self.packet(PKT_GRP, c, first.to_bytes(2, "little") + cnt.to_bytes(2, "little") +
+                                       name.encode("utf-8")[:20]))
+            out += [self.packet(PKT_DEF, i, g.encode("utf-8")) for i, g in enumerate(self.glyphs)]
+        else:
+            out.append(f"SYMBOL_CAT: {len(self.glyphs):<6}{h:08X}\r\n".encode())
+            for c, name in enumerate(self.cats):
+                first, cnt = self.cat_first[c], self.cat_first[c + 1] - self.cat_first[c]
+                out.append(f"SYMBOL_GRP: {c:<4}{first:<6}{cnt:<6}{name}\r\n".encode())
+            out += [f"SYMBOL_DEF: {i:<6}{g}\r\n".encode() for i, g in enumerate(self.glyphs)]
+        out += [self.event(PKT_IDX, 0, None), self.event(PKT_SENT, ID_NONE, None)]
+        return out
+
+    def event(self, ptype: int, sym_id: int, stamps: tuple[int, int, int] | None, partial: bool = False) -> bytes:
+        # MenuEvent()
+        if self.binary:
+            pl = b"".join(v.to_bytes(4, "little") for v in stamps) if stamps else b""
+            frame = self.packet(ptype, sym_id, pl)
+            return frame[:len(frame) // 2] + b"\0" if partial else frame
+        label = "SYMBOL_IDX: " if ptype == PKT_IDX else "SYMBOL_SENT: "
+        if sym_id == ID_NONE:
+            line = f"{label}--\r\n".encode()
+        else:
+            glyph = self.glyphs[sym_id].encode("utf-8")
+            if partial and len(glyph) > 1:
+                glyph = glyph[:random.randrange(1, len(glyph))]
+            line = f"{label}{sym_id} ".encode() + glyph + b"\r\n"
+        if stamps:
+            line += ("SYMBOL_TS: " + " ".join(f"{v:08X}" for v in stamps) + "\r\n").encode()
+        return line
+
+    def sync(self, rx: int, tx: int) -> bytes:
+        # SendSync()
+        if self.binary:
+            return self.packet(PKT_SYNC, 0, rx.to_bytes(4, "little") + tx.to_bytes(4, "little") +
+                               TS_HZ.to_bytes(4, "little"))
+        return f"SYNC: {rx:08X} {tx:08X} {TS_HZ}\r\n".encode()
+
+    def garbage(self) -> bytes:
+        junk = bytes(random.randrange(1, 256) for _ in range(random.randrange(1, 40)))
+        if self.binary:
+            return junk + b"\0"
+        return junk.replace(b"\n", b"?") + b"\r\n"
+
+# ========== LOAD RUN ==========
+class Event:
+    def __init__(self, n: int, ptype: int, sym_id: int, t_sched: float):
+        self.n = n
+        self.ptype = ptype
+        self.sym_id = sym_id
+        self.t_sched = t_sched
+        self.k = 0              # Place in its burst
+        self.edge = None        # Stamp, once sent
+        self.partial = False
+        self.split = False
+        self.garbage = False
+
+def schedule(args, count: int) -> list[Event]:
+    # Bursts of args.burst back to back events, args.rate events/s on average
+    evs = []
+    gap = args.burst / args.rate
+    t = 0.0
+    while t < args.duration:
+        for k in range(args.burst):
+            ptype = PKT_SENT if random.random() < args.sent else PKT_IDX
+            evs.append(Event(len(evs), ptype, random.randrange(count), t))
+            evs[-1].k = k
+        t += gap
+    return evs
+
+class Link:
+    # The MCU end of the pty: a queue of writes paced at the bit rate unless flooding. A
+    # write is made (and stamped) when the UART would start on it and reaches the pty when
+    # its last character would be in, as the bridge assumes.
+    def __init__(self, fd: int, args):
+        self.fd = fd
+        self.char_s = 10 / args.baud
+        self.flood = args.flood
+        self.queue = []         # (not before, bytes or a function making them at write time)
+        self.inflight = None    # (lands at, bytes)
+        self.wire_free = 0.0
+        self.sent_bytes = 0
+
+    def put(self, data, not_before: float = 0.0):
+        self.queue.append((not_before, data))
+
+    def busy(self) -> bool:
+        return bool(self.queue) or self.inflight is not None
+
+    def due(self, now: float) -> float | None:
+        # When step() next has something to do, None with nothing queued
+        if self.inflight is not None:
+            return self.inflight[0]
+        if not self.queue:
+            return None
+        return max(self.queue[0][0], self.wire_free)
+
+    def step(self, now: float):
+        if self.inflight is None and self.queue and self.due(now) <= now:
+            _, data = self.queue.pop(0)
+            if callable(data):
+                data = data()
+            land = now if self.flood else max(now, self.wire_free) + len(data) * self.char_s
+            self.inflight = (land, data)
+            self.wire_free = land
+        if self.inflight is not None and self.inflight[0] <= now:
+            os.write(self.fd, self.inflight[1])     # Blocks while the bridge isn't reading
+            self.sent_bytes += len(self.inflight[1])
+            self.inflight = None
+
+def run(args) -> dict:
+    rows = symcat_gen.read_text(args.catalog)
+    glyphs, cats, _, _, cat_first, _ = symcat_gen.build(rows)
+    mcu = Mcu(args.binary, glyphs, cats, cat_first)
+
+    master, slave = os.openpty()
+    tty.setraw(slave)
+    port = os.ttyname(slave)
+    csv_path = args.csv
+    open(csv_path, "w").close()
+    cmd = [sys.executable, args.bridge, port, "--loopback", "--baud", str(args.baud), "--e2e-file", csv_path]
+    if args.binary:
+        cmd.append("--binary")
+    bridge = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, cwd=HERE)
+    link = Link(master, args)
+    char_s = link.char_s
+
+    def answer(data: bytes, t_rx: float):
+        for b in data:
+            if bytes([b]) == CMD_CATALOG:
+                for chunk in mcu.catalog():
+                    link.put(chunk)
+            elif bytes([b]) == CMD_SYNC:
+                # The request arrived one character time after it left; with --flood the
+                # reply is stamped as sent a line's wire time before it is read
+                rx = ts(t_rx + char_s)
+                wire = len(mcu.sync(0, 0)) * char_s if link.flood else 0.0
+                link.put(lambda rx=rx, wire=wire: mcu.sync(rx, ts(time.perf_counter() - wire)))
+
+    def event_bytes(ev: Event, t0: float):
+        def build() -> bytes:
+            # Scheduled time, so time queued here counts. A burst's events are 1 us apart
+            # so their stamps tell them apart.
+            ev.edge = ts(t0 + ev.t_sched + ev.k * 1e-6)
+            tx = ts_now()
+            return mcu.event(ev.ptype, ev.sym_id, (ev.edge, ev.edge, tx), ev.partial)
+        return build
+
+    # Warm up: catalog, then stamped probe events until the bridge has synced its clock
+    # and times one
+    for chunk in mcu.catalog():
+        link.put(chunk)
+    deadline = time.perf_counter() + args.warmup
+    probe = time.perf_counter() + 0.5
+    warm = {}
+    while not any(row[1] is not None for row in warm.values()):
+        now = time.perf_counter()
+        if bridge.poll() is not None or now > deadline:
+            bridge.kill()
+            sys.exit(f"symbol_loadgen: no end-to-end rows from {args.bridge} after {args.warmup} s")
+        if now >= probe and not link.busy():
+            probe = now + 0.2
+            link.put(lambda: mcu.event(PKT_IDX, 0, (ts_now(), ts_now(), ts_now())))
+        due = link.due(now)
+        wait = 0.05 if due is None else max(0.0, min(0.05, due - now))
+        if select.select([master], [], [], wait)[0]:
+            answer(os.read(master, 256), time.perf_counter())
+        link.step(time.perf_counter())
+        read_rows(csv_path, warm)
+
+    evs = schedule(args, len(glyphs))
+    for ev in evs:
+        ev.partial = random.random() < args.partial
+        ev.split = random.random() < args.split
+        ev.garbage = random.random() < args.garbage
+    t0 = time.perf_counter()
+    cpu0 = cpu_s(bridge.pid)
+    bytes0 = link.sent_bytes
+    i = 0
+    while i < len(evs) or link.busy():
+        now = time.perf_counter()
+        while i < len(evs) and t0 + evs[i].t_sched <= now:
+            ev = evs[i]
+            if ev.garbage:
+                link.put(mcu.garbage())
+            build = event_bytes(ev, t0)
+            if ev.split:
+                cut = {}
+                def first(build=build, cut=cut) -> bytes:
+                    data = build()
+                    k = random.randrange(1, len(data))
+                    cut["rest"] = data[k:]
+                    return data[:k]
+                link.put(first)
+                link.put(lambda cut=cut: cut["rest"], now + args.split_ms / 1e3)
+            else:
+                link.put(build)
+            i += 1
+        wake = [t for t in (link.due(now), t0 + evs[i].t_sched if i < len(evs) else None) if t is not None]
+        if select.select([master], [], [], max(0.0, min(wake) - now) if wake else 0.05)[0]:
+            answer(os.read(master, 256), time.perf_counter())
+        link.step(time.perf_counter())
+    t_sent = time.perf_counter()
+
+    # Let the bridge drain, answering requests, until its CSV stops growing
+    handled = {}
+    last_change = time.perf_counter()
+    while time.perf_counter() - last_change < args.drain:
+        now = time.perf_counter()
+        due = link.due(now)
+        if select.select([master], [], [], 0.05 if due is None else max(0.0, min(0.05, due - now)))[0]:
+            answer(os.read(master, 256), time.perf_counter())
+        link.step(time.perf_counter())
+        n = len(handled)
+        read_rows(csv_path, handled)
+        if len(handled) != n:
+            last_change = time.perf_counter()
+    cpu = cpu_s(bridge.pid) - cpu0
+    bridge.send_signal(signal.SIGINT)
+    try:
+        bridge.wait(5)
+    except subprocess.TimeoutExpired:
+        bridge.kill()
+    os.close(master)
+    os.close(slave)
+    return results(args, evs, handled, t0, t_sent, link.sent_bytes - bytes0, cpu)
+
+def cpu_s(pid: int) -> float:
+    # User + system time of a process so far, from /proc (clock tick resolution)
+    with open(f"/proc/{pid}/stat", encoding="ascii") as f:
+        fields = f.read().rsplit(")", 1)[1].split()
+    return (int(fields[11]) + int(fields[12])) / os.sysconf("SC_CLK_TCK")
+
+def read_rows(path: str, handled: dict):
+    # edge stamp -> (kind, stages in ms or None if the bridge couldn't time it)
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if len(fields) == 8:
+                handled[int(fields[1], 16)] = (fields[0], [float(v) for v in fields[2:]] if fields[2] else None)
+
+def pct(vals: list[float], p: float) -> float:
+    # Nearest rank
+    if not vals:
+        return 0.0
+    vals = sorted(vals)
+    return vals[min(len(vals) - 1, max(0, -(-len(vals) * p // 100) - 1))]
+
+def results(args, evs: list[Event], handled: dict, t0: float, t_sent: float, nbytes: int, cpu: float) -> dict:
+    total = []
+    parse = []
+    inject = []
+    dropped = 0
+    cut = 0
+    untimed = 0
+    t_last = t0
+    for ev in evs:
+        row = handled.get(ev.edge)
+        if ev.partial and args.binary:
+            cut += 1
+            continue
+        if row is None:
+            dropped += 1
+            continue
+        if row[1] is None:
+            untimed += 1        # Handled while the bridge's clock sync was lost
+            continue
+        total.append(row[1][5])
+        parse.append(row[1][3])
+        inject.append(row[1][4])
+        t_last = max(t_last, t0 + ev.t_sched + row[1][5] / 1e3)
+    span = max(t_last, t_sent) - t0
+    return {
+        "events": len(evs),
+        "handled": len(total) + untimed,
+        "untimed": untimed,
+        "dropped": dropped,
+        "cut": cut,
+        "offered_ev_s": round(len(evs) / max(t_sent - t0, 1e-9), 1),
+        "throughput_ev_s": round((len(total) + untimed) / span, 1) if span > 0 else 0.0,
+        "bytes": nbytes,
+        "cpu_us_ev": round(cpu * 1e6 / max(len(total) + untimed, 1), 1),    # Includes the drain's idle time
+        "total_ms": {"p50": pct(total, 50), "p99": pct(total, 99), "max": max(total, default=0.0)},
+        "parse_ms": {"p50": pct(parse, 50), "p99": pct(parse, 99)},
+        "inject_ms": {"p50": pct(inject, 50), "p99": pct(inject, 99)},
+    }
+
+# ========== BASELINE ==========
+def compare(res: dict, base: dict, tol: float) -> list[str]:
+    # Regressions against a saved run: lower throughput, higher p99 or CPU per event, more drops
+    bad = []
+    if res["throughput_ev_s"] < base["throughput_ev_s"] * (1 - tol):
+        bad.append(f"throughput {res['throughput_ev_s']} ev/s, baseline {base['throughput_ev_s']}")
+    if res["total_ms"]["p99"] > base["total_ms"]["p99"] * (1 + tol) + 1.0:
+        bad.append(f"p99 {res['total_ms']['p99']:.3f} ms, baseline {base['total_ms']['p99']:.3f}")
+    if "cpu_us_ev" in base and res["cpu_us_ev"] > base["cpu_us_ev"] * (1 + tol) + 10.0:
+        bad.append(f"{res['cpu_us_ev']} us CPU per event, baseline {base['cpu_us_ev']}")
+    if res["dropped"] > base["dropped"]:
+        bad.append(f"{res['dropped']} dropped, baseline {base['dropped']}")
+    return bad
+
+def print_results(res: dict):
+    print(f"symbol_loadgen: {res['events']} events, {res['handled']} handled ({res['untimed']} untimed), "
+          f"{res['dropped']} dropped, {res['cut']} cut")
+    print(f"symbol_loadgen: offered {res['offered_ev_s']} ev/s, handled {res['throughput_ev_s']} ev/s, "
+          f"{res['bytes']} bytes, {res['cpu_us_ev']} us bridge CPU per event")
+    for name in ("total", "parse", "inject"):
+        st = res[f"{name}_ms"]
+        print(f"symbol_loadgen: {name:>6} ms " + "  ".join(f"{k} {v:.3f}" for k, v in st.items()))
+
+# ========== MAIN ==========
+def main():
+    ap = argparse.ArgumentParser(description="Stress symbol_bridge.py over a pseudo-terminal")
+    ap.add_argument("--rate", type=float, default=50.0, help="events/s, default 50")
+    ap.add_argument("--duration", type=float, default=10.0, help="seconds of events, default 10")
+    ap.add_argument("--burst", type=int, default=1, help="events back to back per burst, default 1")
+    ap.add_argument("--sent", type=float, default=0.3, help="fraction of SYMBOL_SENT, default 0.3")
+    ap.add_argument("--binary", action="store_true", help="COBS packets instead of text lines")
+    ap.add_argument("--baud", type=int, default=115200, help="bit rate the link is paced at")
+    ap.add_argument("--flood", action="store_true", help="don't pace, write as fast as the bridge reads")
+    ap.add_argument("--garbage", type=float, default=0.0, help="probability of a garbage line per event")
+    ap.add_argument("--split", type=float, default=0.0, help="probability of an event written in two parts")
+    ap.add_argument("--split-ms", type=float, default=5.0, help="gap between the parts, default 5")
+    ap.add_argument("--partial", type=float, default=0.0, help="probability of a cut glyph or frame")
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--warmup", type=float, default=10.0, help="most seconds for the catalog and clock sync")
+    ap.add_argument("--drain", type=float, default=1.0, help="seconds without a new row to end the run")
+    ap.add_argument("--bridge", default=os.path.join(HERE, "symbol_bridge.py"), help="receiver to run")
+    ap.add_argument("--catalog", default=symcat_gen.DEF_SRC, help="symbol catalog source")
+    ap.add_argument("--csv", default="loadgen_e2e.csv", help="the bridge's end-to-end rows")
+    ap.add_argument("--save", help="write the results here as a baseline")
+    ap.add_argument("--baseline", help="compare against this baseline, exit 1 on a regression")
+    ap.add_argument("--tol", type=float, default=0.2, help="allowed throughput, p99 and CPU change, default 0.2")
+    args = ap.parse_args()
+    random.seed(args.seed)
+
+    res = run(args)
+    print_results(res)
+    cfg = {k: v for k, v in vars(args).items() if k not in ("save", "baseline", "bridge", "csv", "catalog", "warmup", "drain", "tol")}
+    if args.save:
+        with open(args.save, "w", encoding="utf-8") as f:
+            json.dump({"config": cfg, "results": res}, f, indent=2)
+    if args.baseline:
+        with open(args.baseline, encoding="utf-8") as f:
+            base = json.load(f)
+        if base["config"] != cfg:
+            print("symbol_loadgen: baseline was run with different options", file=sys.stderr)
+        bad = compare(res, base["results"], args.tol)
+        for msg in bad:
+            print(f"symbol_loadgen: REGRESSION {msg}")
+        if bad:
+            sys.exit(1)
+        print("symbol_loadgen: no regression against the baseline")
+
+if __name__ == "__main__":
+    main()
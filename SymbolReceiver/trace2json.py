@@ -0,0 +1,251 @@
+# trace2json.py
+# Converts a Cs/OS3 trace dump (SendTrace() in menu.c, saved by symbol_bridge.py or
+# copied from a serial terminal) to Chrome trace event JSON, which ui.perfetto.dev
+# and chrome://tracing open. Prints where the time went between each switch edge
+# and the SYMBOL_SENT or SYMBOL_IDX that followed it.
+#
+#   python3 trace2json.py trace.txt > trace.json
+#
+# The dump is "TRACE_BEGIN: <count> <lost> <ts Hz>", "TRACE_OBJ: <id> <T|S> <prio> <name>",
+# "TRACE_EV: <index> <record> ..." and "TRACE_END: <count>" lines. A record is 8 bytes in
+# hex, [32-bit ts][type][id][16-bit arg] little endian (SymbolEntry/board/CsOS_Trace.h).
+
+import argparse
+import json
+import struct
+import sys
+
+# ========== RECORD TYPES (CsOS_Trace.h) ==========
+T_TASK_IN = 1
+T_TASK_READY = 2
+T_ISR_ENTER = 3
+T_ISR_EXIT = 4
+T_ISR_EXIT_SCHED = 5
+T_SEM_POST = 6
+T_SEM_PEND = 7
+T_SEM_PEND_BLOCK = 8
+T_TSEM_POST = 9
+T_TSEM_PEND = 10
+T_TSEM_PEND_BLOCK = 11
+T_TICK = 12
+T_TICK_LIST_BEGIN = 13
+T_TICK_LIST_END = 14
+T_USER = 15
+
+# Instant events, by type. The id is the task or semaphore.
+INSTANTS = {
+    T_TASK_READY: "ready",
+    T_SEM_POST: "sem post",
+    T_SEM_PEND: "sem pend",
+    T_SEM_PEND_BLOCK: "sem pend block",
+    T_TSEM_POST: "task sem post",
+    T_TSEM_PEND: "task sem pend",
+    T_TSEM_PEND_BLOCK: "task sem pend block",
+}
+
+# CSOS_TRACE_MARK_x
+MARK_SW_EDGE = 1
+MARK_SW_EV = 2
+MARK_IDX = 3
+MARK_SENT = 4
+MARK_NAMES = {MARK_SW_EDGE: "SW edge", MARK_SW_EV: "SW event", MARK_IDX: "SYMBOL_IDX", MARK_SENT: "SYMBOL_SENT"}
+
+# Exception numbers (16 + IRQn, MCXN947_cm33_core0.h) of the ISRs that call OSIntEnter()
+IRQ_NAMES = {15: "SysTick", 17: "EDMA_0_CH0", 33: "GPIO00", 55: "LP_FLEXCOMM4", 159: "LPTMR0", 160: "LPTMR1"}
+
+# Chrome trace thread ids: tasks use their trace ID, the rest sit above them
+TID_TICK = 900
+TID_LATENCY = 901
+TID_ISR = 1000
+
+# ========== DUMP PARSER ==========
+class TraceDump:
+    def __init__(self, count: int, lost: int, hz: int):
+        self.count = count
+        self.lost = lost
+        self.hz = hz
+        self.objs = {}      # id -> (kind, prio, name)
+        self.recs = []      # (ts, type, id, arg), oldest first
+
+def read_dumps(lines) -> list[TraceDump]:
+    # Complete BEGIN..END blocks only; a block cut short is dropped
+    dumps = []
+    cur = None
+    for line in lines:
+        line = line.strip()
+        tag, _, rest = line.partition(":")
+        fields = rest.split()
+        try:
+            if tag == "TRACE_BEGIN":
+                cur = TraceDump(int(fields[0]), int(fields[1]), int(fields[2]))
+            elif cur is None:
+                continue
+            elif tag == "TRACE_OBJ":
+                cur.objs[int(fields[0])] = (fields[1], int(fields[2]), " ".join(fields[3:]))
+            elif tag == "TRACE_EV":
+                if int(fields[0]) != len(cur.recs):
+                    cur = None      # Lost a line
+                    continue
+                for rec in fields[1:]:
+                    cur.recs.append(struct.unpack("<IBBH", bytes.fromhex(rec)))
+            elif tag == "TRACE_END":
+                if len(cur.recs) == cur.count:
+                    dumps.append(cur)
+                cur = None
+        except (IndexError, ValueError, struct.error):
+            cur = None
+    return dumps
+
+# ========== CONVERSION ==========
+def unwrap(dump: TraceDump) -> list[tuple[float, int, int, int]]:
+    # 32-bit timestamps to µs from the first record. Records are in slot order; a writer
+    # preempted between taking its slot and reading the timer can be a little out of
+    # order, so a small step back is taken as that and not as a wrap.
+    out = []
+    t = 0
+    prev = None
+    for ts, typ, oid, arg in dump.recs:
+        if typ == 0:
+            continue            # Slot still being written when the ring was read
+        if prev is not None:
+            d = (ts - prev) & 0xFFFFFFFF
+            t += d - (1 << 32) if d >= (1 << 31) else d
+        prev = ts
+        out.append((t * 1e6 / dump.hz, typ, oid, arg))
+    out.sort(key=lambda r: r[0])
+    return out
+
+def obj_name(dump: TraceDump, oid: int) -> str:
+    obj = dump.objs.get(oid)
+    return obj[2] if obj else f"#{oid}"
+
+def isr_name(irq: int) -> str:
+    return IRQ_NAMES.get(irq, f"IRQ {irq - 16}" if irq >= 16 else f"exception {irq}")
+
+def convert(dump: TraceDump):
+    # Returns the Chrome trace events and, per edge, the time spent in each context
+    evs = []
+    recs = unwrap(dump)
+    pid = 1
+
+    def meta(tid: int, name: str, order: int):
+        evs.append({"ph": "M", "pid": pid, "tid": tid, "name": "thread_name", "args": {"name": name}})
+        evs.append({"ph": "M", "pid": pid, "tid": tid, "name": "thread_sort_index", "args": {"sort_index": order}})
+
+    def slice_(tid: int, name: str, t0: float, t1: float, args=None):
+        ev = {"ph": "X", "pid": pid, "tid": tid, "name": name, "ts": t0, "dur": max(t1 - t0, 0.0)}
+        if args:
+            ev["args"] = args
+        evs.append(ev)
+
+    evs.append({"ph": "M", "pid": pid, "name": "process_name", "args": {"name": "MCU (Cs/OS3)"}})
+    for oid, (kind, prio, name) in dump.objs.items():
+        if kind == "T":
+            meta(oid, f"{name} (prio {prio})", prio)
+    meta(TID_TICK, "Tick list", 500)
+    meta(TID_LATENCY, "Edge to symbol", -1)
+
+    task = None                 # (id, start) of the running task
+    isrs = []                   # (irq, start) stack
+    tick_list = None
+    seen_isrs = set()
+    # Time accounting: whatever runs between two records gets the time between them
+    edge = None                 # (first edge time, {context: µs}) until its switch event
+    window = None               # The same from the switch event to the menu output
+    windows = []
+    last_t = recs[0][0] if recs else 0.0
+
+    def ctx() -> str:
+        if isrs:
+            return "ISR " + isr_name(isrs[-1][0])
+        return obj_name(dump, task[0]) if task else "?"
+
+    for t, typ, oid, arg in recs:
+        for w in (edge, window):
+            if w is not None:
+                w[1][ctx()] = w[1].get(ctx(), 0.0) + (t - last_t)
+        last_t = t
+        tid = TID_ISR + isrs[-1][0] if isrs else (task[0] if task else 0)
+
+        if typ == T_TASK_IN:
+            if task is None or task[0] != oid:
+                if task is not None:
+                    slice_(task[0], obj_name(dump, task[0]), task[1], t)
+                task = (oid, t)
+        elif typ == T_ISR_ENTER:
+            if oid not in seen_isrs:
+                seen_isrs.add(oid)
+                meta(TID_ISR + oid, "ISR " + isr_name(oid), -10)
+            isrs.append((oid, t))
+        elif typ in (T_ISR_EXIT, T_ISR_EXIT_SCHED):
+            if isrs:
+                irq, t0 = isrs.pop()
+                slice_(TID_ISR + irq, isr_name(irq), t0, t,
+                       {"switch": typ == T_ISR_EXIT_SCHED})
+        elif typ == T_TICK_LIST_BEGIN:
+            tick_list = (t, arg)
+        elif typ == T_TICK_LIST_END:
+            if tick_list is not None:
+                slice_(TID_TICK, "OS_TickListUpdate", tick_list[0], t,
+                       {"ticks": tick_list[1], "updated": arg})
+            tick_list = None
+        elif typ == T_TICK:
+            evs.append({"ph": "i", "s": "t", "pid": pid, "tid": TID_TICK, "name": "tick", "ts": t,
+                        "args": {"OSTickCtr": arg}})
+        elif typ == T_USER:
+            name = MARK_NAMES.get(oid, f"mark {oid}")
+            evs.append({"ph": "i", "s": "g", "pid": pid, "tid": tid, "name": name, "ts": t, "args": {"arg": arg}})
+            if oid == MARK_SW_EDGE:
+                if edge is None:
+                    edge = (t, {})      # First edge of a press, bounces follow
+            elif oid == MARK_SW_EV:
+                window = edge if edge is not None else (t, {})   # Polled mode has no edge
+                edge = None
+            elif oid in (MARK_IDX, MARK_SENT) and window is not None:
+                slice_(TID_LATENCY, f"edge to {name} {arg}", window[0], t)
+                windows.append((window[0], t, name, arg, window[1]))
+                window = None
+        elif typ in INSTANTS:
+            evs.append({"ph": "i", "s": "t", "pid": pid, "tid": tid, "name": f"{INSTANTS[typ]} {obj_name(dump, oid)}",
+                        "ts": t})
+
+    # Close what was still open when the ring was read
+    if task is not None:
+        slice_(task[0], obj_name(dump, task[0]), task[1], last_t)
+    for irq, t0 in isrs:
+        slice_(TID_ISR + irq, isr_name(irq), t0, last_t)
+    return evs, windows
+
+# ========== MAIN ==========
+def main():
+    ap = argparse.ArgumentParser(description="Cs/OS3 trace dump to Chrome/Perfetto JSON")
+    ap.add_argument("dump", nargs="?", help="trace dump, stdin if not given")
+    ap.add_argument("-o", "--out", help="JSON file, stdout if not given")
+    ap.add_argument("-n", "--dump-index", type=int, default=-1, help="which dump in the file, default the last")
+    args = ap.parse_args()
+
+    if args.dump:
+        with open(args.dump, encoding="utf-8", errors="replace") as f:
+            dumps = read_dumps(f)
+    else:
+        dumps = read_dumps(sys.stdin)
+    if not dumps:
+        sys.exit("trace2json: no complete TRACE_BEGIN..TRACE_END dump found")
+    dump = dumps[args.dump_index]
+    evs, windows = convert(dump)
+
+    out = open(args.out, "w", encoding="utf-8") if args.out else sys.stdout
+    json.dump({"traceEvents": evs, "displayTimeUnit": "ns"}, out)
+    if args.out:
+        out.close()
+
+    recs = unwrap(dump)
+    span = (recs[-1][0] - recs[0][0]) if recs else 0.0
+    print(f"trace2json: {len(recs)} records over {span / 1e3:.1f} ms, {dump.lost} overwritten",
+          file=sys.stderr)
+    for t0, t1, name, arg, where in windows:
+        parts = ", ".join(f"{k} {v:.0f}" for k, v in sorted(where.items(), key=lambda kv: -kv[1]))
+        print(f"trace2json: edge to {name} {arg}: {t1 - t0:.0f} us ({parts})", file=sys.stderr)
+
+if __name__ == "__main__":
+    main()